@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				AABB.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Axis aligned bounding box - a minimum and maximum corner with a ray slab test.
+//						An empty box has its minimum above its maximum so growing it by any point gives that point.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AABB_H
+#define AABB_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <limits>
+
+#include "Vector3.h"
+#include "AffineTransform.h"
+#include "Ray.h"
+//\------------------------
+
+class AABB
+{
+public:
+	//\----------------------------------------------------------------------------------
+	//\ Member Variables
+	//\----------------------------------------------------------------------------------
+	Vector3 min;
+	Vector3 max;
+	//\----------------------------------------------------------------------------------
+	//\ Constructors - default is the empty box
+	//\----------------------------------------------------------------------------------
+	constexpr AABB();
+	constexpr AABB(const Vector3& a_min, const Vector3& a_max);
+//\====================================================================================================
+// -- BOX FUNCTIONALITY
+//\====================================================================================================
+	bool				IsEmpty() const;
+	void				Grow(const Vector3& a_point);
+	void				Grow(const AABB& a_box);
+	Vector3				Centre() const;
+	Vector3				Extent() const;
+	// Half the surface area - the constant factor does not matter to the surface area heuristic
+	float				HalfArea() const;
+	// Box around the eight transformed corners of this box
+	AABB				Transformed(const AffineTransform& a_tx) const;
+	//\----------------------------------------------------------------------------------
+	//\ Slab test - a_invDir is one over each component of the ray direction so the division is done once per ray.
+	//\ Returns true when the ray enters the box before a_maxDistance, a_entry is the ray parameter it enters at.
+	//\----------------------------------------------------------------------------------
+	bool				IntersectRay(const Vector3& a_origin, const Vector3& a_invDir, float a_maxDistance, float& a_entry) const;
+};
+
+constexpr AABB::AABB() : min(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()),
+						 max(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max())
+{
+}
+constexpr AABB::AABB(const Vector3& a_min, const Vector3& a_max) : min(a_min), max(a_max)
+{
+}
+
+#endif // !AABB_H
@@ -0,0 +1,122 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				AffineTransform.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Class that implements a 3 by 4 affine transform in Column major Order.
+//						The last row of a Matrix4 used for position, rotation and scale is always (0, 0, 0, 1) so it is
+//						not stored or multiplied. Each column is padded to 16 bytes so SSE can load it directly.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef AFFINETRANSFORM_H
+#define AFFINETRANSFORM_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <iostream>
+
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Matrix4.h"
+//\------------------------
+
+//\----------------------------------------------------------------------------------
+//\ SSE is always available on x64 builds - fall back to scalar code everywhere else
+//\----------------------------------------------------------------------------------
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATHLIB_SSE 1
+#endif
+
+class AffineTransform
+{
+public:
+	//\====================================================================================================
+	//\ Member Variables - four columns (x axis, y axis, z axis, translation)
+	//\		m[column][3] is padding and is always 0
+	//\====================================================================================================
+	alignas(16) float	m[4][4];
+	//\----------------------------------------------------------------------------------
+	//\ Constants
+	//\----------------------------------------------------------------------------------
+	static const AffineTransform IDENTITY;
+	//\----------------------------------------------------------------------------------
+	//\ Constructors
+	//\----------------------------------------------------------------------------------
+	constexpr AffineTransform(); // Default - Identity
+	constexpr AffineTransform(const Vector3& a_xAxis, const Vector3& a_yAxis, const Vector3& a_zAxis, const Vector3& a_translation);
+	explicit AffineTransform(const Matrix4& a_m4); // Drops the last row of the matrix
+	//\----------------------------------------------------------------------------------
+	//\ Conversion back to a full Matrix4 with a (0, 0, 0, 1) last row
+	//\----------------------------------------------------------------------------------
+	Matrix4				ToMatrix4			() const;
+	//\----------------------------------------------------------------------------------
+	//\ Column Access - columns 0 to 2 are the axes, column 3 is the translation
+	//\----------------------------------------------------------------------------------
+	void				SetColumn			(int a_iCol, const Vector3& a_vCol);
+	Vector3				GetColumn			(int a_iCol) const;
+	void				SetTranslation		(const Vector3& a_v3)			{ SetColumn(3, a_v3); }
+	Vector3				GetTranslation		() const						{ return GetColumn(3); }
+//\====================================================================================================
+//\ Transforms - SIMD when MATHLIB_SSE is defined
+//\====================================================================================================
+	//\----------------------------------------------------------------------------------
+	//\ Points are rotated, scaled and translated - vectors are only rotated and scaled
+	//\----------------------------------------------------------------------------------
+	Vector3				TransformPoint		(const Vector3& a_v3) const;
+	Vector3				TransformVector		(const Vector3& a_v3) const;
+	//\----------------------------------------------------------------------------------
+	//\ Normals transform by the inverse transpose of a transform. Call this on the inverse
+	//\ (world to object) transform to take an object space normal into world space.
+	//\ The result is not normalised.
+	//\----------------------------------------------------------------------------------
+	Vector3				TransformNormal		(const Vector3& a_v3) const;
+	//\----------------------------------------------------------------------------------
+	//\ Composition - (A * B) applies B first then A
+	//\----------------------------------------------------------------------------------
+	AffineTransform		operator *			(const AffineTransform& a_tx) const;
+	const AffineTransform& operator *=		(const AffineTransform& a_tx);
+	bool				operator ==			(const AffineTransform& a_tx) const;
+	bool				operator !=			(const AffineTransform& a_tx) const;
+	//\----------------------------------------------------------------------------------
+	//\ Overload operators for Output Stream
+	//\----------------------------------------------------------------------------------
+	friend std::ostream& operator << (std::ostream& os, const AffineTransform& a_tx);
+//\====================================================================================================
+//\ Additional Functionality
+//\====================================================================================================
+	void				Identity			();
+	void				Scale				(const Vector3& a_v3);
+	void				Translate			(const Vector3& a_v3);
+	//\----------------------------------------------------------------------------------
+	//\ Inverse - when the axes are orthogonal (rotation and scale only) the inverse is the
+	//\ transposed axes divided by their squared lengths. Sheared transforms fall back to a
+	//\ general 3x3 inverse. Singular transforms return IDENTITY like Matrix4::Inverse.
+	//\----------------------------------------------------------------------------------
+	float				Determinant			() const;
+	bool				IsOrthogonal		() const;
+	AffineTransform		Inverse				() const;
+};
+
+//\----------------------------------------------------------------------------------
+//\ Default Constructor - by default init to identity
+//\----------------------------------------------------------------------------------
+constexpr AffineTransform::AffineTransform() : m{ { 1.f, 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f, 0.f }, { 0.f, 0.f, 1.f, 0.f }, { 0.f, 0.f, 0.f, 0.f } }
+{
+}
+//\----------------------------------------------------------------------------------
+//\ Construct from the three axis and the translation
+//\----------------------------------------------------------------------------------
+constexpr AffineTransform::AffineTransform(const Vector3& a_xAxis, const Vector3& a_yAxis, const Vector3& a_zAxis, const Vector3& a_translation) :
+	m{	{ a_xAxis.x, a_xAxis.y, a_xAxis.z, 0.f },
+		{ a_yAxis.x, a_yAxis.y, a_yAxis.z, 0.f },
+		{ a_zAxis.x, a_zAxis.y, a_zAxis.z, 0.f },
+		{ a_translation.x, a_translation.y, a_translation.z, 0.f } }
+{
+}
+//\----------------------------------------------------------------------------------
+//\ Identity AffineTransform - a compile time constant
+//\----------------------------------------------------------------------------------
+inline constexpr AffineTransform AffineTransform::IDENTITY = AffineTransform();
+#endif
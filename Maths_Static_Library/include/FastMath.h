@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				FastMath.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Approximations of pow, exp2, log2 and the inverse square root for shading, with the most
+//						error each one makes written next to it. They have no table lookups and every condition is
+//						a select rather than a branch. Whether the renderer uses them is set at run time by the precision.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cmath>
+#include <cstring>
+#include <string>
+
+#include "Vector3.h"
+#include "AffineTransform.h"
+
+#ifdef MATHLIB_SSE
+#include <emmintrin.h>
+#endif
+//\------------------------
+
+namespace FastMath
+{
+	//\----------------------------------------------------------------------------------
+	//\ Precision of the shading and sampling code - PRECISE uses the standard library, FAST the functions below.
+	//\ Set it before rendering, it is read by every render thread. It lives in the header so the switches below
+	//\ inline into the shading code rather than costing a call each.
+	//\----------------------------------------------------------------------------------
+	enum Precision
+	{
+		PRECISE,
+		FAST,
+	};
+	inline Precision	g_precision = PRECISE;		// Shared by every thread - it is only changed between renders
+	inline void			SetPrecision(Precision a_precision) { g_precision = a_precision; }
+	inline Precision	GetPrecision() { return g_precision; }
+	inline bool			IsFast() { return g_precision == FAST; }
+	// Read "precise" or "fast" - false and a_precision unchanged for anything else
+	bool			ParsePrecision(const std::string& a_name, Precision& a_precision);
+	const char*		PrecisionName(Precision a_precision);
+
+	inline float BitsToFloat(int a_bits)
+	{
+		float value;
+		std::memcpy(&value, &a_bits, sizeof(value));
+		return value;
+	}
+	inline int FloatToBits(float a_value)
+	{
+		int bits;
+		std::memcpy(&bits, &a_value, sizeof(bits));
+		return bits;
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ 2 to the power a_value. The nearest whole number goes straight into the exponent bits and a degree 5
+	//\ polynomial fitted at the Chebyshev nodes gives 2^f for the rest, f in -0.5 -> 0.5. Inputs are clamped to
+	//\ -126 -> 127, so the result is always a normal float. Most relative error 2.4e-7 (about 2 ulp).
+	//\----------------------------------------------------------------------------------
+	inline float Exp2(float a_value)
+	{
+		float x = a_value < -126.f ? -126.f : a_value;
+		x = x > 127.f ? 127.f : x;
+		// Adding 1.5 * 2^23 rounds x to a whole number held in the low mantissa bits, with no float to int conversion
+		const float rounded = x + 12582912.f;
+		const int whole = FloatToBits(rounded) - 0x4B400000;
+		const float f = x - (rounded - 12582912.f);
+		const float p = 1.00000008f + f * (0.693147188f + f * (0.240221075f + f * (0.0555035711f + f * (0.00967603192f + f * 0.00133908634f))));
+		return BitsToFloat((whole + 127) << 23) * p;
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Base 2 logarithm of a positive normal float. The mantissa is brought into sqrt(1/2) -> sqrt(2) and the
+	//\ series for log((1 + t) / (1 - t)) to t^7 is summed, |t| < 0.172. Most error 1.6e-7 absolute for a_value in
+	//\ 0.5 -> 2 and 1.3e-7 relative outside it.
+	//\ Zero, negative and denormal inputs give garbage - Pow deals with zero and below itself.
+	//\----------------------------------------------------------------------------------
+	inline float Log2(float a_value)
+	{
+		const int bits = FloatToBits(a_value);
+		int exponent = ((bits >> 23) & 0xFF) - 127;
+		float mantissa = BitsToFloat((bits & 0x007FFFFF) | 0x3F800000);		// 1 -> 2
+		const bool high = mantissa > 1.41421356f;
+		mantissa = high ? mantissa * 0.5f : mantissa;
+		exponent += high ? 1 : 0;
+		const float t = (mantissa - 1.f) / (mantissa + 1.f);
+		const float t2 = t * t;
+		// 2 / ln(2) times 1, 1/3, 1/5 and 1/7
+		return (float)exponent + t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * 0.412198583f)));
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ a_base to the power a_exponent for a_base >= 0, as Exp2(a_exponent * Log2(a_base)). Zero and below give 0.
+	//\ The error of Log2 is multiplied by a_exponent, so the relative error grows with it - at most 4e-6 over the
+	//\ specular range, a_base 0 -> 1 and a_exponent 1 -> 255, counting results above 1e-6 that can still light a pixel.
+	//\----------------------------------------------------------------------------------
+	inline float Pow(float a_base, float a_exponent)
+	{
+		const float result = Exp2(a_exponent * Log2(a_base > 1e-30f ? a_base : 1.f));
+		return a_base > 1e-30f ? result : 0.f;
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ 1 / sqrt(a_value) for a positive a_value - the hardware estimate (12 bits) or the integer trick where there
+	//\ is no SSE, then Newton steps. Most relative error 2.9e-7 with SSE and 1.9e-7 without.
+	//\----------------------------------------------------------------------------------
+	inline float RSqrt(float a_value)
+	{
+#ifdef MATHLIB_SSE
+		float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a_value)));
+		return estimate * (1.5f - 0.5f * a_value * estimate * estimate);
+#else
+		float estimate = BitsToFloat(0x5F375A86 - (FloatToBits(a_value) >> 1));
+		estimate = estimate * (1.5f - 0.5f * a_value * estimate * estimate);
+		estimate = estimate * (1.5f - 0.5f * a_value * estimate * estimate);
+		return estimate * (1.5f - 0.5f * a_value * estimate * estimate);
+#endif
+	}
+
+	// Square root as a_value * RSqrt(a_value) - zero stays zero. Most relative error that of RSqrt.
+	inline float Sqrt(float a_value)
+	{
+		const float root = a_value * RSqrt(a_value > 0.f ? a_value : 1.f);
+		return a_value > 0.f ? root : 0.f;
+	}
+
+	// Unit vector along a_vec3 through RSqrt, a zero vector stays zero - length within 2.9e-7 of 1
+	inline Vector3 Normalize(const Vector3& a_vec3)
+	{
+		const float lengthSqr = a_vec3.x * a_vec3.x + a_vec3.y * a_vec3.y + a_vec3.z * a_vec3.z;
+		float invLength = RSqrt(lengthSqr > 0.f ? lengthSqr : 1.f);
+		invLength = lengthSqr > 0.f ? invLength : 0.f;
+		return Vector3(a_vec3.x * invLength, a_vec3.y * invLength, a_vec3.z * invLength);
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ The precision switch - the standard function or the approximation, whichever the precision asks for.
+	//\ The check is a predictable branch, far cheaper than either function.
+	//\----------------------------------------------------------------------------------
+	inline float PowP(float a_base, float a_exponent)
+	{
+		return g_precision == FAST ? Pow(a_base, a_exponent) : powf(a_base, a_exponent);
+	}
+
+	inline float SqrtP(float a_value)
+	{
+		return g_precision == FAST ? Sqrt(a_value) : sqrtf(a_value);
+	}
+
+	inline Vector3 NormalizeP(const Vector3& a_vec3)
+	{
+		// Vector3's Normalize is named as ::Normalize - inside the namespace the name would also find FastMath::Normalize
+		return g_precision == FAST ? FastMath::Normalize(a_vec3) : ::Normalize(a_vec3);
+	}
+
+#ifdef MATHLIB_SSE
+	//\----------------------------------------------------------------------------------
+	//\ Four at a time - the same steps in the same order as the functions above, so every lane gives the
+	//\ same bits the one value version would, and the errors above hold for each lane
+	//\----------------------------------------------------------------------------------
+	// a_mask ? a_true : a_false for each lane, a_mask all ones or all zeros as the compares give
+	inline __m128 Select(__m128 a_mask, __m128 a_true, __m128 a_false)
+	{
+		return _mm_or_ps(_mm_and_ps(a_mask, a_true), _mm_andnot_ps(a_mask, a_false));
+	}
+
+	inline __m128 Exp2(__m128 a_value)
+	{
+		const __m128 magic = _mm_set1_ps(12582912.f);
+		__m128 x = _mm_max_ps(_mm_set1_ps(-126.f), a_value);		// max and min keep the lane they are given on a tie, as the compares above do
+		x = _mm_min_ps(_mm_set1_ps(127.f), x);
+		const __m128 rounded = _mm_add_ps(x, magic);
+		const __m128i whole = _mm_sub_epi32(_mm_castps_si128(rounded), _mm_set1_epi32(0x4B400000));
+		const __m128 f = _mm_sub_ps(x, _mm_sub_ps(rounded, magic));
+		__m128 p = _mm_add_ps(_mm_set1_ps(0.00967603192f), _mm_mul_ps(f, _mm_set1_ps(0.00133908634f)));
+		p = _mm_add_ps(_mm_set1_ps(0.0555035711f), _mm_mul_ps(f, p));
+		p = _mm_add_ps(_mm_set1_ps(0.240221075f), _mm_mul_ps(f, p));
+		p = _mm_add_ps(_mm_set1_ps(0.693147188f), _mm_mul_ps(f, p));
+		p = _mm_add_ps(_mm_set1_ps(1.00000008f), _mm_mul_ps(f, p));
+		return _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(whole, _mm_set1_epi32(127)), 23)), p);
+	}
+
+	inline __m128 Log2(__m128 a_value)
+	{
+		const __m128i bits = _mm_castps_si128(a_value);
+		__m128i exponent = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(bits, 23), _mm_set1_epi32(0xFF)), _mm_set1_epi32(127));
+		__m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+		const __m128 high = _mm_cmpgt_ps(mantissa, _mm_set1_ps(1.41421356f));
+		mantissa = Select(high, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f)), mantissa);
+		exponent = _mm_sub_epi32(exponent, _mm_castps_si128(high));		// The mask is -1 where the mantissa was halved
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 t = _mm_div_ps(_mm_sub_ps(mantissa, one), _mm_add_ps(mantissa, one));
+		const __m128 t2 = _mm_mul_ps(t, t);
+		__m128 series = _mm_add_ps(_mm_set1_ps(0.577078016f), _mm_mul_ps(t2, _mm_set1_ps(0.412198583f)));
+		series = _mm_add_ps(_mm_set1_ps(0.961796694f), _mm_mul_ps(t2, series));
+		series = _mm_add_ps(_mm_set1_ps(2.88539008f), _mm_mul_ps(t2, series));
+		return _mm_add_ps(_mm_cvtepi32_ps(exponent), _mm_mul_ps(t, series));
+	}
+
+	inline __m128 Pow(__m128 a_base, __m128 a_exponent)
+	{
+		const __m128 positive = _mm_cmpgt_ps(a_base, _mm_set1_ps(1e-30f));
+		const __m128 result = Exp2(_mm_mul_ps(a_exponent, Log2(Select(positive, a_base, _mm_set1_ps(1.f)))));
+		return _mm_and_ps(positive, result);
+	}
+
+	inline __m128 RSqrt(__m128 a_value)
+	{
+		const __m128 estimate = _mm_rsqrt_ps(a_value);
+		return _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), a_value), estimate), estimate)));
+	}
+
+	inline __m128 Sqrt(__m128 a_value)
+	{
+		const __m128 positive = _mm_cmpgt_ps(a_value, _mm_setzero_ps());
+		return _mm_and_ps(positive, _mm_mul_ps(a_value, RSqrt(Select(positive, a_value, _mm_set1_ps(1.f)))));
+	}
+
+	// Four vectors, one to a lane of a_x, a_y and a_z, made unit length in place
+	inline void Normalize(__m128& a_x, __m128& a_y, __m128& a_z)
+	{
+		const __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a_x, a_x), _mm_mul_ps(a_y, a_y)), _mm_mul_ps(a_z, a_z));
+		const __m128 positive = _mm_cmpgt_ps(lengthSqr, _mm_setzero_ps());
+		const __m128 invLength = _mm_and_ps(positive, RSqrt(Select(positive, lengthSqr, _mm_set1_ps(1.f))));
+		a_x = _mm_mul_ps(a_x, invLength);
+		a_y = _mm_mul_ps(a_y, invLength);
+		a_z = _mm_mul_ps(a_z, invLength);
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ The precision switch for four lanes - precise lanes match powf, sqrtf and Normalize bit for bit
+	//\----------------------------------------------------------------------------------
+	// The standard library has no four wide pow, so precise lanes go through powf one at a time
+	__m128			PrecisePow(__m128 a_base, __m128 a_exponent);
+
+	inline __m128 PowP(__m128 a_base, __m128 a_exponent)
+	{
+		return g_precision == FAST ? Pow(a_base, a_exponent) : PrecisePow(a_base, a_exponent);
+	}
+
+	inline __m128 SqrtP(__m128 a_value)
+	{
+		return g_precision == FAST ? Sqrt(a_value) : _mm_sqrt_ps(a_value);
+	}
+
+	// Precise lanes take the steps of Vector3's Normalize - one over the length, then a multiply
+	inline void NormalizeP(__m128& a_x, __m128& a_y, __m128& a_z)
+	{
+		if (g_precision == FAST)
+		{
+			Normalize(a_x, a_y, a_z);
+			return;
+		}
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a_x, a_x), _mm_mul_ps(a_y, a_y)), _mm_mul_ps(a_z, a_z)));
+		const __m128 positive = _mm_cmpgt_ps(length, _mm_setzero_ps());		// No length gives a zero vector
+		const __m128 invLength = _mm_div_ps(_mm_set1_ps(1.f), length);
+		a_x = _mm_and_ps(positive, _mm_mul_ps(a_x, invLength));
+		a_y = _mm_and_ps(positive, _mm_mul_ps(a_y, invLength));
+		a_z = _mm_and_ps(positive, _mm_mul_ps(a_z, invLength));
+	}
+#endif
+};
+
+#endif // !FASTMATH_H
@@ -10,12 +10,31 @@
 #ifndef MATHLIB_H
 #define MATHLIB_H
 
+#include <limits>
 
 namespace MathLib
 {
-	const float PI = 3.14159265359f;
-	const float DEG2RAD = PI / 180.f;
-	const float RAD2DEG = 180.f * PI;
+	constexpr float PI = 3.14159265359f;
+	constexpr float DEG2RAD = PI / 180.f;
+	constexpr float RAD2DEG = 180.f / PI;
+
+	//\----------------------------------------------------------------------------------
+	//\ Compile time square root - Newton's method, for building tables in constant expressions.
+	//\ Use std::sqrt at runtime, this is much slower.
+	//\----------------------------------------------------------------------------------
+	constexpr float Sqrt(float a_value)
+	{
+		if (a_value == 0.f) { return 0.f; }
+		if (!(a_value > 0.f)) { return std::numeric_limits<float>::quiet_NaN(); }
+		float guess = a_value > 1.f ? a_value : 1.f;
+		for (int i = 0; i < 64; ++i)
+		{
+			const float next = 0.5f * (guess + a_value / guess);
+			if (next == guess) { break; }
+			guess = next;
+		}
+		return guess;
+	}
 }
 
 #include "Vector2.h"
@@ -23,7 +42,9 @@ namespace MathLib
 #include "Vector4.h"
 #include "Matrix3.h"
 #include "Matrix4.h"
+#include "AffineTransform.h"
 #include "Ray.h"
+#include "AABB.h"
 #include "Random.h"
 
 #endif
\ No newline at end of file
@@ -25,8 +25,10 @@ private:
 	//\----------------------------------------------------------------------------------
 	//\ Member variables held in unnamed union for accessibility 
 	//\		Items in a union share the same memory 
-	//\		E.g. m[0][0] == m_11 == m_xAxis.x 
-	//\		m[2][2] == m_m_33 == m_zAxis.z 
+	//\		E.g. m[0][0] == m_11
+	//\		m[2][2] == m_m_33
+	//\		The constexpr functions only use the m_ names - a constant expression may only
+	//\		read the union member that was initialised
 	//\----------------------------------------------------------------------------------
 	union
 	{
@@ -37,12 +39,6 @@ private:
 			float m_12, m_22, m_32;		// Column 2 -> y axis
 			float m_13, m_23, m_33;		// Column 3 -> z axis
 		};
-		struct
-		{
-			Vector3 m_xAxis;
-			Vector3 m_yAxis;
-			Vector3 m_zAxis;
-		};
 	};
 public:
 	//\----------------------------------------------------------------------------------
@@ -52,17 +48,13 @@ public:
 	//\----------------------------------------------------------------------------------
 	//\ Constructors 
 	//\----------------------------------------------------------------------------------
-	Matrix3(); //default constructor
-	Matrix3(const float* a_mat); // float pointer to an array of floats
-	Matrix3(float a_m11, float a_m21, float a_m31, // constructors for taking all nine float arguments
+	constexpr Matrix3(); //default constructor
+	constexpr Matrix3(const float* a_mat); // float pointer to an array of floats
+	constexpr Matrix3(float a_m11, float a_m21, float a_m31, // constructors for taking all nine float arguments
 			float a_m12, float a_m22, float a_m32,
 			float a_m13, float a_m23, float a_m33);
-	Matrix3(const Vector3& a_xAxis, const Vector3& a_yAxis, const Vector3& a_zAxis); // constructor for three axis vectors
-	Matrix3(const Matrix3& a_m3); // copy constructor to allow us to easily duplicate a matrix.
-	//\----------------------------------------------------------------------------------
-	//\ Destructor 
-	//\----------------------------------------------------------------------------------
-	~Matrix3();
+	constexpr Matrix3(const Vector3& a_xAxis, const Vector3& a_yAxis, const Vector3& a_zAxis); // constructor for three axis vectors
+	// Copy, assignment and destruction are the compiler generated (trivial) ones
 	//\----------------------------------------------------------------------------------
 	//\ Component Access Operators 
 	//\----------------------------------------------------------------------------------
@@ -80,28 +72,28 @@ public:
 	//\----------------------------------------------------------------------------------
 	//\ Eqivalance Operators 
 	//\----------------------------------------------------------------------------------
-	bool				operator ==			(const Matrix3& a_m3) const;
-	bool				operator !=			(const Matrix3& a_m3) const;
+	constexpr bool		operator ==			(const Matrix3& a_m3) const;
+	constexpr bool		operator !=			(const Matrix3& a_m3) const;
 	//\----------------------------------------------------------------------------------
 	//\ Overload operators for Addition 
 	//\----------------------------------------------------------------------------------
-	Matrix3				operator +			(const Matrix3& a_m3) const;
-	const Matrix3&		operator +=			(const Matrix3& a_m3);
+	constexpr Matrix3	operator +			(const Matrix3& a_m3) const;
+	constexpr const Matrix3& operator +=	(const Matrix3& a_m3);
 	//\----------------------------------------------------------------------------------
 	//\  Overload operators for Subtraction 
 	//\----------------------------------------------------------------------------------
-	Matrix3				operator -			(const Matrix3& a_m3) const;
-	const Matrix3&		operator -=			(const Matrix3& a_m3);
+	constexpr Matrix3	operator -			(const Matrix3& a_m3) const;
+	constexpr const Matrix3& operator -=	(const Matrix3& a_m3);
 	//\----------------------------------------------------------------------------------
 	//\ Overload operators for Multiplication 
 	//\----------------------------------------------------------------------------------
-	Matrix3				operator *			(const float a_scalar) const;
-	const Matrix3&		operator *=			(const float a_scalar);
+	constexpr Matrix3	operator *			(const float a_scalar) const;
+	constexpr const Matrix3& operator *=	(const float a_scalar);
 
-	Vector3				operator *			(const Vector3& a_v3) const;
+	constexpr Vector3	operator *			(const Vector3& a_v3) const;
 
-	Matrix3				operator *			(const Matrix3& a_m3) const;
-	const Matrix3&		operator *=			(const Matrix3& a_m3);
+	constexpr Matrix3	operator *			(const Matrix3& a_m3) const;
+	constexpr const Matrix3& operator *=	(const Matrix3& a_m3);
 	//\----------------------------------------------------------------------------------
 	//\ Overload operators for Output Stream 
 	//\----------------------------------------------------------------------------------
@@ -115,13 +107,13 @@ public:
 	//\----------------------------------------------------------------------------------
 	//\ Transpose 
 	//\----------------------------------------------------------------------------------
-	void				Transpose();
-	Matrix3				GetTranspose() const;
+	constexpr void		Transpose();
+	constexpr Matrix3	GetTranspose() const;
 	//\----------------------------------------------------------------------------------
 	//\ Scale 
 	//\----------------------------------------------------------------------------------
-	void				Scale(const float a_scalar);
-	void				Scale(const Vector3& a_v3);
+	constexpr void		Scale(const float a_scalar);
+	constexpr void		Scale(const Vector3& a_v3);
 	//\----------------------------------------------------------------------------------
 	//\ Rotation Functions  
 	//\----------------------------------------------------------------------------------
@@ -135,11 +127,11 @@ public:
 	//\----------------------------------------------------------------------------------
 	//\ Identity 
 	//\----------------------------------------------------------------------------------
-	void				Identity();
+	constexpr void		Identity();
 	//\----------------------------------------------------------------------------------
 	//\ Determinant 
 	//\----------------------------------------------------------------------------------
-	float				Determinant()const;
+	constexpr float		Determinant()const;
 	//\----------------------------------------------------------------------------------
 	//\ Inverse 
 	//\----------------------------------------------------------------------------------
@@ -148,4 +140,185 @@ public:
 	//\----------------------------------------------------------------------------------
 };
 
+#pragma region Constructors
+//\----------------------------------------------------------------------------------
+//\ Default Constructor - by default init to identity 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3::Matrix3() :	m_11(1.f), m_21(0.f), m_31(0.f),
+								m_12(0.f), m_22(1.f), m_32(0.f),
+								m_13(0.f), m_23(0.f), m_33(1.f)
+{
+}
+//\----------------------------------------------------------------------------------
+//\ Constructor using pointer to float data 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3::Matrix3(const float* a_mat):	m_11(a_mat[0]), m_21(a_mat[1]), m_31(a_mat[2]),
+												m_12(a_mat[3]), m_22(a_mat[4]), m_32(a_mat[5]),
+												m_13(a_mat[6]), m_23(a_mat[7]), m_33(a_mat[8])
+{
+}
+//\----------------------------------------------------------------------------------
+//\ Constructor using all components of matrix data structure 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3::Matrix3	(float a_m11, float a_m21, float a_m31,
+							float a_m12, float a_m22, float a_m32,
+							float a_m13, float a_m23, float a_m33):
+							m_11(a_m11), m_21(a_m21), m_31(a_m31), 
+							m_12(a_m12), m_22(a_m22), m_32(a_m32),
+							m_13(a_m13), m_23(a_m23), m_33(a_m33)
+{
+}
+//\----------------------------------------------------------------------------------
+//\ Construct from Axis angle vectors 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3::Matrix3(const Vector3& a_xAxis, const Vector3& a_yAxis, const Vector3& a_zAxis) :
+	m_11(a_xAxis.x), m_21(a_xAxis.y), m_31(a_xAxis.z),
+	m_12(a_yAxis.x), m_22(a_yAxis.y), m_32(a_yAxis.z),
+	m_13(a_zAxis.x), m_23(a_zAxis.y), m_33(a_zAxis.z)
+{
+}
+#pragma endregion
+//\----------------------------------------------------------------------------------
+//\ Identity Matrix3 - a compile time constant
+//\----------------------------------------------------------------------------------
+inline constexpr Matrix3 Matrix3::IDENTITY = Matrix3(1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f);
+#pragma region Operator_Overloads
+//\----------------------------------------------------------------------------------
+//\ Equivalence Operators - Matrix Testing for equality 
+//\----------------------------------------------------------------------------------
+constexpr bool Matrix3::operator == (const Matrix3& a_m3) const
+{
+	return	m_11 == a_m3.m_11 && m_21 == a_m3.m_21 && m_31 == a_m3.m_31 &&
+			m_12 == a_m3.m_12 && m_22 == a_m3.m_22 && m_32 == a_m3.m_32 &&
+			m_13 == a_m3.m_13 && m_23 == a_m3.m_23 && m_33 == a_m3.m_33;
+}
+constexpr bool Matrix3::operator != (const Matrix3& a_m3) const
+{
+	return !(*this == a_m3);
+}
+//\----------------------------------------------------------------------------------
+//\ Operator Overloads for Addition 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3 Matrix3::operator+(const Matrix3& a_m3) const
+{
+	return Matrix3(	m_11 + a_m3.m_11, m_21 + a_m3.m_21, m_31 + a_m3.m_31,
+					m_12 + a_m3.m_12, m_22 + a_m3.m_22, m_32 + a_m3.m_32,
+					m_13 + a_m3.m_13, m_23 + a_m3.m_23, m_33 + a_m3.m_33);
+}
+constexpr const Matrix3& Matrix3::operator+=(const Matrix3& a_m3)
+{
+	m_11 += a_m3.m_11; m_12 += a_m3.m_12; m_13 += a_m3.m_13;
+	m_21 += a_m3.m_21; m_22 += a_m3.m_22; m_23 += a_m3.m_23;
+	m_31 += a_m3.m_31; m_32 += a_m3.m_32; m_33 += a_m3.m_33;
+	return *this;
+}
+//\----------------------------------------------------------------------------------
+//\ Operator Overloads for Subtraction 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3 Matrix3::operator-(const Matrix3& a_m3) const
+{
+	return Matrix3(	m_11 - a_m3.m_11, m_21 - a_m3.m_21, m_31 - a_m3.m_31,
+					m_12 - a_m3.m_12, m_22 - a_m3.m_22, m_32 - a_m3.m_32,
+					m_13 - a_m3.m_13, m_23 - a_m3.m_23, m_33 - a_m3.m_33);
+}
+constexpr const Matrix3& Matrix3::operator-=(const Matrix3& a_m3)
+{
+	m_11 -= a_m3.m_11; m_12 -= a_m3.m_12; m_13 -= a_m3.m_13;
+	m_21 -= a_m3.m_21; m_22 -= a_m3.m_22; m_23 -= a_m3.m_23;
+	m_31 -= a_m3.m_31; m_32 -= a_m3.m_32; m_33 -= a_m3.m_33;
+	return *this;
+}
+//\----------------------------------------------------------------------------------
+//\ Operator Overloads for Multiplication 
+//\----------------------------------------------------------------------------------
+constexpr Matrix3 Matrix3::operator*(const float a_fScalar) const
+{
+	return Matrix3(	m_11 * a_fScalar, m_21 * a_fScalar, m_31 * a_fScalar,
+					m_12 * a_fScalar, m_22 * a_fScalar, m_32 * a_fScalar,
+					m_13 * a_fScalar, m_23 * a_fScalar, m_33 * a_fScalar);
+}
+constexpr const Matrix3& Matrix3::operator*=(float a_fScalar)
+{
+	m_11 *= a_fScalar; m_12 *= a_fScalar; m_13 *= a_fScalar;
+	m_21 *= a_fScalar; m_22 *= a_fScalar; m_23 *= a_fScalar;
+	m_31 *= a_fScalar; m_32 *= a_fScalar; m_33 *= a_fScalar;
+	return *this;
+}
+//\----------------------------------------------------------------------------------
+//\ Matrix multiplication you simply calculate the dot product 
+//\		of each row of the LHS matrix by each column of the RHS matrix.
+//\----------------------------------------------------------------------------------
+constexpr Vector3 Matrix3::operator*(const Vector3& a_v3) const
+{
+	return Vector3(
+		m_11 * a_v3.x + m_12 * a_v3.y + m_13 * a_v3.z,
+		m_21 * a_v3.x + m_22 * a_v3.y + m_23 * a_v3.z,
+		m_31 * a_v3.x + m_32 * a_v3.y + m_33 * a_v3.z);
+}
+constexpr Matrix3 Matrix3::operator*(const Matrix3& a_m3) const
+{
+	return Matrix3(	m_11 * a_m3.m_11 + m_12 * a_m3.m_21 + m_13 * a_m3.m_31,
+					m_21 * a_m3.m_11 + m_22 * a_m3.m_21 + m_23 * a_m3.m_31,
+					m_31 * a_m3.m_11 + m_32 * a_m3.m_21 + m_33 * a_m3.m_31,
+
+					m_11 * a_m3.m_12 + m_12 * a_m3.m_22 + m_13 * a_m3.m_32,
+					m_21 * a_m3.m_12 + m_22 * a_m3.m_22 + m_23 * a_m3.m_32,
+					m_31 * a_m3.m_12 + m_32 * a_m3.m_22 + m_33 * a_m3.m_32,
+
+					m_11 * a_m3.m_13 + m_12 * a_m3.m_23 + m_13 * a_m3.m_33,
+					m_21 * a_m3.m_13 + m_22 * a_m3.m_23 + m_23 * a_m3.m_33,
+					m_31 * a_m3.m_13 + m_32 * a_m3.m_23 + m_33 * a_m3.m_33);
+}
+constexpr const Matrix3& Matrix3::operator*=(const Matrix3& a_m3)
+{
+	*this = (*this) * a_m3;
+	return *this;
+}
+#pragma endregion
+#pragma region Algebraic_Functionality
+//\----------------------------------------------------------------------------------
+//\ Transpose Matrix - Transform from Row To Column 
+//\----------------------------------------------------------------------------------
+constexpr void Matrix3::Transpose()
+{
+	float k = m_12; m_12 = m_21; m_21 = k;
+	k = m_13; m_13 = m_31; m_31 = k;
+	k = m_23; m_23 = m_32; m_32 = k;
+}
+constexpr Matrix3 Matrix3::GetTranspose() const
+{
+	return Matrix3( m_11, m_12, m_13,
+					m_21, m_22, m_23,
+					m_31, m_32, m_33);
+}
+//\----------------------------------------------------------------------------------
+//\ Scale Functionality 
+//\----------------------------------------------------------------------------------
+constexpr void Matrix3::Scale(const Vector3& a_v3)
+{
+	m_11 = a_v3.x;		m_12 = 0.0f;	m_13 = 0.0f;
+	m_21 = 0.0f;		m_22 = a_v3.y;	m_23 = 0.0f;
+	m_31 = 0.0f;		m_32 = 0.0f;	m_33 = a_v3.z;
+}
+constexpr void Matrix3::Scale(float a_fScalar)
+{
+	Scale(Vector3(a_fScalar, a_fScalar, a_fScalar));
+}
+constexpr void Matrix3::Identity()
+{
+	m_11 = 1.0f;	m_12 = 0.0f;	m_13 = 0.0f;
+	m_21 = 0.0f;	m_22 = 1.0f;	m_23 = 0.0f;
+	m_31 = 0.0f;	m_32 = 0.0f;	m_33 = 1.0f;
+}
+//\----------------------------------------------------------------------------------
+//\ Determinant - Must be a non-zero value 
+//\		Cross product of row 2 & 3 dotted with row 1
+//\----------------------------------------------------------------------------------
+constexpr float Matrix3::Determinant() const
+{
+	return (m_11 * (m_22 * m_33 - m_23 * m_32) +
+			m_12 * (m_23 * m_31 - m_21 * m_33) +
+			m_13 * (m_21 * m_32 - m_22 * m_31));
+}
+#pragma endregion
 #endif
\ No newline at end of file
@@ -24,6 +24,9 @@ namespace Random
 	int				GetSeed();
 	// Plants the seed
 	void			SetSeed(const int& iSeed);
+	// Seed for one of many independent sequences - the same seed and coordinates always give the same seed,
+	// so a pixel gets the same random numbers however much of the image is rendered
+	int				HashSeed(const int& iSeed, const int& iX, const int& iY);
 	// Sets the MAX integer
 	int				RandMax();
 
@@ -27,6 +27,8 @@ private:
 	Vector3 m_v3Direction;			// Direction is the direction of the ray
 	float	m_MaxLength;			// Max Length is the maximal length the ray can project 
 	float	m_MinLength;			// Min Length is the minimal length the ray can project 
+	float	m_ConeWidth;			// Width of the cone of space the ray stands for where it starts
+	float	m_ConeSpread;			// How fast the cone widens - width gained per unit travelled
 
 public:
 	//\----------------------------------------------------------------------------------
@@ -34,6 +36,7 @@ public:
 	//\----------------------------------------------------------------------------------
 	Ray();
 	Ray(const Ray& a_Ray);
+	Ray& operator=(const Ray& a_Ray) = default;
 	Ray(const Vector3& a_v3Origin, const Vector3& a_v3Direction, float a_MinLength = 0.f, float a_maxLength = std::numeric_limits<float>::max() );
 	//\----------------------------------------------------------------------------------
 	//\ Destructors 
@@ -47,6 +50,17 @@ public:
 	Vector3			Direction() const			{ return m_v3Direction; }
 	float			MaxDistance() const			{ return m_MaxLength; }
 	float			MinLength() const			{ return m_MinLength; }
+	float			ConeSpread() const			{ return m_ConeSpread; }
+	// Cut the ray short - used to stop searches at the nearest hit found so far
+	void			SetMaxDistance(float a_maxLength)	{ m_MaxLength = a_maxLength; }
+
+	//\----------------------------------------------------------------------------------
+	//\ Ray cone - a ray from the camera stands for the whole pixel it was traced through. The width of
+	//\ that cone where it hits something is how much of the surface the pixel covers, which is what
+	//\ texture filtering needs. Rays start as a line, a width and spread of 0.
+	//\----------------------------------------------------------------------------------
+	void			SetCone(float a_width, float a_spread)	{ m_ConeWidth = a_width; m_ConeSpread = a_spread; }
+	float			ConeWidthAt(float a_distance) const		{ return m_ConeWidth + m_ConeSpread * a_distance; }
 
 	//\----------------------------------------------------------------------------------
 	//\ Point At - To return a point a specific distance along the ray
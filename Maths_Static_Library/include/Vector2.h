@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-// 
+//
 //	File:				Vector2.h
 //	Author:				Scott Baldwin
 //	Last Edited:		20-05-21
@@ -11,7 +11,8 @@
 #define _VECTOR2_H_
 
 //\====================================================================================================
-//\ Vector2 - 2 Dimensional Vector Class 
+//\ Vector2 - 2 Dimensional Vector Class
+//\		Everything here is constexpr and defined in this header so vectors can be built at compile time
 //\====================================================================================================
 class Vector2
 {
@@ -22,33 +23,24 @@ public:
 	float x; float y;
 
 	//\----------------------------------------------------------------------------------
-	//\Constructors/Destructers
-	//\----------------------------------------------------------------------------------
-	Vector2();															// Default Constructor
-	Vector2(float a_x, float a_y);										// Custom Constructor (float values)
-	Vector2(const Vector2& a_v2);										// Copy Constructor
-	//\----------------------------------------------------------------------------------
-	//\ Destructor
+	//\Constructors - copy, assignment and destruction are the compiler generated (trivial) ones
 	//\----------------------------------------------------------------------------------
-	~Vector2();
+	constexpr Vector2();												// Default Constructor
+	constexpr Vector2(float a_x, float a_y);							// Custom Constructor (float values)
 
 //\====================================================================================================
 // -- OPERATOR OVERLOADS
 //\====================================================================================================
 	//\----------------------------------------------------------------------------------
-	//\ Assignment Operator
+	//\ Equivalence Operators
 	//\----------------------------------------------------------------------------------
-	Vector2&			operator =				(const Vector2& a_v2);
+	constexpr bool		operator ==				(const Vector2& a_v2) const;
+	constexpr bool		operator !=				(const Vector2& a_v2) const;
 	//\----------------------------------------------------------------------------------
-	//\ Equivalence Operators 
+	//\ Addition and Subtraction
 	//\----------------------------------------------------------------------------------
-	bool				operator ==				(const Vector2& a_v2);
-	bool				operator !=				(const Vector2& a_v2);
-	//\----------------------------------------------------------------------------------
-	//\ Addition and Subtraction 
-	//\----------------------------------------------------------------------------------
-	const Vector2		operator -				() const;
-	Vector2				operator +				(const Vector2& a_v2) const;
+	constexpr const Vector2	operator -			() const;
+	constexpr Vector2	operator +				(const Vector2& a_v2) const;
 
 //\====================================================================================================
 // -- VECTOR 2 FUNCTIONALITY
@@ -57,8 +49,50 @@ public:
 	//\----------------------------------------------------------------------------------
 	//\ Dot Product Functionality
 	//\----------------------------------------------------------------------------------
-	float				Dot(const Vector2& a_v2) const;
-	friend float		Dot(const Vector2& a_v2a, const Vector2& a_v2b);
+	constexpr float		Dot(const Vector2& a_v2) const;
+	friend constexpr float Dot(const Vector2& a_v2a, const Vector2& a_v2b);
 	//\----------------------------------------------------------------------------------
 };
-#endif // _VECTOR2_H_
\ No newline at end of file
+
+//\====================================================================================================
+// -- CONSTRUCTORS
+//\====================================================================================================
+constexpr Vector2::Vector2() : x(0.f), y(0.f)							// Initialising the default constructor values to zero
+{
+}
+constexpr Vector2::Vector2(float a_x, float a_y) : x(a_x), y(a_y)		// Initialising the X and Y to their corrosponding arguments
+{
+}
+
+//\====================================================================================================
+// -- OPERATOR OVERLOADS
+//\====================================================================================================
+constexpr bool Vector2::operator ==(const Vector2& a_v2) const
+{
+	return (x == a_v2.x && y == a_v2.y);
+}
+constexpr bool Vector2::operator !=(const Vector2& a_v2) const
+{
+	return (x != a_v2.x || y != a_v2.y);
+}
+constexpr const Vector2 Vector2::operator -() const
+{
+	return Vector2(-x, -y);
+}
+constexpr Vector2 Vector2::operator +(const Vector2& a_v2) const
+{
+	return Vector2(x + a_v2.x, y + a_v2.y);
+}
+
+//\====================================================================================================
+// -- VECTOR 2 FUNCTIONALITY
+//\====================================================================================================
+constexpr float Vector2::Dot(const Vector2& a_v2) const
+{
+	return x * a_v2.x + y * a_v2.y;
+}
+constexpr float Dot(const Vector2& a_v2a, const Vector2& a_v2b)
+{
+	return a_v2a.x * a_v2b.x + a_v2a.y * a_v2b.y;
+}
+#endif // _VECTOR2_H_
@@ -1,5 +1,5 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-// 
+//
 //	File:				Vector3.h
 //	Author:				Scott Baldwin
 //	Last Edited:		20-05-21
@@ -8,7 +8,9 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 
 //\====================================================================================================
-//\ Vector3 - 3 Dimensional Vector Class 
+//\ Vector3 - 3 Dimensional Vector Class
+//\		All of the arithmetic is constexpr and defined at the bottom of this header. Only the functions
+//\		that need a square root (Length and Normalize) live in Vector3.cpp.
 //\====================================================================================================
 
 #ifndef VECTOR3_H
@@ -18,79 +20,188 @@ class Vector3
 {
 public:
 	//\----------------------------------------------------------------------------------
-	//\ Member Variables 
+	//\ Member Variables
 	//\----------------------------------------------------------------------------------
 	float x; float y; float z;
 
 	//\----------------------------------------------------------------------------------
-	//\ Constructors 
-	//\----------------------------------------------------------------------------------
-	Vector3();																	// Default Constructor
-	Vector3(const float a_x, const float a_y, const float a_z);					// Custom Constructor (float values)
-	Vector3(const Vector3& a_v3);												// Copy Constructor
-	//\----------------------------------------------------------------------------------
-	//\ Destructor 
+	//\ Constructors - copy, assignment and destruction are the compiler generated (trivial) ones
 	//\----------------------------------------------------------------------------------
-	~Vector3();
+	constexpr Vector3();														// Default Constructor
+	constexpr Vector3(const float a_x, const float a_y, const float a_z);		// Custom Constructor (float values)
 
 //\====================================================================================================
 // -- OPERATOR OVERLOADS
 //\====================================================================================================
 	//\----------------------------------------------------------------------------------
-	//\ Equivalence Operators 
+	//\ Equivalence Operators
 	//\----------------------------------------------------------------------------------
-	bool				operator ==			(const Vector3& a_v3) const;
-	bool				operator !=			(const Vector3& a_v3) const;
+	constexpr bool		operator ==			(const Vector3& a_v3) const;
+	constexpr bool		operator !=			(const Vector3& a_v3) const;
 	//\----------------------------------------------------------------------------------
-	//\ Negate Operator 
+	//\ Negate Operator
 	//\----------------------------------------------------------------------------------
-	const Vector3		operator -			()const ;
+	constexpr const Vector3	operator -		()const ;
 	//\----------------------------------------------------------------------------------
-	//\ Addition Operators 
+	//\ Addition Operators
 	//\----------------------------------------------------------------------------------
-	Vector3				operator +			(const Vector3& a_v3) const;
-	Vector3				operator +			(const float a_scalar) const;
-	Vector3				operator +=			(const Vector3& a_v3);
+	constexpr Vector3	operator +			(const Vector3& a_v3) const;
+	constexpr Vector3	operator +			(const float a_scalar) const;
+	constexpr Vector3	operator +=			(const Vector3& a_v3);
 	//\----------------------------------------------------------------------------------
-	//\ Subtraction Operators 
+	//\ Subtraction Operators
 	//\----------------------------------------------------------------------------------
-	Vector3				operator -			(const Vector3& a_v3)const;
+	constexpr Vector3	operator -			(const Vector3& a_v3)const;
 
 //\====================================================================================================
 // -- VECTOR 3 FUNCTIONALITY
 //\====================================================================================================
 
 	//\----------------------------------------------------------------------------------
-	//\ DOT Product Functionality 
+	//\ DOT Product Functionality
 	//\----------------------------------------------------------------------------------
-	float				Dot(const Vector3& a_v3) const;
-	friend float		Dot(const Vector3& a_v3A, const Vector3& a_v3B);
+	constexpr float		Dot(const Vector3& a_v3) const;
+	friend constexpr float Dot(const Vector3& a_v3A, const Vector3& a_v3B);
 	//\----------------------------------------------------------------------------------
-	//\ CROSS Product 
+	//\ CROSS Product
 	//\----------------------------------------------------------------------------------
-	Vector3				Cross(const Vector3& b) const;
-	friend Vector3		Cross(const Vector3& a_v3A, const Vector3& a_v3B);
+	constexpr Vector3	Cross(const Vector3& b) const;
+	friend constexpr Vector3 Cross(const Vector3& a_v3A, const Vector3& a_v3B);
 	//\----------------------------------------------------------------------------------
 	//\ Multiplication Operators - Allows us to multiply Vector3 by a scalar Value
 	//\----------------------------------------------------------------------------------
-	Vector3				operator *			(const float& a_scalar) const;
-	Vector3				operator *			(const Vector3& s_v30) const;
+	constexpr Vector3	operator *			(const float& a_scalar) const;
+	constexpr Vector3	operator *			(const Vector3& s_v30) const;
 	//\----------------------------------------------------------------------------------
-	//\ Get the Length of Vector 
+	//\ Get the Length of Vector
 	//\----------------------------------------------------------------------------------
 	float				Length() const;
 	//\----------------------------------------------------------------------------------
-	//\ Normalize the Vector - modifies variables ( non const function 
+	//\ Normalize the Vector - modifies variables ( non const function
 	//\----------------------------------------------------------------------------------
 	void				Normalize();
 	friend Vector3		Normalize(const Vector3& a_vec3) ;
 	//\----------------------------------------------------------------------------------
-	//\ Linear Interpolate 
+	//\ Linear Interpolate
 	//\----------------------------------------------------------------------------------
-	friend Vector3		Lerp(const Vector3& a_v3A, const Vector3& a_v3B, const float a_t);
+	friend constexpr Vector3 Lerp(const Vector3& a_v3A, const Vector3& a_v3B, const float a_t);
 	//\----------------------------------------------------------------------------------
-	//\ Reflect one Vector around another 
+	//\ Reflect one Vector around another
 	//\----------------------------------------------------------------------------------
-	friend Vector3		Reflect(const Vector3& a_v3A, const Vector3& a_v3B);
+	friend constexpr Vector3 Reflect(const Vector3& a_v3A, const Vector3& a_v3B);
 };
-#endif
\ No newline at end of file
+
+//\====================================================================================================
+// -- CONSTRUCTORS
+//\====================================================================================================
+constexpr Vector3::Vector3() : x(0.f), y(0.f), z(0.f)
+{
+}
+constexpr Vector3::Vector3(const float a_x, const float a_y, const float a_z) : x(a_x), y(a_y), z(a_z)
+{
+}
+
+//\====================================================================================================
+// -- OPERATOR OVERLOADS
+//\====================================================================================================
+
+//\----------------------------------------------------------------------------------
+//\ Equivalence operators
+//\----------------------------------------------------------------------------------
+constexpr bool Vector3::operator==(const Vector3& a_v3) const
+{
+	return ( x == a_v3.x && y == a_v3.y && z == a_v3.z);
+}
+constexpr bool Vector3::operator!=(const Vector3& a_v3) const
+{
+	return (x != a_v3.x || y != a_v3.y || z != a_v3.z);
+}
+//\----------------------------------------------------------------------------------
+//\ Negate
+//\----------------------------------------------------------------------------------
+constexpr const Vector3 Vector3::operator-() const
+{
+	return Vector3(-x, -y, -z);
+}
+//\----------------------------------------------------------------------------------
+//\ Addition + Subtraction -
+//\----------------------------------------------------------------------------------
+constexpr Vector3 Vector3::operator+(const Vector3& a_v3) const
+{
+	return Vector3(x + a_v3.x, y + a_v3.y, z + a_v3.z);
+}
+constexpr Vector3 Vector3::operator-(const Vector3& a_v3) const
+{
+	return Vector3(x - a_v3.x, y - a_v3.y, z - a_v3.z);
+}
+constexpr Vector3 Vector3::operator+(const float a_scalar) const
+{
+	return Vector3(x + a_scalar, y + a_scalar, z + a_scalar);
+}
+constexpr Vector3 Vector3::operator+=(const Vector3& a_v3)
+{
+	x += a_v3.x;
+	y += a_v3.y;
+	z += a_v3.z;
+	return *this;
+}
+//\----------------------------------------------------------------------------------
+//\ MULTIPLICATION
+//\----------------------------------------------------------------------------------
+constexpr Vector3 Vector3::operator*(const float& a_scalar) const
+{
+	return Vector3(x * a_scalar, y * a_scalar, z * a_scalar);
+}
+constexpr Vector3 Vector3::operator*(const Vector3& a_v3) const
+{
+	return Vector3(a_v3.x * x, a_v3.y * y, a_v3.z * z);
+}
+
+//\====================================================================================================
+// -- VECTOR 3 FUNCTIONALITY
+//\====================================================================================================
+
+//\----------------------------------------------------------------------------------
+//\ Dot Product - projection of one vector along another
+//\				  or the cosine value of the angle between two vectors
+//\----------------------------------------------------------------------------------
+constexpr float Vector3::Dot(const Vector3& a_v3) const
+{
+	return (x * a_v3.x + y * a_v3.y + z * a_v3.z);
+}
+constexpr float Dot(const Vector3& a_v3A, const Vector3& a_v3B)
+{
+	return a_v3A.Dot(a_v3B);
+}
+//\----------------------------------------------------------------------------------
+//\ CROSS PRODUCT
+//\----------------------------------------------------------------------------------
+constexpr Vector3 Vector3::Cross(const Vector3& b) const
+{
+	return Vector3 (y*b.z - z*b.y,
+					z*b.x - x*b.z,
+					x*b.y - y*b.x);
+}
+constexpr Vector3 Cross(const Vector3& a_v3A, const Vector3& a_v3B)
+{
+	return a_v3A.Cross(a_v3B);
+}
+//\----------------------------------------------------------------------------------
+//\ LERP - Linear Interpolate
+//\----------------------------------------------------------------------------------
+constexpr Vector3 Lerp(const Vector3& a_v3A, const Vector3& a_v3B, const float a_t)
+{
+	return (a_v3B - a_v3A) * a_t + a_v3A;
+}
+//\----------------------------------------------------------------------------------
+//\ REFLECT - one Vector around another
+//\----------------------------------------------------------------------------------
+constexpr Vector3 Reflect(const Vector3& a_v3A, const Vector3& a_v3B)
+{
+	return a_v3A - a_v3B * 2.f * Dot(a_v3A, a_v3B);
+}
+//\----------------------------------------------------------------------------------
+//\ NORMALIZE - defined in Vector3.cpp, declared here as well so it can be named as ::Normalize
+//\----------------------------------------------------------------------------------
+Vector3 Normalize(const Vector3& a_vec3);
+#endif
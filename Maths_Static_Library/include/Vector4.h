@@ -26,16 +26,11 @@ class Vector4
 	//\----------------------------------------------------------------------------------
 	float x; float y; float z; float w;
 	//\----------------------------------------------------------------------------------
-	//\ Constructors 
+	//\ Constructors - copy, assignment and destruction are the compiler generated (trivial) ones
 	//\----------------------------------------------------------------------------------
-	Vector4();																		// Default Constructor
-	Vector4(const float a_x, const float a_y, const float a_z, const float a_w);	// Custom Constructor (float values)
-	Vector4(const Vector3& a_v3, float a_w = 0.f);									// Copy Constructor - initialising w to 0
-	Vector4(const Vector4& a_v4);													// Copy Constructor	
-	//\----------------------------------------------------------------------------------	
-	//\ Destructor 
-	//\----------------------------------------------------------------------------------
-	~Vector4();
+	constexpr Vector4();																	// Default Constructor
+	constexpr Vector4(const float a_x, const float a_y, const float a_z, const float a_w);	// Custom Constructor (float values)
+	constexpr Vector4(const Vector3& a_v3, float a_w = 0.f);								// Copy Constructor - initialising w to 0
 
 //\====================================================================================================
 // -- OPERATOR OVERLOADS
@@ -43,28 +38,28 @@ class Vector4
 	//\----------------------------------------------------------------------------------
 	//\ Equivalence Operators 
 	//\----------------------------------------------------------------------------------
-	bool			operator ==				(const Vector4& a_v4) const;
-	bool			operator !=				(const Vector4& a_v4) const;
+	constexpr bool	operator ==				(const Vector4& a_v4) const;
+	constexpr bool	operator !=				(const Vector4& a_v4) const;
 	//\----------------------------------------------------------------------------------
 	//\ Negate operator 
 	//\----------------------------------------------------------------------------------
-	const Vector4	operator -				() const;
+	constexpr const Vector4	operator -		() const;
 	//\----------------------------------------------------------------------------------
 	//\ Addition Operators 
 	//\----------------------------------------------------------------------------------
-	Vector4			operator +				(const Vector4& a_v4) const;
-	Vector4			operator +				(const float a_scalar) const;
+	constexpr Vector4	operator +			(const Vector4& a_v4) const;
+	constexpr Vector4	operator +			(const float a_scalar) const;
 
-	Vector4			operator +=				(const Vector4& a_v4) ;
+	constexpr Vector4	operator +=			(const Vector4& a_v4) ;
 	//\----------------------------------------------------------------------------------
     //\ Subtraction Operators 
 	//\----------------------------------------------------------------------------------
-    Vector4			operator -				(const Vector4& a_v4) const;
-	Vector4			operator -				(const float a_scalar) const;
+	constexpr Vector4	operator -			(const Vector4& a_v4) const;
+	constexpr Vector4	operator -			(const float a_scalar) const;
 	//\----------------------------------------------------------------------------------
 	//\ Multiplication Operators 
 	//\----------------------------------------------------------------------------------
-	Vector4			operator *				(const float& a_scalar) const;
+	constexpr Vector4	operator *			(const float& a_scalar) const;
 	//\----------------------------------------------------------------------------------
 	
 //\====================================================================================================
@@ -74,8 +69,8 @@ class Vector4
 	//\----------------------------------------------------------------------------------
 	//\ Dot Product  
 	//\----------------------------------------------------------------------------------
-	float					Dot(const Vector4& a_v4) const;
-	friend float			Dot(const Vector4& a_v4A, const Vector4& a_v4B);
+	constexpr float			Dot(const Vector4& a_v4) const;
+	friend constexpr float	Dot(const Vector4& a_v4A, const Vector4& a_v4B);
 	//\----------------------------------------------------------------------------------
 	//\ Get Length of Vector 
 	//\----------------------------------------------------------------------------------
@@ -88,11 +83,117 @@ class Vector4
 	//\----------------------------------------------------------------------------------
 	//\ Linear Interpolation 
 	//\----------------------------------------------------------------------------------
-	friend Vector4			Lerp(const Vector4 a_v4A, const Vector4& a_v4B, const float a_t);
+	friend constexpr Vector4 Lerp(const Vector4 a_v4A, const Vector4& a_v4B, const float a_t);
 
 	//\----------------------------------------------------------------------------------
 	// make Vector 4 into Vector 3
 	//\----------------------------------------------------------------------------------
-	Vector3 xyz() const;
+	constexpr Vector3 xyz() const;
 };
+
+//\====================================================================================================
+// -- CONSTRUCTORS - the constexpr functions are defined here, Length and Normalize live in Vector4.cpp
+//\====================================================================================================
+constexpr Vector4::Vector4() : x(0.f), y(0.f), z(0.f), w(0.f)
+{
+}
+constexpr Vector4::Vector4(const float a_x, const float a_y, const float a_z, const float a_w) :
+	x(a_x), y(a_y), z(a_z), w(a_w)
+{
+}
+//\----------------------------------------------------------------------------------
+//\ Construct from Vector 3
+//\----------------------------------------------------------------------------------
+constexpr Vector4::Vector4(const Vector3& a_v3, float a_w) :
+	x(a_v3.x), y(a_v3.y), z(a_v3.z), w(a_w)
+{
+}
+
+//\====================================================================================================
+// -- OPERATOR OVERLOADS
+//\====================================================================================================
+
+//\----------------------------------------------------------------------------------
+//\ Equivalence operators
+//\----------------------------------------------------------------------------------
+constexpr bool Vector4::operator==(const Vector4& a_v4) const
+{
+	return ( x == a_v4.x && y == a_v4.y && z == a_v4.z && w == a_v4.w);
+}
+constexpr bool Vector4::operator!=(const Vector4& a_v4) const
+{
+	return (x != a_v4.x || y != a_v4.y || z != a_v4.z || w != a_v4.w);
+}
+//\----------------------------------------------------------------------------------
+//\ Neg operator
+//\----------------------------------------------------------------------------------
+constexpr const Vector4 Vector4::operator-() const
+{
+	return Vector4(-x, -y, -z, -w);
+}
+//\----------------------------------------------------------------------------------
+//\ Overload Operators for Vector4 Addition
+//\----------------------------------------------------------------------------------
+constexpr Vector4 Vector4::operator+(const Vector4& a_v4) const
+{
+	return Vector4(x + a_v4.x, y + a_v4.y, z + a_v4.z, w + a_v4.w);
+}
+constexpr Vector4 Vector4::operator+(const float a_scalar) const
+{
+	return Vector4(x + a_scalar, y + a_scalar, z + a_scalar, w + a_scalar);
+}
+constexpr Vector4 Vector4::operator+=(const Vector4& a_v4)
+{
+	x += a_v4.x;
+	y += a_v4.y;
+	z += a_v4.z;
+	w += a_v4.w;
+	return *this;
+}
+//\----------------------------------------------------------------------------------
+//\ Overload Operators for Vector4 Subtraction
+//\----------------------------------------------------------------------------------
+constexpr Vector4 Vector4::operator-(const Vector4& a_v4) const
+{
+	return Vector4(x - a_v4.x, y - a_v4.y, z - a_v4.z, w - a_v4.w);
+}
+constexpr Vector4 Vector4::operator-(const float a_scalar) const
+{
+	return Vector4(x - a_scalar, y - a_scalar, z - a_scalar, w - a_scalar);
+}
+//\----------------------------------------------------------------------------------
+//\ Overload Operators for Vector4 Multiplication
+//\----------------------------------------------------------------------------------
+constexpr Vector4 Vector4::operator*(const float& a_scalar) const
+{
+	return Vector4( x * a_scalar, y * a_scalar, z * a_scalar, w * a_scalar);
+}
+
+//\====================================================================================================
+// -- VECTOR 4 FUNCTIONALITY
+//\====================================================================================================
+
+//\----------------------------------------------------------------------------------
+//\ Dot Product - Vector4 (Cosine value of angle between the two vectors
+//\ Will only work if w is not two points
+//\----------------------------------------------------------------------------------
+constexpr float Vector4::Dot(const Vector4& a_v4) const
+{
+	return (x * a_v4.x + y * a_v4.y + z * a_v4.z + w * a_v4.w);
+}
+constexpr float Dot(const Vector4& a_v4A, const Vector4& a_v4B)
+{
+	return a_v4A.Dot(a_v4B);
+}
+//\----------------------------------------------------------------------------------
+//\ LERP - Linear Interpolation
+//\----------------------------------------------------------------------------------
+constexpr Vector4 Lerp(const Vector4 a_v4A, const Vector4& a_v4B, const float a_t)
+{
+	return (a_v4B - a_v4A) * a_t + a_v4A;
+}
+constexpr Vector3 Vector4::xyz() const
+{
+	return Vector3(x, y, z);
+}
 #endif // !VECTOR4_H
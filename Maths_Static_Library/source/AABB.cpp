@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				AABB.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Axis aligned bounding box - a minimum and maximum corner with a ray slab test.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+
+#include "AABB.h"
+//\------------------------
+
+bool AABB::IsEmpty() const
+{
+	return min.x > max.x || min.y > max.y || min.z > max.z;
+}
+
+void AABB::Grow(const Vector3& a_point)
+{
+	min = Vector3(std::min(min.x, a_point.x), std::min(min.y, a_point.y), std::min(min.z, a_point.z));
+	max = Vector3(std::max(max.x, a_point.x), std::max(max.y, a_point.y), std::max(max.z, a_point.z));
+}
+
+void AABB::Grow(const AABB& a_box)
+{
+	min = Vector3(std::min(min.x, a_box.min.x), std::min(min.y, a_box.min.y), std::min(min.z, a_box.min.z));
+	max = Vector3(std::max(max.x, a_box.max.x), std::max(max.y, a_box.max.y), std::max(max.z, a_box.max.z));
+}
+
+Vector3 AABB::Centre() const
+{
+	return (min + max) * 0.5f;
+}
+
+Vector3 AABB::Extent() const
+{
+	return max - min;
+}
+
+float AABB::HalfArea() const
+{
+	if (IsEmpty())
+	{
+		return 0.f;
+	}
+	Vector3 e = Extent();
+	return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+AABB AABB::Transformed(const AffineTransform& a_tx) const
+{
+	AABB box;
+	if (IsEmpty())
+	{
+		return box;
+	}
+	for (int corner = 0; corner < 8; ++corner)
+	{
+		Vector3 p((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z);
+		box.Grow(a_tx.TransformPoint(p));
+	}
+	return box;
+}
+
+bool AABB::IntersectRay(const Vector3& a_origin, const Vector3& a_invDir, float a_maxDistance, float& a_entry) const
+{
+	float t0x = (min.x - a_origin.x) * a_invDir.x;
+	float t1x = (max.x - a_origin.x) * a_invDir.x;
+	float t0y = (min.y - a_origin.y) * a_invDir.y;
+	float t1y = (max.y - a_origin.y) * a_invDir.y;
+	float t0z = (min.z - a_origin.z) * a_invDir.z;
+	float t1z = (max.z - a_origin.z) * a_invDir.z;
+
+	float tEnter = std::max(std::max(std::min(t0x, t1x), std::min(t0y, t1y)), std::max(std::min(t0z, t1z), 0.f));
+	float tExit = std::min(std::min(std::max(t0x, t1x), std::max(t0y, t1y)), std::min(std::max(t0z, t1z), a_maxDistance));
+	a_entry = tEnter;
+	return tEnter <= tExit;
+}
@@ -0,0 +1,286 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				AffineTransform.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Class that implements a 3 by 4 affine transform in Column major Order.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cassert>
+#include <cmath>
+
+#include "AffineTransform.h"
+
+#ifdef MATHLIB_SSE
+#include <emmintrin.h>
+#endif
+//\------------------------
+#pragma region Constructors
+//\----------------------------------------------------------------------------------
+//\ Construct from a Matrix4 - the last row is assumed to be (0, 0, 0, 1)
+//\----------------------------------------------------------------------------------
+AffineTransform::AffineTransform(const Matrix4& a_m4) :
+	AffineTransform(a_m4.GetColumnV3(0), a_m4.GetColumnV3(1), a_m4.GetColumnV3(2), a_m4.GetColumnV3(3))
+{
+}
+Matrix4 AffineTransform::ToMatrix4() const
+{
+	return Matrix4(	m[0][0], m[0][1], m[0][2], 0.f,
+					m[1][0], m[1][1], m[1][2], 0.f,
+					m[2][0], m[2][1], m[2][2], 0.f,
+					m[3][0], m[3][1], m[3][2], 1.f);
+}
+#pragma endregion
+#pragma region Getters_Setters
+//\----------------------------------------------------------------------------------
+//\ Column Access
+//\----------------------------------------------------------------------------------
+void AffineTransform::SetColumn(int a_iCol, const Vector3& a_vCol)
+{
+	assert(a_iCol >= 0 && a_iCol < 4);
+	m[a_iCol][0] = a_vCol.x; m[a_iCol][1] = a_vCol.y; m[a_iCol][2] = a_vCol.z;
+}
+Vector3 AffineTransform::GetColumn(int a_iCol) const
+{
+	assert(a_iCol >= 0 && a_iCol < 4);
+	return Vector3(m[a_iCol][0], m[a_iCol][1], m[a_iCol][2]);
+}
+#pragma endregion
+#pragma region Transforms
+//\====================================================================================================
+// -- TRANSFORMS
+//\		p' = x * Xaxis + y * Yaxis + z * Zaxis (+ Translation for points)
+//\		With SSE each column is one register so this is three multiplies and three adds
+//\====================================================================================================
+Vector3 AffineTransform::TransformPoint(const Vector3& a_v3) const
+{
+#ifdef MATHLIB_SSE
+	__m128 result = _mm_add_ps(_mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(_mm_load_ps(m[0]), _mm_set1_ps(a_v3.x)), _mm_mul_ps(_mm_load_ps(m[1]), _mm_set1_ps(a_v3.y))),
+		_mm_mul_ps(_mm_load_ps(m[2]), _mm_set1_ps(a_v3.z))), _mm_load_ps(m[3]));
+	alignas(16) float out[4];
+	_mm_store_ps(out, result);
+	return Vector3(out[0], out[1], out[2]);
+#else
+	return Vector3(	m[0][0] * a_v3.x + m[1][0] * a_v3.y + m[2][0] * a_v3.z + m[3][0],
+					m[0][1] * a_v3.x + m[1][1] * a_v3.y + m[2][1] * a_v3.z + m[3][1],
+					m[0][2] * a_v3.x + m[1][2] * a_v3.y + m[2][2] * a_v3.z + m[3][2]);
+#endif
+}
+Vector3 AffineTransform::TransformVector(const Vector3& a_v3) const
+{
+#ifdef MATHLIB_SSE
+	__m128 result = _mm_add_ps(
+		_mm_add_ps(_mm_mul_ps(_mm_load_ps(m[0]), _mm_set1_ps(a_v3.x)), _mm_mul_ps(_mm_load_ps(m[1]), _mm_set1_ps(a_v3.y))),
+		_mm_mul_ps(_mm_load_ps(m[2]), _mm_set1_ps(a_v3.z)));
+	alignas(16) float out[4];
+	_mm_store_ps(out, result);
+	return Vector3(out[0], out[1], out[2]);
+#else
+	return Vector3(	m[0][0] * a_v3.x + m[1][0] * a_v3.y + m[2][0] * a_v3.z,
+					m[0][1] * a_v3.x + m[1][1] * a_v3.y + m[2][1] * a_v3.z,
+					m[0][2] * a_v3.x + m[1][2] * a_v3.y + m[2][2] * a_v3.z);
+#endif
+}
+//\----------------------------------------------------------------------------------
+//\ Multiply by the transpose of the 3x3 part - each component is an axis dotted with the normal
+//\----------------------------------------------------------------------------------
+Vector3 AffineTransform::TransformNormal(const Vector3& a_v3) const
+{
+#ifdef MATHLIB_SSE
+	__m128 c0 = _mm_load_ps(m[0]);
+	__m128 c1 = _mm_load_ps(m[1]);
+	__m128 c2 = _mm_load_ps(m[2]);
+	__m128 c3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);					// Columns are now the rows of the 3x3
+	__m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(a_v3.x)), _mm_mul_ps(c1, _mm_set1_ps(a_v3.y))),
+		_mm_mul_ps(c2, _mm_set1_ps(a_v3.z)));
+	alignas(16) float out[4];
+	_mm_store_ps(out, result);
+	return Vector3(out[0], out[1], out[2]);
+#else
+	return Vector3(	m[0][0] * a_v3.x + m[0][1] * a_v3.y + m[0][2] * a_v3.z,
+					m[1][0] * a_v3.x + m[1][1] * a_v3.y + m[1][2] * a_v3.z,
+					m[2][0] * a_v3.x + m[2][1] * a_v3.y + m[2][2] * a_v3.z);
+#endif
+}
+#pragma endregion
+#pragma region Operator_Overloads
+//\----------------------------------------------------------------------------------
+//\ Composition - the axes of B are taken through A, the translation of B is a point
+//\----------------------------------------------------------------------------------
+AffineTransform AffineTransform::operator*(const AffineTransform& a_tx) const
+{
+	return AffineTransform(	TransformVector(a_tx.GetColumn(0)),
+							TransformVector(a_tx.GetColumn(1)),
+							TransformVector(a_tx.GetColumn(2)),
+							TransformPoint(a_tx.GetColumn(3)));
+}
+const AffineTransform& AffineTransform::operator*=(const AffineTransform& a_tx)
+{
+	*this = (*this) * a_tx;
+	return *this;
+}
+bool AffineTransform::operator==(const AffineTransform& a_tx) const
+{
+	for (int col = 0; col < 4; ++col)
+	{
+		if (m[col][0] != a_tx.m[col][0] || m[col][1] != a_tx.m[col][1] || m[col][2] != a_tx.m[col][2]) { return false; }
+	}
+	return true;
+}
+bool AffineTransform::operator!=(const AffineTransform& a_tx) const
+{
+	return !(*this == a_tx);
+}
+std::ostream& operator<<(std::ostream& os, const AffineTransform& a_tx)
+{
+	os.setf(std::ios::fixed, std::ios::floatfield); // Set fixed precision of decimal places
+	os.precision(3);
+
+	for (int row = 0; row < 3; ++row)
+	{
+		os << a_tx.m[0][row] << "\t" << a_tx.m[1][row] << "\t" << a_tx.m[2][row] << "\t" << a_tx.m[3][row] << std::endl;
+	}
+	return os;
+}
+#pragma endregion
+#pragma region Algebraic_Functionality
+//\----------------------------------------------------------------------------------
+//\ General Functions
+//\----------------------------------------------------------------------------------
+void AffineTransform::Identity()
+{
+	m[0][0] = 1.f;	m[0][1] = 0.f;	m[0][2] = 0.f;	m[0][3] = 0.f;
+	m[1][0] = 0.f;	m[1][1] = 1.f;	m[1][2] = 0.f;	m[1][3] = 0.f;
+	m[2][0] = 0.f;	m[2][1] = 0.f;	m[2][2] = 1.f;	m[2][3] = 0.f;
+	m[3][0] = 0.f;	m[3][1] = 0.f;	m[3][2] = 0.f;	m[3][3] = 0.f;
+}
+void AffineTransform::Scale(const Vector3& a_v3)
+{
+	Identity();
+	m[0][0] = a_v3.x; m[1][1] = a_v3.y; m[2][2] = a_v3.z;
+}
+void AffineTransform::Translate(const Vector3& a_v3)
+{
+	Identity();
+	SetColumn(3, a_v3);
+}
+//\----------------------------------------------------------------------------------
+//\ Determinant of the 3x3 part - the translation does not change the volume
+//\----------------------------------------------------------------------------------
+float AffineTransform::Determinant() const
+{
+	return Dot(GetColumn(0), Cross(GetColumn(1), GetColumn(2)));
+}
+//\----------------------------------------------------------------------------------
+//\ Are the three axes perpendicular to each other (rotation and scale, no shear)
+//\		|a.b| <= tol * |a||b| is compared squared so no square roots are needed
+//\----------------------------------------------------------------------------------
+bool AffineTransform::IsOrthogonal() const
+{
+	const float tolerance2 = 1e-8f;
+	float xx = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+	float yy = m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2];
+	float zz = m[2][0] * m[2][0] + m[2][1] * m[2][1] + m[2][2] * m[2][2];
+	float xy = m[0][0] * m[1][0] + m[0][1] * m[1][1] + m[0][2] * m[1][2];
+	float yz = m[1][0] * m[2][0] + m[1][1] * m[2][1] + m[1][2] * m[2][2];
+	float zx = m[2][0] * m[0][0] + m[2][1] * m[0][1] + m[2][2] * m[0][2];
+	return	xy * xy <= tolerance2 * xx * yy &&
+			yz * yz <= tolerance2 * yy * zz &&
+			zx * zx <= tolerance2 * zz * xx;
+}
+//\----------------------------------------------------------------------------------
+//\ Inverse - the rows of the inverse 3x3 are built first, the new translation is
+//\ the old translation taken through those rows and negated
+//\----------------------------------------------------------------------------------
+AffineTransform AffineTransform::Inverse() const
+{
+#ifdef MATHLIB_SSE
+	// Rows of the 3x3 - the fourth column is the zero padding so lane 3 stays 0 throughout
+	__m128 r0 = _mm_load_ps(m[0]);
+	__m128 r1 = _mm_load_ps(m[1]);
+	__m128 r2 = _mm_load_ps(m[2]);
+	__m128 r3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	// (xx, yy, zz) squared axis lengths and (xy, yz, zx) axis dot products
+	__m128 lengths = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2));
+	__m128 dots = _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(r0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 0, 2, 1))),
+		_mm_mul_ps(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 0, 2, 1)))),
+		_mm_mul_ps(r2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 0, 2, 1))));
+	// Same test as IsOrthogonal - dot squared against tolerance squared times both lengths squared
+	__m128 limit = _mm_mul_ps(_mm_mul_ps(lengths, _mm_shuffle_ps(lengths, lengths, _MM_SHUFFLE(3, 0, 2, 1))), _mm_set1_ps(1e-8f));
+	int orthogonal = _mm_movemask_ps(_mm_cmple_ps(_mm_mul_ps(dots, dots), limit));
+	int positive = _mm_movemask_ps(_mm_cmpgt_ps(lengths, _mm_setzero_ps()));
+	if ((orthogonal & positive & 0x7) == 0x7)
+	{
+		// Orthonormal plus scale - the transposed axes divided by their squared lengths
+		__m128 invScale = _mm_div_ps(_mm_set1_ps(1.f), _mm_add_ps(lengths, _mm_set_ps(1.f, 0.f, 0.f, 0.f)));
+		invScale = _mm_and_ps(invScale, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+		AffineTransform inv;
+		__m128 c0 = _mm_mul_ps(r0, invScale);
+		__m128 c1 = _mm_mul_ps(r1, invScale);
+		__m128 c2 = _mm_mul_ps(r2, invScale);
+		__m128 t = _mm_load_ps(m[3]);
+		__m128 c3 = _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))),
+			_mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))),
+			_mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)))));
+		_mm_store_ps(inv.m[0], c0);
+		_mm_store_ps(inv.m[1], c1);
+		_mm_store_ps(inv.m[2], c2);
+		_mm_store_ps(inv.m[3], c3);
+		return inv;
+	}
+#endif
+	float r[3][3];	// Rows of the inverse 3x3
+	float xx = m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2];
+	float yy = m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2];
+	float zz = m[2][0] * m[2][0] + m[2][1] * m[2][1] + m[2][2] * m[2][2];
+	if (xx > 0.f && yy > 0.f && zz > 0.f && IsOrthogonal())
+	{
+		// Orthonormal plus scale - transpose and divide each axis by its squared length
+		float invScale[3] = { 1.f / xx, 1.f / yy, 1.f / zz };
+		for (int i = 0; i < 3; ++i)
+		{
+			r[i][0] = m[i][0] * invScale[i]; r[i][1] = m[i][1] * invScale[i]; r[i][2] = m[i][2] * invScale[i];
+		}
+	}
+	else
+	{
+		// General 3x3 inverse - rows are the cross products of the other two axes over the determinant
+		for (int i = 0; i < 3; ++i)
+		{
+			const float* a = m[(i + 1) % 3];
+			const float* b = m[(i + 2) % 3];
+			r[i][0] = a[1] * b[2] - a[2] * b[1];
+			r[i][1] = a[2] * b[0] - a[0] * b[2];
+			r[i][2] = a[0] * b[1] - a[1] * b[0];
+		}
+		float fDet = m[0][0] * r[0][0] + m[0][1] * r[0][1] + m[0][2] * r[0][2];
+		if (fDet == 0.f)
+		{
+			return AffineTransform::IDENTITY;
+		}
+		float fInvDet = 1.f / fDet;
+		for (int i = 0; i < 3; ++i)
+		{
+			r[i][0] *= fInvDet; r[i][1] *= fInvDet; r[i][2] *= fInvDet;
+		}
+	}
+	AffineTransform inv;
+	for (int col = 0; col < 3; ++col)
+	{
+		inv.m[col][0] = r[0][col]; inv.m[col][1] = r[1][col]; inv.m[col][2] = r[2][col];
+	}
+	inv.m[3][0] = -(r[0][0] * m[3][0] + r[0][1] * m[3][1] + r[0][2] * m[3][2]);
+	inv.m[3][1] = -(r[1][0] * m[3][0] + r[1][1] * m[3][1] + r[1][2] * m[3][2]);
+	inv.m[3][2] = -(r[2][0] * m[3][0] + r[2][1] * m[3][1] + r[2][2] * m[3][2]);
+	return inv;
+}
+#pragma endregion
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				FastMath.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Approximations of pow, exp2, log2 and the inverse square root for shading, with the most
+//						error each one makes written next to it. They have no table lookups and every condition is
+//						a select rather than a branch. Whether the renderer uses them is set at run time by the precision.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "FastMath.h"
+
+#include <cmath>
+//\------------------------
+
+bool FastMath::ParsePrecision(const std::string& a_name, Precision& a_precision)
+{
+	if (a_name == "precise")
+	{
+		a_precision = PRECISE;
+		return true;
+	}
+	if (a_name == "fast")
+	{
+		a_precision = FAST;
+		return true;
+	}
+	return false;
+}
+
+const char* FastMath::PrecisionName(Precision a_precision)
+{
+	return a_precision == FAST ? "fast" : "precise";
+}
+
+#ifdef MATHLIB_SSE
+// Out of line as it is the slow path - the fast one is the polynomial in the header
+__m128 FastMath::PrecisePow(__m128 a_base, __m128 a_exponent)
+{
+	alignas(16) float base[4];
+	alignas(16) float exponent[4];
+	_mm_store_ps(base, a_base);
+	_mm_store_ps(exponent, a_exponent);
+	for (int i = 0; i < 4; ++i)
+	{
+		base[i] = powf(base[i], exponent[i]);
+	}
+	return _mm_load_ps(base);
+}
+#endif
@@ -15,62 +15,6 @@
 #include "Matrix4.h"
 #include <math.h>
 //\------------------------
-#pragma region Constructors
-//\----------------------------------------------------------------------------------
-//\ Identity Matrix4 
-//\----------------------------------------------------------------------------------
-const Matrix4 Matrix4::IDENTITY = Matrix4(1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f);
-//\----------------------------------------------------------------------------------
-//\ Constructors 
-//\----------------------------------------------------------------------------------
-Matrix4::Matrix4() : m_11(1.f), m_12(0.f), m_13(0.f), m_14(0.f),
-					 m_21(0.f), m_22(1.f), m_23(0.f), m_24(0.f),
-					 m_31(0.f), m_32(0.f), m_33(1.f), m_34(0.f),
-					 m_41(0.f), m_42(0.f), m_43(0.f), m_44(1.f)
-{
-}
-//\----------------------------------------------------------------------------------
-//\ Constructor using pointer to float data 
-//\----------------------------------------------------------------------------------
-Matrix4::Matrix4(const float* a_mat) :
-
-					m_11(a_mat[0]), m_21(a_mat[1]), m_31(a_mat[2]), m_41(a_mat[3]),
-					m_12(a_mat[4]), m_22(a_mat[5]), m_32(a_mat[6]), m_42(a_mat[7]),
-					m_13(a_mat[8]), m_23(a_mat[9]), m_33(a_mat[10]), m_43(a_mat[11]),
-					m_14(a_mat[12]), m_24(a_mat[13]), m_34(a_mat[14]), m_44(a_mat[15])
-{
-}
-//\----------------------------------------------------------------------------------
-//\ Constructor using all components of matrix data structure 
-//\----------------------------------------------------------------------------------
-Matrix4::Matrix4	(float m11, float m21, float m31, float m41,
-					float m12, float m22, float m32, float m42,
-					float m13, float m23, float m33, float m43,
-					float m14, float m24, float m34, float m44):
-					m_11(m11), m_21(m21), m_31(m31), m_41(m41),
-					m_12(m12), m_22(m22), m_32(m32), m_42(m42),
-					m_13(m13), m_23(m23), m_33(m33), m_43(m43),
-					m_14(m14), m_24(m24), m_34(m34), m_44(m44)
-{
-}
-//\----------------------------------------------------------------------------------
-//\ Copy Constructor
-//\----------------------------------------------------------------------------------
-Matrix4::Matrix4(const Matrix4& a_m4) :
-					m_11(a_m4.m_11), m_21(a_m4.m_21), m_31(a_m4.m_31), m_41(a_m4.m_41),
-                    m_12(a_m4.m_12), m_22(a_m4.m_22), m_32(a_m4.m_32), m_42(a_m4.m_42),
-                    m_13(a_m4.m_13), m_23(a_m4.m_23), m_33(a_m4.m_33), m_43(a_m4.m_43),
-                    m_14(a_m4.m_14), m_24(a_m4.m_24), m_34(a_m4.m_34), m_44(a_m4.m_44)
-{
-}
-
-//\----------------------------------------------------------------------------------
-//\ Destructor 
-//\----------------------------------------------------------------------------------
-Matrix4::~Matrix4()
-{
-}
-#pragma endregion
 #pragma region Operator_Overloads
 //\====================================================================================================
 // -- OPERATOR OVERLOADS 
@@ -118,106 +62,6 @@ Vector4 Matrix4::GetColumnV4(int a_iCol) const
 	return Vector4(m[a_iCol][0], m[a_iCol][1], m[a_iCol][2], m[a_iCol][3]);
 }
 
-//\----------------------------------------------------------------------------------
-//\ EQUIVALENCE - Operator Overload - Matrix Testing for equality 
-//\----------------------------------------------------------------------------------
-bool Matrix4::operator==(const Matrix4& a_m4) const
-{
-	if (m_11 != a_m4.m_11) { return false; }
-	if (m_21 != a_m4.m_21) { return false; }
-	if (m_31 != a_m4.m_31) { return false; }
-	if (m_41 != a_m4.m_41) { return false; }
-	
-	if (m_12 != a_m4.m_12) { return false; }
-	if (m_22 != a_m4.m_22) { return false; }
-	if (m_32 != a_m4.m_32) { return false; }
-	if (m_42 != a_m4.m_42) { return false; }
-	
-	if (m_13 != a_m4.m_13) { return false; }
-	if (m_23 != a_m4.m_23) { return false; }
-	if (m_33 != a_m4.m_33) { return false; }
-	if (m_43 != a_m4.m_43) { return false; }
-	
-	if (m_14 != a_m4.m_14) { return false; }
-	if (m_24 != a_m4.m_24) { return false; }
-	if (m_34 != a_m4.m_34) { return false; }
-	if (m_44 != a_m4.m_44) { return false; }
-	return true;
-}
-bool Matrix4::operator!=(const Matrix4& a_m4) const
-{
-	if (m_11 != a_m4.m_11) { return true; }
-	if (m_21 != a_m4.m_21) { return true; }
-	if (m_31 != a_m4.m_31) { return true; }
-	if (m_41 != a_m4.m_41) { return true; }
-	if (m_12 != a_m4.m_12) { return true; }
-	if (m_22 != a_m4.m_22) { return true; }
-	if (m_32 != a_m4.m_32) { return true; }
-	if (m_42 != a_m4.m_42) { return true; }
-	if (m_13 != a_m4.m_13) { return true; }
-	if (m_23 != a_m4.m_23) { return true; }
-	if (m_33 != a_m4.m_33) { return true; }
-	if (m_43 != a_m4.m_43) { return true; }
-	if (m_14 != a_m4.m_14) { return true; }
-	if (m_24 != a_m4.m_24) { return true; }
-	if (m_34 != a_m4.m_34) { return true; }
-	if (m_44 != a_m4.m_44) { return true; }
-	return false;
-}
-//\----------------------------------------------------------------------------------
-//\ ADDITION - Operator Overload
-//\----------------------------------------------------------------------------------
-Matrix4 Matrix4::operator+(const Matrix4& a_m4) const
-{
-	return Matrix4(	m_11 + a_m4.m_11, m_21 + a_m4.m_21, m_31 + a_m4.m_31, m_41 + a_m4.m_41,
-                    m_12 + a_m4.m_12, m_22 + a_m4.m_22, m_32 + a_m4.m_32, m_42 + a_m4.m_42,
-                    m_13 + a_m4.m_13, m_23 + a_m4.m_23, m_33 + a_m4.m_33, m_43 + a_m4.m_43,
-                    m_14 + a_m4.m_14, m_24 + a_m4.m_24, m_34 + a_m4.m_34, m_44 + a_m4.m_44);
-}
-const Matrix4& Matrix4::operator+=(const Matrix4& a_m4)
-{
-					m_11 += a_m4.m_11; m_12 += a_m4.m_12; m_13 += a_m4.m_13; m_14 += a_m4.m_14;
-					m_21 += a_m4.m_21; m_22 += a_m4.m_22; m_23 += a_m4.m_23; m_24 += a_m4.m_24;
-					m_31 += a_m4.m_31; m_32 += a_m4.m_32; m_33 += a_m4.m_33; m_34 += a_m4.m_34;
-					m_41 += a_m4.m_41; m_42 += a_m4.m_42; m_43 += a_m4.m_43; m_44 += a_m4.m_44;
-					return *this;
-}
-//\----------------------------------------------------------------------------------
-//\ SUBTRACTION - Operator Overload 
-//\----------------------------------------------------------------------------------
-Matrix4 Matrix4::operator-(const Matrix4& a_m4) const
-{
-	return Matrix4(	m_11 - a_m4.m_11, m_21 - a_m4.m_21, m_31 - a_m4.m_31, m_41 - a_m4.m_41,
-                    m_12 - a_m4.m_12, m_22 - a_m4.m_22, m_32 - a_m4.m_32, m_42 - a_m4.m_42,
-                    m_13 - a_m4.m_13, m_23 - a_m4.m_23, m_33 - a_m4.m_33, m_43 - a_m4.m_43,
-                    m_14 - a_m4.m_14, m_24 - a_m4.m_24, m_34 - a_m4.m_34, m_44 - a_m4.m_44);
-}
-const Matrix4& Matrix4::operator-=(const Matrix4& a_m4)
-{
-					m_11 -= a_m4.m_11; m_12 -= a_m4.m_12; m_13 -= a_m4.m_13; m_14 -= a_m4.m_14;
-					m_21 -= a_m4.m_21; m_22 -= a_m4.m_22; m_23 -= a_m4.m_23; m_24 -= a_m4.m_24;
-					m_31 -= a_m4.m_31; m_32 -= a_m4.m_32; m_33 -= a_m4.m_33; m_34 -= a_m4.m_34;
-					m_41 -= a_m4.m_41; m_42 -= a_m4.m_42; m_43 -= a_m4.m_43; m_44 -= a_m4.m_44;
-					return *this;
-}
-//\----------------------------------------------------------------------------------
-//\ MULTIPLICATION - Operator Overload
-//\----------------------------------------------------------------------------------
-Matrix4 Matrix4::operator*(const float a_scalar) const
-{
-	return Matrix4(	m_11 * a_scalar, m_21 * a_scalar, m_31 * a_scalar, m_41 * a_scalar,
-					m_12 * a_scalar, m_22 * a_scalar, m_32 * a_scalar, m_42 * a_scalar,
-					m_13 * a_scalar, m_23 * a_scalar, m_33 * a_scalar, m_43 * a_scalar,
-					m_14 * a_scalar, m_24 * a_scalar, m_34 * a_scalar, m_44 * a_scalar);
-}
-const Matrix4& Matrix4::operator*=(const float a_scalar)
-{
-					m_11 *= a_scalar, m_21 *= a_scalar, m_31 *= a_scalar, m_41 *= a_scalar,
-					m_12 *= a_scalar, m_22 *= a_scalar, m_32 *= a_scalar, m_42 *= a_scalar,
-					m_13 *= a_scalar, m_23 *= a_scalar, m_33 *= a_scalar, m_43 *= a_scalar,
-					m_14 *= a_scalar, m_24 *= a_scalar, m_34 *= a_scalar, m_44 *= a_scalar;
-					return *this;
-}
 //\----------------------------------------------------------------------------------
 //\ INSERTION - Operator Overload
 //\----------------------------------------------------------------------------------
@@ -233,109 +77,12 @@ std::ostream& operator<<(std::ostream& os, const Matrix4& a_m4)
 
 	return os;
 }
-//\----------------------------------------------------------------------------------
-//\ Matrix multiplication you simply calculate the dot product 
-//\		of each row of the LHS matrix by each column of the RHS matrix.
-//\----------------------------------------------------------------------------------
-//\ Operator Overloads for Multiplication by Vector4 Value
-//\----------------------------------------------------------------------------------
-Vector4 Matrix4::operator*(const Vector4& a_v4) const
-{
-	return Vector4(
-		m_11 * a_v4.x + m_12 * a_v4.y + m_13 * a_v4.z + m_14 * a_v4.w,
-		m_21 * a_v4.x + m_22 * a_v4.y + m_23 * a_v4.z + m_24 * a_v4.w,
-		m_31 * a_v4.x + m_32 * a_v4.y + m_33 * a_v4.z + m_34 * a_v4.w,
-		m_41 * a_v4.x + m_42 * a_v4.y + m_43 * a_v4.z + m_44 * a_v4.w);
-}
-Matrix4 Matrix4::operator*(const Matrix4& a_m4) const
-{
-	return Matrix4(	m_11 * a_m4.m_11 + m_12 * a_m4.m_21 + m_13 * a_m4.m_31 + m_14 * a_m4.m_41, // Row 1 * Col 1
-					m_21 * a_m4.m_11 + m_22 * a_m4.m_21 + m_23 * a_m4.m_31 + m_24 * a_m4.m_41, // Row 2 * Col 1
-					m_31 * a_m4.m_11 + m_32 * a_m4.m_21 + m_33 * a_m4.m_31 + m_34 * a_m4.m_41, // Row 3 * Col 1
-					m_41 * a_m4.m_11 + m_42 * a_m4.m_21 + m_43 * a_m4.m_31 + m_44 * a_m4.m_41, // Row 4 * Col 1													 
-					
-					m_11 * a_m4.m_12 + m_12 * a_m4.m_22 + m_13 * a_m4.m_32 + m_14 * a_m4.m_42, // Row 1 * Col 2
-					m_21 * a_m4.m_12 + m_22 * a_m4.m_22 + m_23 * a_m4.m_32 + m_24 * a_m4.m_42, // Row 2 * Col 2
-					m_31 * a_m4.m_12 + m_32 * a_m4.m_22 + m_33 * a_m4.m_32 + m_34 * a_m4.m_42, // Row 3 * Col 2
-					m_41 * a_m4.m_12 + m_42 * a_m4.m_22 + m_43 * a_m4.m_32 + m_44 * a_m4.m_42, // Row 4 * Col 2
-										
-					m_11 * a_m4.m_13 + m_12 * a_m4.m_23 + m_13 * a_m4.m_33 + m_14 * a_m4.m_43, // Row 1 * Col 3
-					m_21 * a_m4.m_13 + m_22 * a_m4.m_23 + m_23 * a_m4.m_33 + m_24 * a_m4.m_43, // Row 2 * col 3
-					m_31 * a_m4.m_13 + m_32 * a_m4.m_23 + m_33 * a_m4.m_33 + m_34 * a_m4.m_43, // Row 3 * col 3
-					m_41 * a_m4.m_13 + m_42 * a_m4.m_23 + m_43 * a_m4.m_33 + m_44 * a_m4.m_43, // Row 4 * col 3
-
-					m_11 * a_m4.m_14 + m_12 * a_m4.m_24 + m_13 * a_m4.m_34 + m_14 * a_m4.m_44, // Row 1 * Col 4
-					m_21 * a_m4.m_14 + m_22 * a_m4.m_24 + m_23 * a_m4.m_34 + m_24 * a_m4.m_44, // Row 2 * Col 4
-					m_31 * a_m4.m_14 + m_32 * a_m4.m_24 + m_33 * a_m4.m_34 + m_34 * a_m4.m_44, // Row 3 * Col 4
-					m_41 * a_m4.m_14 + m_42 * a_m4.m_24 + m_43 * a_m4.m_34 + m_44 * a_m4.m_44); // Row 4 * Col 4
-}
-const Matrix4& Matrix4::operator*=(const Matrix4& a_m4)
-{
-	*this = (*this) * a_m4;
-	return *this;
-}
 #pragma endregion
 #pragma region Algebraic_Functionality
 //\====================================================================================================
 // -- Algebraic Matrix 4 Functionality
 //\====================================================================================================
 
-//\----------------------------------------------------------------------------------
-//\ Transpose Matrix - Transform from Row To Column 
-//\----------------------------------------------------------------------------------
-void Matrix4::Transpose()
-{
-	float k;
-	k = m_12; m_12 = m_21; m_21 = k;
-	k = m_13; m_13 = m_31; m_31 = k;
-	k = m_23; m_23 = m_32; m_32 = k;
-	k = m_14; m_14 = m_41; m_41 = k;
-	k = m_24; m_24 = m_42; m_42 = k;
-	k = m_34; m_34 = m_43; m_43 = k;
-}
-Matrix4 Matrix4::GetTranspose() const
-{
-	return Matrix4( m_11, m_12, m_13, m_14,
-                    m_21, m_22, m_23, m_24,
-                    m_31, m_32, m_33, m_34,
-                    m_41, m_42, m_43, m_44);
-}
-//\----------------------------------------------------------------------------------
-//\ Scale Functionality 
-//\----------------------------------------------------------------------------------
-void Matrix4::Scale(const Vector4& a_v4)
-{
-	m_11 = a_v4.x;		m_12 = 0.0f;	m_13 = 0.0f;	m_14 = 0.0f;
-	m_21 = 0.0f;		m_22 = a_v4.y;	m_23 = 0.0f;	m_24 = 0.0f;
-	m_31 = 0.0f;		m_32 = 0.0f;	m_33 = a_v4.z;	m_34 = 0.0f;
-	m_41 = 0.0f;		m_42 = 0.0f;	m_43 = 0.0f;	m_44 = 1.f;
-}
-void Matrix4::Scale(const float a_fScalar)
-{
-	Scale(Vector4(a_fScalar, a_fScalar, a_fScalar, a_fScalar));
-}
-//void Matrix4::Shear(float xy, float xz, float yx, float yz, float zx, float zy)
-//{
-//	m_11 = 1.f;		m_12 = xy;		m_13 = xz;		m_14 = 0.f;
-//	m_21 = yx;		m_22 = 1.f;		m_23 = yz;		m_24 = 0.f;
-//	m_31 = zx;		m_32 = zy;		m_13 = 1.f;		m_34 = 0.f;
-//	m_41 = 0.f;		m_42 = 0.f;		m_43 = 0.f;		m_44 = 1.f;
-//}
-//Matrix4 Matrix4::GetShear() const
-//{
-//	return Matr
-//}
-//\----------------------------------------------------------------------------------
-//\ General Matrix Functions 
-//\----------------------------------------------------------------------------------
-void Matrix4::Identity()
-{
-	m_11 = 1.0f;	m_12 = 0.0f;	m_13 = 0.0f;	m_14 = 0.0f;
-	m_21 = 0.0f;	m_22 = 1.0f;	m_23 = 0.0f;	m_24 = 0.0f;
-	m_31 = 0.0f;	m_32 = 0.0f;	m_33 = 1.0f;	m_34 = 0.0f;
-	m_41 = 0.0f;	m_42 = 0.0f;	m_43 = 0.0f;	m_44 = 1.0f;
-}
-
 //\====================================================================================================
 //\ ROTATION
 //\====================================================================================================
@@ -399,109 +146,6 @@ void RotateZ(Matrix4& a_m4, float a_angle)
 // -- RAY TRACING SPECIFIC - Matrix 4 Functionality
 //\====================================================================================================
 
-float Matrix4::Determinant() const
-{
-	float fA = m_11 * (	m_22 * (m_33 * m_44 - m_34 * m_43) +
-						m_23 * (m_34 * m_42 - m_32 * m_44) +
-						m_24 * (m_32 * m_43 - m_33 * m_42)	);
-	
-	float fB = m_12 * (	m_21 * (m_33 * m_44 - m_34 * m_43) +
-						m_23 * (m_34 * m_41 - m_31 * m_44) +
-						m_24 * (m_31 * m_43 - m_33 * m_41)	);
-
-	float fC = m_13 * (	m_21 * (m_32 * m_44 - m_34 * m_42) +
-                        m_22 * (m_34 * m_41 - m_31 * m_44) +
-                        m_24 * (m_31 * m_42 - m_32 * m_41)	);
-
-	float fD = m_14 * (	m_21 * (m_32 * m_43 - m_33 * m_42) +
-                        m_22 * (m_33 * m_41 - m_31 * m_43) +
-                        m_23 * (m_31 * m_42 - m_32 * m_41)	);
-	
-	return fA - fB + fC - fD;
-}
-Matrix4 Matrix4::Inverse() const // Calculating the inverse of a 4x4 matrix to create an Identity Matrix 
-{
-	const float fDet = Determinant();
-	if (fDet != 0.0f)
-	{
-		const float fInvDet = 1.f/fDet;
-
-		Matrix4 mat;
-		mat.m_11 = (m_22 * (m_33 * m_44 - m_34 * m_43) +
-					m_23 * (m_34 * m_42 - m_32 * m_44) +
-					m_24 * (m_32 * m_43 - m_33 * m_42)) * fInvDet;
-		
-		mat.m_21 = (m_21 * (m_33 * m_44 - m_34 * m_43) +
-                    m_23 * (m_34 * m_41 - m_31 * m_44) +
-                    m_24 * (m_31 * m_43 - m_33 * m_42)) * -fInvDet;
-
-		mat.m_31 = (m_21 * (m_32 * m_44 - m_34 * m_42) +
-                    m_22 * (m_34 * m_41 - m_31 * m_44) +
-                    m_24 * (m_31 * m_42 - m_32 * m_41)) * fInvDet;
-
-		mat.m_41 = (m_21 * (m_32 * m_43 - m_33 * m_42) +
-                    m_22 * (m_33 * m_41 - m_31 * m_43) +
-                    m_23 * (m_31 * m_42 - m_32 * m_41)) * -fInvDet;
-
-		
-		mat.m_12 = (m_12 * (m_33 * m_44 - m_34 * m_43) +
-                    m_13 * (m_34 * m_42 - m_32 * m_44) +
-                    m_14 * (m_32 * m_43 - m_33 * m_42)) * -fInvDet;
-
-		mat.m_22 = (m_11 * (m_33 * m_44 - m_34 * m_43) +
-                    m_13 * (m_34 * m_41 - m_31 * m_44) +
-                    m_14 * (m_31 * m_43 - m_33 * m_41)) * fInvDet;
-
-		mat.m_32 = (m_11 * (m_32 * m_44 - m_34 * m_42) +
-                    m_12 * (m_34 * m_41 - m_31 * m_44) +
-                    m_14 * (m_31 * m_42 - m_32 * m_41)) * -fInvDet;
-
-		mat.m_42 = (m_11 * (m_32 * m_43 - m_33 * m_42) +
-                    m_12 * (m_33 * m_41 - m_32 * m_43) +
-                    m_13 * (m_31 * m_42 - m_32 * m_41)) * fInvDet;
-
-		
-		mat.m_13 = (m_12 * (m_23 * m_44 - m_24 * m_43) +
-                    m_13 * (m_24 * m_42 - m_22 * m_44) +
-                    m_14 * (m_22 * m_43 - m_23 * m_42)) * fInvDet;
-
-		mat.m_23 = (m_11 * (m_23 * m_44 - m_24 * m_43) +
-                    m_13 * (m_24 * m_41 - m_21 * m_44) +
-                    m_14 * (m_21 * m_43 - m_23 * m_41)) * -fInvDet;
-
-		mat.m_33 = (m_11 * (m_22 * m_44 - m_24 * m_42) +
-                    m_12 * (m_24 * m_41 - m_21 * m_44) +
-                    m_14 * (m_21 * m_42 - m_22 * m_41)) * fInvDet;
-
-		mat.m_43 = (m_11 * (m_22 * m_43 - m_23 * m_42) +
-                    m_12 * (m_23 * m_41 - m_21 * m_43) +
-                    m_13 * (m_21 * m_42 - m_22 * m_41)) * -fInvDet;
-
-		
-		mat.m_14 = (m_12 * (m_23 * m_34 - m_24 * m_33) +
-                    m_13 * (m_24 * m_32 - m_22 * m_34) +
-                    m_14 * (m_22 * m_33 - m_23 * m_32)) * -fInvDet;
-
-		mat.m_24 = (m_11 * (m_23 * m_34 - m_24 * m_33) +
-                    m_13 * (m_24 * m_31 - m_21 * m_34) +
-                    m_14 * (m_21 * m_33 - m_23 * m_31)) * fInvDet;
-
-		mat.m_34 = (m_11 * (m_22 * m_34 - m_24 * m_32) +
-                    m_12 * (m_24 * m_31 - m_21 * m_34) +
-                    m_14 * (m_21 * m_32 - m_22 * m_31)) * -fInvDet;
-
-		mat.m_44 = (m_11 * (m_22 * m_33 - m_23 * m_32) +
-                    m_12 * (m_23 * m_31 - m_21 * m_33) +
-                    m_13 * (m_21 * m_32 - m_22 * m_31)) * fInvDet;
-
-		return mat;
-	}
-	else
-	{
-		return Matrix4::IDENTITY;
-	}
-	
-}
 #pragma endregion
 #pragma region Camera_Projection_Functions
 //\====================================================================================================
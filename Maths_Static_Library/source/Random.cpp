@@ -15,11 +15,12 @@
 #include <algorithm>
 //\------------------------
 
-static int rand_seed = 0xB16B00B5;			// Default value for the seed
-// Values set to glibc (used by GCC)
-static const int rand_mod = 0x80000000;		// Set rand mod value 2^31
-static const int rand_a = 1103515245;		// Set LCG A value
-static const int rand_c = 12345;			// Set LCG C Value
+// Each thread has its own sequence, so threads rendering different pixels never share a seed
+static thread_local int rand_seed = 0xB16B00B5;	// Default value for the seed
+// Values set to glibc (used by GCC) - unsigned so the multiply wraps the same way on every compiler
+static const unsigned int rand_mod = 0x80000000u;	// Set rand mod value 2^31
+static const unsigned int rand_a = 1103515245u;		// Set LCG A value
+static const unsigned int rand_c = 12345u;			// Set LCG C Value
 static const int rand_L = 0x3FFFFFFF;		// Set LCG L (or Bitmask ) value
 
 
@@ -31,13 +32,27 @@ void Random::SetSeed(const int& a_seed)
 {
 	rand_seed = a_seed;
 }
+// Coordinates are mixed into the seed and scrambled with the MurmurHash3 finaliser so neighbouring pixels
+// start their sequences far apart
+int Random::HashSeed(const int& a_seed, const int& a_x, const int& a_y)
+{
+	unsigned int hash = static_cast<unsigned int>(a_seed);
+	hash ^= static_cast<unsigned int>(a_x) * 0x8DA6B343u;
+	hash ^= static_cast<unsigned int>(a_y) * 0xD8163841u;
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35u;
+	hash ^= hash >> 16;
+	return static_cast<int>(hash & 0x7FFFFFFFu);
+}
 int Random::RandMax()
 {
 	return rand_L;
 }
 int Random::RandInt()
 {
-	rand_seed = (rand_seed * rand_a + rand_c) % rand_mod;	// Calculate seed value
+	rand_seed = static_cast<int>((static_cast<unsigned int>(rand_seed) * rand_a + rand_c) % rand_mod);	// Calculate seed value
 	return rand_seed & rand_L;								// & with L to keep value in bit range
 }
 int Random::RandomRange(const int& min, const int& max)
@@ -11,6 +11,7 @@
 //\------------------------
 //\ INCLUDES
 //\------------------------
+#include <cmath>
 #include "Ray.h"
 //\------------------------
 
@@ -20,14 +21,16 @@
 Ray::Ray(): m_v3Origin(0.f, 0.f, 0.f),
 			m_v3Direction(0.f, 0.f, 1.f),
 			m_MinLength(0.f),
-			m_MaxLength(std::numeric_limits<float>::max())
+			m_MaxLength(std::numeric_limits<float>::max()),
+			m_ConeWidth(0.f),
+			m_ConeSpread(0.f)
 {
 }
 //\----------------------------------------------------------------------------------
 //\ Constructor with origin and direction values 
 //\----------------------------------------------------------------------------------
 Ray::Ray(const Vector3& a_v3Origin, const Vector3& a_v3Direction, float a_minLength, float a_maxLength) :
-	m_v3Origin(a_v3Origin), m_v3Direction(a_v3Direction), m_MinLength(a_minLength), m_MaxLength(a_maxLength)
+	m_v3Origin(a_v3Origin), m_v3Direction(a_v3Direction), m_MinLength(a_minLength), m_MaxLength(a_maxLength), m_ConeWidth(0.f), m_ConeSpread(0.f)
 {
 	if (m_v3Direction.Length() > 1.f)					// If length is greater that 1 the vector is normalised
 	{
@@ -38,7 +41,8 @@ Ray::Ray(const Vector3& a_v3Origin, const Vector3& a_v3Direction, float a_minLen
 //\ Copy Constructor 
 //\----------------------------------------------------------------------------------
 Ray::Ray(const Ray& a_Ray) :
-m_v3Origin(a_Ray.m_v3Origin), m_v3Direction(a_Ray.m_v3Direction), m_MinLength(a_Ray.m_MinLength), m_MaxLength(a_Ray.m_MaxLength)
+m_v3Origin(a_Ray.m_v3Origin), m_v3Direction(a_Ray.m_v3Direction), m_MinLength(a_Ray.m_MinLength), m_MaxLength(a_Ray.m_MaxLength),
+m_ConeWidth(a_Ray.m_ConeWidth), m_ConeSpread(a_Ray.m_ConeSpread)
 {
 }
 //\----------------------------------------------------------------------------------
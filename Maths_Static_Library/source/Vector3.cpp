@@ -15,134 +15,9 @@
 //\------------------------
 
 //\====================================================================================================
-//\ Vector2 - 2 Dimensional Vector Class 
+//\ Vector3 - the constexpr arithmetic is defined in Vector3.h, only the square root functions are here
 //\====================================================================================================
 
-//\----------------------------------------------------------------------------------
-//\ Default Constructor 
-//\----------------------------------------------------------------------------------
-Vector3::Vector3()
-{
-	x = 0.f; y = 0.f; z = 0.f;
-}
-//\----------------------------------------------------------------------------------
-//\ Constructor with X, Y Values
-//\----------------------------------------------------------------------------------
-Vector3::Vector3(const float a_x, const float a_y, const float a_z)
-{
-	x = a_x;
-	y = a_y;
-	z = a_z;
-}
-//\----------------------------------------------------------------------------------
-//\ Copy constructor 
-//\----------------------------------------------------------------------------------
-Vector3::Vector3(const Vector3& a_v3)
-{
-	x = a_v3.x;
-	y = a_v3.y;
-	z = a_v3.z;
-}
-//\----------------------------------------------------------------------------------
-//\ Destructor 
-//\----------------------------------------------------------------------------------
-Vector3::~Vector3()
-{
-	//nothing new, nothing to delete
-}
-
-//\====================================================================================================
-// -- OPERATOR OVERLOADS
-//\====================================================================================================
-
-//\----------------------------------------------------------------------------------
-//\ Equivalence operators
-//\----------------------------------------------------------------------------------
-bool Vector3::operator==(const Vector3& a_v3) const
-{
-	return ( x == a_v3.x && y == a_v3.y && z == a_v3.z);
-}
-bool Vector3::operator!=(const Vector3& a_v3) const
-{
-	return (x != a_v3.x || y != a_v3.y || z != a_v3.z);
-}
-//\----------------------------------------------------------------------------------
-//\ Negate
-//\----------------------------------------------------------------------------------
-const Vector3 Vector3::operator-() const
-{
-	return Vector3(-x, -y, -z);
-}
-//\----------------------------------------------------------------------------------
-//\ Addition + Subtraction -
-//\----------------------------------------------------------------------------------
-Vector3 Vector3::operator+(const Vector3& a_v3) const
-{
-	return Vector3(x + a_v3.x, y + a_v3.y, z + a_v3.z);
-}
-Vector3			Vector3::operator -			(const Vector3& a_v3)const
-{
-	return Vector3(x - a_v3.x, y - a_v3.y, z - a_v3.z);
-}
-Vector3 Vector3::operator+(const float a_scalar) const
-{
-	return Vector3(x + a_scalar, y + a_scalar, z + a_scalar);
-}
-
-Vector3	Vector3::operator +=	(const Vector3& a_v3)
-{
-	x += a_v3.x;
-	y += a_v3.y;
-	z += a_v3.z;
-	return *this;
-}
-//\----------------------------------------------------------------------------------
-//\ MULTIPLICATION
-//\----------------------------------------------------------------------------------
-Vector3 Vector3::operator*(const float& a_scalar) const
-{
-	return Vector3(x * a_scalar, y * a_scalar, z * a_scalar);
-}
-Vector3 Vector3::operator*(const Vector3& a_v3) const
-{
-	return Vector3(a_v3.x * x, a_v3.y * y, a_v3.z * z);
-}
-
-//\====================================================================================================
-// -- VECTOR 4 FUNCTIONALITY
-//\====================================================================================================
-
-//\----------------------------------------------------------------------------------
-//\ Dot Product - projection of one vector along another 
-//\				  or the cosine value of the angle between two vectors 
-//\----------------------------------------------------------------------------------
-float Vector3::Dot(const Vector3& a_v3) const
-{
-	return (x * a_v3.x + y * a_v3.y + z * a_v3.z);
-}
-//\----------------------------------------------------------------------------------
-//\ Dot Product - Freind function allows use to do the following in code 
-//\				  Vector2 result = Dot( vec2A, vec2B );		
-//				  notice the lack of "Vector2::" prior to the function name 
-//\----------------------------------------------------------------------------------
-float Dot(const Vector3& a_v3A, const  Vector3& a_v3B)
-{
-	return a_v3A.Dot(a_v3B);
-}
-//\----------------------------------------------------------------------------------
-//\ CROSS PRODUCT 
-//\----------------------------------------------------------------------------------
-Vector3 Vector3::Cross( const Vector3& b) const 
-{
-	return Vector3 (y*b.z - z*b.y,
-					z*b.x - x*b.z,
-					x*b.y - y*b.x);
-}
-Vector3 Cross(const Vector3& a_v3A, const  Vector3& a_v3B)
-{
-	return a_v3A.Cross(a_v3B);
-}
-
 //\----------------------------------------------------------------------------------
 //\ Get the length (Magnitude) of the Vector 
 //\----------------------------------------------------------------------------------
@@ -178,19 +53,3 @@ Vector3 Normalize(const Vector3& a_vec3)
 	}
 	return n;
 }
-//\----------------------------------------------------------------------------------
-//\ LERP - Linear Interpolate 
-//\----------------------------------------------------------------------------------
-Vector3 Lerp(const Vector3& a_v3A, const Vector3& a_v3B, const float a_t)
-{
-	return (a_v3B - a_v3A) * a_t + a_v3A;
-}
-//\----------------------------------------------------------------------------------
-//\ REFLECT - one Vector around another 
-//\----------------------------------------------------------------------------------
-Vector3 Reflect(const Vector3& a_v3A, const Vector3& a_v3B)
-{
-	Vector3 reflect = a_v3A - a_v3B * 2.f * Dot(a_v3A, a_v3B);
-	return reflect;
-}
-
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				AOV.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Arbitrary output variables - what the primary ray of each pixel hit, kept alongside the
+//						beauty pass for compositing and to guide the denoiser. Scene::CastRay fills them in from the
+//						hit it has already found, so they cost a few copies per ray rather than a render each.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef AOV_H
+#define AOV_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <string>
+#include <vector>
+
+#include "ColourRGB.h"
+//\------------------------
+
+struct IntersectResponse;
+
+//\----------------------------------------------------------------------------------
+//\ What one primary ray hit - a ray that only sees the sky has an albedo of one, zero position, normal
+//\ and depth, and a primitive ID of -1
+//\----------------------------------------------------------------------------------
+struct AOVSample
+{
+	Vector3		position;				// World space hit position
+	Vector3		normal;					// World space surface normal
+	Vector3		albedo;					// Albedo of the material hit
+	float		depth;					// Distance from the camera
+	int			primitiveID;			// Index of the primitive hit within the scene
+};
+
+//\----------------------------------------------------------------------------------
+//\ One value per pixel for each output variable. Everything but the primitive ID is averaged over the rays of
+//\ the pixel so edges are anti-aliased the same as the beauty pass, the ID is the one hit nearest the centre.
+//\----------------------------------------------------------------------------------
+struct AOVBuffers
+{
+	std::vector<Vector3>	position;
+	std::vector<Vector3>	normal;
+	std::vector<Vector3>	albedo;
+	std::vector<float>		depth;
+	std::vector<int>		primitiveID;
+
+	void Resize(size_t a_pixelCount);
+	void Set(size_t a_pixel, const AOVSample& a_sample);
+	size_t Size() const { return depth.size(); }
+};
+
+namespace AOV
+{
+	enum Channel
+	{
+		POSITION,
+		NORMAL,
+		ALBEDO,
+		DEPTH,
+		PRIMITIVE_ID,
+		CHANNEL_COUNT,
+	};
+
+	// What a ray that hit a_ir saw, and what a ray that hit nothing saw
+	AOVSample		FromHit(const Ray& a_ray, const IntersectResponse& a_ir);
+	AOVSample		Miss();
+
+	// Name of the channel - also the suffix of its image file
+	const char*		ChannelName(Channel a_channel);
+	// out.ppm becomes out_depth.ppm
+	std::string		ChannelFilename(const std::string& a_filename, Channel a_channel);
+	//\----------------------------------------------------------------------------------
+	//\ Colours to display a channel - normals are mapped from -1 -> 1 to 0 -> 1, position and depth are scaled
+	//\ to fit the largest value in the image and every primitive ID gets its own colour
+	//\----------------------------------------------------------------------------------
+	void			ToColours(const AOVBuffers& a_buffers, Channel a_channel, std::vector<ColourRGB>& a_colours);
+	// The values themselves for float images - depth and primitive ID go in all three channels
+	void			ToValues(const AOVBuffers& a_buffers, Channel a_channel, std::vector<ColourRGB>& a_values);
+};
+
+#endif // !AOV_H
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				AliasTable.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Walker's alias method - picks an index with probability proportional to its weight in constant
+//						time however many weights there are. Used to choose which lights to sample at a hit.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef ALIASTABLE_H
+#define ALIASTABLE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+//\------------------------
+
+class AliasTable
+{
+public:
+	AliasTable();
+	~AliasTable();
+
+	// Build the table from a list of weights - negative weights are treated as zero and if every weight is zero
+	// each index is equally likely
+	void Build(const std::vector<float>& a_weights);
+	// Pick an index from a random number in the range 0 to 1
+	int Sample(float a_random) const;
+	// Probability of Sample returning a_index
+	float Pdf(int a_index) const { return m_pdf[a_index]; }
+	int Size() const { return (int)m_pdf.size(); }
+
+private:
+	std::vector<float> m_probability;	// Chance of keeping each slot rather than taking its alias
+	std::vector<int> m_alias;			// The index each slot gives its leftover chance to
+	std::vector<float> m_pdf;			// Normalised weight of each index
+};
+
+#endif // !ALIASTABLE_H
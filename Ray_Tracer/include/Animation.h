@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Animation.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Keyframed transforms for primitives, lights and cameras. Apply(time) moves everything to
+//						where it is at that time, blending linearly between the two keys either side of it.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+#include <MathLib.h>
+//\------------------------
+
+class Primitive;
+class Light;
+class Camera;
+
+class Animation
+{
+public:
+	// Position, rotation (euler angles in degrees, applied X then Y then Z) and scale at a point in time
+	struct TransformKey
+	{
+		float	time;
+		Vector3	position;
+		Vector3	rotation;
+		Vector3	scale;
+	};
+	// Camera position and the point it looks at
+	struct CameraKey
+	{
+		float	time;
+		Vector3	position;
+		Vector3	target;
+	};
+
+	Animation();
+	~Animation();
+
+	// Keys can be added in any order - the animated objects are not owned and must outlive the animation
+	void AddKey(Primitive* a_primitive, const TransformKey& a_key);
+	void AddKey(Light* a_light, const TransformKey& a_key);
+	void AddKey(Camera* a_camera, const CameraKey& a_key);
+	void Clear();
+
+	// Move every animated object to where it is at a_time - before the first key or after the last one the end key is held
+	void Apply(float a_time) const;
+
+	// Time of the first and last key of all tracks
+	float GetStartTime() const;
+	float GetEndTime() const;
+
+	// Build the transform a key describes
+	static AffineTransform ToTransform(const TransformKey& a_key);
+
+private:
+	template<typename Target, typename Key>
+	struct Track
+	{
+		Target*				target;
+		std::vector<Key>	keys;			// Sorted by time
+	};
+
+	template<typename Target, typename Key>
+	static void AddKey(std::vector<Track<Target, Key>>& a_tracks, Target* a_target, const Key& a_key);
+	static TransformKey Blend(const std::vector<TransformKey>& a_keys, float a_time);
+	static CameraKey Blend(const std::vector<CameraKey>& a_keys, float a_time);
+
+	std::vector<Track<Primitive, TransformKey>> m_primitiveTracks;
+	std::vector<Track<Light, TransformKey>> m_lightTracks;
+	std::vector<Track<Camera, CameraKey>> m_cameraTracks;
+};
+
+#endif // !ANIMATION_H
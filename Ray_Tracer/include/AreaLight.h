@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				AreaLight.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A rectangular area light centred on the position of its transform, shining out of its forward
+//						direction. Each sample picks a random point on the rectangle so the many rays per pixel average
+//						out into soft shadows.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef AREALIGHT_H
+#define AREALIGHT_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Light.h"
+//\------------------------
+
+class AreaLight : public Light
+{
+public:
+	AreaLight();
+	AreaLight(const Vector3& a_position, const Vector3& a_facing, float a_width, float a_height, const ColourRGB& a_colour, float a_intensity);
+	virtual ~AreaLight();
+
+	// Override the base light class - a random point on the rectangle
+	LightSample SampleLight(const Vector3& a_point) const override;
+	float EstimatePower() const override;
+
+	void SetFacing(const Vector3& a_facing) { Light::SetFacing(a_facing); }
+	Vector3 GetFacing() const { return m_Transform.GetColumn(2); }
+	void SetSize(float a_width, float a_height) { m_width = a_width; m_height = a_height; }
+
+protected:
+	float m_width;			// Size of the rectangle along the right (x) axis of the transform
+	float m_height;			// Size of the rectangle along the up (y) axis of the transform
+	float m_intensity;		// Brightness of each unit of area at a distance of one unit
+};
+
+#endif // !AREALIGHT_H
@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				BVH.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Bounding volume hierarchy over the primitives of a scene. Built top down with the surface area
+//						heuristic, it can be refit in place when only the transforms of the primitives change. Refitting
+//						keeps the tree shape so it gets worse as objects move apart - Cost() against BuildCost() says
+//						when a full rebuild is worth it.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef BVH_H
+#define BVH_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+#include <MathLib.h>
+//\------------------------
+
+class Primitive;
+
+class BVH
+{
+public:
+	BVH();
+	~BVH();
+
+	// Build the tree over a_objects - the vector is referenced, not copied, and must not change until the next Build or Clear
+	void Build(const std::vector<const Primitive*>& a_objects);
+	// Recalculate every box from the current bounds of the primitives, keeping the shape of the tree
+	void Refit();
+	void Clear();
+	bool IsBuilt() const { return !m_nodes.empty(); }
+
+	// Surface area heuristic cost of the tree as it is now and as it was when it was built
+	float Cost() const;
+	float BuildCost() const { return m_buildCost; }
+	AABB GetBounds() const;
+	// Levels below the root of the deepest leaf - always under STACK_SIZE
+	int GetDepth() const { return m_depth; }
+
+	// Nearest primitive hit by the ray between its min and max lengths
+	bool IntersectNearest(const Ray& a_ray, float& a_distance, int& a_objectIndex) const;
+	//\----------------------------------------------------------------------------------
+	//\ Visit every primitive whose box the ray passes through before a_maxDistance, in no particular order.
+	//\ a_visit(objectIndex) returns true to stop the traversal early.
+	//\----------------------------------------------------------------------------------
+	template<typename Visitor>
+	void VisitCandidates(const Ray& a_ray, float a_maxDistance, Visitor a_visit) const;
+
+private:
+	// Entries of the traversal stacks - a walk holds at most one node more than the depth of the tree, and the
+	// build keeps the depth under this
+	static const int STACK_SIZE = 64;
+
+	//\----------------------------------------------------------------------------------
+	//\ Nodes are stored depth first, the left child of an inner node is always the next node
+	//\----------------------------------------------------------------------------------
+	struct Node
+	{
+		AABB	bounds;
+		int		first;			// Inner node - index of the right child. Leaf - first entry in m_indices
+		int		count;			// Number of primitives in a leaf, 0 for an inner node
+	};
+
+	int BuildNode(int a_first, int a_count, int a_depth, const std::vector<AABB>& a_bounds, const std::vector<Vector3>& a_centres);
+	// Reciprocal of the unit ray direction for the slab tests - the primitives return world distances whatever the
+	// length of the direction, so the box distances must be world distances too
+	static Vector3 InverseDirection(const Ray& a_ray);
+
+	std::vector<Node> m_nodes;
+	std::vector<int> m_indices;						// Primitive indices, each leaf owns a contiguous range
+	const std::vector<const Primitive*>* m_objects;
+	float m_buildCost;
+	int m_depth;
+};
+
+template<typename Visitor>
+void BVH::VisitCandidates(const Ray& a_ray, float a_maxDistance, Visitor a_visit) const
+{
+	if (m_nodes.empty())
+	{
+		return;
+	}
+	const Vector3 invDirection = InverseDirection(a_ray);
+	const Vector3 origin = a_ray.Origin();
+
+	int stack[STACK_SIZE];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const Node& node = m_nodes[stack[--stackSize]];
+		float entry = 0.f;
+		if (!node.bounds.IntersectRay(origin, invDirection, a_maxDistance, entry))
+		{
+			continue;
+		}
+		if (node.count > 0)
+		{
+			for (int i = node.first; i < node.first + node.count; ++i)
+			{
+				if (a_visit(m_indices[i]))
+				{
+					return;
+				}
+			}
+		}
+		else
+		{
+			int self = (int)(&node - &m_nodes[0]);
+			stack[stackSize++] = node.first;
+			stack[stackSize++] = self + 1;
+		}
+	}
+}
+
+#endif // !BVH_H
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Benchmark.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Built in micro benchmarks run from the command line with --bench [name]. Each benchmark
+//						times the current code path against the one it replaced and writes a small report.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GeneratedScene.h"
+//\------------------------
+
+namespace Benchmark
+{
+	//\----------------------------------------------------------------------------------
+	//\ A scaling sweep - a generated scene is rendered with the wavefront renderer for every combination of object
+	//\ count, thread count and rays per pixel. An empty thread list means 1, 2, 4 and so on up to one per core.
+	//\----------------------------------------------------------------------------------
+	struct SweepSettings
+	{
+		GeneratedSceneSettings scene;		// Every setting but the object count
+		std::vector<int> objectCounts = { 100, 1000, 10000 };
+		std::vector<int> threadCounts;
+		std::vector<int> raysPerPixel = { 4 };
+		int width = 256;
+		int height = 128;
+		int repeats = 1;					// Each combination keeps its best time over this many renders
+	};
+
+	// Run the named benchmark writing the report to a_out - returns false if there is no benchmark with that name
+	bool			Run(const std::string& a_name, std::ostream& a_out);
+	// Write the list of benchmark names
+	void			List(std::ostream& a_out);
+
+	// Matrix4 against AffineTransform - point, vector and normal transforms plus the inverse
+	void			Transform(std::ostream& a_out);
+	// Secondary rays traced once per light against once per hit - render time as directional lights are added
+	void			Lights(std::ostream& a_out);
+	// Every light shadow tested at every hit against one light sampled a hit - the cost of a hit as point lights are added
+	void			LightCount(std::ostream& a_out);
+	// Re-rendering the tiles an edit can change against re-rendering the whole image
+	void			Incremental(std::ostream& a_out);
+	// Few rays per pixel plus the denoiser against more rays per pixel in the same time - error against a reference render
+	void			Denoise(std::ostream& a_out);
+	// Rendering with the output variables filled in against rendering the beauty pass alone
+	void			AOVs(std::ostream& a_out);
+	// Bulk SSE2 pixel format conversions against one value at a time, plus the size and error of each storage format
+	void			FrameBufferFormats(std::ostream& a_out);
+	// The PFM, QOI and PNG encoders on one thread and on all of them against the text PPM writer - time and file size
+	void			ImageFormats(std::ostream& a_out);
+	// The recursive renderer against the wavefront renderer on one thread and on all of them - time and error
+	void			Wavefront(std::ostream& a_out);
+	// Secondary rays traced in the order shading leaves them against sorted by octant and origin - incoherent bounce throughput
+	void			Reorder(std::ostream& a_out);
+	// The textured main scene rendered with a shrinking texture cache - time, hit rate and memory against the whole texture
+	void			Textures(std::ostream& a_out);
+	// The fast math approximations against the standard library - time and most error of each, then renders in both precisions
+	void			MathPrecision(std::ostream& a_out);
+	// Each kind of light sampled and shaded one hit at a time against a batch of hits at once - time and matching results
+	void			LightBatch(std::ostream& a_out);
+	// Particles moving every frame with the hierarchy rebuilt or refit against the grid rebuilt or updated - update and render time
+	void			Grid(std::ostream& a_out);
+	// Moving clusters of many parts as one flat scene refit or rebuilt against instances of sub scenes with only the top refit
+	void			Instances(std::ostream& a_out);
+	// A small scaling sweep written as CSV
+	void			Sweep(std::ostream& a_out);
+
+	//\----------------------------------------------------------------------------------
+	//\ Run a sweep writing one CSV row per render to a_csv and the progress to a_log. Each row has the settings,
+	//\ the time to generate the scene and build its hierarchy, the render time, the rays traced and the rays a
+	//\ second, plus the speed up and parallel efficiency against the first thread count of the same scene and spp.
+	//\----------------------------------------------------------------------------------
+	void			Sweep(const SweepSettings& a_settings, std::ostream& a_csv, std::ostream& a_log);
+};
+
+#endif // !BENCHMARK_H
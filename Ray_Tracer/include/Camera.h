@@ -63,16 +63,18 @@ public:
 	//\----------------------------------------------------------------------------------
 	Ray CastRay(Vector2 a_screenspaceCoord);
 	//\----------------------------------------------------------------------------------
-	//\ Get camera pos/rot matrix 
+	//\ Get camera pos/rot matrix - the camera to world transform is affine, Matrix4 is kept for the projection
 	//\----------------------------------------------------------------------------------
-	Matrix4 GetTransform() { return m_Transform; }
+	Matrix4 GetTransform() { return m_Transform.ToMatrix4(); }
+	const AffineTransform& GetAffineTransform() const { return m_Transform; }
 	//\----------------------------------------------------------------------------------
 	//\ Get Projection Matrix
 	//\----------------------------------------------------------------------------------
 	Matrix4 GetProjectionMatrix() {return m_projectionMatrix; }
 private:
 	Matrix4 m_projectionMatrix;
-	Matrix4 m_Transform;
+	Matrix4 m_invProjectionMatrix;		// Cached inverse of the projection - rays are unprojected through this
+	AffineTransform m_Transform;		// Camera to world transform (inverse of the view matrix)
 	float m_aspectRatio;
 	float m_fov;
 	float m_zNear;
@@ -0,0 +1,32 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				CropMerge.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Assembles crop window renders back into the full image. The pixel values are copied from the
+//						crops as they were written, so crops of a frame merge into a file identical to a full render.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef CROP_MERGE_H
+#define CROP_MERGE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+//\------------------------
+
+namespace CropMerge
+{
+	//\----------------------------------------------------------------------------------
+	//\ Merge the PPM images in a_inputs into a_output. Crops are placed where their crop comment says and later
+	//\ inputs are drawn over earlier ones, so a re-rendered region can be listed after the full image to patch it.
+	//\ Returns false, with the reason written to a_log, if an input can not be read, the inputs disagree on the
+	//\ size of the full image or some pixels are not covered by any input.
+	//\----------------------------------------------------------------------------------
+	bool			Merge(const std::vector<std::string>& a_inputs, const std::string& a_output, std::ostream& a_log);
+};
+
+#endif // !CROP_MERGE_H
@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Deflate.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Deflate compression (RFC 1951) and the checksums PNG needs, so images can be compressed
+//						without an external library. Each block is written with whichever of stored, fixed or
+//						dynamic Huffman codes is smallest. Pieces of one stream can be compressed on separate
+//						threads and joined end to end.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef DEFLATE_H
+#define DEFLATE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cstddef>
+#include <vector>
+//\------------------------
+
+namespace Deflate
+{
+	//\----------------------------------------------------------------------------------
+	//\ Append the deflate blocks for a_size bytes of a_data to a_output. The last block is marked final when
+	//\ a_final is set, otherwise the output ends on a byte boundary with an empty stored block so the next piece
+	//\ can be appended after it. Matches never reach back before a_data, so pieces do not depend on each other.
+	//\----------------------------------------------------------------------------------
+	void			Compress(const unsigned char* a_data, size_t a_size, bool a_final, std::vector<unsigned char>& a_output);
+
+	// Running checksums - pass the result of the previous call to continue one over more data
+	unsigned int	Adler32(const unsigned char* a_data, size_t a_size, unsigned int a_adler = 1);
+	unsigned int	Crc32(const unsigned char* a_data, size_t a_size, unsigned int a_crc = 0);
+	// Adler-32 of two pieces of data joined together, from the checksum of each and the size of the second
+	unsigned int	Adler32Combine(unsigned int a_first, unsigned int a_second, size_t a_secondSize);
+};
+
+#endif // !DEFLATE_H
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Denoiser.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Edge avoiding a-trous wavelet filter for images rendered with few rays per pixel. Each pass
+//						blurs with a 5x5 kernel whose taps are spread twice as far apart as the pass before, and every
+//						tap is weighted by how alike the two pixels' colour, albedo, normal and depth are so the blur
+//						stops at the edges of objects and materials.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef DENOISER_H
+#define DENOISER_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+
+#include "AOV.h"
+#include "ColourRGB.h"
+//\------------------------
+
+class Denoiser
+{
+public:
+	struct Settings
+	{
+		int		passes;					// Number of a-trous passes - the filter reaches 2^(passes + 1) - 2 pixels from the centre
+		float	colourSigma;			// Colour difference halving the weight of a tap, halved again on every pass
+		float	normalSigma;			// Length of the normal difference allowed between two pixels
+		float	depthSigma;				// Depth difference allowed per pixel between two pixels, as a fraction of the deeper of the two
+		float	albedoSigma;			// Albedo difference allowed between two pixels
+		bool	demodulate;				// Filter the lighting divided by the albedo so texture and colour edges stay sharp
+	};
+
+	// Settings tuned for 8 to 16 rays per pixel
+	static Settings DefaultSettings();
+
+	Denoiser();
+	explicit Denoiser(const Settings& a_settings);
+	~Denoiser();
+
+	const Settings& GetSettings() const { return m_settings; }
+	void SetSettings(const Settings& a_settings) { m_settings = a_settings; }
+	// Threads used by the filter, 0 for one per hardware thread
+	void SetThreadCount(int a_threads) { m_threads = a_threads; }
+
+	// Filter a_width * a_height pixels into a_output guided by the albedo, normal and depth of a_aovs, which must cover
+	// the same pixels. The image is split into tiles which are filtered in parallel, each pass waits for the one before.
+	void Denoise(const std::vector<ColourRGB>& a_pixels, const AOVBuffers& a_aovs, int a_width, int a_height,
+				 std::vector<ColourRGB>& a_output) const;
+
+private:
+	// One a-trous pass of the rows and columns in the tile, reading a_input and writing a_output
+	void FilterTile(const std::vector<ColourRGB>& a_input, const AOVBuffers& a_aovs, int a_width, int a_height,
+					int a_tileX, int a_tileY, int a_step, float a_colourSigma, std::vector<ColourRGB>& a_output) const;
+
+	Settings m_settings;
+	int m_threads;
+};
+
+#endif // !DENOISER_H
@@ -0,0 +1,54 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				DependencySet.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				The primitives and materials that a group of rays touched. The scene adds to the set while
+//						one is being recorded, the incremental renderer keeps one per tile to find the tiles an edit
+//						can change.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef DEPENDENCY_SET_H
+#define DEPENDENCY_SET_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+//\------------------------
+
+class Primitive;
+class Material;
+
+class DependencySet
+{
+public:
+	DependencySet();
+	~DependencySet();
+
+	void Clear();
+	// Adding is cheap and may keep duplicates until the next Compact
+	void Add(const Primitive* a_primitive);
+	void Add(const Material* a_material);
+	void Add(const DependencySet& a_set);
+	// Sort and remove the duplicates - must be called before Contains
+	void Compact();
+
+	bool Contains(const Primitive* a_primitive) const;
+	bool Contains(const Material* a_material) const;
+	int GetPrimitiveCount() const { return (int)m_primitives.size(); }
+	int GetMaterialCount() const { return (int)m_materials.size(); }
+
+private:
+	template<typename T>
+	static void Add(std::vector<const T*>& a_items, size_t& a_compactSize, const T* a_item);
+	template<typename T>
+	static void Compact(std::vector<const T*>& a_items, size_t& a_compactSize);
+
+	std::vector<const Primitive*> m_primitives;
+	std::vector<const Material*> m_materials;
+	size_t m_primitivesCompactSize;			// Size after the last compact - the vectors are compacted again when they double
+	size_t m_materialsCompactSize;
+};
+
+#endif // !DEPENDENCY_SET_H
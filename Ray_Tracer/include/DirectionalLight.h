@@ -7,6 +7,8 @@
 //						of the lights transform Matrix.
 // 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef DIRECTIONALLIGHT_H
+#define DIRECTIONALLIGHT_H
 
 //\------------------------
 //\ INCLUDES
@@ -22,14 +24,19 @@ public:
 	DirectionalLight();
 	DirectionalLight(const Matrix4& a_transform, const Vector3& a_colour, const Vector3& a_facing);
 	virtual ~DirectionalLight();
-	// Override the base light class' calculate lighting function
-	ColourRGB calculateLighting(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, float a_shadowFactor = 1.0) const override;
 
 	// Functionality to set and get the direction of the light
 	void SetDirection(const Vector3& a_direction, const Vector3& a_up = Vector3(0.f, 1.f, 0.f));
 	Vector3 GetDirection() const;
 	Vector3 GetDirectionToLight(const Vector3& a_point = Vector3(0.f, 0.f, 0.f)) const override;
+	// The light is infinitely far away so nothing behind the surface point is ever past the light
+	float GetDistanceToLight(const Vector3& a_point) const override;
 	
 protected:
+	// Every hit gets the same sample
+	void SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const override;
+
 	// Directional Light no additional variables used fwd direction from a_transform for direction.
 };
+
+#endif // !DIRECTIONALLIGHT_H
@@ -7,7 +7,8 @@
 //						scalling of the Ellipsoids radius in all three dimensions.				
 // 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
-#ifndef PRIMATIVE_H
+#ifndef ELLIPSOID_H
+#define ELLIPSOID_H
 
 //\------------------------
 //\ INCLUDES
@@ -22,12 +23,17 @@ public:
 	Ellipsoid(const Vector3& a_pos, const float& a_radius);
 	virtual ~Ellipsoid();
 
-	// This function will Override the Ellipsoid class will be used in place of the function in the base Primitive class
-	bool IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const override;
+	// These functions Override the base Primitive class - distance only test and building the hit record for the nearest hit
+	bool IntersectDistance(const Ray& a_ray, float& a_distance) const override;
+	void FinalizeHit(const Ray& a_ray, float a_distance, IntersectResponse& a_intersectResponse) const override;
+	AABB GetBounds() const override;
 	Vector3 m_colour;
 
+protected:
+	void TransformChanged() override;
+
 private:
-	float m_radius;
+	float m_radius;			// Mean world space radius - kept up to date with the transform for the texture coordinate scale
 	
 };
-#endif // !PRIMATIVE_H
\ No newline at end of file
+#endif // !ELLIPSOID_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				ExampleScene.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				The demo scene rendered by the application - a row of glass, metal and matte spheres on a
+//						green ground lit by a single directional light, plus a turntable animation of it.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef EXAMPLE_SCENE_H
+#define EXAMPLE_SCENE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Camera.h"
+#include "DirectionalLight.h"
+#include "Ellipsoid.h"
+#include "Material.h"
+#include "Scene.h"
+//\------------------------
+
+class Animation;
+class Texture;
+
+class ExampleScene
+{
+public:
+	ExampleScene(float a_aspectRatio);
+	~ExampleScene();
+
+	Scene& GetScene() { return m_scene; }
+	Camera& GetCamera() { return m_camera; }
+
+	// Key a_animation with the camera circling the spheres once over a_duration while the blue sphere bounces
+	// and the green sphere rolls toward the centre and back
+	void AddTurntable(Animation& a_animation, float a_duration);
+	// Put a_texture on the ground, tinted by its green and repeated a_repeat times around it
+	void SetGroundTexture(const Texture* a_texture, float a_repeat);
+
+private:
+	// The scene only holds pointers so everything it draws lives here
+	Scene m_scene;
+	Camera m_camera;
+	DirectionalLight m_light;
+
+	Material m_lightBlueRough;
+	Material m_greenSmooth;
+	Material m_greenRough;
+	Material m_redSmooth;
+	Material m_clear;
+	Material m_clearInner;
+
+	Ellipsoid m_ground;
+	Ellipsoid m_leftSphere;
+	Ellipsoid m_centreSphere;
+	Ellipsoid m_rightSphere;
+	Ellipsoid m_glassOuter;
+	Ellipsoid m_glassInner;
+};
+
+#endif // !EXAMPLE_SCENE_H
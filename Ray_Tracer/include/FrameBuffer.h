@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				FrameBuffer.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Floating point image with a choice of storage - 32 bit floats to accumulate into, 16 bit
+//						half floats or shared exponent RGBE to keep large images small. Pixels are stored in square
+//						tiles so a tile of the image is one contiguous block of memory.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef FRAMEBUFFER_H
+#define FRAMEBUFFER_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ColourRGB.h"
+//\------------------------
+
+//\----------------------------------------------------------------------------------
+//\ Pixel format conversions. The bulk routines use SSE2 when the target has it and give exactly the same
+//\ bits as the single value routines, which are the reference for them.
+//\----------------------------------------------------------------------------------
+namespace PixelFormat
+{
+	// IEEE half float, rounded to nearest even - values too large for a half become infinity
+	unsigned short	FloatToHalf(float a_value);
+	float			HalfToFloat(unsigned short a_half);
+	void			FloatToHalf(const float* a_values, unsigned short* a_halves, size_t a_count);
+	void			HalfToFloat(const unsigned short* a_halves, float* a_values, size_t a_count);
+
+	// Ward's RGBE - three 8 bit mantissas sharing the exponent of the brightest channel. Negative channels are
+	// stored as zero, there is no sign.
+	void			EncodeRGBE(const float* a_rgb, unsigned char* a_rgbe);
+	void			DecodeRGBE(const unsigned char* a_rgbe, float* a_rgb);
+	void			EncodeRGBE(const float* a_rgb, unsigned char* a_rgbe, size_t a_pixelCount);
+	void			DecodeRGBE(const unsigned char* a_rgbe, float* a_rgb, size_t a_pixelCount);
+
+	// True when the bulk routines were built with SSE2
+	bool			HasSIMD();
+};
+
+class FrameBuffer
+{
+public:
+	enum Format
+	{
+		FLOAT32,		// 12 bytes a pixel, exact - the one to accumulate samples into
+		HALF,			// 6 bytes a pixel, about three significant figures
+		RGBE,			// 4 bytes a pixel, 8 bits of mantissa relative to the brightest channel
+	};
+	static const int TILE_SIZE = 16;
+
+	FrameBuffer();
+	FrameBuffer(int a_width, int a_height, Format a_format = FLOAT32);
+	~FrameBuffer();
+
+	// Every pixel is black after a resize
+	void Resize(int a_width, int a_height, Format a_format);
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	Format GetFormat() const { return m_format; }
+	// Bytes held by the pixels, including the padding of the tiles on the right and bottom edges
+	size_t GetMemorySize() const { return m_data.size(); }
+
+	static int BytesPerPixel(Format a_format);
+	static const char* FormatName(Format a_format);
+	// Reads "fp32", "half" or "rgbe" - returns false for anything else
+	static bool ParseFormat(const std::string& a_name, Format& a_format);
+
+	void SetPixel(int a_x, int a_y, const ColourRGB& a_colour);
+	ColourRGB GetPixel(int a_x, int a_y) const;
+	// Add to a pixel - exact for FLOAT32, the other formats round the sum every time it is stored
+	void AddPixel(int a_x, int a_y, const ColourRGB& a_colour);
+
+	// Convert a_count pixels starting at (a_x, a_y) along the row in one go - the run may cross any number of tiles
+	void StoreRow(int a_x, int a_y, const ColourRGB* a_colours, int a_count);
+	void LoadRow(int a_x, int a_y, ColourRGB* a_colours, int a_count) const;
+	// The whole image to and from rows top to bottom, width * height colours
+	void Store(const std::vector<ColourRGB>& a_pixels);
+	void Load(std::vector<ColourRGB>& a_pixels) const;
+
+private:
+	size_t PixelOffset(int a_x, int a_y) const;
+	// Convert between one run of pixels inside a single tile row and the stored format
+	void Encode(const float* a_rgb, unsigned char* a_stored, int a_count) const;
+	void Decode(const unsigned char* a_stored, float* a_rgb, int a_count) const;
+
+	int m_width;
+	int m_height;
+	int m_tilesX;
+	Format m_format;
+	int m_bytesPerPixel;
+	std::vector<unsigned char> m_data;
+};
+
+#endif // !FRAMEBUFFER_H
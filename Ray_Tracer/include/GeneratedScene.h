@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				GeneratedScene.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A field of random spheres and ellipsoids made from a handful of settings and a seed, for
+//						measuring how rendering scales. The same settings always make the same scene, and the size
+//						of the objects follows their count so every scene covers the screen about as deeply.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef GENERATED_SCENE_H
+#define GENERATED_SCENE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <string>
+#include <vector>
+
+#include "Camera.h"
+#include "DirectionalLight.h"
+#include "Ellipsoid.h"
+#include "Material.h"
+#include "PointLight.h"
+#include "Scene.h"
+//\------------------------
+
+//\----------------------------------------------------------------------------------
+//\ What to generate - written as a comma separated list of name=value by ToString and read by Parse
+//\----------------------------------------------------------------------------------
+struct GeneratedSceneSettings
+{
+	int		objects = 1000;				// Spheres and ellipsoids in the field, the ground not counted
+	float	ellipsoids = 0.5f;			// Part of the objects stretched and turned into ellipsoids, 0 -> 1
+	float	glass = 0.2f;				// Part of the objects given a glass material, 0 -> 1
+	int		lights = 1;					// A directional light, then point lights over the field
+	float	depth = 2.f;				// Objects a ray through the field passes on average - the depth complexity
+	int		seed = 1;
+
+	// Read name=value pairs over the current settings - false, with the settings as far as they got, on a bad pair
+	bool Parse(const std::string& a_text);
+	std::string ToString() const;
+};
+
+class GeneratedScene
+{
+public:
+	GeneratedScene(const GeneratedSceneSettings& a_settings, float a_aspectRatio);
+	~GeneratedScene();
+	// The scene points into the vectors below so it cannot be copied
+	GeneratedScene(const GeneratedScene&) = delete;
+	GeneratedScene& operator=(const GeneratedScene&) = delete;
+
+	Scene& GetScene() { return m_scene; }
+	Camera& GetCamera() { return m_camera; }
+	const GeneratedSceneSettings& GetSettings() const { return m_settings; }
+	// Radius the objects are sized around to give the depth complexity asked for
+	float GetObjectRadius() const { return m_objectRadius; }
+
+	// Width, height and depth of the box the objects are scattered through - it sits on the ground in front of the camera
+	static const Vector3 FIELD_SIZE;
+
+private:
+	GeneratedSceneSettings m_settings;
+	float m_objectRadius;
+
+	// The scene only holds pointers so everything it draws lives here - the vectors are sized once and never grow
+	Scene m_scene;
+	Camera m_camera;
+	std::vector<Material> m_opaqueMaterials;
+	std::vector<Material> m_glassMaterials;
+	std::vector<Ellipsoid> m_objects;
+	DirectionalLight m_sun;
+	std::vector<PointLight> m_pointLights;
+};
+
+#endif // !GENERATED_SCENE_H
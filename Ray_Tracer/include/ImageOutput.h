@@ -0,0 +1,50 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				ImageOutput.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Binary image formats for a frame buffer - PFM keeps the full floating point colours, QOI and
+//						PNG are lossless 8 bit. The image is cut into strips of rows that are encoded on separate
+//						threads and joined into one file, so large frames encode in a fraction of their render time.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef IMAGEOUTPUT_H
+#define IMAGEOUTPUT_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <string>
+#include <vector>
+//\------------------------
+
+class FrameBuffer;
+
+namespace ImageOutput
+{
+	enum Format
+	{
+		PPM,			// Plain text 8 bit, written by the renderer
+		PFM,			// Portable float map - 32 bit float RGB, nothing is clamped
+		QOI,			// "Quite OK Image" - fast lossless 8 bit RGB
+		PNG,			// Lossless 8 bit RGB, filtered rows compressed with deflate
+	};
+
+	// The format matching the extension of a_filename - PPM for anything not recognised
+	Format			FormatFromFilename(const std::string& a_filename);
+	const char*		FormatName(Format a_format);
+	// A colour channel as an 8 bit value, clamped to 0 -> 255
+	unsigned char	ToByte(float a_value);
+
+	//\----------------------------------------------------------------------------------
+	//\ Encode the whole frame into a_output using up to a_threads threads, 0 for one per hardware thread.
+	//\ The 8 bit formats clamp each channel to 0 -> 1 first.
+	//\----------------------------------------------------------------------------------
+	void			EncodePFM(const FrameBuffer& a_frame, std::vector<unsigned char>& a_output, int a_threads = 0);
+	void			EncodeQOI(const FrameBuffer& a_frame, std::vector<unsigned char>& a_output, int a_threads = 0);
+	void			EncodePNG(const FrameBuffer& a_frame, std::vector<unsigned char>& a_output, int a_threads = 0);
+	// Encode in a_format and write the file - PPM is not handled here and returns false
+	bool			Write(const std::string& a_filename, const FrameBuffer& a_frame, Format a_format, int a_threads = 0);
+};
+
+#endif // !IMAGEOUTPUT_H
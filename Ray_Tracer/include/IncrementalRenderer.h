@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				IncrementalRenderer.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Keeps a rendered image and re-renders only the tiles an edit can change. Every tile remembers
+//						the primitives and materials its rays touched, so after an object is moved or a material is
+//						changed only the tiles that depend on it are rendered again.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef INCREMENTAL_RENDERER_H
+#define INCREMENTAL_RENDERER_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+
+#include "ColourRGB.h"
+#include "DependencySet.h"
+//\------------------------
+
+class Renderer;
+class Scene;
+class Primitive;
+class Material;
+
+class IncrementalRenderer
+{
+public:
+	// a_prepassRaysPerPixel rays per pixel are traced through the clean tiles after an object moves to find the
+	// tiles it has moved into - more rays catch smaller objects and reflections but cost more
+	IncrementalRenderer(const Renderer& a_renderer, int a_tileSize = 16, int a_prepassRaysPerPixel = 1);
+	~IncrementalRenderer();
+
+	// Render every tile and record what each one depends on
+	void Render(const Scene& a_scene);
+
+	//\----------------------------------------------------------------------------------
+	//\ Edits - call after changing the scene and before Update. Lights, the camera and adding or removing
+	//\ objects are not tracked, call InvalidateAll for those. Moving geometry shared by instances counts as
+	//\ a change to each instance of it.
+	//\----------------------------------------------------------------------------------
+	void PrimitiveChanged(const Primitive* a_primitive);
+	void MaterialChanged(const Material* a_material);
+	void InvalidateAll();
+
+	// Re-render the tiles the edits since the last update can change - returns the number of tiles rendered
+	int Update(const Scene& a_scene);
+
+	int GetTileCount() const { return (int)m_tiles.size(); }
+	const std::vector<ColourRGB>& GetPixels() const { return m_pixels; }
+
+private:
+	struct Tile
+	{
+		int				x0, y0;			// Top left pixel
+		int				x1, y1;			// One past the bottom right pixel
+		DependencySet	dependencies;
+		bool			dirty;
+	};
+
+	// Render a tile with a_raysPerPixel rays per pixel - the colours are only kept when a_keepPixels is set
+	void RenderTile(const Scene& a_scene, const Tile& a_tile, int a_raysPerPixel, float a_pixelSpread, bool a_keepPixels, DependencySet& a_dependencies);
+	bool DependsOnEdits(const DependencySet& a_dependencies) const;
+
+	const Renderer& m_renderer;
+	int m_prepassRaysPerPixel;
+	std::vector<Tile> m_tiles;
+	std::vector<ColourRGB> m_pixels;
+	std::vector<const Primitive*> m_changedPrimitives;	// Edits since the last update
+	std::vector<const Material*> m_changedMaterials;
+};
+
+#endif // !INCREMENTAL_RENDERER_H
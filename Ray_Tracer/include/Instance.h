@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Instance.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				An instance places shared geometry in the world with its own transform and an optional
+//						material override. The geometry is either a single primitive or a whole sub scene and is only
+//						referenced, so placing the same object thousands of times only costs one instance each.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Primitive.h"
+//\------------------------
+
+class Scene;
+
+class Instance : public Primitive
+{
+public:
+	// The geometry is not owned by the instance and must outlive it. A sub scene is the bottom level of a two level
+	// structure - build its acceleration structure once in its own space, then moving the instance only needs the
+	// scene holding it to be refit.
+	Instance(const Primitive* a_geometry, const AffineTransform& a_transform, Material* a_material = nullptr);
+	Instance(const Scene* a_scene, const AffineTransform& a_transform, Material* a_material = nullptr);
+	virtual ~Instance();
+
+	// These functions Override the base Primitive class - the world ray is moved into instance space once
+	// and handed to the shared geometry, the hit is then moved back into world space
+	bool IntersectDistance(const Ray& a_ray, float& a_distance) const override;
+	void FinalizeHit(const Ray& a_ray, float a_distance, IntersectResponse& a_intersectResponse) const override;
+	AABB GetBounds() const override;
+
+	const Primitive* GetGeometry() const { return m_geometry; }
+	const Scene* GetScene() const { return m_scene; }
+
+private:
+	// Build the instance space ray - a_distanceScale converts world distances to instance space distances
+	Ray ToInstanceSpace(const Ray& a_ray, float& a_distanceScale) const;
+
+	const Primitive* m_geometry;	// Shared primitive - null when the instance is of a sub scene
+	const Scene* m_scene;			// Shared sub scene - null when the instance is of a primitive
+};
+
+#endif // !INSTANCE_H
@@ -21,6 +21,10 @@ struct IntersectResponse
 	float		distance;				// The distance to the hit location
 	Material*	material;				// The material property of the intersected object
 	float		currentRefInd;			// current refractive index
+	int			primitiveID;			// Index of the intersected primitive within the scene
+	Vector2		uv;						// Texture coordinates at the intersection
+	float		uvPerUnit;				// How far the texture coordinates move for one unit across the surface
+	float		footprint;				// Width of the ray's cone where it hit - how much surface it stands for
 };
 
 #endif // !IntersectionResponse_H
\ No newline at end of file
@@ -19,6 +19,69 @@
 #include "IntersectionResponse.h"
 //\------------------------
 
+//\----------------------------------------------------------------------------------
+//\ Light Sample - the light arriving at a surface point from one point on a light
+//\----------------------------------------------------------------------------------
+struct LightSample
+{
+	Vector3		directionToLight;		// Normalised direction from the surface point toward the light
+	float		distance;				// Distance to the sampled point on the light - used to end the shadow ray
+	ColourRGB	colour;					// Light colour arriving at the surface after distance and cone falloff
+};
+
+//\----------------------------------------------------------------------------------
+//\ Shading Batch - hits shaded together by Light::ShadeBatch, a structure of arrays of count entries. The albedo
+//\ is looked up once per hit by the caller, texture and all, so every light shading the hits shares it.
+//\----------------------------------------------------------------------------------
+struct ShadingBatch
+{
+	int						count;
+	const float*			positionX;
+	const float*			positionY;
+	const float*			positionZ;
+	const float*			normalX;
+	const float*			normalY;
+	const float*			normalZ;
+	const float*			albedoR;
+	const float*			albedoG;
+	const float*			albedoB;
+	const int*				material;		// Index of each hit's material in materials
+	const Material* const*	materials;
+	int*					seeds;			// Random sequence of each hit, for lights that draw random numbers - nullptr to use the thread's own
+	Vector3					eyePosition;
+};
+
+// What a light gives each hit of a batch - its light sample, and the shading of it before any shadow
+struct LightBatchResult
+{
+	float*		directionX;
+	float*		directionY;
+	float*		directionZ;
+	float*		distance;
+	float*		colourR;
+	float*		colourG;
+	float*		colourB;
+
+	void Store(int a_index, const LightSample& a_sample) const
+	{
+		directionX[a_index] = a_sample.directionToLight.x;
+		directionY[a_index] = a_sample.directionToLight.y;
+		directionZ[a_index] = a_sample.directionToLight.z;
+		distance[a_index] = a_sample.distance;
+		colourR[a_index] = a_sample.colour.x;
+		colourG[a_index] = a_sample.colour.y;
+		colourB[a_index] = a_sample.colour.z;
+	}
+	LightSample Load(int a_index) const
+	{
+		LightSample sample;
+		sample.directionToLight = Vector3(directionX[a_index], directionY[a_index], directionZ[a_index]);
+		sample.distance = distance[a_index];
+		sample.colour = ColourRGB(colourR[a_index], colourG[a_index], colourB[a_index]);
+		return sample;
+	}
+};
+
 class Light
 {
 public: 
@@ -27,21 +90,37 @@ public:
 	//\----------------------------------------------------------------------------------
 	Light();
 	Light(const Matrix4& a_transform, const ColourRGB& a_colour);
+	Light(const AffineTransform& a_transform, const ColourRGB& a_colour);
 	virtual ~Light();
 
 	//\----------------------------------------------------------------------------------
 	//\ Lighting Functions
 	//\----------------------------------------------------------------------------------
-	// Type of light calculation for its own lighting outcome based off it's type
-	virtual ColourRGB calculateLighting(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, float a_shadowFactor = 1.0) const = 0;
+	// Type of light calculation for its own lighting outcome based off it's type - shades one sample of the light
+	virtual ColourRGB calculateLighting(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, float a_shadowFactor = 1.0) const;
 	// Function to get the direction to the light from a light origin (a_point)
 	virtual Vector3 GetDirectionToLight(const Vector3& a_point = Vector3(0.f, 0.f, 0.f)) const;
+	// Function to get the distance to the light from a_point - lights at infinity return the max float value
+	virtual float GetDistanceToLight(const Vector3& a_point) const;
+	// Pick a point on the light as seen from a_point - lights with an area return a different point each call
+	virtual LightSample SampleLight(const Vector3& a_point) const;
+	// Rough estimate of how much light this light adds to the scene - used to choose which lights to sample
+	virtual float EstimatePower() const;
+	// Ambient, diffuse and specular shading of a surface lit by a light sample
+	ColourRGB ShadeSample(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, const LightSample& a_sample, float a_shadowFactor = 1.0) const;
+	//\----------------------------------------------------------------------------------
+	//\ Sample the light and shade every hit of a_batch in one call - the results are the same bits SampleLight and
+	//\ ShadeSample give one hit at a time, but the shading is done four hits at a time with SSE
+	//\----------------------------------------------------------------------------------
+	void ShadeBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const;
 	
 	//\----------------------------------------------------------------------------------
 	// -- GETTERS AND SETTERS
 	//\----------------------------------------------------------------------------------
 	Matrix4 GetTransform() const;
 	void SetTransform(const Matrix4& a_m4);
+	const AffineTransform& GetAffineTransform() const { return m_Transform; }
+	void SetTransform(const AffineTransform& a_tx) { m_Transform = a_tx; }
 	//\----------------------------------------------------------------------------------
 	// Get and set the position of the light
 	Vector3 GetPosition() const;
@@ -52,7 +131,12 @@ public:
 	void SetColour(const ColourRGB& a_colour) { m_colourRGB = a_colour; }
 
 protected:
-	Matrix4 m_Transform;		// transform of the light
+	// Point the forward (z) axis of the transform along a_facing and build the other two axes around it
+	void SetFacing(const Vector3& a_facing);
+	// Fill in the light sample of every hit of a_batch, the colour unshaded - SampleLight once a hit unless a light does better
+	virtual void SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const;
+
+	AffineTransform m_Transform;		// transform of the light
 	ColourRGB m_colourRGB;		// Colour of the light
 
 };
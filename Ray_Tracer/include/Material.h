@@ -15,10 +15,12 @@
 //\------------------------
 //\ INCLUDES
 //\------------------------
-#include <mathLib.h>
+#include <MathLib.h>
 #include "IntersectionResponse.h"
 //\------------------------
 
+class Texture;
+
 //\===========================================================================================================
 //\ An abstract base material class
 //\===========================================================================================================
@@ -27,9 +29,9 @@ class Material
 {
 public:
 	Material(const Vector3& a_albedo, float a_ambient, float a_diffuse, float a_specular, float a_roughness, float a_reflective, float a_transparency, float a_refractiveIndex) :
-		m_albedo(a_albedo), m_ambient(a_ambient), m_diffuse(a_diffuse), m_specular(a_specular), m_roughness(a_roughness), m_reflective(a_reflective), m_transparency(a_transparency), m_refractiveIndex(a_refractiveIndex){};
+		m_albedo(a_albedo), m_ambient(a_ambient), m_diffuse(a_diffuse), m_specular(a_specular), m_roughness(a_roughness), m_reflective(a_reflective), m_transparency(a_transparency), m_refractiveIndex(a_refractiveIndex), m_albedoTexture(nullptr), m_textureRepeat(1.f){};
 
-	Material() : m_albedo(1.f, 1.f, 1.f), m_ambient(0.f), m_diffuse(0.f), m_specular(0.f), m_roughness(0.f), m_reflective(0.f), m_transparency(0.f), m_refractiveIndex(0.f) {};
+	Material() : m_albedo(1.f, 1.f, 1.f), m_ambient(0.f), m_diffuse(0.f), m_specular(0.f), m_roughness(0.f), m_reflective(0.f), m_transparency(0.f), m_refractiveIndex(0.f), m_albedoTexture(nullptr), m_textureRepeat(1.f) {};
 	~Material() {};
 
 	bool CalcReflection(const Ray& a_in, const IntersectResponse& a_ir, Ray& a_out) const;
@@ -40,6 +42,12 @@ public:
 	//\----------------------------------------------------------------------------------
 	const Vector3 GetAlbedo() { return m_albedo; }
 	void SetAlbedo(const Vector3& a_albedo) { m_albedo; }
+	// Albedo at a hit - the albedo colour times the albedo texture when there is one
+	Vector3 GetAlbedo(const IntersectResponse& a_ir) const;
+
+	// Texture the albedo colour is multiplied by, repeated a_repeat times across the surface's texture coordinates
+	void SetAlbedoTexture(const Texture* a_texture, float a_repeat = 1.f) { m_albedoTexture = a_texture; m_textureRepeat = a_repeat; }
+	const Texture* GetAlbedoTexture() const { return m_albedoTexture; }
 
 	const float& GetAmbient() const { return m_ambient; }
 	void SetAmbient(const float& a_ambient) { m_ambient = a_ambient; }
@@ -73,6 +81,8 @@ protected:
 	float m_reflective;						// reflectivity of a surface 0 -> 1.0
 	float m_transparency;					// transparency of the surface 0 -> 1
 	float m_refractiveIndex;				// refractive Index of the surface (how much light on entering/exiting a surface)
+	const Texture* m_albedoTexture;			// Optional texture for the albedo - not owned
+	float m_textureRepeat;					// Times the texture repeats across 0 -> 1 in texture coordinates
 	
 	// Refractive index of common materials.
 											/*	Water (ice) 	1.31
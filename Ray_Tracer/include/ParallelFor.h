@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				ParallelFor.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Runs a loop body over a range of indices on several threads. The indices are handed out one
+//						at a time from a shared counter so threads that finish early take the remaining work.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+//\------------------------
+
+namespace Parallel
+{
+	// Number of threads to use when none is asked for - one per hardware thread
+	inline int DefaultThreadCount()
+	{
+		return std::max(1, (int)std::thread::hardware_concurrency());
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Call a_body(index) once for every index in [0, a_count) on up to a_threads threads, 0 for the default.
+	//\ The calling thread does its share of the work and the call returns once every index is done.
+	//\----------------------------------------------------------------------------------
+	template<typename Body>
+	void For(int a_count, Body a_body, int a_threads = 0)
+	{
+		int threadCount = std::min(a_threads > 0 ? a_threads : DefaultThreadCount(), a_count);
+		if (threadCount <= 1)
+		{
+			for (int i = 0; i < a_count; ++i)
+			{
+				a_body(i);
+			}
+			return;
+		}
+
+		std::atomic<int> next(0);
+		auto work = [&]()
+		{
+			for (int i = next++; i < a_count; i = next++)
+			{
+				a_body(i);
+			}
+		};
+		std::vector<std::thread> threads;
+		threads.reserve(threadCount - 1);
+		for (int t = 1; t < threadCount; ++t)
+		{
+			threads.emplace_back(work);
+		}
+		work();
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+	}
+};
+
+#endif // !PARALLEL_FOR_H
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				PointLight.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A point light shines equally in all directions from the position of its transform. The light
+//						falls off with the square of the distance from the light.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef POINTLIGHT_H
+#define POINTLIGHT_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Light.h"
+//\------------------------
+
+class PointLight : public Light
+{
+public:
+	PointLight();
+	PointLight(const Vector3& a_position, const ColourRGB& a_colour, float a_intensity);
+	virtual ~PointLight();
+
+	// Override the base light class - the colour is scaled by intensity over distance squared
+	LightSample SampleLight(const Vector3& a_point) const override;
+	float EstimatePower() const override;
+
+	float GetIntensity() const { return m_intensity; }
+	void SetIntensity(float a_intensity) { m_intensity = a_intensity; }
+
+protected:
+	// The samples of four hits at a time with SSE
+	void SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const override;
+
+	float m_intensity;		// Brightness of the light at a distance of one unit
+};
+
+#endif // !POINTLIGHT_H
@@ -8,6 +8,7 @@
 //\
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef PRIMITIVE_H
+#define PRIMITIVE_H
 
 //\------------------------
 //\ INCLUDES
@@ -26,12 +27,24 @@ public:
 	//\====================================================================================================
 	Primitive();
 	virtual ~Primitive();
-	// Function to test for intersection and ray - pure virtual only implemented in derived classes
-	virtual  bool IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const = 0;
+	//\----------------------------------------------------------------------------------
+	//\ Intersection is split into two phases so that a scene only pays for the full hit record once
+	//\		IntersectDistance - cheap test returning only the distance to the nearest hit in front of the ray
+	//\		FinalizeHit		  - builds the position, normal and facing of a hit found by IntersectDistance
+	//\----------------------------------------------------------------------------------
+	virtual bool IntersectDistance(const Ray& a_ray, float& a_distance) const = 0;
+	virtual void FinalizeHit(const Ray& a_ray, float a_distance, IntersectResponse& a_intersectResponse) const = 0;
+	// Function to test for intersection and ray - performs both phases for a single primitive
+	bool IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const;
+	// World space box around the primitive - used to build the scene's bounding volume hierarchy
+	virtual AABB GetBounds() const = 0;
 
-	// Get and set primative matrix
+	// Get and set primative matrix - stored as an affine transform, Matrix4 versions convert
 	Matrix4 GetTransform() const;
 	void SetTransform(const Matrix4& a_m4);
+	const AffineTransform& GetAffineTransform() const { return m_Transform; }
+	const AffineTransform& GetInverseTransform() const { return m_InvTransform; }
+	void SetTransform(const AffineTransform& a_tx);
 
 	//Get and Set the position of the primative
 	Vector3 GetPosition() const;
@@ -47,10 +60,14 @@ public:
 
 	//Get and set the material for this primative
 	void SetMaterial(Material* a_material);
-	const Material* GetMaterial() { return m_material; }
+	const Material* GetMaterial() const { return m_material; }
 
 protected:
-	Matrix4 m_Transform;		// Position scale and Rotation
+	// Called after any change to the transform - for derived classes that cache values built from it
+	virtual void TransformChanged() {}
+
+	AffineTransform m_Transform;		// Position scale and Rotation
+	AffineTransform m_InvTransform;		// Cached inverse of the transform - updated whenever the transform changes
 	Vector3 m_Scale;			// Scale Vector
 	Matrix4 m_Shear;			// Shear matrix values
 	Material* m_material;		// Surface material for the primitive
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Regression.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Golden image and throughput checks run from the command line with --regress [directory].
+//						A fixed set of seeded scenes is rendered and each image is compared with the one stored in
+//						the directory, and each render speed with the speed recorded for it on this machine.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ColourRGB.h"
+//\------------------------
+
+namespace Regression
+{
+	//\----------------------------------------------------------------------------------
+	//\ How far a render may drift before the check fails. A build renders the same image every time, so the
+	//\ golden images belong to the compiler and settings that made them. The thresholds let through the odd pixel
+	//\ whose random path goes another way after a change in rounding, not a change to shading or sampling - a
+	//\ tenth off the diffuse of one sphere is caught by both the PSNR and the peak error.
+	//\----------------------------------------------------------------------------------
+	struct Thresholds
+	{
+		double	minPsnr = 45.0;				// Decibels, over the 8 bit displayed colours
+		double	maxMeanError = 0.005;		// Average of the perceptual error, 0 -> 1
+		double	maxPeakError = 0.02;		// The perceptual error 99% of the pixels must be under
+		double	maxSlowdown = 0.3;			// Part of the recorded rays a second a render may lose - well past the run to run noise
+	};
+
+	// How different an image is from its golden image
+	struct ImageDifference
+	{
+		double	psnr;						// Peak signal to noise ratio in decibels - infinite for the same image
+		double	meanError;					// Average of the perceptual error over the pixels
+		double	peakError;					// The perceptual error 99% of the pixels are under
+	};
+
+	//\----------------------------------------------------------------------------------
+	//\ Compare two images of display colours, clamped to 0 -> 1. The perceptual error follows FLIP - both images
+	//\ are blurred a little the way the eye blurs detail finer than it can see, then each pixel's difference is
+	//\ measured in an opponent colour space where a change of brightness counts for more than a change of hue.
+	//\----------------------------------------------------------------------------------
+	ImageDifference	Compare(const std::vector<ColourRGB>& a_image, const std::vector<ColourRGB>& a_golden, int a_width, int a_height);
+
+	//\----------------------------------------------------------------------------------
+	//\ Check the acceleration structures find the same hits as the linear search, then render the reference scenes
+	//\ and check them against the golden images in a_directory, writing a line for each to a_out. An image that has changed is written next to its golden image with _failed added to the
+	//\ name. The first run on a machine records the rays a second later runs are held to. Returns false if any
+	//\ check fails or a golden image is missing.
+	//\----------------------------------------------------------------------------------
+	bool			Run(const std::string& a_directory, const Thresholds& a_thresholds, std::ostream& a_out);
+	// Render the reference scenes and store them as the golden images and recorded speeds - after a change that
+	// is meant to change the images
+	bool			Update(const std::string& a_directory, std::ostream& a_out);
+};
+
+#endif // !REGRESSION_H
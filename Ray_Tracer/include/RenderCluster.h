@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				RenderCluster.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Splits a render across worker processes. The coordinator hands out tiles over TCP and puts
+//						the colours that come back into the image, workers render the tiles they are given. Every
+//						pixel has its own random sequence so the image matches a single process render exactly.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef RENDER_CLUSTER_H
+#define RENDER_CLUSTER_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ColourRGB.h"
+//\------------------------
+
+class Renderer;
+
+namespace RenderCluster
+{
+	//\----------------------------------------------------------------------------------
+	//\ Coordinator - renders the crop window of a_renderer with the example scene. a_localWorkers copies of
+	//\ a_executable are started as workers on this machine, workers on other machines can connect to a_port
+	//\ (0 picks a free port). A tile is handed out again when its worker disconnects, and is also given to an
+	//\ idle worker when it takes much longer than the tiles before it. Returns false when every local worker
+	//\ has exited before the image is finished.
+	//\----------------------------------------------------------------------------------
+	bool			RunCoordinator(const Renderer& a_renderer, const std::string& a_executable, int a_localWorkers, int a_port,
+								   std::vector<ColourRGB>& a_pixels, std::ostream& a_log);
+	// Worker - connect to the coordinator and render tiles until it says the job is done
+	bool			RunWorker(const std::string& a_host, int a_port, std::ostream& a_log);
+};
+
+#endif // !RENDER_CLUSTER_H
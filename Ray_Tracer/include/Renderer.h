@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Renderer.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Renders a scene into a pixel buffer and writes the buffer out as an image. Keeping the
+//						pixels in memory lets an animation write one frame while the next one is being rendered.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef RENDERER_H
+#define RENDERER_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ColourRGB.h"
+//\------------------------
+
+class Scene;
+struct AOVBuffers;
+struct AOVSample;
+class FrameBuffer;
+
+class Renderer
+{
+public:
+	Renderer(int a_width, int a_height, int a_raysPerPixel, int a_bounces = 15);
+	~Renderer();
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	int GetRaysPerPixel() const { return m_raysPerPixel; }
+	int GetBounces() const { return m_bounces; }
+
+	// Every pixel reseeds the random numbers from this seed and its own coordinates
+	void SetSeed(int a_seed) { m_seed = a_seed; }
+	int GetSeed() const { return m_seed; }
+	// Write the scanline progress to std::clog while rendering
+	void SetShowProgress(bool a_show) { m_showProgress = a_show; }
+
+	//\----------------------------------------------------------------------------------
+	//\ Crop window - only this rectangle of the full image is rendered and written. The camera still covers the
+	//\ full image and every pixel keeps its own random sequence, so crops merged together match a full render.
+	//\----------------------------------------------------------------------------------
+	void SetCropWindow(int a_x, int a_y, int a_width, int a_height);
+	void ClearCropWindow();
+	bool HasCropWindow() const { return m_cropWidth != m_width || m_cropHeight != m_height; }
+	int GetCropX() const { return m_cropX; }
+	int GetCropY() const { return m_cropY; }
+	int GetCropWidth() const { return m_cropWidth; }
+	int GetCropHeight() const { return m_cropHeight; }
+
+	// Render every pixel of the crop window into a_pixels - rows top to bottom, crop width * crop height colours.
+	// The output variables of the same pixels are filled in from the same rays when a_aovs is given.
+	void Render(const Scene& a_scene, std::vector<ColourRGB>& a_pixels, AOVBuffers* a_aovs = nullptr) const;
+	// Render into a frame buffer the size of the crop window - each finished row is converted to the buffer's format
+	// in one go, so only a row of full float colours is held at a time
+	void Render(const Scene& a_scene, FrameBuffer& a_frame, AOVBuffers* a_aovs = nullptr) const;
+	//\----------------------------------------------------------------------------------
+	//\ Render straight to a .ppm or .pfm file a band of a_bandRows rows at a time - each finished band is written
+	//\ to its place in the file while the next one renders, so only two bands are ever held in memory
+	//\----------------------------------------------------------------------------------
+	bool RenderToFile(const Scene& a_scene, const std::string& a_filename, int a_bandRows) const;
+	// Angle a pixel covers at the centre of the image - how fast the cone of a camera ray widens, for texture filtering
+	float GetPixelSpread(const Scene& a_scene) const;
+	// Average colour of a_raysPerPixel rays through pixel (a_x, a_y) of the full image - a_pixelSpread is GetPixelSpread,
+	// worked out once per render rather than for every pixel
+	ColourRGB RenderPixel(const Scene& a_scene, int a_x, int a_y, int a_raysPerPixel, float a_pixelSpread, AOVSample* a_aov = nullptr) const;
+	// Output variables of the crop window without the beauty pass, for pixels rendered somewhere else. Only primary
+	// rays are traced - a_raysPerPixel of them spread evenly down each pixel, the way the colour rays are jittered.
+	void RenderAOVs(const Scene& a_scene, AOVBuffers& a_aovs, int a_raysPerPixel = 4) const;
+	// Write the pixels as a plain text (P3) PPM image - a crop records where it belongs in a comment after the magic number
+	void WritePPM(std::ostream& a_out, const std::vector<ColourRGB>& a_pixels) const;
+	bool WritePPM(const std::string& a_filename, const std::vector<ColourRGB>& a_pixels) const;
+	void WritePPM(std::ostream& a_out, const FrameBuffer& a_frame) const;
+	bool WritePPM(const std::string& a_filename, const FrameBuffer& a_frame) const;
+	// Write the pixels in the format the extension of a_filename asks for - .pfm, .qoi and .png, PPM for anything else
+	bool WriteImage(const std::string& a_filename, const std::vector<ColourRGB>& a_pixels) const;
+	bool WriteImage(const std::string& a_filename, const FrameBuffer& a_frame) const;
+	// Write every output variable as its own image next to a_filename - out.ppm gets out_depth.ppm and the rest.
+	// A .pfm keeps the values themselves rather than colours to display them with.
+	bool WriteAOVs(const std::string& a_filename, const AOVBuffers& a_aovs) const;
+
+private:
+	int m_width;
+	int m_height;
+	int m_raysPerPixel;
+	int m_bounces;				// Maximum depth of the reflection and refraction rays
+	int m_seed;
+	bool m_showProgress;
+	int m_cropX;
+	int m_cropY;
+	int m_cropWidth;
+	int m_cropHeight;
+};
+
+#endif // !RENDERER_H
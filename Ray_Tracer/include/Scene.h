@@ -9,6 +9,7 @@
 //
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
 #ifndef SCENE_H
+#define SCENE_H
 
 //\------------------------
 //\ INCLUDES
@@ -16,15 +17,43 @@
 #include <vector>
 #include "MathLib.h"
 #include "IntersectionResponse.h"
+#include "AliasTable.h"
+#include "BVH.h"
+#include "UniformGrid.h"
 //\------------------------
 
 class Primitive;
 class Camera;
 class Light;
+class DependencySet;
+struct AOVSample;
+
+//\----------------------------------------------------------------------------------
+//\ Shadow occluder cache statistics - a hit is a shadow ray answered by the cached occluder alone
+//\----------------------------------------------------------------------------------
+struct ShadowCacheStats
+{
+	long long	shadowTests;			// Number of shadow rays tested
+	long long	cacheHits;				// Shadow rays blocked by the last occluder found for the same light
+	long long	occluded;				// Shadow rays blocked by anything
+};
 
 class Scene
 {
 public:
+	// How the lights are chosen at each hit
+	enum LightSelection
+	{
+		ALL_LIGHTS,			// Every light is shadow tested and shaded - cost grows with the number of lights
+		SAMPLED_LIGHTS,		// A fixed number of lights is picked in proportion to their estimated power
+	};
+	// What BuildAccelerationStructure builds
+	enum Acceleration
+	{
+		BOUNDING_VOLUME_HIERARCHY,	// Fastest to trace - refit when objects move, rebuilt with the surface area heuristic when that gets slow
+		UNIFORM_GRID,				// Built in linear time and updated an object at a time - for scenes where everything moves every frame
+	};
+
 	// Default constructors / destructor
 	Scene();
 	~Scene();
@@ -33,20 +62,67 @@ public:
 	void AddObject(const Primitive* a_object);
 	void RemoveObject(const Primitive* a_object);
 
+	// Build the bounding volume hierarchy over the objects in the scene - without one every ray tests every object.
+	// Adding or removing objects drops the hierarchy so it has to be built again afterwards.
+	void BuildAccelerationStructure();
+	// Refit the hierarchy after objects have moved - rebuilt from scratch instead when refitting has made it too slow
+	// compared to a fresh build. Returns true when it was rebuilt.
+	bool RefitAccelerationStructure();
+	// Tell the acceleration structure object a_objectIndex, in the order objects were added, has moved. The grid
+	// moves it to its new cells straight away, a hierarchy is left for RefitAccelerationStructure to refit.
+	void ObjectMoved(int a_objectIndex);
+	bool HasAccelerationStructure() const { return m_bvh.IsBuilt() || m_grid.IsBuilt(); }
+	// Choose the acceleration structure - one already built is replaced with the new kind
+	void SetAcceleration(Acceleration a_acceleration);
+	Acceleration GetAcceleration() const { return m_acceleration; }
+	// Box around every object in the scene
+	AABB GetBounds() const;
 
 	void AddLight(const Light* a_light);
 	void RemoveLight(const Light* a_light);
+	// Choose between shading every light or a_samplesPerHit sampled lights at each hit
+	void SetLightSelection(LightSelection a_mode, int a_samplesPerHit = 1);
+	// Rebuild the light sampling table - call after changing the colour or intensity of a light in the scene
+	void UpdateLightSampling();
+	// Number of lights shaded at each hit - every light, or the sample count when lights are sampled
+	int GetLightSamplesPerHit() const;
+	// Light for sample a_sample of a hit with its index, and the weight its shading is scaled by. Sampled lights use
+	// a random number, so calls must be made in the same order as CastRay makes them to get the same image.
+	const Light* ChooseLight(int a_sample, int& a_lightIndex, float& a_weight) const;
+	// Where shading is seen from
+	Vector3 GetEyePosition() const;
+	// Colour of the sky along a ray that hits nothing
+	static Vector3 SkyColour(const Ray& a_ray);
 
 	Ray GetScreenRay(const Vector2& a_screenSpacePos) const;
-	Vector3 CastRay(const const Ray& a_ray, int a_bounces, float currentIr = 1.0f) const;
+	// a_aov is filled in with what this ray hit - pass it for primary rays only, the rays this one spawns never fill it
+	Vector3 CastRay(const Ray& a_ray, int a_bounces, float currentIr = 1.0f, AOVSample* a_aov = nullptr) const;
 	// Intersection testing - returning true if an intersection occurs from the cameras ray and stored in the Intersection Response variable that is passed in by reference
 	bool IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const;
+	// Shadow test toward light number a_lightIndex - returns 1 when the light is not blocked, 0 when an opaque object
+	// blocks it and the transparency of the nearest occluder when only transparent objects are in the way
+	float ShadowTest(const Ray& a_shadowRay, int a_lightIndex) const;
+	// The two phases of IntersectTest - used by instances of this scene to find the nearest object before building its hit record
+	bool IntersectDistance(const Ray& a_ray, float& a_distance, int& a_objectIndex) const;
+	void FinalizeHit(const Ray& a_ray, float a_distance, int a_objectIndex, IntersectResponse& a_intersectResponse) const;
 
 	void SetCamera(Camera* a_pCamera) { m_pCamera = a_pCamera; }
 
+	// Shadow cache statistics summed over every thread that has rendered so far
+	static ShadowCacheStats GetShadowCacheStats();
+	static void ResetShadowCacheStats();
+	// Record every primitive and material the rays cast on this thread touch into a_dependencies, null to stop recording
+	static void SetDependencyRecorder(DependencySet* a_dependencies);
+
 private: 
 	std::vector<const Primitive*> m_objects;
 	std::vector<const Light* > m_lights;
+	BVH m_bvh;								// Built on request over m_objects
+	UniformGrid m_grid;						// Built in place of the hierarchy when the acceleration is UNIFORM_GRID
+	Acceleration m_acceleration;
+	AliasTable m_lightTable;				// Lights weighted by their estimated power
+	LightSelection m_lightSelection;
+	int m_lightSamplesPerHit;
 	Camera* m_pCamera;
 };
 #endif
\ No newline at end of file
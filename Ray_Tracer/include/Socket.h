@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Socket.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Minimal blocking TCP socket used by the render cluster - Winsock on Windows, BSD sockets
+//						everywhere else.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef SOCKET_H
+#define SOCKET_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+//\------------------------
+
+class Socket
+{
+public:
+#ifdef _WIN32
+	typedef std::uintptr_t Handle;		// Same as SOCKET - keeps the Winsock headers out of this one
+#else
+	typedef int Handle;
+#endif
+
+	Socket();
+	~Socket();
+	// A socket owns its connection so it can be moved but not copied
+	Socket(Socket&& a_other);
+	Socket& operator=(Socket&& a_other);
+	Socket(const Socket&) = delete;
+	Socket& operator=(const Socket&) = delete;
+
+	// Start the socket library - needed once per process on Windows, does nothing elsewhere
+	static bool Startup();
+
+	// Listen for connections on every interface - port 0 picks a free port, GetPort says which
+	bool Listen(int a_port);
+	int GetPort() const;
+	Socket Accept();
+	bool Connect(const std::string& a_host, int a_port);
+
+	// Send or receive exactly a_size bytes - false if the connection closed or failed first
+	bool SendAll(const void* a_data, size_t a_size);
+	bool ReceiveAll(void* a_data, size_t a_size);
+
+	void Close();
+	bool IsOpen() const;
+
+	// Wait up to a_timeoutMs for any of the sockets to have data (or a connection) waiting.
+	// a_readable is set per socket, returns false on error.
+	static bool WaitReadable(const std::vector<Socket*>& a_sockets, int a_timeoutMs, std::vector<bool>& a_readable);
+
+private:
+	Handle m_handle;
+};
+
+#endif // !SOCKET_H
@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				SpotLight.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A spot light is a point light that only shines inside a cone around its forward direction.
+//						Inside the inner angle the light is at full strength, it then fades out smoothly to the outer angle.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef SPOTLIGHT_H
+#define SPOTLIGHT_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "PointLight.h"
+//\------------------------
+
+class SpotLight : public PointLight
+{
+public:
+	SpotLight();
+	// Cone angles are the half angles in degrees from the direction of the light to the edge of the cone
+	SpotLight(const Vector3& a_position, const Vector3& a_direction, const ColourRGB& a_colour, float a_intensity, float a_innerAngle, float a_outerAngle);
+	virtual ~SpotLight();
+
+	// Override the point light - the colour is also scaled by the cone falloff
+	LightSample SampleLight(const Vector3& a_point) const override;
+	float EstimatePower() const override;
+
+	// Functionality to set and get the direction of the light
+	void SetDirection(const Vector3& a_direction) { SetFacing(a_direction); }
+	Vector3 GetDirection() const { return m_Transform.GetColumn(2); }
+	void SetConeAngles(float a_innerAngle, float a_outerAngle);
+
+protected:
+	// The point light's batch with the cone falloff applied after
+	void SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const override;
+
+	float m_cosInner;		// Cosine of the inner cone half angle
+	float m_cosOuter;		// Cosine of the outer cone half angle
+};
+
+#endif // !SPOTLIGHT_H
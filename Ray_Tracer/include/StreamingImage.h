@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				StreamingImage.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				An image file written a band of rows at a time for frames too large to hold in memory.
+//						Every pixel has a fixed size in the file, so each band is written straight to its final
+//						offset with a positional write and bands can arrive in any order.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef STREAMINGIMAGE_H
+#define STREAMINGIMAGE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cstddef>
+#include <string>
+
+#include "ColourRGB.h"
+#include "ImageOutput.h"
+//\------------------------
+
+class StreamingImage
+{
+public:
+#ifdef _WIN32
+	typedef void* Handle;				// Same as HANDLE - keeps windows.h out of this header
+#else
+	typedef int Handle;
+#endif
+
+	StreamingImage();
+	~StreamingImage();
+	// An image owns its file so it cannot be copied
+	StreamingImage(const StreamingImage&) = delete;
+	StreamingImage& operator=(const StreamingImage&) = delete;
+
+	//\----------------------------------------------------------------------------------
+	//\ Only formats with a fixed number of bytes a pixel can be streamed - PFM, and PPM which is written as
+	//\ binary (P6) rather than text so every row starts at a known offset
+	//\----------------------------------------------------------------------------------
+	static bool CanStream(ImageOutput::Format a_format);
+
+	// Create the file at its full size with the header written - a_comment goes on a line of its own in a PPM header
+	bool Open(const std::string& a_filename, int a_width, int a_height, const std::string& a_comment = "");
+	// Write a_rowCount whole rows starting at row a_y, top to bottom. Different rows can be written from several
+	// threads at once.
+	bool WriteRows(int a_y, int a_rowCount, const ColourRGB* a_pixels);
+	bool Close();
+	bool IsOpen() const;
+
+	ImageOutput::Format GetFormat() const { return m_format; }
+	unsigned long long GetFileSize() const;
+
+private:
+	bool WriteAt(unsigned long long a_offset, const void* a_data, size_t a_size);
+
+	Handle m_handle;
+	ImageOutput::Format m_format;
+	int m_width;
+	int m_height;
+	size_t m_headerSize;
+	size_t m_rowSize;
+};
+
+#endif // !STREAMINGIMAGE_H
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Texture.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				An image texture kept on disk as a pyramid of mip levels cut into square tiles. Only the header
+//						is held in memory - texels are fetched a tile at a time through a TextureCache, and each
+//						lookup reads the mip level that matches how much of the texture the ray's footprint covers.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef TEXTURE_H
+#define TEXTURE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <string>
+#include <vector>
+#include <MathLib.h>
+
+#include "ColourRGB.h"
+#include "TextureCache.h"
+//\------------------------
+
+class Texture
+{
+public:
+#ifdef _WIN32
+	typedef void* Handle;				// Same as HANDLE - keeps windows.h out of this header
+#else
+	typedef int Handle;
+#endif
+	static const int DEFAULT_TILE_SIZE = 64;
+
+	Texture();
+	~Texture();
+	// A texture owns its file so it cannot be copied
+	Texture(const Texture&) = delete;
+	Texture& operator=(const Texture&) = delete;
+
+	//\----------------------------------------------------------------------------------
+	//\ Build the tiled file for an image - the mip levels are made by halving the image with a box filter until
+	//\ it is one texel. The whole image is loaded to do this, it is the step before rendering that makes the
+	//\ rendering side cheap. The image can be a .ppm (plain or binary) or a .pfm.
+	//\----------------------------------------------------------------------------------
+	static bool CreateTiled(const std::string& a_imageFilename, const std::string& a_tiledFilename, int a_tileSize = DEFAULT_TILE_SIZE);
+	static bool CreateTiled(const std::vector<ColourRGB>& a_pixels, int a_width, int a_height, const std::string& a_tiledFilename,
+		int a_tileSize = DEFAULT_TILE_SIZE);
+	// Read a .ppm or .pfm into a_pixels, rows top to bottom
+	static bool LoadImage(const std::string& a_filename, std::vector<ColourRGB>& a_pixels, int& a_width, int& a_height);
+
+	// Open a tiled file made by CreateTiled - its tiles go through a_cache, or the shared cache when it is null
+	bool Open(const std::string& a_tiledFilename, TextureCache* a_cache = nullptr);
+	void Close();
+	bool IsOpen() const;
+
+	//\----------------------------------------------------------------------------------
+	//\ Colour at a_uv, repeating outside 0 -> 1. a_footprint is the width of the area to filter over in texture
+	//\ coordinates - it picks the pair of mip levels to read and blend, each read with bilinear filtering.
+	//\----------------------------------------------------------------------------------
+	ColourRGB Sample(const Vector2& a_uv, float a_footprint) const;
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	int GetLevelCount() const { return (int)m_levels.size(); }
+	int GetTileSize() const { return m_tileSize; }
+	// Unique for the life of the program - the cache tells textures apart by it
+	int GetID() const { return m_id; }
+	// Memory every tile of every level would take if the texture were loaded whole
+	size_t GetFullSize() const;
+
+	// Read one tile from the file - called by the cache when the tile is not loaded
+	bool LoadTile(int a_level, int a_tileX, int a_tileY, std::vector<unsigned short>& a_texels) const;
+
+private:
+	struct Level
+	{
+		int width;
+		int height;
+		int tilesX;
+		int tilesY;
+		unsigned long long offset;			// Where the level's first tile starts in the file
+	};
+
+	ColourRGB Bilinear(int a_level, const Vector2& a_uv) const;
+	bool ReadAt(unsigned long long a_offset, void* a_data, size_t a_size) const;
+
+	Handle m_handle;
+	TextureCache* m_cache;
+	int m_id;
+	int m_width;
+	int m_height;
+	int m_tileSize;
+	std::vector<Level> m_levels;
+};
+
+#endif // !TEXTURE_H
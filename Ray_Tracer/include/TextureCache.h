@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				TextureCache.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A fixed size cache of texture tiles shared by every render thread. Tiles are read from their
+//						texture's file the first time they are looked up and the least recently used tiles are
+//						dropped to stay inside the memory budget, so textures far larger than memory can be used.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+//\------------------------
+
+class Texture;
+
+// One square tile of one mip level - RGB half floats, rows top to bottom
+struct TextureTile
+{
+	std::vector<unsigned short> texels;
+};
+
+//\----------------------------------------------------------------------------------
+//\ Cache statistics - a hit is a lookup answered without reading the texture's file
+//\----------------------------------------------------------------------------------
+struct TextureCacheStats
+{
+	long long	lookups;				// Tile lookups
+	long long	hits;					// Lookups that found the tile already loaded
+	long long	tilesLoaded;			// Tiles read from disk
+	long long	evictions;				// Tiles dropped to make room
+	size_t		residentBytes;			// Memory held by the tiles in the cache now
+	size_t		peakResidentBytes;		// Most memory the tiles have held at once
+	size_t		capacityBytes;			// The budget
+};
+
+class TextureCache
+{
+public:
+	typedef std::shared_ptr<const TextureTile> TilePtr;
+
+	explicit TextureCache(size_t a_capacityBytes = DEFAULT_CAPACITY);
+	~TextureCache();
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	// The cache textures use when they are not given one of their own
+	static TextureCache& Shared();
+	static const size_t DEFAULT_CAPACITY = (size_t)64 << 20;
+
+	// Change the budget - tiles are dropped straight away when the cache holds more than the new budget
+	void SetCapacity(size_t a_capacityBytes);
+	size_t GetCapacity() const { return m_capacity; }
+
+	//\----------------------------------------------------------------------------------
+	//\ The tile at a_tileX, a_tileY of mip level a_level, loaded from a_texture's file if it is not in the cache.
+	//\ The tile stays valid for as long as the pointer is held even if the cache drops it meanwhile. Null if the
+	//\ tile could not be read.
+	//\----------------------------------------------------------------------------------
+	TilePtr GetTile(const Texture& a_texture, int a_level, int a_tileX, int a_tileY);
+
+	// Drop every tile
+	void Clear();
+	TextureCacheStats GetStats() const;
+	void ResetStats();
+
+private:
+	// The cache is split into shards with a lock each so threads looking up different tiles rarely wait on each other
+	static const int SHARD_COUNT = 16;
+
+	struct Entry
+	{
+		unsigned long long key;
+		TilePtr tile;
+		size_t bytes;
+	};
+	struct Shard
+	{
+		mutable std::mutex mutex;
+		std::list<Entry> entries;			// Most recently used first
+		std::unordered_map<unsigned long long, std::list<Entry>::iterator> index;
+		size_t bytes = 0;
+		long long lookups = 0;
+		long long hits = 0;
+		long long tilesLoaded = 0;
+		long long evictions = 0;
+	};
+
+	// Drop the least recently used tiles of a_shard until it fits its share of the budget - the shard must be locked
+	void Evict(Shard& a_shard);
+	void AddResident(long long a_bytes);
+
+	Shard m_shards[SHARD_COUNT];
+	std::atomic<size_t> m_capacity;
+	std::atomic<size_t> m_residentBytes;
+	std::atomic<size_t> m_peakResidentBytes;
+};
+
+#endif // !TEXTURECACHE_H
@@ -0,0 +1,224 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				UniformGrid.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Uniform grid over the primitives of a scene for scenes where everything moves every frame.
+//						The build is a parallel counting sort of the objects into cells, linear in the object count,
+//						and a moved object is taken out of the cells it left and put in the ones it now covers without
+//						touching the rest. Rays walk the cells they pass through in order with a 3D-DDA.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef UNIFORM_GRID_H
+#define UNIFORM_GRID_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <MathLib.h>
+//\------------------------
+
+class Primitive;
+
+class UniformGrid
+{
+public:
+	UniformGrid();
+	~UniformGrid();
+
+	// Build the grid over a_objects on up to a_threads threads, 0 for one per core - the vector is referenced, not
+	// copied, and must not change until the next Build or Clear
+	void Build(const std::vector<const Primitive*>& a_objects, int a_threads = 0);
+	// Move object a_objectIndex to the cells its bounds cover now. An object that has left the grid is tested by
+	// every ray until the next build.
+	void Update(int a_objectIndex);
+	// Update every object
+	void Refit();
+	void Clear();
+	bool IsBuilt() const { return m_objects != nullptr; }
+
+	// Box the cells cover, fixed at the build
+	AABB GetBounds() const { return m_bounds; }
+	int GetCellCount() const { return m_resolution[0] * m_resolution[1] * m_resolution[2]; }
+	// Objects that have moved outside the box since the build
+	int GetOutsideCount() const { return m_outsideCount; }
+	// Cell entries that did not fit in the space the build gave the cell and went on its overflow list
+	int GetOverflowCount() const { return (int)m_overflow.size() - m_freeOverflowCount; }
+	int GetEntryCount() const { return (int)m_entries.size(); }
+
+	// Nearest primitive hit by the ray between its min and max lengths
+	bool IntersectNearest(const Ray& a_ray, float& a_distance, int& a_objectIndex) const;
+	//\----------------------------------------------------------------------------------
+	//\ Visit every primitive in the cells the ray passes through before a_maxDistance, in no particular order.
+	//\ a_visit(objectIndex) returns true to stop the traversal early.
+	//\----------------------------------------------------------------------------------
+	template<typename Visitor>
+	void VisitCandidates(const Ray& a_ray, float a_maxDistance, Visitor a_visit) const;
+
+private:
+	// Where an object is kept - the large and outside ones are in the global list
+	enum Placement
+	{
+		IN_CELLS,
+		LARGE,				// Far bigger than the other objects or the cells, set at the build and kept
+		OUTSIDE,			// Moved out of the box since the build
+	};
+	// The cells an object covers, min and max inclusive
+	struct CellRange
+	{
+		int			min[3];
+		int			max[3];
+		Placement	placement;
+	};
+	// An entry of a cell past the space the build gave it
+	struct Overflow
+	{
+		int		object;
+		int		next;			// Next entry of the same cell, -1 at the end
+	};
+
+	CellRange RangeOf(const AABB& a_bounds) const;
+	int CellIndex(int a_x, int a_y, int a_z) const { return (a_z * m_resolution[1] + a_y) * m_resolution[0] + a_x; }
+	void Insert(int a_objectIndex, const CellRange& a_range);
+	void Remove(int a_objectIndex, const CellRange& a_range);
+
+	//\----------------------------------------------------------------------------------
+	//\ Walk the cells along the ray with the 3D-DDA, first calling a_visit for the global objects. a_maxDistance
+	//\ is read after every cell, so a visitor can shorten it as it finds hits and the walk stops at the first cell
+	//\ that starts past it. An object covering several cells is seldom visited more than once.
+	//\----------------------------------------------------------------------------------
+	template<typename Visitor>
+	void Walk(const Ray& a_ray, const float& a_maxDistance, Visitor a_visit) const;
+
+	const std::vector<const Primitive*>* m_objects;
+	AABB m_bounds;
+	int m_resolution[3];
+	Vector3 m_cellSize;
+	Vector3 m_invCellSize;
+	std::vector<int> m_cellStart;				// First entry of each cell, with one more for the end of the last
+	std::vector<int> m_cellCount;				// Entries in use from the start of each cell
+	std::vector<int> m_entries;					// Object indices, each cell owns a contiguous range
+	std::vector<int> m_overflowHead;			// First overflow entry of each cell, -1 for none
+	std::vector<Overflow> m_overflow;
+	int m_freeOverflow;							// Head of the list of overflow entries free for reuse
+	int m_freeOverflowCount;
+	std::vector<CellRange> m_ranges;			// Cells of each object as of its last build or update
+	std::vector<int> m_global;					// Objects tested by every ray - too big for the cells, or outside them
+	std::vector<int> m_globalSlot;				// Where each object is in m_global, -1 when it is in cells
+	int m_outsideCount;
+};
+
+template<typename Visitor>
+void UniformGrid::Walk(const Ray& a_ray, const float& a_maxDistance, Visitor a_visit) const
+{
+	for (int object : m_global)
+	{
+		if (a_visit(object))
+		{
+			return;
+		}
+	}
+
+	// The unit direction, so the distances along the ray are world distances like the ones the primitives return
+	const Vector3 origin = a_ray.Origin();
+	const Vector3 direction = Normalize(a_ray.Direction());
+	const Vector3 invDirection(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+	float entry = 0.f;
+	if (m_cellStart.empty() || !m_bounds.IntersectRay(origin, invDirection, a_maxDistance, entry))
+	{
+		return;
+	}
+
+	// The cell the ray enters by, and the distance along the ray to the next boundary on each axis
+	const float originAxis[3] = { origin.x, origin.y, origin.z };
+	const float directionAxis[3] = { direction.x, direction.y, direction.z };
+	const float invDirectionAxis[3] = { invDirection.x, invDirection.y, invDirection.z };
+	const float boundsMin[3] = { m_bounds.min.x, m_bounds.min.y, m_bounds.min.z };
+	const float cellSize[3] = { m_cellSize.x, m_cellSize.y, m_cellSize.z };
+	const float invCellSize[3] = { m_invCellSize.x, m_invCellSize.y, m_invCellSize.z };
+	int cell[3];
+	int step[3];
+	float next[3];
+	float delta[3];
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		const float position = originAxis[axis] + directionAxis[axis] * entry;
+		cell[axis] = std::min(std::max((int)((position - boundsMin[axis]) * invCellSize[axis]), 0), m_resolution[axis] - 1);
+		if (directionAxis[axis] == 0.f)
+		{
+			step[axis] = 0;
+			next[axis] = std::numeric_limits<float>::infinity();
+			delta[axis] = std::numeric_limits<float>::infinity();
+			continue;
+		}
+		step[axis] = directionAxis[axis] > 0.f ? 1 : -1;
+		const float boundary = boundsMin[axis] + (float)(cell[axis] + (step[axis] > 0 ? 1 : 0)) * cellSize[axis];
+		next[axis] = (boundary - originAxis[axis]) * invDirectionAxis[axis];
+		delta[axis] = cellSize[axis] * std::fabs(invDirectionAxis[axis]);
+	}
+
+	// The last few objects visited - an object in several cells along the ray is usually still in here
+	int recent[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+	int recentNext = 0;
+	auto visitOnce = [&](int a_object)
+	{
+		for (int seen : recent)
+		{
+			if (seen == a_object)
+			{
+				return false;
+			}
+		}
+		recent[recentNext] = a_object;
+		recentNext = (recentNext + 1) & 7;
+		return a_visit(a_object);
+	};
+
+	while (true)
+	{
+		const int index = CellIndex(cell[0], cell[1], cell[2]);
+		const int start = m_cellStart[index];
+		for (int i = start; i < start + m_cellCount[index]; ++i)
+		{
+			if (visitOnce(m_entries[i]))
+			{
+				return;
+			}
+		}
+		for (int o = m_overflowHead[index]; o >= 0; o = m_overflow[o].next)
+		{
+			if (visitOnce(m_overflow[o].object))
+			{
+				return;
+			}
+		}
+
+		// Step across the nearest boundary - every axis with no direction has an infinite distance to it
+		const int axis = (next[0] < next[1]) ? (next[0] < next[2] ? 0 : 2) : (next[1] < next[2] ? 1 : 2);
+		if (step[axis] == 0 || next[axis] > a_maxDistance)
+		{
+			return;
+		}
+		cell[axis] += step[axis];
+		if (cell[axis] < 0 || cell[axis] >= m_resolution[axis])
+		{
+			return;
+		}
+		next[axis] += delta[axis];
+	}
+}
+
+template<typename Visitor>
+void UniformGrid::VisitCandidates(const Ray& a_ray, float a_maxDistance, Visitor a_visit) const
+{
+	if (IsBuilt())
+	{
+		Walk(a_ray, a_maxDistance, a_visit);
+	}
+}
+
+#endif // !UNIFORM_GRID_H
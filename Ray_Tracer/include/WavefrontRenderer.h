@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				WavefrontRenderer.h
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Renders the same image as Renderer breadth first - a large wave of paths is moved through
+//						separate stages instead of tracing one ray at a time to the bottom of its recursion. Each
+//						stage is a loop over arrays of one kind of data, run across every core, so intersection,
+//						shading and shadow code each get the caches to themselves while they run.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef WAVEFRONT_RENDERER_H
+#define WAVEFRONT_RENDERER_H
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <vector>
+
+#include "ColourRGB.h"
+//\------------------------
+
+class AABB;
+class Ray;
+class Renderer;
+class Scene;
+class Material;
+
+//\----------------------------------------------------------------------------------
+//\ Time spent in each stage over a render
+//\----------------------------------------------------------------------------------
+struct WavefrontStageTimes
+{
+	double	generateMs;				// Camera rays for every path of the wave
+	double	extendMs;				// Nearest hit of every live path
+	double	shadeMs;				// Misses shaded, hits lit and their reflected and refracted rays made, grouped by material
+	double	connectMs;				// Shadow rays toward the lights
+	double	compactMs;				// Finished paths dropped from the queue and queued reflections started
+	double	sortMs;					// Secondary rays put in order before they are extended
+	double	secondaryExtendMs;		// The part of extendMs spent on rays after the first hit
+	long long extensions;			// Rays traced to their nearest hit
+	long long secondaryExtensions;	// The part of extensions after the first hit
+	long long shadowRays;			// Shadow rays traced
+};
+
+class WavefrontRenderer
+{
+public:
+	// The order live paths are extended in after the first hit
+	enum RayOrder
+	{
+		MATERIAL_ORDER,		// As the shading stage left them - grouped by the material they left
+		MORTON_ORDER,		// Sorted by direction octant, then by a Morton code of the origin within the scene
+	};
+
+	//\----------------------------------------------------------------------------------
+	//\ Uses the size, crop window, rays per pixel, bounces and seed of a_renderer. A wave holds about
+	//\ a_waveSize paths - whole pixels of them - and every stage runs on a_threads threads, 0 for one per core.
+	//\----------------------------------------------------------------------------------
+	WavefrontRenderer(const Renderer& a_renderer, int a_waveSize = 1 << 18, int a_threads = 0);
+	~WavefrontRenderer();
+
+	//\----------------------------------------------------------------------------------
+	//\ Render the crop window into a_pixels, rows top to bottom. Shading matches Scene::CastRay but each path has
+	//\ its own random sequence, so the noise is different from Renderer::Render while the image it converges to
+	//\ is the same. A hit that both reflects and refracts carries on as the refracted ray and starts a new path
+	//\ for the reflected one, each weighted the way CastRay blends their colours.
+	//\----------------------------------------------------------------------------------
+	void Render(const Scene& a_scene, std::vector<ColourRGB>& a_pixels);
+
+	const WavefrontStageTimes& GetStageTimes() const { return m_times; }
+
+	//\----------------------------------------------------------------------------------
+	//\ Sorting the secondary rays puts rays that start close together and head the same way next to each other,
+	//\ so consecutive traversals visit the same nodes and objects. Pays off when the bounces are incoherent and the
+	//\ scene is too big for the cache - the image is the same either way.
+	//\----------------------------------------------------------------------------------
+	void SetRayOrder(RayOrder a_order) { m_rayOrder = a_order; }
+	RayOrder GetRayOrder() const { return m_rayOrder; }
+	// The sort key of a ray - the octant of a_direction in 3 bits above a 30 bit Morton code of a_origin in a
+	// 1024 cell grid over a_bounds. Origins outside the bounds go in the nearest cell.
+	static unsigned long long RayOrderKey(const Vector3& a_origin, const Vector3& a_direction, const AABB& a_bounds);
+	// Fill a_order with the indices of a_rays in key order, the grid over the bounds of their origins
+	static void SortRays(const std::vector<Ray>& a_rays, std::vector<int>& a_order);
+
+private:
+	// Generate the paths for pixels [a_firstPixel, a_firstPixel + a_pixelCount) of the crop window
+	void Generate(const Scene& a_scene, int a_firstPixel, int a_pixelCount);
+	void Extend(const Scene& a_scene, bool a_secondary);
+	void SortRays();
+	void Shade(const Scene& a_scene);
+	void Connect(const Scene& a_scene);
+	void Compact();
+	// Point path a_path along a_ray, carrying a_weight of its colour to the pixel
+	void SetPathRay(int a_path, const Ray& a_ray, float a_weight, float a_refractiveIndex);
+	// Make room for a_count paths - the hits and shadow slots grow with them
+	void GrowPaths(size_t a_count);
+
+	const Renderer& m_renderer;
+	int m_waveSize;
+	int m_threads;
+	RayOrder m_rayOrder;
+	WavefrontStageTimes m_times;
+
+	//\----------------------------------------------------------------------------------
+	//\ Path state, one entry per path of the wave - a structure of arrays so each stage only pulls the
+	//\ fields it uses through the cache
+	//\----------------------------------------------------------------------------------
+	struct Paths
+	{
+		std::vector<float> originX, originY, originZ;
+		std::vector<float> directionX, directionY, directionZ;
+		std::vector<float> minLength;			// Start of the ray - secondary rays start just off the surface
+		std::vector<float> coneWidth, coneSpread;	// The ray's cone, for texture filtering
+		std::vector<float> weight;				// What the colour this path finds is scaled by on its way to the pixel
+		std::vector<float> refractiveIndex;		// Of the medium the ray is travelling through
+		std::vector<int> bounces;				// Bounces left, the same count CastRay is called with
+		std::vector<int> seed;					// State of the path's own random sequence
+		std::vector<float> radianceR, radianceG, radianceB;		// Colour found so far
+		std::vector<unsigned char> alive;
+		std::vector<int> sample;				// The camera sample a path started for a reflection adds its colour to
+		std::vector<unsigned int> branch;		// A bit for each reflection split off on the way from the camera, by bounces left
+
+		void Resize(size_t a_count);
+	};
+
+	// Nearest hit of each path, filled in by the extend stage
+	struct Hits
+	{
+		std::vector<int> object;				// -1 for a miss
+		std::vector<float> distance;
+		std::vector<float> positionX, positionY, positionZ;
+		std::vector<float> normalX, normalY, normalZ;
+		std::vector<float> u, v, uvPerUnit, footprint;
+		std::vector<unsigned char> frontFace;
+		std::vector<Material*> material;
+
+		void Resize(size_t a_count);
+	};
+
+	// A fixed number of slots per path, one for each light shaded at a hit - light -1 marks an empty slot
+	struct ShadowRays
+	{
+		std::vector<float> directionX, directionY, directionZ;
+		std::vector<float> maxDistance;
+		std::vector<int> light;
+		std::vector<float> colourR, colourG, colourB;	// Shading the light adds if nothing blocks it, path weight included
+
+		void Resize(size_t a_count);
+	};
+
+	// The reflected ray of each hit that also refracts, queued by the shading stage for a path of its own
+	struct Branches
+	{
+		std::vector<float> originX, originY, originZ;
+		std::vector<float> directionX, directionY, directionZ;
+		std::vector<float> minLength;
+		std::vector<float> coneWidth, coneSpread;
+		std::vector<float> weight;
+		std::vector<float> refractiveIndex;
+		std::vector<int> seed;
+		std::vector<unsigned char> queued;
+
+		void Resize(size_t a_count);
+	};
+
+	Paths m_paths;
+	Hits m_hits;
+	ShadowRays m_shadows;
+	Branches m_branches;
+	int m_sampleCount;							// Paths below this are the camera samples of the wave, the rest are branches
+	std::vector<int> m_freePaths;				// Branch paths free for reuse
+	int m_shadowSlots;							// Shadow ray slots per path
+	std::vector<int> m_active;					// Live paths, in the order the stages visit them
+	std::vector<int> m_shadeOrder;				// Paths that hit something, grouped by material
+	std::vector<int> m_shadeMaterial;			// The material group of each entry of m_shadeOrder
+	std::vector<int> m_scratch;
+	std::vector<unsigned long long> m_sortKeys;
+	std::vector<unsigned long long> m_sortScratch;
+};
+
+#endif // !WAVEFRONT_RENDERER_H
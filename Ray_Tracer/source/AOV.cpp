@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				AOV.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Arbitrary output variables - what the primary ray of each pixel hit, kept alongside the
+//						beauty pass for compositing and to guide the denoiser. Scene::CastRay fills them in from the
+//						hit it has already found, so they cost a few copies per ray rather than a render each.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cmath>
+#include <Random.h>
+
+#include "AOV.h"
+#include "Material.h"
+//\------------------------
+
+void AOVBuffers::Resize(size_t a_pixelCount)
+{
+	position.resize(a_pixelCount);
+	normal.resize(a_pixelCount);
+	albedo.resize(a_pixelCount);
+	depth.resize(a_pixelCount);
+	primitiveID.resize(a_pixelCount);
+}
+
+void AOVBuffers::Set(size_t a_pixel, const AOVSample& a_sample)
+{
+	position[a_pixel] = a_sample.position;
+	normal[a_pixel] = a_sample.normal;
+	albedo[a_pixel] = a_sample.albedo;
+	depth[a_pixel] = a_sample.depth;
+	primitiveID[a_pixel] = a_sample.primitiveID;
+}
+
+AOVSample AOV::FromHit(const Ray& a_ray, const IntersectResponse& a_ir)
+{
+	return AOVSample{ a_ir.HitPos, a_ir.SurfaceNormal, a_ir.material->GetAlbedo(a_ir), (a_ir.HitPos - a_ray.Origin()).Length(), a_ir.primitiveID };
+}
+
+AOVSample AOV::Miss()
+{
+	return AOVSample{ Vector3(0.f, 0.f, 0.f), Vector3(0.f, 0.f, 0.f), Vector3(1.f, 1.f, 1.f), 0.f, -1 };
+}
+
+const char* AOV::ChannelName(Channel a_channel)
+{
+	switch (a_channel)
+	{
+	case POSITION:		return "position";
+	case NORMAL:		return "normal";
+	case ALBEDO:		return "albedo";
+	case DEPTH:			return "depth";
+	case PRIMITIVE_ID:	return "id";
+	default:			return "unknown";
+	}
+}
+
+std::string AOV::ChannelFilename(const std::string& a_filename, Channel a_channel)
+{
+	size_t extension = a_filename.find_last_of('.');
+	if (extension == std::string::npos)
+	{
+		return a_filename + "_" + ChannelName(a_channel);
+	}
+	return a_filename.substr(0, extension) + "_" + ChannelName(a_channel) + a_filename.substr(extension);
+}
+
+void AOV::ToColours(const AOVBuffers& a_buffers, Channel a_channel, std::vector<ColourRGB>& a_colours)
+{
+	const size_t pixelCount = a_buffers.Size();
+	a_colours.resize(pixelCount);
+	switch (a_channel)
+	{
+	case POSITION:
+		{
+			float scale = 0.f;
+			for (const Vector3& position : a_buffers.position)
+			{
+				scale = std::max(scale, std::max(std::abs(position.x), std::max(std::abs(position.y), std::abs(position.z))));
+			}
+			scale = scale > 0.f ? 0.5f / scale : 0.f;
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				a_colours[i] = a_buffers.position[i] * scale + 0.5f;
+			}
+			break;
+		}
+	case NORMAL:
+		{
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				a_colours[i] = a_buffers.normal[i] * 0.5f + 0.5f;
+			}
+			break;
+		}
+	case ALBEDO:
+		{
+			a_colours = a_buffers.albedo;
+			break;
+		}
+	case DEPTH:
+		{
+			// Near is bright, the sky is black
+			float farthest = 0.f;
+			for (float depth : a_buffers.depth)
+			{
+				farthest = std::max(farthest, depth);
+			}
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				float depth = a_buffers.depth[i];
+				float value = (depth > 0.f) ? 1.f - 0.9f * depth / farthest : 0.f;
+				a_colours[i] = ColourRGB(value, value, value);
+			}
+			break;
+		}
+	case PRIMITIVE_ID:
+		{
+			// The same ID always hashes to the same colour, so IDs keep their colour from frame to frame
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				int id = a_buffers.primitiveID[i];
+				if (id < 0)
+				{
+					a_colours[i] = ColourRGB(0.f, 0.f, 0.f);
+					continue;
+				}
+				unsigned int hash = (unsigned int)Random::HashSeed(id, 0, 0);
+				a_colours[i] = ColourRGB((float)(hash & 0xff), (float)((hash >> 8) & 0xff), (float)((hash >> 16) & 0xff)) * (1.f / 255.f);
+			}
+			break;
+		}
+	default:
+		{
+			std::fill(a_colours.begin(), a_colours.end(), ColourRGB(0.f, 0.f, 0.f));
+			break;
+		}
+	}
+}
+
+void AOV::ToValues(const AOVBuffers& a_buffers, Channel a_channel, std::vector<ColourRGB>& a_values)
+{
+	const size_t pixelCount = a_buffers.Size();
+	switch (a_channel)
+	{
+	case POSITION:	a_values = a_buffers.position; break;
+	case NORMAL:	a_values = a_buffers.normal; break;
+	case ALBEDO:	a_values = a_buffers.albedo; break;
+	case DEPTH:
+		{
+			a_values.resize(pixelCount);
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				a_values[i] = ColourRGB(a_buffers.depth[i], a_buffers.depth[i], a_buffers.depth[i]);
+			}
+			break;
+		}
+	case PRIMITIVE_ID:
+		{
+			a_values.resize(pixelCount);
+			for (size_t i = 0; i < pixelCount; ++i)
+			{
+				float id = (float)a_buffers.primitiveID[i];
+				a_values[i] = ColourRGB(id, id, id);
+			}
+			break;
+		}
+	default:
+		{
+			a_values.assign(pixelCount, ColourRGB(0.f, 0.f, 0.f));
+			break;
+		}
+	}
+}
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				AliasTable.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Walker's alias method - picks an index with probability proportional to its weight in constant
+//						time however many weights there are. Used to choose which lights to sample at a hit.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "AliasTable.h"
+//\------------------------
+
+AliasTable::AliasTable()
+{
+}
+
+AliasTable::~AliasTable()
+{
+}
+
+//\----------------------------------------------------------------------------------
+//\ Vose's construction - every slot is filled to the average weight by topping up the
+//\ slots below average with the excess of slots above average
+//\----------------------------------------------------------------------------------
+void AliasTable::Build(const std::vector<float>& a_weights)
+{
+	const int count = (int)a_weights.size();
+	m_probability.assign(count, 1.f);
+	m_alias.resize(count);
+	m_pdf.resize(count);
+	if (count == 0)
+	{
+		return;
+	}
+
+	double total = 0.0;
+	for (float weight : a_weights)
+	{
+		total += weight > 0.f ? weight : 0.f;
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		m_pdf[i] = total > 0.0 ? (float)((a_weights[i] > 0.f ? a_weights[i] : 0.f) / total) : 1.f / (float)count;
+		m_alias[i] = i;
+	}
+
+	// Scale so the average slot is 1 and split into slots under and over the average
+	std::vector<float> scaled(count);
+	std::vector<int> small;
+	std::vector<int> large;
+	for (int i = 0; i < count; ++i)
+	{
+		scaled[i] = m_pdf[i] * (float)count;
+		if (scaled[i] < 1.f) { small.push_back(i); }
+		else { large.push_back(i); }
+	}
+	while (!small.empty() && !large.empty())
+	{
+		int under = small.back(); small.pop_back();
+		int over = large.back(); large.pop_back();
+		m_probability[under] = scaled[under];
+		m_alias[under] = over;
+		scaled[over] = (scaled[over] + scaled[under]) - 1.f;
+		if (scaled[over] < 1.f) { small.push_back(over); }
+		else { large.push_back(over); }
+	}
+	// Anything left over is within rounding error of the average and always keeps its own slot
+	for (int i : small) { m_probability[i] = 1.f; }
+	for (int i : large) { m_probability[i] = 1.f; }
+}
+
+// One random number picks the slot with its integer part and the choice within the slot with the fraction
+int AliasTable::Sample(float a_random) const
+{
+	const int count = (int)m_probability.size();
+	float scaled = a_random * (float)count;
+	int slot = (int)scaled;
+	if (slot >= count) { slot = count - 1; }
+	float fraction = scaled - (float)slot;
+	return fraction < m_probability[slot] ? slot : m_alias[slot];
+}
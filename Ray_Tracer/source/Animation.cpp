@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Animation.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Keyframed transforms for primitives, lights and cameras. Apply(time) moves everything to
+//						where it is at that time, blending linearly between the two keys either side of it.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <limits>
+
+#include "Animation.h"
+#include "Primitive.h"
+#include "Light.h"
+#include "Camera.h"
+//\------------------------
+
+namespace
+{
+	// Index of the key at or before a_time and how far a_time is toward the key after it
+	template<typename Key>
+	int FindKey(const std::vector<Key>& a_keys, float a_time, float& a_t)
+	{
+		a_t = 0.f;
+		if (a_time <= a_keys.front().time)
+		{
+			return 0;
+		}
+		if (a_time >= a_keys.back().time)
+		{
+			return (int)a_keys.size() - 1;
+		}
+		int next = (int)(std::upper_bound(a_keys.begin(), a_keys.end(), a_time, [](float a_value, const Key& a_key) { return a_value < a_key.time; }) - a_keys.begin());
+		int key = next - 1;
+		a_t = (a_time - a_keys[key].time) / (a_keys[next].time - a_keys[key].time);
+		return key;
+	}
+}
+
+Animation::Animation()
+{
+}
+
+Animation::~Animation()
+{
+}
+
+//\----------------------------------------------------------------------------------
+//\ Adding keys - each animated object gets one track, keys are kept in time order
+//\----------------------------------------------------------------------------------
+template<typename Target, typename Key>
+void Animation::AddKey(std::vector<Track<Target, Key>>& a_tracks, Target* a_target, const Key& a_key)
+{
+	auto track = std::find_if(a_tracks.begin(), a_tracks.end(), [a_target](const Track<Target, Key>& a_track) { return a_track.target == a_target; });
+	if (track == a_tracks.end())
+	{
+		a_tracks.push_back(Track<Target, Key>{ a_target, {} });
+		track = a_tracks.end() - 1;
+	}
+	auto position = std::upper_bound(track->keys.begin(), track->keys.end(), a_key, [](const Key& a_a, const Key& a_b) { return a_a.time < a_b.time; });
+	track->keys.insert(position, a_key);
+}
+
+void Animation::AddKey(Primitive* a_primitive, const TransformKey& a_key)
+{
+	AddKey(m_primitiveTracks, a_primitive, a_key);
+}
+
+void Animation::AddKey(Light* a_light, const TransformKey& a_key)
+{
+	AddKey(m_lightTracks, a_light, a_key);
+}
+
+void Animation::AddKey(Camera* a_camera, const CameraKey& a_key)
+{
+	AddKey(m_cameraTracks, a_camera, a_key);
+}
+
+void Animation::Clear()
+{
+	m_primitiveTracks.clear();
+	m_lightTracks.clear();
+	m_cameraTracks.clear();
+}
+
+//\----------------------------------------------------------------------------------
+//\ Playback
+//\----------------------------------------------------------------------------------
+void Animation::Apply(float a_time) const
+{
+	for (const auto& track : m_primitiveTracks)
+	{
+		track.target->SetTransform(ToTransform(Blend(track.keys, a_time)));
+	}
+	for (const auto& track : m_lightTracks)
+	{
+		track.target->SetTransform(ToTransform(Blend(track.keys, a_time)));
+	}
+	for (const auto& track : m_cameraTracks)
+	{
+		CameraKey key = Blend(track.keys, a_time);
+		track.target->Setposition(key.position);
+		track.target->LookAt(key.target, Vector3(0.f, 1.f, 0.f));
+	}
+}
+
+float Animation::GetStartTime() const
+{
+	float start = std::numeric_limits<float>::max();
+	for (const auto& track : m_primitiveTracks) { start = std::min(start, track.keys.front().time); }
+	for (const auto& track : m_lightTracks) { start = std::min(start, track.keys.front().time); }
+	for (const auto& track : m_cameraTracks) { start = std::min(start, track.keys.front().time); }
+	return start == std::numeric_limits<float>::max() ? 0.f : start;
+}
+
+float Animation::GetEndTime() const
+{
+	float end = -std::numeric_limits<float>::max();
+	for (const auto& track : m_primitiveTracks) { end = std::max(end, track.keys.back().time); }
+	for (const auto& track : m_lightTracks) { end = std::max(end, track.keys.back().time); }
+	for (const auto& track : m_cameraTracks) { end = std::max(end, track.keys.back().time); }
+	return end == -std::numeric_limits<float>::max() ? 0.f : end;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Blending between keys - euler angles are blended directly so keys should be less than half a turn apart
+//\----------------------------------------------------------------------------------
+Animation::TransformKey Animation::Blend(const std::vector<TransformKey>& a_keys, float a_time)
+{
+	float t = 0.f;
+	int key = FindKey(a_keys, a_time, t);
+	if (t <= 0.f)
+	{
+		return a_keys[key];
+	}
+	const TransformKey& from = a_keys[key];
+	const TransformKey& to = a_keys[key + 1];
+	return TransformKey{ a_time, Lerp(from.position, to.position, t), Lerp(from.rotation, to.rotation, t), Lerp(from.scale, to.scale, t) };
+}
+
+Animation::CameraKey Animation::Blend(const std::vector<CameraKey>& a_keys, float a_time)
+{
+	float t = 0.f;
+	int key = FindKey(a_keys, a_time, t);
+	if (t <= 0.f)
+	{
+		return a_keys[key];
+	}
+	const CameraKey& from = a_keys[key];
+	const CameraKey& to = a_keys[key + 1];
+	return CameraKey{ a_time, Lerp(from.position, to.position, t), Lerp(from.target, to.target, t) };
+}
+
+AffineTransform Animation::ToTransform(const TransformKey& a_key)
+{
+	Matrix3 rotateX, rotateY, rotateZ;
+	rotateX.RotateX(a_key.rotation.x * MathLib::DEG2RAD);
+	rotateY.RotateY(a_key.rotation.y * MathLib::DEG2RAD);
+	rotateZ.RotateZ(a_key.rotation.z * MathLib::DEG2RAD);
+	Matrix3 rotation = rotateZ * rotateY * rotateX;
+	return AffineTransform(rotation.GetColumn(0) * a_key.scale.x, rotation.GetColumn(1) * a_key.scale.y,
+		rotation.GetColumn(2) * a_key.scale.z, a_key.position);
+}
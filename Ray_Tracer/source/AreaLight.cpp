@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				AreaLight.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A rectangular area light centred on the position of its transform, shining out of its forward
+//						direction. Each sample picks a random point on the rectangle so the many rays per pixel average
+//						out into soft shadows.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cmath>
+#include "AreaLight.h"
+#include "FastMath.h"
+//\------------------------
+
+AreaLight::AreaLight() : m_width(1.f), m_height(1.f), m_intensity(1.f)
+{
+	Light::SetFacing(Vector3(0.f, -1.f, 0.f));
+}
+
+AreaLight::AreaLight(const Vector3& a_position, const Vector3& a_facing, float a_width, float a_height, const ColourRGB& a_colour, float a_intensity)
+	: Light(AffineTransform::IDENTITY, a_colour), m_width(a_width), m_height(a_height), m_intensity(a_intensity)
+{
+	SetPosition(a_position);
+	Light::SetFacing(a_facing);
+}
+
+AreaLight::~AreaLight()
+{
+}
+
+// The light from one point of the rectangle falls off with distance squared and with the cosine of the angle
+// it leaves the rectangle at. Multiplying by the area makes the average over many samples the light of the whole rectangle.
+LightSample AreaLight::SampleLight(const Vector3& a_point) const
+{
+	Vector3 lightPoint = GetPosition()
+		+ m_Transform.GetColumn(0) * ((Random::RandomFloat() - 0.5f) * m_width)
+		+ m_Transform.GetColumn(1) * ((Random::RandomFloat() - 0.5f) * m_height);
+	Vector3 toLight = lightPoint - a_point;
+	float distanceSqr = Dot(toLight, toLight);
+
+	LightSample sample;
+	sample.distance = FastMath::SqrtP(distanceSqr);
+	sample.directionToLight = toLight * (1.f / sample.distance);
+	float cosLight = -Dot(sample.directionToLight, GetFacing());
+	if (cosLight <= 0.f)
+	{
+		sample.colour = ColourRGB(0.f, 0.f, 0.f);					// Point is behind the light
+	}
+	else
+	{
+		sample.colour = m_colourRGB * (m_intensity * m_width * m_height * cosLight / distanceSqr);
+	}
+	return sample;
+}
+
+// Only half of the sphere around the rectangle is lit and the cosine falloff halves it again
+float AreaLight::EstimatePower() const
+{
+	return Light::EstimatePower() * m_intensity * m_width * m_height * 0.25f;
+}
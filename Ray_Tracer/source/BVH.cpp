@@ -0,0 +1,316 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				BVH.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Bounding volume hierarchy over the primitives of a scene. Built top down with the surface area
+//						heuristic, it can be refit in place when only the transforms of the primitives change.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cassert>
+
+#include "BVH.h"
+#include "Primitive.h"
+//\------------------------
+
+namespace
+{
+	const int BIN_COUNT = 12;				// Candidate split planes per axis
+	const int MAX_LEAF_SIZE = 2;
+	const float TRAVERSAL_COST = 1.f;		// Cost of a box test relative to a primitive test
+	const float INTERSECT_COST = 1.f;
+
+	float Axis(const Vector3& a_v3, int a_axis)
+	{
+		return a_axis == 0 ? a_v3.x : (a_axis == 1 ? a_v3.y : a_v3.z);
+	}
+
+	// Levels a range of a_count primitives takes when it is split at the median all the way down to leaves
+	int MedianDepth(int a_count)
+	{
+		int depth = 0;
+		while (a_count > MAX_LEAF_SIZE)
+		{
+			a_count = (a_count + 1) / 2;
+			++depth;
+		}
+		return depth;
+	}
+}
+
+BVH::BVH() : m_objects(nullptr), m_buildCost(0.f), m_depth(0)
+{
+}
+
+BVH::~BVH()
+{
+}
+
+void BVH::Clear()
+{
+	m_nodes.clear();
+	m_indices.clear();
+	m_objects = nullptr;
+	m_buildCost = 0.f;
+	m_depth = 0;
+}
+
+void BVH::Build(const std::vector<const Primitive*>& a_objects)
+{
+	Clear();
+	if (a_objects.empty())
+	{
+		return;
+	}
+	m_objects = &a_objects;
+
+	std::vector<AABB> bounds(a_objects.size());
+	std::vector<Vector3> centres(a_objects.size());
+	m_indices.resize(a_objects.size());
+	for (int i = 0; i < (int)a_objects.size(); ++i)
+	{
+		bounds[i] = a_objects[i]->GetBounds();
+		centres[i] = bounds[i].Centre();
+		m_indices[i] = i;
+	}
+	m_nodes.reserve(a_objects.size() * 2);
+	BuildNode(0, (int)a_objects.size(), 0, bounds, centres);
+	assert(m_depth < STACK_SIZE);
+	m_buildCost = Cost();
+}
+
+//\----------------------------------------------------------------------------------
+//\ Split the primitives m_indices[a_first, a_first + a_count) - the centres are binned along the longest
+//\ axis and the bin boundary with the lowest surface area cost is used. When no split is cheaper than
+//\ a leaf, or the bins can not separate the centres, the range is split at its median instead.
+//\ A lopsided split can leave almost every primitive on one side, so the surface area split is only
+//\ used while the larger side could still be split at the median to leaves without the tree getting
+//\ as deep as the traversal stack. Past that every split is at the median, which halves the range.
+//\----------------------------------------------------------------------------------
+int BVH::BuildNode(int a_first, int a_count, int a_depth, const std::vector<AABB>& a_bounds, const std::vector<Vector3>& a_centres)
+{
+	int nodeIndex = (int)m_nodes.size();
+	m_nodes.push_back(Node());
+	AABB nodeBounds;
+	AABB centreBounds;
+	for (int i = a_first; i < a_first + a_count; ++i)
+	{
+		nodeBounds.Grow(a_bounds[m_indices[i]]);
+		centreBounds.Grow(a_centres[m_indices[i]]);
+	}
+	m_nodes[nodeIndex].bounds = nodeBounds;
+	m_depth = std::max(m_depth, a_depth);
+
+	if (a_count <= MAX_LEAF_SIZE)
+	{
+		m_nodes[nodeIndex].first = a_first;
+		m_nodes[nodeIndex].count = a_count;
+		return nodeIndex;
+	}
+
+	Vector3 centreExtent = centreBounds.Extent();
+	int axis = 0;
+	if (centreExtent.y > Axis(centreExtent, axis)) { axis = 1; }
+	if (centreExtent.z > Axis(centreExtent, axis)) { axis = 2; }
+	const float axisMin = Axis(centreBounds.min, axis);
+	const float axisExtent = Axis(centreExtent, axis);
+
+	int split = -1;
+	if (axisExtent > 0.f && a_depth + 1 + MedianDepth(a_count - 1) < STACK_SIZE)
+	{
+		AABB binBounds[BIN_COUNT];
+		int binCounts[BIN_COUNT] = {};
+		const float binScale = (float)BIN_COUNT / axisExtent;
+		auto binOf = [&](int a_object)
+		{
+			int bin = (int)((Axis(a_centres[a_object], axis) - axisMin) * binScale);
+			return bin < BIN_COUNT ? bin : BIN_COUNT - 1;
+		};
+		for (int i = a_first; i < a_first + a_count; ++i)
+		{
+			int bin = binOf(m_indices[i]);
+			binBounds[bin].Grow(a_bounds[m_indices[i]]);
+			++binCounts[bin];
+		}
+		// Sweep from the right to get the cost of everything right of each boundary, then from the left
+		float rightCost[BIN_COUNT] = {};
+		AABB sweep;
+		int sweepCount = 0;
+		for (int b = BIN_COUNT - 1; b > 0; --b)
+		{
+			sweep.Grow(binBounds[b]);
+			sweepCount += binCounts[b];
+			rightCost[b] = sweep.HalfArea() * (float)sweepCount;
+		}
+		float bestCost = nodeBounds.HalfArea() * (float)a_count * INTERSECT_COST;		// Cost of making this node a leaf
+		int bestBin = -1;
+		sweep = AABB();
+		sweepCount = 0;
+		for (int b = 0; b < BIN_COUNT - 1; ++b)
+		{
+			sweep.Grow(binBounds[b]);
+			sweepCount += binCounts[b];
+			if (sweepCount == 0 || sweepCount == a_count)
+			{
+				continue;
+			}
+			float cost = nodeBounds.HalfArea() * TRAVERSAL_COST + (sweep.HalfArea() * (float)sweepCount + rightCost[b + 1]) * INTERSECT_COST;
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestBin = b;
+			}
+		}
+		if (bestBin >= 0)
+		{
+			int* middle = std::partition(&m_indices[a_first], &m_indices[a_first] + a_count, [&](int a_object) { return binOf(a_object) <= bestBin; });
+			split = (int)(middle - &m_indices[0]);
+		}
+	}
+	if (split <= a_first || split >= a_first + a_count)
+	{
+		// Median split on the longest axis
+		split = a_first + a_count / 2;
+		std::nth_element(&m_indices[a_first], &m_indices[split], &m_indices[a_first] + a_count,
+			[&](int a_a, int a_b) { return Axis(a_centres[a_a], axis) < Axis(a_centres[a_b], axis); });
+	}
+
+	BuildNode(a_first, split - a_first, a_depth + 1, a_bounds, a_centres);
+	int right = BuildNode(split, a_first + a_count - split, a_depth + 1, a_bounds, a_centres);
+	m_nodes[nodeIndex].first = right;
+	m_nodes[nodeIndex].count = 0;
+	return nodeIndex;
+}
+
+// Children are always stored after their parent so walking the nodes backwards updates children first
+void BVH::Refit()
+{
+	for (int n = (int)m_nodes.size() - 1; n >= 0; --n)
+	{
+		Node& node = m_nodes[n];
+		AABB bounds;
+		if (node.count > 0)
+		{
+			for (int i = node.first; i < node.first + node.count; ++i)
+			{
+				bounds.Grow((*m_objects)[m_indices[i]]->GetBounds());
+			}
+		}
+		else
+		{
+			bounds.Grow(m_nodes[n + 1].bounds);
+			bounds.Grow(m_nodes[node.first].bounds);
+		}
+		node.bounds = bounds;
+	}
+}
+
+// Expected cost of a random ray hitting the root - every node is weighted by the chance of a ray that
+// hits the root also hitting the node, which is the ratio of their surface areas
+float BVH::Cost() const
+{
+	if (m_nodes.empty())
+	{
+		return 0.f;
+	}
+	float rootArea = m_nodes[0].bounds.HalfArea();
+	if (rootArea <= 0.f)
+	{
+		return 0.f;
+	}
+	float cost = 0.f;
+	for (const Node& node : m_nodes)
+	{
+		cost += node.bounds.HalfArea() * (node.count > 0 ? (float)node.count * INTERSECT_COST : TRAVERSAL_COST);
+	}
+	return cost / rootArea;
+}
+
+AABB BVH::GetBounds() const
+{
+	return m_nodes.empty() ? AABB() : m_nodes[0].bounds;
+}
+
+Vector3 BVH::InverseDirection(const Ray& a_ray)
+{
+	const Vector3 direction = Normalize(a_ray.Direction());
+	return Vector3(1.f / direction.x, 1.f / direction.y, 1.f / direction.z);
+}
+
+//\----------------------------------------------------------------------------------
+//\ Nearest hit - the nearer child is visited first so further boxes can be skipped once a hit is closer.
+//\ The primitives are handed the ray cut short at the nearest hit so far, so an instance of a sub scene
+//\ only searches its own tree up to there.
+//\----------------------------------------------------------------------------------
+bool BVH::IntersectNearest(const Ray& a_ray, float& a_distance, int& a_objectIndex) const
+{
+	if (m_nodes.empty())
+	{
+		return false;
+	}
+	const Vector3 invDirection = InverseDirection(a_ray);
+	const Vector3 origin = a_ray.Origin();
+
+	float nearest = a_ray.MaxDistance();
+	int nearestObject = -1;
+	float entry = 0.f;
+	if (!m_nodes[0].bounds.IntersectRay(origin, invDirection, nearest, entry))
+	{
+		return false;
+	}
+
+	Ray clipped = a_ray;
+	int stack[STACK_SIZE];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		int nodeIndex = stack[--stackSize];
+		const Node& node = m_nodes[nodeIndex];
+		if (node.count > 0)
+		{
+			for (int i = node.first; i < node.first + node.count; ++i)
+			{
+				int object = m_indices[i];
+				float objectDistance = 0.f;
+				if ((*m_objects)[object]->IntersectDistance(clipped, objectDistance) && objectDistance > a_ray.MinLength())
+				{
+					// Same rule as the linear search - ties go to the object added to the scene first
+					if (objectDistance < nearest || (objectDistance == nearest && object < nearestObject))
+					{
+						nearest = objectDistance;
+						nearestObject = object;
+						clipped.SetMaxDistance(nearest);
+					}
+				}
+			}
+			continue;
+		}
+		int left = nodeIndex + 1;
+		int right = node.first;
+		float leftEntry = 0.f;
+		float rightEntry = 0.f;
+		bool hitLeft = m_nodes[left].bounds.IntersectRay(origin, invDirection, nearest, leftEntry);
+		bool hitRight = m_nodes[right].bounds.IntersectRay(origin, invDirection, nearest, rightEntry);
+		if (hitLeft && hitRight)
+		{
+			// Push the further child first so the nearer one is popped next
+			if (leftEntry <= rightEntry) { stack[stackSize++] = right; stack[stackSize++] = left; }
+			else { stack[stackSize++] = left; stack[stackSize++] = right; }
+		}
+		else if (hitLeft)	{ stack[stackSize++] = left; }
+		else if (hitRight)	{ stack[stackSize++] = right; }
+	}
+	if (nearestObject < 0)
+	{
+		return false;
+	}
+	a_distance = nearest;
+	a_objectIndex = nearestObject;
+	return true;
+}
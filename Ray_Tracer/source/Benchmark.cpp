@@ -0,0 +1,1541 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Benchmark.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Built in micro benchmarks run from the command line with --bench [name]. Each benchmark
+//						times the current code path against the one it replaced and writes a small report.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <vector>
+#include <MathLib.h>
+
+#include "AreaLight.h"
+#include "Benchmark.h"
+#include "Camera.h"
+#include "Denoiser.h"
+#include "DirectionalLight.h"
+#include "Ellipsoid.h"
+#include "ExampleScene.h"
+#include "FastMath.h"
+#include "FrameBuffer.h"
+#include "GeneratedScene.h"
+#include "ImageOutput.h"
+#include "IncrementalRenderer.h"
+#include "Instance.h"
+#include "Material.h"
+#include "ParallelFor.h"
+#include "PointLight.h"
+#include "Regression.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include "SpotLight.h"
+#include "Texture.h"
+#include "WavefrontRenderer.h"
+//\------------------------
+
+namespace
+{
+	//\----------------------------------------------------------------------------------
+	//\ Timer - milliseconds since construction
+	//\----------------------------------------------------------------------------------
+	class Timer
+	{
+	public:
+		Timer() : m_start(std::chrono::high_resolution_clock::now()) {}
+		double ElapsedMs() const
+		{
+			return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count();
+		}
+	private:
+		std::chrono::high_resolution_clock::time_point m_start;
+	};
+
+	// Write one line of the report as nanoseconds per operation
+	void Report(std::ostream& a_out, const char* a_label, const char* a_baseName, double a_baseMs, const char* a_newName, double a_newMs, int a_count)
+	{
+		a_out << "  " << a_label << "\t" << a_baseName << " " << a_baseMs * 1e6 / a_count << " ns\t" << a_newName << " "
+			<< a_newMs * 1e6 / a_count << " ns\tspeed up " << a_baseMs / a_newMs << "x" << std::endl;
+	}
+
+	// Root mean square error of the displayed colours, which are clamped to 0 -> 1, against the reference image
+	double RmsError(const std::vector<ColourRGB>& a_pixels, const std::vector<ColourRGB>& a_reference)
+	{
+		double sum = 0.0;
+		for (size_t i = 0; i < a_pixels.size(); ++i)
+		{
+			const float* pixel = &a_pixels[i].x;
+			const float* reference = &a_reference[i].x;
+			for (int c = 0; c < 3; ++c)
+			{
+				double difference = (double)std::min(std::max(pixel[c], 0.f), 1.f) - (double)std::min(std::max(reference[c], 0.f), 1.f);
+				sum += difference * difference;
+			}
+		}
+		return std::sqrt(sum / (double)(a_pixels.size() * 3));
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Scene::CastRay as it was before the secondary rays were moved out of the light loop -
+	//\ kept here only so the lights benchmark has something to compare against
+	//\----------------------------------------------------------------------------------
+	Vector3 CastRayPerLight(const Scene& a_scene, const std::vector<const Light*>& a_lights, const Vector3& a_eyePos, const Ray& a_ray, int a_bounces, float a_currentIr)
+	{
+		if (a_bounces <= 0)
+		{
+			return ColourRGB(0.f, 0.f, 0.f);
+		}
+		IntersectResponse ir;
+		if (!a_scene.IntersectTest(a_ray, ir))
+		{
+			return Lerp(Vector3(1.f, 1.f, 1.f), Vector3(0.4f, 0.7f, 1.f), RayToColour(a_ray).y);
+		}
+		ir.currentRefInd = a_currentIr;
+		Vector3 rayColour = Vector3(0.f, 0.f, 0.f);
+		for (const Light* light : a_lights)
+		{
+			LightSample lightSample = light->SampleLight(ir.HitPos);
+			IntersectResponse sr;
+			float shadowValue = (!a_scene.IntersectTest(Ray(ir.HitPos, lightSample.directionToLight, 0.001f, lightSample.distance), sr));
+			if (shadowValue < 1.f)
+			{
+				shadowValue += sr.material->GetTransparency();
+			}
+			rayColour += light->ShadeSample(ir, a_eyePos, lightSample) * shadowValue;
+
+			Ray refractRay;
+			ColourRGB refractionColour = ColourRGB(0.f, 0.f, 0.f);
+			if (ir.material->CalcRefraction(a_ray, ir, refractRay))
+			{
+				refractionColour = CastRayPerLight(a_scene, a_lights, a_eyePos, refractRay, a_bounces - 1, ir.material->GetRefractiveIndex()) * ir.material->GetTransparency();
+			}
+			ColourRGB reflectColour = ColourRGB(0.f, 0.f, 0.f);
+			Ray bounceRay;
+			if (ir.material->GetReflective() > 0.f && ir.material->CalcReflection(a_ray, ir, bounceRay))
+			{
+				reflectColour = CastRayPerLight(a_scene, a_lights, a_eyePos, bounceRay, a_bounces - 1, a_currentIr) * ir.material->GetReflective();
+			}
+			if (ir.material->GetReflective() > 0.f && ir.material->GetTransparency() > 0.f)
+			{
+				float reflectance = ir.material->Schlick(a_ray, ir);
+				rayColour += reflectColour * reflectance + refractionColour * (1.f - reflectance);
+			}
+			else
+			{
+				rayColour += reflectColour + refractionColour;
+			}
+		}
+		return rayColour;
+	}
+}
+
+bool Benchmark::Run(const std::string& a_name, std::ostream& a_out)
+{
+	if (a_name == "transform")	{ Transform(a_out); return true; }
+	if (a_name == "lights")		{ Lights(a_out); return true; }
+	if (a_name == "lightcount")	{ LightCount(a_out); return true; }
+	if (a_name == "incremental")	{ Incremental(a_out); return true; }
+	if (a_name == "denoise")	{ Denoise(a_out); return true; }
+	if (a_name == "aov")		{ AOVs(a_out); return true; }
+	if (a_name == "framebuffer")	{ FrameBufferFormats(a_out); return true; }
+	if (a_name == "images")		{ ImageFormats(a_out); return true; }
+	if (a_name == "wavefront")	{ Wavefront(a_out); return true; }
+	if (a_name == "reorder")	{ Reorder(a_out); return true; }
+	if (a_name == "textures")	{ Textures(a_out); return true; }
+	if (a_name == "fastmath")	{ MathPrecision(a_out); return true; }
+	if (a_name == "lightbatch")	{ LightBatch(a_out); return true; }
+	if (a_name == "grid")		{ Grid(a_out); return true; }
+	if (a_name == "instances")	{ Instances(a_out); return true; }
+	if (a_name == "sweep")		{ Sweep(a_out); return true; }
+	return false;
+}
+
+void Benchmark::List(std::ostream& a_out)
+{
+	a_out << "benchmarks: transform lights lightcount incremental denoise aov framebuffer images wavefront reorder textures fastmath lightbatch grid instances sweep" << std::endl;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Transform - random scale, rotation and translation transforms like the ones in the scene
+//\----------------------------------------------------------------------------------
+void Benchmark::Transform(std::ostream& a_out)
+{
+	const int transformCount = 1024;
+	const int pointCount = 4096;
+	const int inverseRepeats = 1000;
+
+	std::vector<Matrix4> matrices;
+	std::vector<AffineTransform> affines;
+	std::vector<Vector3> points;
+	for (int i = 0; i < transformCount; ++i)
+	{
+		Matrix4 m = Matrix4::LookAt(Vector3(Random::RandomRange(-5.f, 5.f), Random::RandomRange(-5.f, 5.f), Random::RandomRange(-5.f, 5.f)),
+									Vector3(0.f, 0.f, 0.f), Vector3(0.f, 1.f, 0.f));
+		Matrix4 scale;
+		scale.Scale(Vector4(Random::RandomRange(0.1f, 4.f), Random::RandomRange(0.1f, 4.f), Random::RandomRange(0.1f, 4.f), 1.f));
+		m = m * scale;
+		matrices.push_back(m);
+		affines.push_back(AffineTransform(m));
+	}
+	for (int i = 0; i < pointCount; ++i)
+	{
+		points.push_back(Vector3(Random::RandomRange(-10.f, 10.f), Random::RandomRange(-10.f, 10.f), Random::RandomRange(-10.f, 10.f)));
+	}
+
+	a_out << "Transform benchmark - " << transformCount << " transforms, " << pointCount << " points" << std::endl;
+	Vector3 sink(0.f, 0.f, 0.f);		// Results are summed and printed so the optimiser cannot drop the loops
+	const int transformOps = transformCount * pointCount;
+
+	// Points
+	Timer baseTimer;
+	for (const Matrix4& m : matrices)
+		for (const Vector3& p : points) { sink += (m * Vector4(p, 1.f)).xyz(); }
+	double baseMs = baseTimer.ElapsedMs();
+	Timer newTimer;
+	for (const AffineTransform& t : affines)
+		for (const Vector3& p : points) { sink += t.TransformPoint(p); }
+	Report(a_out, "point  ", "Matrix4", baseMs, "AffineTransform", newTimer.ElapsedMs(), transformOps);
+
+	// Vectors
+	baseTimer = Timer();
+	for (const Matrix4& m : matrices)
+		for (const Vector3& p : points) { sink += (m * Vector4(p, 0.f)).xyz(); }
+	baseMs = baseTimer.ElapsedMs();
+	newTimer = Timer();
+	for (const AffineTransform& t : affines)
+		for (const Vector3& p : points) { sink += t.TransformVector(p); }
+	Report(a_out, "vector ", "Matrix4", baseMs, "AffineTransform", newTimer.ElapsedMs(), transformOps);
+
+	// Normals - the Matrix4 path is the transpose of the inverse the ellipsoid used to build per hit
+	baseTimer = Timer();
+	for (const Matrix4& m : matrices)
+	{
+		Matrix4 normalMatrix = m.GetTranspose();
+		for (const Vector3& p : points) { sink += (normalMatrix * Vector4(p, 0.f)).xyz(); }
+	}
+	baseMs = baseTimer.ElapsedMs();
+	newTimer = Timer();
+	for (const AffineTransform& t : affines)
+		for (const Vector3& p : points) { sink += t.TransformNormal(p); }
+	Report(a_out, "normal ", "Matrix4", baseMs, "AffineTransform", newTimer.ElapsedMs(), transformOps);
+
+	// Inverse
+	baseTimer = Timer();
+	for (int r = 0; r < inverseRepeats; ++r)
+		for (const Matrix4& m : matrices) { sink += m.Inverse().GetColumnV3(3); }
+	baseMs = baseTimer.ElapsedMs();
+	newTimer = Timer();
+	for (int r = 0; r < inverseRepeats; ++r)
+		for (const AffineTransform& t : affines) { sink += t.Inverse().GetTranslation(); }
+	Report(a_out, "inverse", "Matrix4", baseMs, "AffineTransform", newTimer.ElapsedMs(), transformCount * inverseRepeats);
+
+	a_out << "  (sink " << sink.x + sink.y + sink.z << ")" << std::endl;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Lights - a small render of spheres like the main scene, adding one directional light at a time.
+//\ Tracing the secondary rays per light multiplies the work by the light count at every bounce.
+//\----------------------------------------------------------------------------------
+void Benchmark::Lights(std::ostream& a_out)
+{
+	const int imageWidth = 16;
+	const int imageHeight = 8;
+	const int bounces = 4;
+	const int maxLights = 6;
+
+	Material rough = Material(Vector3(0.3f, 0.6f, 1.f), 0.2f, 0.9f, 0.6f, 1.f, 0.0f, 0.0f, 1.52f);
+	Material smooth = Material(Vector3(1.f, 0.0f, 0.f), 0.2f, 0.9f, 0.9f, 0.f, 1.0f, 0.f, 2.61f);
+	Material clear = Material(Vector3(1.f, 1.0f, 1.0f), 0.1f, 0.1f, 0.9f, 0.f, 0.5f, 1.f, 1.52f);
+	Ellipsoid ground(Vector3(0.f, -100.5f, -2.5f), 100.f);	ground.SetMaterial(&rough);
+	Ellipsoid left(Vector3(-1.f, 0.f, -1.5f), 0.5f);			left.SetMaterial(&rough);
+	Ellipsoid centre(Vector3(0.f, 0.f, -3.5f), 0.5f);		centre.SetMaterial(&smooth);
+	Ellipsoid right(Vector3(1.5f, 0.f, -4.5f), 0.5f);		right.SetMaterial(&clear);
+
+	Camera camera;
+	camera.SetPerspective(60.f, (float)imageWidth / (float)imageHeight, 0.1f, 1000.0f);
+	camera.Setposition(Vector3(0.f, 0.f, 1.f));
+	camera.LookAt(Vector3(0.f, 0.f, -2.5f), Vector3(0.f, 1.f, 0.f));
+
+	Scene scene;
+	scene.AddObject(&ground);
+	scene.AddObject(&left);
+	scene.AddObject(&centre);
+	scene.AddObject(&right);
+	scene.SetCamera(&camera);
+
+	std::vector<DirectionalLight> lights;
+	lights.reserve(maxLights);
+	std::vector<const Light*> lightPointers;
+
+	a_out << "Lights benchmark - " << imageWidth << "x" << imageHeight << " image, " << bounces << " bounces" << std::endl;
+	Vector3 sink(0.f, 0.f, 0.f);
+	const int pixelCount = imageWidth * imageHeight;
+	for (int l = 1; l <= maxLights; ++l)
+	{
+		float angle = (float)l * 1.1f;
+		lights.push_back(DirectionalLight(Matrix4::IDENTITY, Vector3(0.5f, 0.5f, 0.5f), Normalize(Vector3(cosf(angle), -1.f, sinf(angle)))));
+		scene.AddLight(&lights.back());
+		lightPointers.push_back(&lights.back());
+
+		Timer baseTimer;
+		for (int i = 0; i < imageHeight; ++i)
+			for (int j = 0; j < imageWidth; ++j)
+			{
+				Vector2 screenPos(2.f * ((float)j + 0.5f) / (float)imageWidth - 1.f, 1.f - 2.f * ((float)i + 0.5f) / (float)imageHeight);
+				sink += CastRayPerLight(scene, lightPointers, camera.GetPosition(), scene.GetScreenRay(screenPos), bounces, 1.f);
+			}
+		double baseMs = baseTimer.ElapsedMs();
+		Timer newTimer;
+		for (int i = 0; i < imageHeight; ++i)
+			for (int j = 0; j < imageWidth; ++j)
+			{
+				Vector2 screenPos(2.f * ((float)j + 0.5f) / (float)imageWidth - 1.f, 1.f - 2.f * ((float)i + 0.5f) / (float)imageHeight);
+				sink += scene.CastRay(scene.GetScreenRay(screenPos), bounces);
+			}
+		std::string label = std::to_string(l) + (l == 1 ? " light " : " lights");
+		Report(a_out, label.c_str(), "per light", baseMs, "per hit", newTimer.ElapsedMs(), pixelCount);
+	}
+	a_out << "  (sink " << sink.x + sink.y + sink.z << ")" << std::endl;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Light count - generated scenes with more and more point lights over the field, rendered shadow testing every
+//\ light at every hit and then with one light a hit picked from the alias table. The hits are counted from the
+//\ shadow rays, so the time a hit covers its lights, the secondary rays and everything else a hit does.
+//\----------------------------------------------------------------------------------
+void Benchmark::LightCount(std::ostream& a_out)
+{
+	const int imageWidth = 64;
+	const int imageHeight = 32;
+	const int rays = 4;
+	const int lightCounts[] = { 1, 4, 16, 64, 256 };
+
+	Renderer renderer(imageWidth, imageHeight, rays);
+	renderer.SetShowProgress(false);
+	std::vector<ColourRGB> pixels;
+	a_out << "Light count benchmark - " << imageWidth << "x" << imageHeight << " generated scene, " << rays << " rays per pixel" << std::endl;
+	for (int lights : lightCounts)
+	{
+		GeneratedSceneSettings settings;
+		settings.lights = lights;
+		GeneratedScene generated(settings, (float)imageWidth / (float)imageHeight);
+		Scene& scene = generated.GetScene();
+		const Scene::LightSelection selections[] = { Scene::ALL_LIGHTS, Scene::SAMPLED_LIGHTS };
+		double hitNs[2];
+		for (int s = 0; s < 2; ++s)
+		{
+			scene.SetLightSelection(selections[s]);
+			Scene::ResetShadowCacheStats();
+			Timer timer;
+			renderer.Render(scene, pixels);
+			const double renderMs = timer.ElapsedMs();
+			const long long hits = Scene::GetShadowCacheStats().shadowTests / scene.GetLightSamplesPerHit();
+			hitNs[s] = renderMs * 1e6 / (double)std::max(hits, 1LL);
+		}
+		a_out << "  " << lights << (lights == 1 ? " light " : " lights") << "\tevery light " << hitNs[0] << " ns a hit\tone sampled "
+			<< hitNs[1] << " ns a hit\tspeed up " << hitNs[0] / hitNs[1] << "x" << std::endl;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Incremental - look dev edits to a scene like the main one. Each edit is followed by a full re-render
+//\ and by an incremental update of the image rendered before the edit.
+//\----------------------------------------------------------------------------------
+void Benchmark::Incremental(std::ostream& a_out)
+{
+	const int imageWidth = 256;
+	const int imageHeight = 128;
+	const int raysPerPixel = 8;
+
+	Material groundMaterial = Material(Vector3(0.f, 0.6f, 0.f), 0.2f, 0.9f, 0.5f, 1.f, 0.0f, 0.f, 2.61f);
+	Material rough = Material(Vector3(0.3f, 0.6f, 1.f), 0.2f, 0.9f, 0.6f, 1.f, 0.0f, 0.0f, 1.52f);
+	Material smooth = Material(Vector3(1.f, 0.0f, 0.f), 0.2f, 0.9f, 0.9f, 0.f, 1.0f, 0.f, 2.61f);
+	Material clear = Material(Vector3(1.f, 1.0f, 1.0f), 0.1f, 0.1f, 0.9f, 0.f, 0.5f, 1.f, 1.52f);
+	Ellipsoid ground(Vector3(0.f, -100.5f, -2.5f), 100.f);	ground.SetMaterial(&groundMaterial);
+	Ellipsoid left(Vector3(-1.f, 0.f, -1.5f), 0.5f);			left.SetMaterial(&rough);
+	Ellipsoid centre(Vector3(0.f, 0.f, -3.5f), 0.5f);		centre.SetMaterial(&smooth);
+	Ellipsoid right(Vector3(1.5f, 0.f, -4.5f), 0.5f);		right.SetMaterial(&clear);
+	DirectionalLight light = DirectionalLight(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f), Vector3(-0.5773f, -0.5733f, -0.5773f));
+
+	Camera camera;
+	camera.SetPerspective(60.f, (float)imageWidth / (float)imageHeight, 0.1f, 1000.0f);
+	camera.Setposition(Vector3(0.f, 0.f, 1.f));
+	camera.LookAt(Vector3(0.f, 0.f, -2.5f), Vector3(0.f, 1.f, 0.f));
+
+	Scene scene;
+	scene.AddObject(&ground);
+	scene.AddObject(&left);
+	scene.AddObject(&centre);
+	scene.AddObject(&right);
+	scene.AddLight(&light);
+	scene.SetCamera(&camera);
+	scene.BuildAccelerationStructure();
+
+	Renderer renderer(imageWidth, imageHeight, raysPerPixel);
+	IncrementalRenderer incremental(renderer);
+	std::vector<ColourRGB> pixels;
+	Timer firstTimer;
+	incremental.Render(scene);
+	const double firstMs = firstTimer.ElapsedMs();
+
+	a_out << "Incremental benchmark - " << imageWidth << "x" << imageHeight << " image, " << raysPerPixel << " rays per pixel, "
+		<< incremental.GetTileCount() << " tiles, first render " << firstMs << " ms" << std::endl;
+	const int pixelCount = imageWidth * imageHeight;
+	auto edit = [&](const char* a_label)
+	{
+		Timer fullTimer;
+		renderer.Render(scene, pixels);
+		double fullMs = fullTimer.ElapsedMs();
+		Timer updateTimer;
+		int tiles = incremental.Update(scene);
+		Report(a_out, a_label, "full", fullMs, "incremental", updateTimer.ElapsedMs(), pixelCount);
+		a_out << "  \t" << tiles << " of " << incremental.GetTileCount() << " tiles re-rendered" << std::endl;
+	};
+
+	// Nudge the small sphere on the left
+	left.SetPosition(left.GetPosition() + Vector3(0.f, 0.1f, 0.f));
+	scene.RefitAccelerationStructure();
+	incremental.PrimitiveChanged(&left);
+	edit("move sphere    ");
+
+	// Change the colour of the red mirror sphere
+	smooth = Material(Vector3(1.f, 0.5f, 0.f), 0.2f, 0.9f, 0.9f, 0.f, 1.0f, 0.f, 2.61f);
+	incremental.MaterialChanged(&smooth);
+	edit("change material");
+	std::clog << std::endl;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Denoise - the main scene rendered with a range of rays per pixel, with and without the denoiser, and compared
+//\ against a render with many more rays. Each denoised render is then matched by a plain render given the same
+//\ time, found by scaling its rays per pixel by the extra time the filter took.
+//\----------------------------------------------------------------------------------
+void Benchmark::Denoise(std::ostream& a_out)
+{
+	const int imageWidth = 128;
+	const int imageHeight = 64;
+	const int referenceRays = 1024;
+
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	const Scene& scene = example.GetScene();
+	Denoiser denoiser;
+
+	std::vector<ColourRGB> reference;
+	Renderer referenceRenderer(imageWidth, imageHeight, referenceRays);
+	referenceRenderer.SetShowProgress(false);
+	Timer referenceTimer;
+	referenceRenderer.Render(scene, reference);
+	a_out << "Denoise benchmark - " << imageWidth << "x" << imageHeight << " main scene, reference " << referenceRays
+		<< " rays per pixel in " << referenceTimer.ElapsedMs() << " ms" << std::endl;
+	a_out << "  rays\tdenoised\trender ms\tfilter ms\ttotal ms\tRMS error\tPSNR dB" << std::endl;
+
+	std::vector<ColourRGB> pixels;
+	// Returns the total time so the equal time renders can be sized from it
+	auto run = [&](int a_rays, bool a_denoise, double& a_error)
+	{
+		Renderer renderer(imageWidth, imageHeight, a_rays);
+		renderer.SetShowProgress(false);
+		Timer renderTimer;
+		AOVBuffers aovs;
+		renderer.Render(scene, pixels, a_denoise ? &aovs : nullptr);
+		const double renderMs = renderTimer.ElapsedMs();
+		double filterMs = 0.0;
+		if (a_denoise)
+		{
+			Timer filterTimer;
+			denoiser.Denoise(pixels, aovs, imageWidth, imageHeight, pixels);
+			filterMs = filterTimer.ElapsedMs();
+		}
+		a_error = RmsError(pixels, reference);
+		a_out << "  " << a_rays << "\t" << (a_denoise ? "yes" : "no") << "\t\t" << renderMs << "\t\t" << filterMs << "\t\t"
+			<< renderMs + filterMs << "\t\t" << a_error << "\t" << 20.0 * std::log10(1.0 / std::max(a_error, 1e-9)) << std::endl;
+		return std::make_pair(renderMs, filterMs);
+	};
+
+	double error = 0.0;
+	const int plainRays[] = { 8, 16, 32, 64, 128 };
+	for (int rays : plainRays)
+	{
+		run(rays, false, error);
+	}
+	const int denoisedRays[] = { 4, 8, 16 };
+	for (int rays : denoisedRays)
+	{
+		double denoisedError = 0.0;
+		std::pair<double, double> times = run(rays, true, denoisedError);
+		const int equalRays = std::max((int)std::round((double)rays * (times.first + times.second) / times.first), rays);
+		double plainError = 0.0;
+		a_out << "  equal time for " << rays << " rays denoised:" << std::endl;
+		run(equalRays, false, plainError);
+		a_out << "  \tdenoised error is " << 100.0 * denoisedError / plainError << "% of the plain render's" << std::endl;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ AOVs - the main scene rendered with and without its output variables filled in. The output variables are
+//\ copied from hits the render has already found so the two should take close to the same time.
+//\----------------------------------------------------------------------------------
+void Benchmark::AOVs(std::ostream& a_out)
+{
+	const int imageWidth = 256;
+	const int imageHeight = 128;
+	const int raysPerPixel = 16;
+	const int repeats = 3;
+
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	const Scene& scene = example.GetScene();
+	Renderer renderer(imageWidth, imageHeight, raysPerPixel);
+	renderer.SetShowProgress(false);
+
+	std::vector<ColourRGB> pixels;
+	AOVBuffers aovs;
+	// Interleaved so both see the same machine load, the fastest of the repeats is kept
+	double plainMs = 0.0;
+	double aovMs = 0.0;
+	for (int r = 0; r < repeats; ++r)
+	{
+		Timer plainTimer;
+		renderer.Render(scene, pixels);
+		double ms = plainTimer.ElapsedMs();
+		plainMs = (r == 0) ? ms : std::min(plainMs, ms);
+
+		Timer aovTimer;
+		renderer.Render(scene, pixels, &aovs);
+		ms = aovTimer.ElapsedMs();
+		aovMs = (r == 0) ? ms : std::min(aovMs, ms);
+	}
+	Timer primaryTimer;
+	renderer.RenderAOVs(scene, aovs);
+	const double primaryMs = primaryTimer.ElapsedMs();
+
+	a_out << "AOV benchmark - " << imageWidth << "x" << imageHeight << " main scene, " << raysPerPixel << " rays per pixel" << std::endl;
+	a_out << "  beauty only " << plainMs << " ms\tbeauty and AOVs " << aovMs << " ms\toverhead " << 100.0 * (aovMs - plainMs) / plainMs << "%" << std::endl;
+	a_out << "  AOVs on their own from primary rays " << primaryMs << " ms" << std::endl;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Frame buffer - the bulk conversions against converting one value at a time, the memory each storage format
+//\ needs, and how far a render stored in each format moves once it is written out as 8 bit colour
+//\----------------------------------------------------------------------------------
+void Benchmark::FrameBufferFormats(std::ostream& a_out)
+{
+	const int pixelCount = 1 << 20;
+	const int repeats = 8;
+
+	// Bright highlights over a dim background, much like a render
+	std::vector<float> rgb((size_t)pixelCount * 3);
+	for (float& value : rgb)
+	{
+		value = Random::RandomFloat() * (Random::RandomFloat() < 0.05f ? 16.f : 1.f);
+	}
+	std::vector<unsigned short> halves(rgb.size());
+	std::vector<unsigned char> rgbe((size_t)pixelCount * 4);
+	std::vector<float> decoded(rgb.size());
+
+	a_out << "Frame buffer benchmark - " << pixelCount << " pixels, SSE2 " << (PixelFormat::HasSIMD() ? "on" : "off") << std::endl;
+	Timer baseTimer;
+	for (int r = 0; r < repeats; ++r)
+		for (size_t i = 0; i < rgb.size(); ++i) { halves[i] = PixelFormat::FloatToHalf(rgb[i]); }
+	double baseMs = baseTimer.ElapsedMs();
+	Timer newTimer;
+	for (int r = 0; r < repeats; ++r) { PixelFormat::FloatToHalf(rgb.data(), halves.data(), rgb.size()); }
+	Report(a_out, "float to half", "scalar", baseMs, "bulk", newTimer.ElapsedMs(), pixelCount * repeats);
+
+	baseTimer = Timer();
+	for (int r = 0; r < repeats; ++r)
+		for (size_t i = 0; i < rgb.size(); ++i) { decoded[i] = PixelFormat::HalfToFloat(halves[i]); }
+	baseMs = baseTimer.ElapsedMs();
+	newTimer = Timer();
+	for (int r = 0; r < repeats; ++r) { PixelFormat::HalfToFloat(halves.data(), decoded.data(), rgb.size()); }
+	Report(a_out, "half to float", "scalar", baseMs, "bulk", newTimer.ElapsedMs(), pixelCount * repeats);
+
+	baseTimer = Timer();
+	for (int r = 0; r < repeats; ++r)
+		for (int i = 0; i < pixelCount; ++i) { PixelFormat::EncodeRGBE(&rgb[(size_t)i * 3], &rgbe[(size_t)i * 4]); }
+	baseMs = baseTimer.ElapsedMs();
+	newTimer = Timer();
+	for (int r = 0; r < repeats; ++r) { PixelFormat::EncodeRGBE(rgb.data(), rgbe.data(), pixelCount); }
+	Report(a_out, "encode RGBE  ", "scalar", baseMs, "bulk", newTimer.ElapsedMs(), pixelCount * repeats);
+
+	baseTimer = Timer();
+	for (int r = 0; r < repeats; ++r)
+		for (int i = 0; i < pixelCount; ++i) { PixelFormat::DecodeRGBE(&rgbe[(size_t)i * 4], &decoded[(size_t)i * 3]); }
+	baseMs = baseTimer.ElapsedMs();
+	newTimer = Timer();
+	for (int r = 0; r < repeats; ++r) { PixelFormat::DecodeRGBE(rgbe.data(), decoded.data(), pixelCount); }
+	Report(a_out, "decode RGBE  ", "scalar", baseMs, "bulk", newTimer.ElapsedMs(), pixelCount * repeats);
+
+	// A render of the main scene through each format, compared once quantised the way WriteColourRGB does it
+	const int imageWidth = 128;
+	const int imageHeight = 64;
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	Renderer renderer(imageWidth, imageHeight, 16);
+	renderer.SetShowProgress(false);
+	std::vector<ColourRGB> pixels;
+	renderer.Render(example.GetScene(), pixels);
+
+	const long long largeFrame = 16384LL * 16384LL;
+	const FrameBuffer::Format formats[] = { FrameBuffer::FLOAT32, FrameBuffer::HALF, FrameBuffer::RGBE };
+	for (FrameBuffer::Format format : formats)
+	{
+		FrameBuffer frame(imageWidth, imageHeight, format);
+		frame.Store(pixels);
+		std::vector<ColourRGB> stored;
+		frame.Load(stored);
+		int changed = 0;
+		int largest = 0;
+		for (size_t i = 0; i < pixels.size(); ++i)
+		{
+			const float* before = &pixels[i].x;
+			const float* after = &stored[i].x;
+			for (int c = 0; c < 3; ++c)
+			{
+				int difference = std::abs(static_cast<int>(255.999f * before[c]) - static_cast<int>(255.999f * after[c]));
+				changed += (difference != 0) ? 1 : 0;
+				largest = std::max(largest, difference);
+			}
+		}
+		a_out << "  " << FrameBuffer::FormatName(format) << "\t" << FrameBuffer::BytesPerPixel(format) << " bytes a pixel, "
+			<< (double)(largeFrame * FrameBuffer::BytesPerPixel(format)) / (1024.0 * 1024.0 * 1024.0) << " GB at 16K x 16K\t"
+			<< changed << " of " << pixels.size() * 3 << " 8 bit values changed, by at most " << largest << std::endl;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Image formats - a render written through the text PPM writer against each of the binary encoders, on one
+//\ thread and on all of them, with the size of the file each one makes
+//\----------------------------------------------------------------------------------
+void Benchmark::ImageFormats(std::ostream& a_out)
+{
+	const int imageWidth = 1024;
+	const int imageHeight = 512;
+	const int repeats = 3;
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	Renderer renderer(imageWidth, imageHeight, 4);
+	renderer.SetShowProgress(false);
+	FrameBuffer frame(imageWidth, imageHeight);
+	Timer renderTimer;
+	renderer.Render(example.GetScene(), frame);
+	const double renderMs = renderTimer.ElapsedMs();
+	const double megapixels = (double)imageWidth * imageHeight / 1e6;
+
+	a_out << "Image format benchmark - " << imageWidth << " x " << imageHeight << ", rendered in " << renderMs << " ms, "
+		<< Parallel::DefaultThreadCount() << " threads" << std::endl;
+	Timer ppmTimer;
+	size_t ppmSize = 0;
+	for (int r = 0; r < repeats; ++r)
+	{
+		std::ostringstream ppm;
+		renderer.WritePPM(ppm, frame);
+		ppmSize = ppm.str().size();
+	}
+	const double ppmMs = ppmTimer.ElapsedMs() / repeats;
+	a_out << "  ppm\t" << ppmMs << " ms\t" << megapixels * 1000.0 / ppmMs << " MP/s\t" << ppmSize / 1024 << " KB" << std::endl;
+
+	const ImageOutput::Format formats[] = { ImageOutput::PFM, ImageOutput::QOI, ImageOutput::PNG };
+	for (ImageOutput::Format format : formats)
+	{
+		std::vector<unsigned char> encoded;
+		double ms[2] = {};
+		const int threads[2] = { 1, 0 };
+		for (int t = 0; t < 2; ++t)
+		{
+			Timer timer;
+			for (int r = 0; r < repeats; ++r)
+			{
+				switch (format)
+				{
+				case ImageOutput::PFM:	ImageOutput::EncodePFM(frame, encoded, threads[t]); break;
+				case ImageOutput::QOI:	ImageOutput::EncodeQOI(frame, encoded, threads[t]); break;
+				default:				ImageOutput::EncodePNG(frame, encoded, threads[t]); break;
+				}
+			}
+			ms[t] = timer.ElapsedMs() / repeats;
+		}
+		a_out << "  " << ImageOutput::FormatName(format) << "\t1 thread " << ms[0] << " ms\tall threads " << ms[1] << " ms\t"
+			<< megapixels * 1000.0 / ms[1] << " MP/s\t" << encoded.size() / 1024 << " KB, " << 100.0 * encoded.size() / ppmSize
+			<< "% of the ppm\t" << 100.0 * ms[1] / renderMs << "% of the render time" << std::endl;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Wavefront - the recursive renderer against the staged one on one thread and on every thread, with the
+//\ error of each against a reference so the different noise of the two can be compared fairly
+//\----------------------------------------------------------------------------------
+void Benchmark::Wavefront(std::ostream& a_out)
+{
+	const int imageWidth = 160;
+	const int imageHeight = 80;
+	const int rays = 16;
+	const int referenceRays = 256;
+
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	const Scene& scene = example.GetScene();
+	std::vector<ColourRGB> reference;
+	Renderer referenceRenderer(imageWidth, imageHeight, referenceRays);
+	referenceRenderer.SetShowProgress(false);
+	referenceRenderer.Render(scene, reference);
+
+	Renderer renderer(imageWidth, imageHeight, rays);
+	renderer.SetShowProgress(false);
+	std::vector<ColourRGB> pixels;
+	Timer recursiveTimer;
+	renderer.Render(scene, pixels);
+	const double recursiveMs = recursiveTimer.ElapsedMs();
+	a_out << "Wavefront benchmark - " << imageWidth << "x" << imageHeight << " main scene, " << rays << " rays per pixel, "
+		<< Parallel::DefaultThreadCount() << " threads" << std::endl;
+	a_out << "  recursive\t\t" << recursiveMs << " ms\tRMS error " << RmsError(pixels, reference) << std::endl;
+
+	// One untimed render first so the first timed one does not pay for touching the queues' memory
+	WavefrontRenderer(renderer).Render(scene, pixels);
+	const int threadCounts[] = { 1, 0 };
+	for (int threads : threadCounts)
+	{
+		WavefrontRenderer wavefront(renderer, 1 << 18, threads);
+		Timer wavefrontTimer;
+		wavefront.Render(scene, pixels);
+		const double wavefrontMs = wavefrontTimer.ElapsedMs();
+		const WavefrontStageTimes& times = wavefront.GetStageTimes();
+		a_out << "  wavefront " << (threads == 1 ? "1 thread" : "all threads") << "\t" << wavefrontMs << " ms\tRMS error "
+			<< RmsError(pixels, reference) << "\tspeed up " << recursiveMs / wavefrontMs << "x" << std::endl;
+		a_out << "    generate " << times.generateMs << " ms, extend " << times.extendMs << " ms, shade " << times.shadeMs
+			<< " ms, connect " << times.connectMs << " ms, compact " << times.compactMs << " ms - " << times.extensions
+			<< " rays extended, " << times.shadowRays << " shadow rays" << std::endl;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Reorder - a field of ten thousand small rough glass and diffuse spheres, so every bounce scatters and the
+//\ hierarchy is too big to stay in the cache. First the same random rays are traced as generated and then sorted
+//\ by RayOrderKey, then the wavefront renderer is run with each ray order.
+//\----------------------------------------------------------------------------------
+void Benchmark::Reorder(std::ostream& a_out)
+{
+	const int imageWidth = 160;
+	const int imageHeight = 80;
+	const int rays = 16;
+	const int bounces = 6;
+	const int gridSize = 100;
+	const int randomRays = 1 << 20;
+
+	Material rough = Material(Vector3(0.3f, 0.6f, 1.f), 0.2f, 0.9f, 0.6f, 1.f, 0.0f, 0.5f, 1.52f);
+	Material clear = Material(Vector3(1.f, 1.0f, 1.0f), 0.1f, 0.1f, 0.9f, 0.3f, 0.5f, 1.f, 1.52f);
+	Material frosted = Material(Vector3(0.9f, 0.9f, 0.6f), 0.1f, 0.5f, 0.9f, 0.8f, 0.0f, 0.8f, 1.33f);
+	Material* materials[] = { &rough, &clear, &frosted };
+	std::vector<Ellipsoid> spheres;
+	spheres.reserve(gridSize * gridSize + 1);
+	spheres.push_back(Ellipsoid(Vector3(0.f, -1000.f, 0.f), 999.7f));
+	spheres.back().SetMaterial(&rough);
+	Random::SetSeed(7);
+	for (int i = 0; i < gridSize; ++i)
+	{
+		for (int j = 0; j < gridSize; ++j)
+		{
+			Vector3 position((float)i - gridSize * 0.5f + Random::RandomRange(-0.2f, 0.2f), Random::RandomRange(0.f, 0.4f), -(float)j - 1.f + Random::RandomRange(-0.2f, 0.2f));
+			spheres.push_back(Ellipsoid(position, Random::RandomRange(0.2f, 0.4f)));
+			spheres.back().SetMaterial(materials[(i * 7 + j * 3) % 3]);
+		}
+	}
+	DirectionalLight light(Matrix4::IDENTITY, Vector3(0.9f, 0.9f, 0.9f), Normalize(Vector3(0.3f, -1.f, -0.4f)));
+
+	Camera camera;
+	camera.SetPerspective(60.f, (float)imageWidth / (float)imageHeight, 0.1f, 1000.0f);
+	camera.Setposition(Vector3(0.f, 3.f, 4.f));
+	camera.LookAt(Vector3(0.f, 0.f, -20.f), Vector3(0.f, 1.f, 0.f));
+
+	Scene scene;
+	for (const Ellipsoid& sphere : spheres)
+	{
+		scene.AddObject(&sphere);
+	}
+	scene.AddLight(&light);
+	scene.SetCamera(&camera);
+	scene.BuildAccelerationStructure();
+
+	a_out << "Reorder benchmark - " << spheres.size() << " spheres, " << Parallel::DefaultThreadCount() << " threads" << std::endl;
+
+	// Rays from random points among the spheres in random directions - as incoherent as secondary rays get
+	const AABB bounds(Vector3(-gridSize * 0.5f, -0.3f, -(float)gridSize), Vector3(gridSize * 0.5f, 0.8f, 0.f));
+	std::vector<Ray> randomRayList;
+	randomRayList.reserve(randomRays);
+	for (int i = 0; i < randomRays; ++i)
+	{
+		Vector3 origin(Random::RandomRange(bounds.min.x, bounds.max.x), Random::RandomRange(bounds.min.y, bounds.max.y), Random::RandomRange(bounds.min.z, bounds.max.z));
+		Vector3 direction = Normalize(Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f)));
+		randomRayList.push_back(Ray(origin, direction, 0.001f));
+	}
+	// Each pass keeps its best time over a few turns, so a slow moment on the machine does not land on one side
+	const int repeats = 3;
+	float sink = 0.f;
+	auto traceAll = [&](const std::vector<Ray>& a_rays)
+	{
+		Timer timer;
+		for (const Ray& ray : a_rays)
+		{
+			float distance = 0.f;
+			int object = -1;
+			sink += scene.IntersectDistance(ray, distance, object) ? distance : 0.f;
+		}
+		return timer.ElapsedMs();
+	};
+	double unsortedMs = 1e30;
+	double sortMs = 1e30;
+	double sortedMs = 1e30;
+	std::vector<int> order;
+	std::vector<Ray> sortedRays;
+	sortedRays.reserve(randomRays);
+	traceAll(randomRayList);
+	for (int r = 0; r < repeats; ++r)
+	{
+		unsortedMs = std::min(unsortedMs, traceAll(randomRayList));
+		Timer sortTimer;
+		WavefrontRenderer::SortRays(randomRayList, order);
+		sortedRays.clear();
+		for (int index : order)
+		{
+			sortedRays.push_back(randomRayList[index]);
+		}
+		sortMs = std::min(sortMs, sortTimer.ElapsedMs());
+		sortedMs = std::min(sortedMs, traceAll(sortedRays));
+	}
+	a_out << "  " << randomRays << " random rays, one thread" << std::endl;
+	Report(a_out, "trace", "unsorted", unsortedMs, "sorted", sortedMs, randomRays);
+	Report(a_out, "sort + trace", "unsorted", unsortedMs, "sorted", sortMs + sortedMs, randomRays);
+
+	Renderer renderer(imageWidth, imageHeight, rays, bounces);
+	renderer.SetShowProgress(false);
+	std::vector<ColourRGB> pixels;
+	WavefrontRenderer(renderer).Render(scene, pixels);
+	a_out << "  wavefront " << imageWidth << "x" << imageHeight << ", " << rays << " rays per pixel, " << bounces << " bounces" << std::endl;
+	WavefrontRenderer wavefronts[2] = { WavefrontRenderer(renderer), WavefrontRenderer(renderer) };
+	wavefronts[1].SetRayOrder(WavefrontRenderer::MORTON_ORDER);
+	double bestMs[2] = { 1e30, 1e30 };
+	WavefrontStageTimes bestTimes[2];
+	for (int r = 0; r < repeats; ++r)
+	{
+		for (int w = 0; w < 2; ++w)
+		{
+			Timer renderTimer;
+			wavefronts[w].Render(scene, pixels);
+			const double renderMs = renderTimer.ElapsedMs();
+			if (renderMs < bestMs[w])
+			{
+				bestMs[w] = renderMs;
+				bestTimes[w] = wavefronts[w].GetStageTimes();
+			}
+		}
+	}
+	for (int w = 0; w < 2; ++w)
+	{
+		a_out << "    " << (w == 0 ? "material order" : "morton order  ") << "\t" << bestMs[w] << " ms\tsecondary extend "
+			<< bestTimes[w].secondaryExtendMs * 1e6 / (double)std::max(bestTimes[w].secondaryExtensions, 1LL) << " ns a ray, sort "
+			<< bestTimes[w].sortMs << " ms\tspeed up " << bestMs[0] / bestMs[w] << "x" << std::endl;
+	}
+	a_out << "  (sink " << sink << ")" << std::endl;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Textures - a checker texture on the ground of the main scene, rendered with the cache cut down each time.
+//\ The image is the same whatever the cache holds, only the time and the tiles read from disk change.
+//\----------------------------------------------------------------------------------
+void Benchmark::Textures(std::ostream& a_out)
+{
+	const int imageWidth = 256;
+	const int imageHeight = 128;
+	const int rays = 8;
+	const int textureSize = 2048;
+	const char* tiledFilename = "benchmark_texture.rttx";
+
+	std::vector<ColourRGB> image((size_t)textureSize * textureSize);
+	for (int y = 0; y < textureSize; ++y)
+	{
+		for (int x = 0; x < textureSize; ++x)
+		{
+			const bool light = (((x >> 5) + (y >> 5)) & 1) != 0;
+			image[(size_t)y * textureSize + x] = light ? ColourRGB(0.9f, (float)x / textureSize, (float)y / textureSize) : ColourRGB(0.15f, 0.15f, 0.15f);
+		}
+	}
+	Timer createTimer;
+	if (!Texture::CreateTiled(image, textureSize, textureSize, tiledFilename))
+	{
+		a_out << "Textures benchmark - could not write " << tiledFilename << std::endl;
+		return;
+	}
+	const double createMs = createTimer.ElapsedMs();
+	image.clear();
+	image.shrink_to_fit();
+
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	Renderer renderer(imageWidth, imageHeight, rays);
+	renderer.SetShowProgress(false);
+	std::vector<ColourRGB> plain;
+	Timer plainTimer;
+	renderer.Render(example.GetScene(), plain);
+	const double plainMs = plainTimer.ElapsedMs();
+
+	const size_t capacities[] = { (size_t)64 << 20, (size_t)4 << 20, (size_t)1 << 20, (size_t)256 << 10 };
+	std::vector<ColourRGB> reference;
+	for (size_t capacity : capacities)
+	{
+		TextureCache cache(capacity);
+		Texture texture;
+		texture.Open(tiledFilename, &cache);
+		if (capacity == capacities[0])
+		{
+			a_out << "Textures benchmark - " << imageWidth << "x" << imageHeight << " main scene, " << rays << " rays per pixel, "
+				<< textureSize << "x" << textureSize << " texture of " << texture.GetLevelCount() << " levels, "
+				<< (double)texture.GetFullSize() / (1 << 20) << " MB whole, tiled in " << createMs << " ms" << std::endl;
+			a_out << "  untextured\t" << plainMs << " ms" << std::endl;
+		}
+		example.SetGroundTexture(&texture, 100.f);
+		std::vector<ColourRGB> pixels;
+		Timer renderTimer;
+		renderer.Render(example.GetScene(), pixels);
+		const double renderMs = renderTimer.ElapsedMs();
+		example.SetGroundTexture(nullptr, 1.f);
+		if (reference.empty())
+		{
+			reference = pixels;
+		}
+		const TextureCacheStats stats = cache.GetStats();
+		a_out << "  cache " << (double)capacity / (1 << 20) << " MB\t" << renderMs << " ms\t" << stats.lookups << " lookups, "
+			<< 100.0 * (double)stats.hits / (double)std::max(stats.lookups, 1LL) << "% hits, " << stats.tilesLoaded << " tiles read, "
+			<< stats.evictions << " evicted, peak " << (double)stats.peakResidentBytes / (1 << 20) << " MB\tRMS difference "
+			<< RmsError(pixels, reference) << std::endl;
+	}
+	std::remove(tiledFilename);
+}
+
+//\----------------------------------------------------------------------------------
+//\ MathPrecision - each approximation timed over a block of inputs shaped like the ones shading gives it, with the
+//\ most error it made on them. Then the main scene and a generated one are rendered precise and fast. Every hit
+//\ traces both secondary rays, so a ray that grazes an edge in one precision and misses it in the other moves the
+//\ rest of its pixel's random numbers along - the fast image is fresh noise in places, not the precise image plus
+//\ a small error. The error of both against a render with many more rays puts the change next to the noise.
+//\----------------------------------------------------------------------------------
+void Benchmark::MathPrecision(std::ostream& a_out)
+{
+	const int valueCount = 4096;
+	const int repeats = 500;
+	const int ops = valueCount * repeats;
+
+	std::vector<float> bases, exponents, exponents2, logValues, rootValues;
+	std::vector<Vector3> vectors;
+	for (int i = 0; i < valueCount; ++i)
+	{
+		bases.push_back(Random::RandomFloat());							// Dot products and specular powers
+		exponents.push_back((float)Random::RandomRange(1, 255));
+		exponents2.push_back(Random::RandomRange(-20.f, 20.f));
+		logValues.push_back(Random::RandomRange(0.001f, 1000.f));
+		rootValues.push_back(Random::RandomRange(0.001f, 1000.f));			// Squared distances to lights
+		vectors.push_back(Vector3(Random::RandomRange(-10.f, 10.f), Random::RandomRange(-10.f, 10.f), Random::RandomRange(-10.f, 10.f)));
+	}
+	std::vector<float> results(valueCount), fastResults(valueCount);
+	std::vector<Vector3> normals(valueCount), fastNormals(valueCount);
+	float sink = 0.f;		// Results are summed and printed so the optimiser cannot drop the loops
+
+	// Most relative error of the fast results, leaving out results too small to light a pixel
+	auto mostError = [&]()
+	{
+		double most = 0.0;
+		for (int i = 0; i < valueCount; ++i)
+		{
+			if (std::fabs(results[i]) > 1e-6f)
+			{
+				most = std::max(most, std::fabs((double)fastResults[i] - (double)results[i]) / std::fabs((double)results[i]));
+			}
+		}
+		return most;
+	};
+	// Time a_std and a_fast, each filling its results from value i
+	auto compare = [&](const char* a_label, auto a_std, auto a_fast)
+	{
+		Timer baseTimer;
+		for (int r = 0; r < repeats; ++r)
+		{
+			for (int i = 0; i < valueCount; ++i) { results[i] = a_std(i); }
+			sink += results[r % valueCount];
+		}
+		const double baseMs = baseTimer.ElapsedMs();
+		Timer newTimer;
+		for (int r = 0; r < repeats; ++r)
+		{
+			for (int i = 0; i < valueCount; ++i) { fastResults[i] = a_fast(i); }
+			sink += fastResults[r % valueCount];
+		}
+		const double newMs = newTimer.ElapsedMs();
+		Report(a_out, a_label, "std", baseMs, "fast", newMs, ops);
+		a_out << "\t\tmost relative error " << mostError() << std::endl;
+	};
+
+	a_out << "Fast math benchmark - " << valueCount << " values, " << repeats << " times" << std::endl;
+	compare("pow      ", [&](int i) { return powf(bases[i], exponents[i]); }, [&](int i) { return FastMath::Pow(bases[i], exponents[i]); });
+	compare("exp2     ", [&](int i) { return exp2f(exponents2[i]); }, [&](int i) { return FastMath::Exp2(exponents2[i]); });
+	compare("log2     ", [&](int i) { return log2f(logValues[i]); }, [&](int i) { return FastMath::Log2(logValues[i]); });
+	compare("rsqrt    ", [&](int i) { return 1.f / sqrtf(rootValues[i]); }, [&](int i) { return FastMath::RSqrt(rootValues[i]); });
+
+	Timer baseTimer;
+	for (int r = 0; r < repeats; ++r)
+	{
+		for (int i = 0; i < valueCount; ++i) { normals[i] = Normalize(vectors[i]); }
+		sink += normals[r % valueCount].x;
+	}
+	const double baseMs = baseTimer.ElapsedMs();
+	Timer newTimer;
+	for (int r = 0; r < repeats; ++r)
+	{
+		for (int i = 0; i < valueCount; ++i) { fastNormals[i] = FastMath::Normalize(vectors[i]); }
+		sink += fastNormals[r % valueCount].x;
+	}
+	Report(a_out, "normalize", "std", baseMs, "fast", newTimer.ElapsedMs(), ops);
+	double mostLengthError = 0.0;
+	for (const Vector3& normal : fastNormals)
+	{
+		mostLengthError = std::max(mostLengthError, std::fabs(std::sqrt((double)normal.x * normal.x + (double)normal.y * normal.y + (double)normal.z * normal.z) - 1.0));
+	}
+	a_out << "\t\tmost length error " << mostLengthError << std::endl;
+	a_out << "  (sink " << sink << ")" << std::endl;
+
+	// Renders - the time of each precision and how far the fast image is from the precise one
+	const int imageWidth = 160;
+	const int imageHeight = 80;
+	const int rays = 16;
+	const int referenceRays = 256;
+	const FastMath::Precision startPrecision = FastMath::GetPrecision();
+	ExampleScene example((float)imageWidth / (float)imageHeight);
+	GeneratedSceneSettings settings;
+	settings.objects = 2000;
+	settings.glass = 0.3f;
+	settings.lights = 3;
+	GeneratedScene generated(settings, (float)imageWidth / (float)imageHeight);
+	const Scene* scenes[] = { &example.GetScene(), &generated.GetScene() };
+	const char* sceneNames[] = { "main scene", "generated" };
+	Renderer renderer(imageWidth, imageHeight, rays);
+	renderer.SetShowProgress(false);
+	Renderer referenceRenderer(imageWidth, imageHeight, referenceRays);
+	referenceRenderer.SetShowProgress(false);
+	a_out << "  renders " << imageWidth << "x" << imageHeight << ", " << rays << " rays per pixel, references " << referenceRays << std::endl;
+	for (int s = 0; s < 2; ++s)
+	{
+		std::vector<ColourRGB> reference, precise, fast;
+		FastMath::SetPrecision(FastMath::PRECISE);
+		referenceRenderer.Render(*scenes[s], reference);
+		Timer preciseTimer;
+		renderer.Render(*scenes[s], precise);
+		const double preciseMs = preciseTimer.ElapsedMs();
+		FastMath::SetPrecision(FastMath::FAST);
+		Timer fastTimer;
+		renderer.Render(*scenes[s], fast);
+		const double fastMs = fastTimer.ElapsedMs();
+		const Regression::ImageDifference difference = Regression::Compare(fast, precise, imageWidth, imageHeight);
+		a_out << "  " << sceneNames[s] << "\tprecise " << preciseMs << " ms\tfast " << fastMs << " ms\tspeed up " << preciseMs / fastMs
+			<< "x" << std::endl;
+		a_out << "    fast against precise PSNR " << difference.psnr << " dB, mean error " << difference.meanError << ", 99% under "
+			<< difference.peakError << "\tRMS error against the reference - precise " << RmsError(precise, reference) << ", fast "
+			<< RmsError(fast, reference) << std::endl;
+	}
+	FastMath::SetPrecision(startPrecision);
+}
+
+//\----------------------------------------------------------------------------------
+//\ Light batch - random hits on a few materials in front of each kind of light, shaded in the chunks the
+//\ wavefront renderer uses. The batch has to give every hit the same bits as SampleLight and ShadeSample.
+//\----------------------------------------------------------------------------------
+void Benchmark::LightBatch(std::ostream& a_out)
+{
+	const int hitCount = 1 << 16;
+	const int batchSize = 256;
+	const int repeats = 20;
+
+	const Material materials[] = {
+		Material(Vector3(0.8f, 0.3f, 0.3f), 0.1f, 0.8f, 0.5f, 0.2f, 0.f, 0.f, 1.f),
+		Material(Vector3(0.3f, 0.8f, 0.3f), 0.1f, 0.6f, 0.9f, 0.7f, 0.f, 0.f, 1.f),
+		Material(Vector3(0.9f, 0.9f, 0.9f), 0.05f, 0.9f, 0.1f, 0.95f, 0.f, 0.f, 1.f) };
+	const Material* materialList[] = { &materials[0], &materials[1], &materials[2] };
+	std::vector<float> positionX(hitCount), positionY(hitCount), positionZ(hitCount);
+	std::vector<float> normalX(hitCount), normalY(hitCount), normalZ(hitCount);
+	std::vector<float> albedoR(hitCount), albedoG(hitCount), albedoB(hitCount);
+	std::vector<int> materialIndex(hitCount), seeds(hitCount), batchSeeds(hitCount);
+	std::vector<IntersectResponse> hits(hitCount);
+	for (int i = 0; i < hitCount; ++i)
+	{
+		IntersectResponse& ir = hits[i];
+		ir.HitPos = Vector3(Random::RandomRange(-10.f, 10.f), Random::RandomRange(-2.f, 2.f), Random::RandomRange(-10.f, 10.f));
+		ir.SurfaceNormal = Normalize(Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f)));
+		materialIndex[i] = (i / 64) % 3;					// Runs of one material, as the wavefront shading order leaves them
+		ir.material = const_cast<Material*>(materialList[materialIndex[i]]);
+		const Vector3 albedo = ir.material->GetAlbedo(ir);
+		positionX[i] = ir.HitPos.x;
+		positionY[i] = ir.HitPos.y;
+		positionZ[i] = ir.HitPos.z;
+		normalX[i] = ir.SurfaceNormal.x;
+		normalY[i] = ir.SurfaceNormal.y;
+		normalZ[i] = ir.SurfaceNormal.z;
+		albedoR[i] = albedo.x;
+		albedoG[i] = albedo.y;
+		albedoB[i] = albedo.z;
+		seeds[i] = Random::RandomRange(1, 1 << 30);
+	}
+	const Vector3 eyePosition(0.f, 2.f, 20.f);
+	std::vector<float> directionX(hitCount), directionY(hitCount), directionZ(hitCount), distance(hitCount);
+	std::vector<float> colourR(hitCount), colourG(hitCount), colourB(hitCount);
+	std::vector<LightSample> samples(hitCount);
+	std::vector<ColourRGB> colours(hitCount);
+
+	DirectionalLight directional(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f), Vector3(-0.3f, -1.f, -0.4f));
+	PointLight point(Vector3(0.f, 8.f, 0.f), ColourRGB(1.f, 0.9f, 0.8f), 60.f);
+	SpotLight spot(Vector3(0.f, 8.f, 0.f), Vector3(0.2f, -1.f, 0.1f), ColourRGB(1.f, 1.f, 1.f), 60.f, 25.f, 40.f);
+	AreaLight area(Vector3(0.f, 8.f, 0.f), Vector3(0.f, -1.f, 0.f), 4.f, 2.f, ColourRGB(1.f, 1.f, 1.f), 60.f);
+	const Light* lights[] = { &directional, &point, &spot, &area };
+	const char* lightNames[] = { "directional", "point      ", "spot       ", "area       " };
+
+	const FastMath::Precision startPrecision = FastMath::GetPrecision();
+	float sink = 0.f;
+	a_out << "Light batch benchmark - " << hitCount << " hits in batches of " << batchSize << ", " << repeats << " times" << std::endl;
+	for (FastMath::Precision precision : { FastMath::PRECISE, FastMath::FAST })
+	{
+		FastMath::SetPrecision(precision);
+		a_out << "  " << FastMath::PrecisionName(precision) << std::endl;
+		for (int l = 0; l < 4; ++l)
+		{
+			const Light* light = lights[l];
+			double hitMs = 1e30;
+			double batchMs = 1e30;
+			for (int r = 0; r < repeats; ++r)
+			{
+				Timer hitTimer;
+				for (int i = 0; i < hitCount; ++i)
+				{
+					Random::SetSeed(seeds[i]);
+					samples[i] = light->SampleLight(hits[i].HitPos);
+					colours[i] = light->ShadeSample(hits[i], eyePosition, samples[i]);
+				}
+				hitMs = std::min(hitMs, hitTimer.ElapsedMs());
+				sink += colours[r].x;
+
+				batchSeeds = seeds;
+				Timer batchTimer;
+				for (int first = 0; first < hitCount; first += batchSize)
+				{
+					const ShadingBatch batch = { std::min(batchSize, hitCount - first), &positionX[first], &positionY[first], &positionZ[first],
+						&normalX[first], &normalY[first], &normalZ[first], &albedoR[first], &albedoG[first], &albedoB[first],
+						&materialIndex[first], materialList, &batchSeeds[first], eyePosition };
+					const LightBatchResult result = { &directionX[first], &directionY[first], &directionZ[first], &distance[first],
+						&colourR[first], &colourG[first], &colourB[first] };
+					light->ShadeBatch(batch, result);
+				}
+				batchMs = std::min(batchMs, batchTimer.ElapsedMs());
+				sink += colourR[r];
+			}
+
+			int mismatches = 0;
+			for (int i = 0; i < hitCount; ++i)
+			{
+				if (samples[i].directionToLight.x != directionX[i] || samples[i].directionToLight.y != directionY[i] || samples[i].directionToLight.z != directionZ[i]
+					|| samples[i].distance != distance[i] || colours[i].x != colourR[i] || colours[i].y != colourG[i] || colours[i].z != colourB[i])
+				{
+					++mismatches;
+				}
+			}
+			Report(a_out, lightNames[l], "per hit", hitMs, "batch", batchMs, hitCount);
+			a_out << "		" << mismatches << " hits differ" << std::endl;
+		}
+	}
+	a_out << "  (sink " << sink << ")" << std::endl;
+	FastMath::SetPrecision(startPrecision);
+}
+
+//\----------------------------------------------------------------------------------
+//\ Grid - a box of particles that all move every frame, bouncing off the walls. Each way of keeping the
+//\ acceleration structure up to date plays the same frames, then the build times are compared on their own.
+//\----------------------------------------------------------------------------------
+void Benchmark::Grid(std::ostream& a_out)
+{
+	const int particleCount = 10000;
+	const int frameCount = 10;
+	const int imageWidth = 128;
+	const int imageHeight = 64;
+	const Vector3 boxSize(20.f, 10.f, 20.f);
+	const float radius = 0.15f;
+	const float speed = 0.3f;					// Most a particle moves in a frame
+
+	Material groundMaterial = Material(Vector3(0.f, 0.6f, 0.f), 0.2f, 0.9f, 0.5f, 1.f, 0.0f, 0.f, 2.61f);
+	Material particleMaterial = Material(Vector3(0.3f, 0.6f, 1.f), 0.2f, 0.9f, 0.6f, 1.f, 0.0f, 0.0f, 1.52f);
+	Ellipsoid ground(Vector3(0.f, -1000.f, 0.f), 1000.f);
+	ground.SetMaterial(&groundMaterial);
+	std::vector<Vector3> startPositions;
+	std::vector<Vector3> velocities;
+	Random::SetSeed(1);
+	for (int i = 0; i < particleCount; ++i)
+	{
+		startPositions.push_back(Vector3(Random::RandomRange(-0.5f, 0.5f) * boxSize.x, Random::RandomRange(radius, boxSize.y),
+			-Random::RandomRange(0.f, boxSize.z) - 2.f));
+		velocities.push_back(Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f)) * speed);
+	}
+	std::vector<Ellipsoid> particles(particleCount);
+	DirectionalLight light = DirectionalLight(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f), Vector3(-0.5773f, -0.5733f, -0.5773f));
+	Camera camera;
+	camera.SetPerspective(60.f, (float)imageWidth / (float)imageHeight, 0.1f, 1000.0f);
+	camera.Setposition(Vector3(0.f, boxSize.y * 0.6f, 4.f));
+	camera.LookAt(Vector3(0.f, boxSize.y * 0.3f, -boxSize.z * 0.5f - 2.f), Vector3(0.f, 1.f, 0.f));
+
+	Scene scene;
+	scene.AddObject(&ground);
+	for (Ellipsoid& particle : particles)
+	{
+		particle.SetMaterial(&particleMaterial);
+		scene.AddObject(&particle);
+	}
+	scene.AddLight(&light);
+	scene.SetCamera(&camera);
+	Renderer renderer(imageWidth, imageHeight, 1);
+	renderer.SetShowProgress(false);
+	renderer.SetSeed(1);
+
+	a_out << "Grid benchmark - " << particleCount << " particles moving for " << frameCount << " frames, " << imageWidth << "x" << imageHeight
+		<< " at 1 ray per pixel" << std::endl;
+	std::vector<ColourRGB> hierarchyImage;
+	auto play = [&](const char* a_label, Scene::Acceleration a_acceleration, int a_update)
+	{
+		std::vector<Vector3> positions = startPositions;
+		std::vector<Vector3> frameVelocities = velocities;
+		for (int i = 0; i < particleCount; ++i)
+		{
+			particles[i].SetTransform(Matrix4::IDENTITY);
+			particles[i].SetScale(Vector3(radius, radius, radius));
+			particles[i].SetPosition(positions[i]);
+		}
+		scene.SetAcceleration(a_acceleration);
+		scene.BuildAccelerationStructure();
+		std::vector<ColourRGB> pixels;
+		double updateMs = 0.0;
+		double renderMs = 0.0;
+		int rebuilds = 0;
+		for (int frame = 0; frame < frameCount; ++frame)
+		{
+			for (int i = 0; i < particleCount; ++i)
+			{
+				positions[i] += frameVelocities[i];
+				float* position = &positions[i].x;
+				float* velocity = &frameVelocities[i].x;
+				const float low[3] = { -0.5f * boxSize.x, radius, -boxSize.z - 2.f };
+				const float high[3] = { 0.5f * boxSize.x, boxSize.y, -2.f };
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					if (position[axis] < low[axis] || position[axis] > high[axis])
+					{
+						velocity[axis] = -velocity[axis];
+						position[axis] = std::min(std::max(position[axis], low[axis]), high[axis]);
+					}
+				}
+				particles[i].SetPosition(positions[i]);
+			}
+			Timer updateTimer;
+			if (a_update == 0)
+			{
+				scene.BuildAccelerationStructure();
+			}
+			else if (a_update == 1)
+			{
+				rebuilds += scene.RefitAccelerationStructure() ? 1 : 0;
+			}
+			else
+			{
+				for (int i = 0; i < particleCount; ++i)
+				{
+					scene.ObjectMoved(i + 1);				// The ground is object 0
+				}
+			}
+			updateMs += updateTimer.ElapsedMs();
+			Timer renderTimer;
+			renderer.Render(scene, pixels);
+			renderMs += renderTimer.ElapsedMs();
+		}
+		a_out << "  " << a_label << "	update " << updateMs / frameCount << " ms	render " << renderMs / frameCount << " ms	frame "
+			<< (updateMs + renderMs) / frameCount << " ms";
+		if (a_update == 1)
+		{
+			a_out << "	" << rebuilds << " rebuilds";
+		}
+		if (hierarchyImage.empty())
+		{
+			hierarchyImage = pixels;
+		}
+		else
+		{
+			int differ = 0;
+			for (size_t p = 0; p < pixels.size(); ++p)
+			{
+				differ += (pixels[p].x != hierarchyImage[p].x || pixels[p].y != hierarchyImage[p].y || pixels[p].z != hierarchyImage[p].z) ? 1 : 0;
+			}
+			a_out << "	" << differ << " pixels differ";
+		}
+		a_out << std::endl;
+	};
+	play("hierarchy rebuilt", Scene::BOUNDING_VOLUME_HIERARCHY, 0);
+	play("hierarchy refit  ", Scene::BOUNDING_VOLUME_HIERARCHY, 1);
+	play("grid rebuilt     ", Scene::UNIFORM_GRID, 0);
+	play("grid updated     ", Scene::UNIFORM_GRID, 2);
+
+	// Build times alone as the scene grows
+	a_out << "  builds" << std::endl;
+	for (int count : { 1000, 10000, 100000 })
+	{
+		std::vector<Ellipsoid> objects(count);
+		std::vector<const Primitive*> objectList;
+		for (Ellipsoid& object : objects)
+		{
+			object.SetScale(Vector3(radius, radius, radius));
+			object.SetPosition(Vector3(Random::RandomRange(-0.5f, 0.5f) * boxSize.x, Random::RandomRange(0.f, boxSize.y), -Random::RandomRange(0.f, boxSize.z)));
+			objectList.push_back(&object);
+		}
+		BVH bvh;
+		Timer bvhTimer;
+		bvh.Build(objectList);
+		const double bvhMs = bvhTimer.ElapsedMs();
+		UniformGrid grid;
+		Timer gridTimer;
+		grid.Build(objectList);
+		const double gridMs = gridTimer.ElapsedMs();
+		a_out << "  " << count << " objects	hierarchy " << bvhMs << " ms	grid " << gridMs << " ms (" << grid.GetCellCount() << " cells)	speed up "
+			<< bvhMs / gridMs << "x" << std::endl;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Instances - clusters of small parts that spin and bob every frame. The flat scene holds every part and
+//\ has to move each of them and refit or rebuild the whole hierarchy. The two level scene holds one instance
+//\ per cluster over a few shared sub scenes, whose hierarchies are built once in their own space, so a
+//\ frame only sets the instance transforms and refits the small hierarchy over them.
+//\----------------------------------------------------------------------------------
+void Benchmark::Instances(std::ostream& a_out)
+{
+	const int shapeCount = 4;
+	const int partsPerCluster = 256;
+	const int clustersPerSide = 8;
+	const int clusterCount = clustersPerSide * clustersPerSide;
+	const int frameCount = 10;
+	const int imageWidth = 128;
+	const int imageHeight = 64;
+	const float spacing = 3.f;
+
+	Material groundMaterial = Material(Vector3(0.f, 0.6f, 0.f), 0.2f, 0.9f, 0.5f, 1.f, 0.0f, 0.f, 2.61f);
+	Material partMaterial = Material(Vector3(1.f, 0.6f, 0.3f), 0.2f, 0.9f, 0.6f, 1.f, 0.0f, 0.0f, 1.52f);
+	Ellipsoid ground(Vector3(0.f, -1000.f, 0.f), 1000.f);
+	ground.SetMaterial(&groundMaterial);
+
+	// The parts of each shape in its own space, a ball of radius 1 made of small squashed ellipsoids
+	Random::SetSeed(1);
+	std::vector<AffineTransform> partTransforms;
+	for (int i = 0; i < shapeCount * partsPerCluster; ++i)
+	{
+		Vector3 offset;
+		do
+		{
+			offset = Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f));
+		} while (offset.Length() > 1.f);
+		AffineTransform part;
+		part.Scale(Vector3(Random::RandomRange(0.08f, 0.2f), Random::RandomRange(0.08f, 0.2f), Random::RandomRange(0.08f, 0.2f)));
+		part.SetTranslation(offset * 0.85f);
+		partTransforms.push_back(part);
+	}
+	std::vector<Ellipsoid> shapeParts(shapeCount * partsPerCluster);
+	std::vector<Scene> shapes(shapeCount);
+	for (int i = 0; i < shapeCount * partsPerCluster; ++i)
+	{
+		shapeParts[i].SetTransform(partTransforms[i]);
+		shapeParts[i].SetMaterial(&partMaterial);
+		shapes[i / partsPerCluster].AddObject(&shapeParts[i]);
+	}
+	for (Scene& shape : shapes)
+	{
+		shape.BuildAccelerationStructure();
+	}
+
+	// Where each cluster is on a frame - turned about the up axis and raised by its own amount
+	auto clusterTransform = [&](int a_cluster, int a_frame)
+	{
+		const float angle = 0.3f * (float)a_frame + 0.7f * (float)a_cluster;
+		const float c = std::cos(angle);
+		const float s = std::sin(angle);
+		const float x = ((float)(a_cluster % clustersPerSide) - 0.5f * (float)(clustersPerSide - 1)) * spacing;
+		const float z = -(float)(a_cluster / clustersPerSide) * spacing - 4.f;
+		const float height = 1.2f + 0.5f * std::sin(0.5f * (float)a_frame + (float)a_cluster);
+		return AffineTransform(Vector3(c, 0.f, -s), Vector3(0.f, 1.f, 0.f), Vector3(s, 0.f, c), Vector3(x, height, z));
+	};
+
+	Scene flatScene;
+	Scene twoLevelScene;
+	flatScene.AddObject(&ground);
+	twoLevelScene.AddObject(&ground);
+	std::vector<Ellipsoid> flatParts(clusterCount * partsPerCluster);
+	std::vector<Instance> instances;
+	instances.reserve(clusterCount);
+	for (int cluster = 0; cluster < clusterCount; ++cluster)
+	{
+		const int shape = cluster % shapeCount;
+		for (int i = 0; i < partsPerCluster; ++i)
+		{
+			flatParts[cluster * partsPerCluster + i].SetMaterial(&partMaterial);
+			flatScene.AddObject(&flatParts[cluster * partsPerCluster + i]);
+		}
+		instances.push_back(Instance(&shapes[shape], clusterTransform(cluster, 0)));
+	}
+	for (Instance& instance : instances)
+	{
+		twoLevelScene.AddObject(&instance);
+	}
+
+	DirectionalLight light = DirectionalLight(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f), Vector3(-0.5773f, -0.5733f, -0.5773f));
+	Camera camera;
+	camera.SetPerspective(60.f, (float)imageWidth / (float)imageHeight, 0.1f, 1000.0f);
+	camera.Setposition(Vector3(0.f, 8.f, 4.f));
+	camera.LookAt(Vector3(0.f, 0.f, -spacing * (float)clustersPerSide * 0.5f - 4.f), Vector3(0.f, 1.f, 0.f));
+	for (Scene* scene : { &flatScene, &twoLevelScene })
+	{
+		scene->AddLight(&light);
+		scene->SetCamera(&camera);
+	}
+	Renderer renderer(imageWidth, imageHeight, 1);
+	renderer.SetShowProgress(false);
+	renderer.SetSeed(1);
+
+	a_out << "Instances benchmark - " << clusterCount << " clusters of " << partsPerCluster << " parts moving for " << frameCount << " frames, "
+		<< imageWidth << "x" << imageHeight << " at 1 ray per pixel" << std::endl;
+	std::vector<ColourRGB> flatImage;
+	auto play = [&](const char* a_label, bool a_twoLevel, bool a_rebuild)
+	{
+		Scene& scene = a_twoLevel ? twoLevelScene : flatScene;
+		std::vector<ColourRGB> pixels;
+		double updateMs = 0.0;
+		double renderMs = 0.0;
+		for (int frame = 0; frame <= frameCount; ++frame)
+		{
+			Timer updateTimer;
+			for (int cluster = 0; cluster < clusterCount; ++cluster)
+			{
+				const AffineTransform transform = clusterTransform(cluster, frame);
+				if (a_twoLevel)
+				{
+					instances[cluster].SetTransform(transform);
+					continue;
+				}
+				const int shape = cluster % shapeCount;
+				for (int i = 0; i < partsPerCluster; ++i)
+				{
+					flatParts[cluster * partsPerCluster + i].SetTransform(transform * partTransforms[shape * partsPerCluster + i]);
+				}
+			}
+			// Frame 0 only places everything for the first build and is not timed
+			if (frame == 0 || a_rebuild)
+			{
+				scene.BuildAccelerationStructure();
+			}
+			else
+			{
+				scene.RefitAccelerationStructure();
+			}
+			if (frame == 0)
+			{
+				continue;
+			}
+			updateMs += updateTimer.ElapsedMs();
+			Timer renderTimer;
+			renderer.Render(scene, pixels);
+			renderMs += renderTimer.ElapsedMs();
+		}
+		a_out << "  " << a_label << "\tupdate " << updateMs / frameCount << " ms\trender " << renderMs / frameCount << " ms\tframe "
+			<< (updateMs + renderMs) / frameCount << " ms";
+		if (flatImage.empty())
+		{
+			flatImage = pixels;
+		}
+		else
+		{
+			a_out << "\trms error " << RmsError(pixels, flatImage);
+		}
+		a_out << std::endl;
+	};
+	play("flat refit     ", false, false);
+	play("flat rebuilt   ", false, true);
+	play("two level refit", true, false);
+}
+
+//\----------------------------------------------------------------------------------
+//\ Sweep - a quick run of the scaling sweep small enough for the benchmark list, run with the defaults otherwise
+//\----------------------------------------------------------------------------------
+void Benchmark::Sweep(std::ostream& a_out)
+{
+	SweepSettings settings;
+	settings.width = 128;
+	settings.height = 64;
+	Sweep(settings, a_out, std::clog);
+}
+
+void Benchmark::Sweep(const SweepSettings& a_settings, std::ostream& a_csv, std::ostream& a_log)
+{
+	std::vector<int> threadCounts = a_settings.threadCounts;
+	if (threadCounts.empty())
+	{
+		for (int threads = 1; threads < Parallel::DefaultThreadCount(); threads *= 2)
+		{
+			threadCounts.push_back(threads);
+		}
+		threadCounts.push_back(Parallel::DefaultThreadCount());
+	}
+
+	a_csv << "objects,ellipsoids,glass,lights,depth,seed,width,height,spp,threads,build_ms,render_ms,rays,shadow_rays,"
+		"mrays_per_second,speed_up,efficiency" << std::endl;
+	const float aspectRatio = (float)a_settings.width / (float)a_settings.height;
+	for (int objects : a_settings.objectCounts)
+	{
+		GeneratedSceneSettings sceneSettings = a_settings.scene;
+		sceneSettings.objects = objects;
+		Timer buildTimer;
+		GeneratedScene generated(sceneSettings, aspectRatio);
+		const double buildMs = buildTimer.ElapsedMs();
+
+		for (int rays : a_settings.raysPerPixel)
+		{
+			Renderer renderer(a_settings.width, a_settings.height, rays);
+			renderer.SetShowProgress(false);
+			std::vector<ColourRGB> pixels;
+			double firstMs = 0.0;
+			for (size_t t = 0; t < threadCounts.size(); ++t)
+			{
+				WavefrontRenderer wavefront(renderer, 1 << 18, threadCounts[t]);
+				double renderMs = 1e30;
+				for (int r = 0; r < std::max(a_settings.repeats, 1); ++r)
+				{
+					Timer renderTimer;
+					wavefront.Render(generated.GetScene(), pixels);
+					renderMs = std::min(renderMs, renderTimer.ElapsedMs());
+				}
+				if (t == 0)
+				{
+					firstMs = renderMs;
+				}
+				// Every ray is counted, camera, bounce and shadow rays alike
+				const WavefrontStageTimes& times = wavefront.GetStageTimes();
+				const long long traced = times.extensions + times.shadowRays;
+				const double speedUp = firstMs / renderMs;
+				a_csv << objects << "," << sceneSettings.ellipsoids << "," << sceneSettings.glass << "," << sceneSettings.lights << ","
+					<< sceneSettings.depth << "," << sceneSettings.seed << "," << a_settings.width << "," << a_settings.height << ","
+					<< rays << "," << threadCounts[t] << "," << buildMs << "," << renderMs << "," << times.extensions << ","
+					<< times.shadowRays << "," << (double)traced / (renderMs * 1e3) << "," << speedUp << ","
+					<< speedUp * (double)threadCounts[0] / (double)threadCounts[t] << std::endl;
+				a_log << "Sweep - " << objects << " objects, " << rays << " spp, " << threadCounts[t] << " threads: "
+					<< renderMs << " ms" << std::endl;
+			}
+		}
+	}
+}
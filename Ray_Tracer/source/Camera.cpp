@@ -13,6 +13,7 @@
 //\ INCLUDES
 //\------------------------
 #include "Camera.h"
+#include "FastMath.h"
 //\------------------------
 
 //\====================================================================================================
@@ -21,7 +22,8 @@
 Camera::Camera() : m_aspectRatio(0.f), m_fov(0.f), m_zNear(0.f), m_zFar(0.f)
 {
 m_projectionMatrix = Matrix4::IDENTITY;
-	m_Transform = Matrix4::IDENTITY;
+	m_invProjectionMatrix = Matrix4::IDENTITY;
+	m_Transform = AffineTransform::IDENTITY;
 }
 Camera::~Camera()
 {
@@ -29,13 +31,12 @@ Camera::~Camera()
 
 void Camera::Setposition(Vector3 a_v3Pos)
 {
-	m_Transform.SetColumnV3(3, a_v3Pos);
+	m_Transform.SetTranslation(a_v3Pos);
 }
 
 Vector3 Camera::GetPosition()
 {
-	Vector4 pos = m_Transform.GetColumnV3(3);
-	return Vector3(pos.x, pos.y, pos.z);
+	return m_Transform.GetTranslation();
 }
 //\====================================================================================================
 //	Perspective and Orthographic Functions - 
@@ -47,6 +48,7 @@ void Camera::SetPerspective(float a_fieldOfView, float a_aspectRatio, float a_ne
 	m_zNear = a_near;
 	m_zFar = a_far;
 	m_projectionMatrix.Perspective(m_fov, a_aspectRatio, a_near, a_far);
+	m_invProjectionMatrix = m_projectionMatrix.Inverse();
 }
 void Camera::SetOrthographic(float a_left, float a_right, float a_top, float a_bottom, float a_near, float a_far)
 {
@@ -54,28 +56,27 @@ void Camera::SetOrthographic(float a_left, float a_right, float a_top, float a_b
 	m_zNear = a_near;
 	m_zFar = a_far;
 	m_projectionMatrix.Orthographic(a_left, a_right, a_top, a_bottom, a_near, a_far);
+	m_invProjectionMatrix = m_projectionMatrix.Inverse();
 }
 
 void Camera::LookAt(const Vector3& a_v3Target, const Vector3& a_v3Up)
 {
 	Matrix4 viewMatrix = Matrix4::LookAt(GetPosition(), a_v3Target, a_v3Up);
-	m_Transform = viewMatrix.Inverse();
+	m_Transform = AffineTransform(viewMatrix).Inverse();		// View matrix is orthonormal so this takes the fast inverse
 }
 
 Ray Camera::CastRay(Vector2 a_screenspaceCoord)
 {
-	// Get Projection View Matrix
-	Matrix4 projViewMatrix = m_projectionMatrix * m_Transform.Inverse();
-	//Invert to transform screen coordination into world Space
-	Matrix4 invPV = projViewMatrix.Inverse();
-	// Multiply screen coordinates by inverse projection matrix to get position on near plane
-	Vector4 nearProjSpaceCoords = invPV * Vector4(a_screenspaceCoord.x, a_screenspaceCoord.y, -1.f, 1.f);
+	// The inverse of the Projection View Matrix is the camera transform multiplied by the inverse projection
+	// Multiply screen coordinates by inverse projection matrix to get position on near plane in view space
+	Vector4 nearProjSpaceCoords = m_invProjectionMatrix * Vector4(a_screenspaceCoord.x, a_screenspaceCoord.y, -1.f, 1.f);
 	// We need to handle the perspective divide to get the coordinate on the near place
 	nearProjSpaceCoords = nearProjSpaceCoords * (1.f / nearProjSpaceCoords.w);
-	Vector3 v3Near = Vector3(nearProjSpaceCoords.x, nearProjSpaceCoords.y, nearProjSpaceCoords.z);
+	// Take the near plane point from view space into world space
+	Vector3 v3Near = m_Transform.TransformPoint(nearProjSpaceCoords.xyz());
 	// Subtract the camera position from near plane location to get the direction of the ray.
 	Vector3 v3Projected = v3Near - GetPosition();
-	v3Projected.Normalize();
+	v3Projected = FastMath::NormalizeP(v3Projected);
 	// Create ray starting from camera position with projection
 	Ray cameraRay(GetPosition(), v3Projected);
 
@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				CropMerge.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Assembles crop window renders back into the full image. The pixel values are copied from the
+//						crops as they were written, so crops of a frame merge into a file identical to a full render.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <fstream>
+#include <sstream>
+
+#include "CropMerge.h"
+//\------------------------
+
+namespace
+{
+	// A plain text PPM as written by the renderer - the values are kept as the integers in the file
+	struct CropImage
+	{
+		int					x, y;					// Position in the full image
+		int					fullWidth, fullHeight;
+		int					width, height;
+		std::vector<int>	values;					// Three per pixel
+	};
+
+	bool ReadCrop(const std::string& a_filename, CropImage& a_crop, std::ostream& a_log)
+	{
+		std::ifstream file(a_filename.c_str());
+		std::string magic;
+		if (!(file >> magic) || magic != "P3")
+		{
+			a_log << a_filename << ": not a plain text (P3) PPM image" << std::endl;
+			return false;
+		}
+		a_crop.x = 0;
+		a_crop.y = 0;
+		a_crop.fullWidth = -1;
+		a_crop.fullHeight = -1;
+		// Comments come before the size, a crop comment gives the position and the size of the full image
+		file >> std::ws;
+		while (file.peek() == '#')
+		{
+			std::string comment;
+			std::getline(file, comment);
+			std::istringstream words(comment);
+			std::string hash, keyword;
+			words >> hash >> keyword;
+			if (keyword == "crop")
+			{
+				words >> a_crop.x >> a_crop.y >> a_crop.fullWidth >> a_crop.fullHeight;
+			}
+			file >> std::ws;
+		}
+		int maxValue = 0;
+		if (!(file >> a_crop.width >> a_crop.height >> maxValue) || a_crop.width < 0 || a_crop.height < 0)
+		{
+			a_log << a_filename << ": bad image header" << std::endl;
+			return false;
+		}
+		if (a_crop.fullWidth < 0)
+		{
+			// No crop comment - a full image
+			a_crop.fullWidth = a_crop.width;
+			a_crop.fullHeight = a_crop.height;
+		}
+		if (a_crop.x < 0 || a_crop.y < 0 || a_crop.x + a_crop.width > a_crop.fullWidth || a_crop.y + a_crop.height > a_crop.fullHeight)
+		{
+			a_log << a_filename << ": crop window is outside the full image" << std::endl;
+			return false;
+		}
+		a_crop.values.resize((size_t)a_crop.width * (size_t)a_crop.height * 3);
+		for (int& value : a_crop.values)
+		{
+			if (!(file >> value))
+			{
+				a_log << a_filename << ": image data ends early" << std::endl;
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+bool CropMerge::Merge(const std::vector<std::string>& a_inputs, const std::string& a_output, std::ostream& a_log)
+{
+	int fullWidth = -1;
+	int fullHeight = -1;
+	std::vector<int> values;
+	std::vector<bool> covered;
+	for (const std::string& input : a_inputs)
+	{
+		CropImage crop;
+		if (!ReadCrop(input, crop, a_log))
+		{
+			return false;
+		}
+		if (fullWidth < 0)
+		{
+			fullWidth = crop.fullWidth;
+			fullHeight = crop.fullHeight;
+			values.resize((size_t)fullWidth * (size_t)fullHeight * 3, 0);
+			covered.resize((size_t)fullWidth * (size_t)fullHeight, false);
+		}
+		else if (crop.fullWidth != fullWidth || crop.fullHeight != fullHeight)
+		{
+			a_log << input << ": crop of a " << crop.fullWidth << "x" << crop.fullHeight << " image, expected "
+				<< fullWidth << "x" << fullHeight << std::endl;
+			return false;
+		}
+		for (int i = 0; i < crop.height; ++i)
+		{
+			for (int j = 0; j < crop.width; ++j)
+			{
+				size_t pixel = (size_t)(crop.y + i) * fullWidth + (crop.x + j);
+				size_t cropPixel = (size_t)i * crop.width + j;
+				values[pixel * 3] = crop.values[cropPixel * 3];
+				values[pixel * 3 + 1] = crop.values[cropPixel * 3 + 1];
+				values[pixel * 3 + 2] = crop.values[cropPixel * 3 + 2];
+				covered[pixel] = true;
+			}
+		}
+	}
+	if (fullWidth < 0)
+	{
+		a_log << "No images to merge" << std::endl;
+		return false;
+	}
+	size_t missing = 0;
+	for (bool pixelCovered : covered)
+	{
+		missing += pixelCovered ? 0 : 1;
+	}
+	if (missing > 0)
+	{
+		a_log << missing << " pixels of the " << fullWidth << "x" << fullHeight << " image are not covered by any crop" << std::endl;
+		return false;
+	}
+
+	// Written the same way as Renderer::WritePPM
+	std::ofstream file(a_output.c_str());
+	file << "P3" << std::endl;
+	file << fullWidth << ' ' << fullHeight << std::endl;
+	file << 255 << std::endl;
+	for (int i = 0; i < fullHeight; ++i)
+	{
+		for (int j = 0; j < fullWidth; ++j)
+		{
+			size_t pixel = (size_t)i * fullWidth + j;
+			file << values[pixel * 3] << ' ' << values[pixel * 3 + 1] << ' ' << values[pixel * 3 + 2] << ' ';
+		}
+		file << std::endl;
+	}
+	if (!file.good())
+	{
+		a_log << a_output << ": could not write the merged image" << std::endl;
+		return false;
+	}
+	return true;
+}
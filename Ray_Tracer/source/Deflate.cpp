@@ -0,0 +1,694 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Deflate.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Deflate compression (RFC 1951) and the checksums PNG needs, so images can be compressed
+//						without an external library. Each block is written with whichever of stored, fixed or
+//						dynamic Huffman codes is smallest. Pieces of one stream can be compressed on separate
+//						threads and joined end to end.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <queue>
+
+#include "Deflate.h"
+//\------------------------
+
+namespace
+{
+	const int WINDOW_SIZE = 32768;
+	const int WINDOW_MASK = WINDOW_SIZE - 1;
+	const int HASH_BITS = 15;
+	const int HASH_SIZE = 1 << HASH_BITS;
+	const int MIN_MATCH = 3;
+	const int MAX_MATCH = 258;
+	const int MAX_CHAIN = 48;				// Candidates looked at per position - more compresses a little better, slower
+	const int GOOD_MATCH = 64;				// Stop looking once a match this long is found
+	const int BLOCK_SYMBOLS = 32768;		// Literals and matches per block before its codes are rebuilt
+
+	const int LITLEN_CODES = 288;
+	const int DIST_CODES = 30;
+	const int CODELEN_CODES = 19;
+	const int END_OF_BLOCK = 256;
+
+	const int LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const int LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const int DIST_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+		4097, 6145, 8193, 12289, 16385, 24577 };
+	const int DIST_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	// Order the code length code lengths are sent in
+	const int CODELEN_ORDER[CODELEN_CODES] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	//\----------------------------------------------------------------------------------
+	//\ Lookup tables built once - the code for every match length and distance, and the CRC of every byte
+	//\----------------------------------------------------------------------------------
+	struct Tables
+	{
+		unsigned char lengthCode[MAX_MATCH + 1];
+		unsigned char distCode[512];		// Distances up to 256 directly, longer ones in steps of 128
+		unsigned int crc[256];
+
+		Tables()
+		{
+			for (int code = 0; code < 29; ++code)
+			{
+				for (int length = LENGTH_BASE[code]; length < LENGTH_BASE[code] + (1 << LENGTH_EXTRA[code]) && length <= MAX_MATCH; ++length)
+				{
+					lengthCode[length] = (unsigned char)code;
+				}
+			}
+			// 258 has a code of its own rather than being the last of code 284's range
+			lengthCode[MAX_MATCH] = 28;
+			for (int code = 0; code < DIST_CODES; ++code)
+			{
+				for (int dist = DIST_BASE[code]; dist < DIST_BASE[code] + (1 << DIST_EXTRA[code]); ++dist)
+				{
+					if (dist <= 256)
+					{
+						distCode[dist - 1] = (unsigned char)code;
+					}
+					else
+					{
+						distCode[256 + ((dist - 1) >> 7)] = (unsigned char)code;
+					}
+				}
+			}
+			for (unsigned int n = 0; n < 256; ++n)
+			{
+				unsigned int c = n;
+				for (int k = 0; k < 8; ++k)
+				{
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				}
+				crc[n] = c;
+			}
+		}
+
+		int DistanceCode(int a_distance) const
+		{
+			return (a_distance <= 256) ? distCode[a_distance - 1] : distCode[256 + ((a_distance - 1) >> 7)];
+		}
+	};
+
+	const Tables& GetTables()
+	{
+		static const Tables tables;
+		return tables;
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Writes bits least significant first, the order deflate packs them into bytes
+	//\----------------------------------------------------------------------------------
+	class BitWriter
+	{
+	public:
+		BitWriter(std::vector<unsigned char>& a_output) : m_output(a_output), m_bits(0), m_count(0) {}
+
+		void Write(unsigned int a_bits, int a_count)
+		{
+			m_bits |= (unsigned long long)a_bits << m_count;
+			m_count += a_count;
+			while (m_count >= 8)
+			{
+				m_output.push_back((unsigned char)m_bits);
+				m_bits >>= 8;
+				m_count -= 8;
+			}
+		}
+		// Pad with zeros to the next byte
+		void Align()
+		{
+			if (m_count > 0)
+			{
+				Write(0, 8 - m_count);
+			}
+		}
+		int PendingBits() const { return m_count; }
+
+	private:
+		std::vector<unsigned char>& m_output;
+		unsigned long long m_bits;
+		int m_count;
+	};
+
+	// A literal when distance is zero, otherwise a match of length bytes distance back
+	struct Symbol
+	{
+		unsigned short length;
+		unsigned short distance;
+	};
+
+	//\----------------------------------------------------------------------------------
+	//\ Huffman code lengths for a_frequencies of at most a_maxLength bits. Symbols that never occur get no code.
+	//\----------------------------------------------------------------------------------
+	void BuildLengths(const unsigned int* a_frequencies, int a_count, int a_maxLength, unsigned char* a_lengths)
+	{
+		std::memset(a_lengths, 0, a_count);
+		std::vector<int> used;
+		for (int i = 0; i < a_count; ++i)
+		{
+			if (a_frequencies[i] > 0)
+			{
+				used.push_back(i);
+			}
+		}
+		if (used.empty())
+		{
+			return;
+		}
+		if (used.size() == 1)
+		{
+			a_lengths[used[0]] = 1;
+			return;
+		}
+
+		// Plain Huffman tree first - leaves are 0 -> used-1, the internal nodes follow
+		std::vector<unsigned long long> weight(used.size() * 2);
+		std::vector<int> parent(used.size() * 2, -1);
+		typedef std::pair<unsigned long long, int> Node;
+		std::priority_queue<Node, std::vector<Node>, std::greater<Node>> heap;
+		for (size_t i = 0; i < used.size(); ++i)
+		{
+			weight[i] = a_frequencies[used[i]];
+			heap.push(Node(weight[i], (int)i));
+		}
+		int next = (int)used.size();
+		while (heap.size() > 1)
+		{
+			Node a = heap.top(); heap.pop();
+			Node b = heap.top(); heap.pop();
+			weight[next] = a.first + b.first;
+			parent[a.second] = next;
+			parent[b.second] = next;
+			heap.push(Node(weight[next], next));
+			++next;
+		}
+
+		int lengthCounts[64] = {};
+		for (size_t i = 0; i < used.size(); ++i)
+		{
+			int depth = 0;
+			for (int node = (int)i; parent[node] >= 0; node = parent[node])
+			{
+				++depth;
+			}
+			++lengthCounts[std::min(depth, 63)];
+		}
+
+		// Fold anything too long down to the limit, then lengthen the shortest codes that can take it until the
+		// lengths fit the code space again
+		for (int length = a_maxLength + 1; length < 64; ++length)
+		{
+			lengthCounts[a_maxLength] += lengthCounts[length];
+			lengthCounts[length] = 0;
+		}
+		unsigned int total = 0;
+		for (int length = a_maxLength; length > 0; --length)
+		{
+			total += (unsigned int)lengthCounts[length] << (a_maxLength - length);
+		}
+		while (total != (1u << a_maxLength))
+		{
+			--lengthCounts[a_maxLength];
+			for (int length = a_maxLength - 1; length > 0; --length)
+			{
+				if (lengthCounts[length] > 0)
+				{
+					--lengthCounts[length];
+					lengthCounts[length + 1] += 2;
+					break;
+				}
+			}
+			--total;
+		}
+
+		// The most frequent symbols get the shortest codes
+		std::stable_sort(used.begin(), used.end(), [a_frequencies](int a, int b) { return a_frequencies[a] > a_frequencies[b]; });
+		size_t symbol = 0;
+		for (int length = 1; length <= a_maxLength; ++length)
+		{
+			for (int i = 0; i < lengthCounts[length]; ++i)
+			{
+				a_lengths[used[symbol++]] = (unsigned char)length;
+			}
+		}
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Canonical codes for a set of lengths, bit reversed ready for the bit writer
+	//\----------------------------------------------------------------------------------
+	void BuildCodes(const unsigned char* a_lengths, int a_count, unsigned short* a_codes)
+	{
+		int lengthCounts[16] = {};
+		for (int i = 0; i < a_count; ++i)
+		{
+			++lengthCounts[a_lengths[i]];
+		}
+		lengthCounts[0] = 0;
+		unsigned int nextCode[16] = {};
+		unsigned int code = 0;
+		for (int length = 1; length < 16; ++length)
+		{
+			code = (code + lengthCounts[length - 1]) << 1;
+			nextCode[length] = code;
+		}
+		for (int i = 0; i < a_count; ++i)
+		{
+			int length = a_lengths[i];
+			if (length == 0)
+			{
+				a_codes[i] = 0;
+				continue;
+			}
+			unsigned int value = nextCode[length]++;
+			unsigned int reversed = 0;
+			for (int bit = 0; bit < length; ++bit)
+			{
+				reversed = (reversed << 1) | ((value >> bit) & 1);
+			}
+			a_codes[i] = (unsigned short)reversed;
+		}
+	}
+
+	// Make sure at least two symbols have a code - a lone code of one bit is an incomplete code some decoders refuse
+	void EnsureTwoCodes(unsigned int* a_frequencies, int a_count)
+	{
+		int used = 0;
+		for (int i = 0; i < a_count && used < 2; ++i)
+		{
+			used += a_frequencies[i] > 0 ? 1 : 0;
+		}
+		for (int i = 0; i < a_count && used < 2; ++i)
+		{
+			if (a_frequencies[i] == 0)
+			{
+				a_frequencies[i] = 1;
+				++used;
+			}
+		}
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Run length code the literal/length and distance code lengths with the code length alphabet - 16 repeats
+	//\ the previous length 3 -> 6 times, 17 and 18 give runs of 3 -> 10 and 11 -> 138 zeros
+	//\----------------------------------------------------------------------------------
+	struct CodeLength
+	{
+		unsigned char symbol;
+		unsigned char extra;
+	};
+
+	void RunLengthCode(const unsigned char* a_lengths, int a_count, std::vector<CodeLength>& a_output)
+	{
+		a_output.clear();
+		int i = 0;
+		while (i < a_count)
+		{
+			unsigned char length = a_lengths[i];
+			int run = 1;
+			while (i + run < a_count && a_lengths[i + run] == length)
+			{
+				++run;
+			}
+			i += run;
+			if (length == 0)
+			{
+				while (run >= 11)
+				{
+					int count = std::min(run, 138);
+					a_output.push_back(CodeLength{ 18, (unsigned char)(count - 11) });
+					run -= count;
+				}
+				if (run >= 3)
+				{
+					a_output.push_back(CodeLength{ 17, (unsigned char)(run - 3) });
+					run = 0;
+				}
+			}
+			else
+			{
+				a_output.push_back(CodeLength{ length, 0 });
+				--run;
+				while (run >= 3)
+				{
+					int count = std::min(run, 6);
+					a_output.push_back(CodeLength{ 16, (unsigned char)(count - 3) });
+					run -= count;
+				}
+			}
+			while (run-- > 0)
+			{
+				a_output.push_back(CodeLength{ length, 0 });
+			}
+		}
+	}
+
+	int CodeLengthExtraBits(int a_symbol)
+	{
+		return (a_symbol == 16) ? 2 : (a_symbol == 17) ? 3 : (a_symbol == 18) ? 7 : 0;
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Write the symbols of one block with the given codes - no block header
+	//\----------------------------------------------------------------------------------
+	void WriteSymbols(BitWriter& a_writer, const Symbol* a_symbols, size_t a_count, const unsigned char* a_data,
+		const unsigned char* a_litLengths, const unsigned short* a_litCodes, const unsigned char* a_distLengths, const unsigned short* a_distCodes)
+	{
+		const Tables& tables = GetTables();
+		size_t position = 0;
+		for (size_t i = 0; i < a_count; ++i)
+		{
+			const Symbol& symbol = a_symbols[i];
+			if (symbol.distance == 0)
+			{
+				unsigned char literal = a_data[position++];
+				a_writer.Write(a_litCodes[literal], a_litLengths[literal]);
+				continue;
+			}
+			int lengthCode = tables.lengthCode[symbol.length];
+			a_writer.Write(a_litCodes[257 + lengthCode], a_litLengths[257 + lengthCode]);
+			if (LENGTH_EXTRA[lengthCode] > 0)
+			{
+				a_writer.Write(symbol.length - LENGTH_BASE[lengthCode], LENGTH_EXTRA[lengthCode]);
+			}
+			int distCode = tables.DistanceCode(symbol.distance);
+			a_writer.Write(a_distCodes[distCode], a_distLengths[distCode]);
+			if (DIST_EXTRA[distCode] > 0)
+			{
+				a_writer.Write(symbol.distance - DIST_BASE[distCode], DIST_EXTRA[distCode]);
+			}
+			position += symbol.length;
+		}
+		a_writer.Write(a_litCodes[END_OF_BLOCK], a_litLengths[END_OF_BLOCK]);
+	}
+
+	// Raw bytes as stored blocks of up to 65535 bytes, the last marked final if a_final is set
+	void WriteStored(BitWriter& a_writer, const unsigned char* a_data, size_t a_size, bool a_final, std::vector<unsigned char>& a_output)
+	{
+		do
+		{
+			size_t length = std::min(a_size, (size_t)65535);
+			a_writer.Write((a_final && length == a_size) ? 1 : 0, 1);
+			a_writer.Write(0, 2);
+			a_writer.Align();
+			a_writer.Write((unsigned int)length, 16);
+			a_writer.Write((unsigned int)length ^ 0xffff, 16);
+			a_output.insert(a_output.end(), a_data, a_data + length);
+			a_data += length;
+			a_size -= length;
+		} while (a_size > 0);
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Write one block of symbols covering a_size bytes of a_data in whichever form comes out smallest
+	//\----------------------------------------------------------------------------------
+	void WriteBlock(BitWriter& a_writer, const Symbol* a_symbols, size_t a_count, const unsigned char* a_data, size_t a_size,
+		bool a_final, std::vector<unsigned char>& a_output)
+	{
+		const Tables& tables = GetTables();
+		unsigned int litFrequencies[LITLEN_CODES] = {};
+		unsigned int distFrequencies[DIST_CODES] = {};
+		size_t extraBits = 0;
+		size_t position = 0;
+		for (size_t i = 0; i < a_count; ++i)
+		{
+			const Symbol& symbol = a_symbols[i];
+			if (symbol.distance == 0)
+			{
+				++litFrequencies[a_data[position++]];
+				continue;
+			}
+			int lengthCode = tables.lengthCode[symbol.length];
+			int distCode = tables.DistanceCode(symbol.distance);
+			++litFrequencies[257 + lengthCode];
+			++distFrequencies[distCode];
+			extraBits += LENGTH_EXTRA[lengthCode] + DIST_EXTRA[distCode];
+			position += symbol.length;
+		}
+		litFrequencies[END_OF_BLOCK] = 1;
+
+		// Fixed codes
+		unsigned char fixedLit[LITLEN_CODES];
+		unsigned char fixedDist[DIST_CODES];
+		for (int i = 0; i < LITLEN_CODES; ++i)
+		{
+			fixedLit[i] = (unsigned char)((i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8);
+		}
+		std::fill(fixedDist, fixedDist + DIST_CODES, (unsigned char)5);
+		size_t fixedBits = 3 + extraBits;
+		for (int i = 0; i < LITLEN_CODES; ++i)
+		{
+			fixedBits += (size_t)litFrequencies[i] * fixedLit[i];
+		}
+		for (int i = 0; i < DIST_CODES; ++i)
+		{
+			fixedBits += (size_t)distFrequencies[i] * fixedDist[i];
+		}
+
+		// Dynamic codes, only 286 literal/length codes may be used
+		EnsureTwoCodes(litFrequencies, 286);
+		EnsureTwoCodes(distFrequencies, DIST_CODES);
+		unsigned char litLengths[LITLEN_CODES];
+		unsigned char distLengths[DIST_CODES];
+		BuildLengths(litFrequencies, 286, 15, litLengths);
+		litLengths[286] = litLengths[287] = 0;
+		BuildLengths(distFrequencies, DIST_CODES, 15, distLengths);
+		int litCount = 286;
+		while (litCount > 257 && litLengths[litCount - 1] == 0)
+		{
+			--litCount;
+		}
+		int distCount = DIST_CODES;
+		while (distCount > 1 && distLengths[distCount - 1] == 0)
+		{
+			--distCount;
+		}
+		// Both sets of lengths are coded as one sequence, so runs can carry on from one into the other
+		unsigned char allLengths[286 + DIST_CODES];
+		std::memcpy(allLengths, litLengths, litCount);
+		std::memcpy(allLengths + litCount, distLengths, distCount);
+		std::vector<CodeLength> codeLengths;
+		RunLengthCode(allLengths, litCount + distCount, codeLengths);
+		unsigned int clFrequencies[CODELEN_CODES] = {};
+		for (const CodeLength& codeLength : codeLengths)
+		{
+			++clFrequencies[codeLength.symbol];
+		}
+		EnsureTwoCodes(clFrequencies, CODELEN_CODES);
+		unsigned char clLengths[CODELEN_CODES];
+		BuildLengths(clFrequencies, CODELEN_CODES, 7, clLengths);
+		int clCount = CODELEN_CODES;
+		while (clCount > 4 && clLengths[CODELEN_ORDER[clCount - 1]] == 0)
+		{
+			--clCount;
+		}
+		size_t dynamicBits = 3 + 5 + 5 + 4 + 3 * (size_t)clCount + extraBits;
+		for (const CodeLength& codeLength : codeLengths)
+		{
+			dynamicBits += clLengths[codeLength.symbol] + CodeLengthExtraBits(codeLength.symbol);
+		}
+		for (int i = 0; i < litCount; ++i)
+		{
+			dynamicBits += (size_t)litFrequencies[i] * litLengths[i];
+		}
+		for (int i = 0; i < distCount; ++i)
+		{
+			dynamicBits += (size_t)distFrequencies[i] * distLengths[i];
+		}
+
+		// Stored - the header, padding to a byte then four bytes of length for every 64K
+		size_t storedBits = 3 + (8 - ((a_writer.PendingBits() + 3) & 7)) % 8 + 8 * a_size + 40 * (a_size / 65535 + 1);
+
+		if (storedBits <= fixedBits && storedBits <= dynamicBits)
+		{
+			WriteStored(a_writer, a_data, a_size, a_final, a_output);
+			return;
+		}
+		a_writer.Write(a_final ? 1 : 0, 1);
+		unsigned short litCodes[LITLEN_CODES];
+		unsigned short distCodes[DIST_CODES];
+		if (fixedBits <= dynamicBits)
+		{
+			a_writer.Write(1, 2);
+			BuildCodes(fixedLit, LITLEN_CODES, litCodes);
+			BuildCodes(fixedDist, DIST_CODES, distCodes);
+			WriteSymbols(a_writer, a_symbols, a_count, a_data, fixedLit, litCodes, fixedDist, distCodes);
+			return;
+		}
+		a_writer.Write(2, 2);
+		a_writer.Write(litCount - 257, 5);
+		a_writer.Write(distCount - 1, 5);
+		a_writer.Write(clCount - 4, 4);
+		for (int i = 0; i < clCount; ++i)
+		{
+			a_writer.Write(clLengths[CODELEN_ORDER[i]], 3);
+		}
+		unsigned short clCodes[CODELEN_CODES];
+		BuildCodes(clLengths, CODELEN_CODES, clCodes);
+		for (const CodeLength& codeLength : codeLengths)
+		{
+			a_writer.Write(clCodes[codeLength.symbol], clLengths[codeLength.symbol]);
+			int extra = CodeLengthExtraBits(codeLength.symbol);
+			if (extra > 0)
+			{
+				a_writer.Write(codeLength.extra, extra);
+			}
+		}
+		BuildCodes(litLengths, LITLEN_CODES, litCodes);
+		BuildCodes(distLengths, DIST_CODES, distCodes);
+		WriteSymbols(a_writer, a_symbols, a_count, a_data, litLengths, litCodes, distLengths, distCodes);
+	}
+}
+
+void Deflate::Compress(const unsigned char* a_data, size_t a_size, bool a_final, std::vector<unsigned char>& a_output)
+{
+	BitWriter writer(a_output);
+	std::vector<int> head(HASH_SIZE, -1);
+	std::vector<int> previous(WINDOW_SIZE, -1);
+	std::vector<Symbol> symbols;
+	symbols.reserve(BLOCK_SYMBOLS);
+	auto hash = [a_data](size_t a_position)
+	{
+		unsigned int value = (unsigned int)a_data[a_position] | ((unsigned int)a_data[a_position + 1] << 8) | ((unsigned int)a_data[a_position + 2] << 16);
+		return (int)((value * 2654435761u) >> (32 - HASH_BITS));
+	};
+	auto insert = [&](size_t a_position)
+	{
+		int h = hash(a_position);
+		previous[a_position & WINDOW_MASK] = head[h];
+		head[h] = (int)a_position;
+	};
+
+	size_t blockStart = 0;
+	size_t position = 0;
+	bool wroteFinal = false;
+	while (position < a_size)
+	{
+		int bestLength = 0;
+		int bestDistance = 0;
+		if (position + MIN_MATCH <= a_size)
+		{
+			const int maxLength = (int)std::min((size_t)MAX_MATCH, a_size - position);
+			int candidate = head[hash(position)];
+			for (int chain = 0; chain < MAX_CHAIN && candidate >= 0; ++chain)
+			{
+				int distance = (int)position - candidate;
+				if (distance > WINDOW_SIZE - 1)
+				{
+					break;
+				}
+				// Only worth comparing if it could beat the best so far
+				if (a_data[candidate + bestLength] == a_data[position + bestLength] || bestLength == 0)
+				{
+					int length = 0;
+					while (length < maxLength && a_data[candidate + length] == a_data[position + length])
+					{
+						++length;
+					}
+					if (length > bestLength)
+					{
+						bestLength = length;
+						bestDistance = distance;
+						if (length >= GOOD_MATCH || length == maxLength)
+						{
+							break;
+						}
+					}
+				}
+				int older = previous[candidate & WINDOW_MASK];
+				if (older >= candidate)
+				{
+					break;
+				}
+				candidate = older;
+			}
+			insert(position);
+		}
+
+		if (bestLength >= MIN_MATCH)
+		{
+			symbols.push_back(Symbol{ (unsigned short)bestLength, (unsigned short)bestDistance });
+			for (size_t i = position + 1; i < position + bestLength && i + MIN_MATCH <= a_size; ++i)
+			{
+				insert(i);
+			}
+			position += bestLength;
+		}
+		else
+		{
+			symbols.push_back(Symbol{ 1, 0 });
+			++position;
+		}
+
+		if (symbols.size() >= BLOCK_SYMBOLS)
+		{
+			bool last = a_final && position == a_size;
+			WriteBlock(writer, symbols.data(), symbols.size(), a_data + blockStart, position - blockStart, last, a_output);
+			wroteFinal = last;
+			symbols.clear();
+			blockStart = position;
+		}
+	}
+	if (!symbols.empty() || (a_final && !wroteFinal))
+	{
+		WriteBlock(writer, symbols.data(), symbols.size(), a_data + blockStart, position - blockStart, a_final, a_output);
+	}
+	if (!a_final)
+	{
+		// Empty stored block - ends the piece on a byte boundary without ending the stream
+		WriteStored(writer, nullptr, 0, false, a_output);
+	}
+	writer.Align();
+}
+
+unsigned int Deflate::Adler32(const unsigned char* a_data, size_t a_size, unsigned int a_adler)
+{
+	const unsigned int BASE = 65521;
+	unsigned int a = a_adler & 0xffff;
+	unsigned int b = a_adler >> 16;
+	while (a_size > 0)
+	{
+		// The largest run that cannot overflow before taking the modulus
+		size_t run = std::min(a_size, (size_t)5552);
+		a_size -= run;
+		while (run-- > 0)
+		{
+			a += *a_data++;
+			b += a;
+		}
+		a %= BASE;
+		b %= BASE;
+	}
+	return (b << 16) | a;
+}
+
+unsigned int Deflate::Crc32(const unsigned char* a_data, size_t a_size, unsigned int a_crc)
+{
+	const Tables& tables = GetTables();
+	unsigned int crc = ~a_crc;
+	for (size_t i = 0; i < a_size; ++i)
+	{
+		crc = tables.crc[(crc ^ a_data[i]) & 0xff] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+unsigned int Deflate::Adler32Combine(unsigned int a_first, unsigned int a_second, size_t a_secondSize)
+{
+	const unsigned int BASE = 65521;
+	unsigned int remainder = (unsigned int)(a_secondSize % BASE);
+	unsigned int a = a_first & 0xffff;
+	unsigned int b = (unsigned int)(((unsigned long long)remainder * a) % BASE);
+	a += (a_second & 0xffff) + BASE - 1;
+	b += (a_first >> 16) + (a_second >> 16) + BASE - remainder;
+	a %= BASE;
+	b %= BASE;
+	return (b << 16) | a;
+}
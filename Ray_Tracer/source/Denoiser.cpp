@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Denoiser.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Edge avoiding a-trous wavelet filter for images rendered with few rays per pixel. Each pass
+//						blurs with a 5x5 kernel whose taps are spread twice as far apart as the pass before, and every
+//						tap is weighted by how alike the two pixels' colour, albedo, normal and depth are so the blur
+//						stops at the edges of objects and materials.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cmath>
+
+#include "Denoiser.h"
+#include "ParallelFor.h"
+//\------------------------
+
+namespace
+{
+	const int TILE_SIZE = 32;
+	// B3 spline - the taps of the 5x5 kernel are the products of these
+	const float KERNEL[5] = { 1.f / 16.f, 1.f / 4.f, 3.f / 8.f, 1.f / 4.f, 1.f / 16.f };
+	// Albedo channels darker than this are left in the colour, dividing by them would only amplify the noise
+	const float MIN_ALBEDO = 0.01f;
+
+	float DistanceSquared(const Vector3& a_a, const Vector3& a_b)
+	{
+		Vector3 difference = a_a - a_b;
+		return Dot(difference, difference);
+	}
+
+	float Demodulate(float a_colour, float a_albedo)
+	{
+		return a_albedo > MIN_ALBEDO ? a_colour / a_albedo : a_colour;
+	}
+
+	float Remodulate(float a_colour, float a_albedo)
+	{
+		return a_albedo > MIN_ALBEDO ? a_colour * a_albedo : a_colour;
+	}
+}
+
+Denoiser::Settings Denoiser::DefaultSettings()
+{
+	Settings settings;
+	settings.passes = 2;
+	// Reflections change quickly across a curved mirror, so the normals stop the blur after a small turn and the
+	// colour test is left looser
+	settings.colourSigma = 0.5f;
+	settings.normalSigma = 0.1f;
+	settings.depthSigma = 0.05f;
+	settings.albedoSigma = 0.1f;
+	settings.demodulate = true;
+	return settings;
+}
+
+Denoiser::Denoiser() : m_settings(DefaultSettings()), m_threads(0)
+{
+}
+
+Denoiser::Denoiser(const Settings& a_settings) : m_settings(a_settings), m_threads(0)
+{
+}
+
+Denoiser::~Denoiser()
+{
+}
+
+void Denoiser::Denoise(const std::vector<ColourRGB>& a_pixels, const AOVBuffers& a_aovs, int a_width, int a_height,
+					   std::vector<ColourRGB>& a_output) const
+{
+	const size_t pixelCount = (size_t)a_width * (size_t)a_height;
+	std::vector<ColourRGB> current(a_pixels.begin(), a_pixels.begin() + pixelCount);
+	if (m_settings.demodulate)
+	{
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			const Vector3& albedo = a_aovs.albedo[i];
+			current[i] = ColourRGB(Demodulate(current[i].x, albedo.x), Demodulate(current[i].y, albedo.y), Demodulate(current[i].z, albedo.z));
+		}
+	}
+
+	// Ping pong between the two buffers - every pass reads the whole output of the pass before
+	std::vector<ColourRGB> next(pixelCount);
+	const int tilesX = (a_width + TILE_SIZE - 1) / TILE_SIZE;
+	const int tilesY = (a_height + TILE_SIZE - 1) / TILE_SIZE;
+	float colourSigma = m_settings.colourSigma;
+	for (int pass = 0; pass < m_settings.passes; ++pass)
+	{
+		const int step = 1 << pass;
+		Parallel::For(tilesX * tilesY, [&](int a_tile)
+		{
+			FilterTile(current, a_aovs, a_width, a_height, (a_tile % tilesX) * TILE_SIZE, (a_tile / tilesX) * TILE_SIZE,
+				step, colourSigma, next);
+		}, m_threads);
+		current.swap(next);
+		// Noise is lower after each pass so smaller colour differences are already real detail
+		colourSigma *= 0.5f;
+	}
+
+	a_output.resize(pixelCount);
+	for (size_t i = 0; i < pixelCount; ++i)
+	{
+		if (m_settings.demodulate)
+		{
+			const Vector3& albedo = a_aovs.albedo[i];
+			a_output[i] = ColourRGB(Remodulate(current[i].x, albedo.x), Remodulate(current[i].y, albedo.y), Remodulate(current[i].z, albedo.z));
+		}
+		else
+		{
+			a_output[i] = current[i];
+		}
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Each weight is 2^-(difference / sigma)^2 - a difference of one sigma halves the weight of the tap. The depth
+//\ allowed grows with the distance between the pixels so surfaces seen at a glancing angle are still blurred.
+//\----------------------------------------------------------------------------------
+void Denoiser::FilterTile(const std::vector<ColourRGB>& a_input, const AOVBuffers& a_aovs, int a_width, int a_height,
+						  int a_tileX, int a_tileY, int a_step, float a_colourSigma, std::vector<ColourRGB>& a_output) const
+{
+	const float invColour = 1.f / (a_colourSigma * a_colourSigma);
+	const float invNormal = 1.f / (m_settings.normalSigma * m_settings.normalSigma);
+	const float invAlbedo = 1.f / (m_settings.albedoSigma * m_settings.albedoSigma);
+
+	const int endX = std::min(a_tileX + TILE_SIZE, a_width);
+	const int endY = std::min(a_tileY + TILE_SIZE, a_height);
+	for (int y = a_tileY; y < endY; ++y)
+	{
+		for (int x = a_tileX; x < endX; ++x)
+		{
+			const size_t centre = (size_t)y * a_width + x;
+			const ColourRGB& centreColour = a_input[centre];
+			const Vector3& centreNormal = a_aovs.normal[centre];
+			const Vector3& centreAlbedo = a_aovs.albedo[centre];
+			const float centreDepth = a_aovs.depth[centre];
+
+			ColourRGB sum(0.f, 0.f, 0.f);
+			float weightSum = 0.f;
+			for (int j = 0; j < 5; ++j)
+			{
+				const int ty = y + (j - 2) * a_step;
+				if (ty < 0 || ty >= a_height)
+				{
+					continue;
+				}
+				for (int i = 0; i < 5; ++i)
+				{
+					const int tx = x + (i - 2) * a_step;
+					if (tx < 0 || tx >= a_width)
+					{
+						continue;
+					}
+					const size_t tap = (size_t)ty * a_width + tx;
+					float exponent = DistanceSquared(a_input[tap], centreColour) * invColour
+						+ DistanceSquared(a_aovs.normal[tap], centreNormal) * invNormal
+						+ DistanceSquared(a_aovs.albedo[tap], centreAlbedo) * invAlbedo;
+					const float depth = a_aovs.depth[tap];
+					const float depthScale = std::max(depth, centreDepth);
+					if (depthScale > 0.f)
+					{
+						const float pixels = (float)(std::abs(i - 2) + std::abs(j - 2)) * (float)a_step;
+						const float depthDifference = std::abs(depth - centreDepth) / (m_settings.depthSigma * depthScale * std::max(pixels, 1.f));
+						exponent += depthDifference * depthDifference;
+					}
+					const float weight = KERNEL[i] * KERNEL[j] * std::exp2(-exponent);
+					sum += a_input[tap] * weight;
+					weightSum += weight;
+				}
+			}
+			// The centre tap always has a weight above zero
+			a_output[centre] = sum * (1.f / weightSum);
+		}
+	}
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				DependencySet.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				The primitives and materials that a group of rays touched. The scene adds to the set while
+//						one is being recorded, the incremental renderer keeps one per tile to find the tiles an edit
+//						can change.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+
+#include "DependencySet.h"
+//\------------------------
+
+namespace
+{
+	const size_t MIN_COMPACT_SIZE = 64;
+}
+
+DependencySet::DependencySet() : m_primitivesCompactSize(0), m_materialsCompactSize(0)
+{
+}
+
+DependencySet::~DependencySet()
+{
+}
+
+void DependencySet::Clear()
+{
+	m_primitives.clear();
+	m_materials.clear();
+	m_primitivesCompactSize = 0;
+	m_materialsCompactSize = 0;
+}
+
+// Neighbouring rays mostly touch the same objects so repeats of the last item are skipped straight away,
+// anything else is appended and removed by the compact once the vector has doubled
+template<typename T>
+void DependencySet::Add(std::vector<const T*>& a_items, size_t& a_compactSize, const T* a_item)
+{
+	if (a_item == nullptr || (!a_items.empty() && a_items.back() == a_item))
+	{
+		return;
+	}
+	a_items.push_back(a_item);
+	if (a_items.size() >= std::max(a_compactSize * 2, MIN_COMPACT_SIZE))
+	{
+		Compact(a_items, a_compactSize);
+	}
+}
+
+template<typename T>
+void DependencySet::Compact(std::vector<const T*>& a_items, size_t& a_compactSize)
+{
+	std::sort(a_items.begin(), a_items.end());
+	a_items.erase(std::unique(a_items.begin(), a_items.end()), a_items.end());
+	a_compactSize = a_items.size();
+}
+
+void DependencySet::Add(const Primitive* a_primitive)
+{
+	Add(m_primitives, m_primitivesCompactSize, a_primitive);
+}
+
+void DependencySet::Add(const Material* a_material)
+{
+	Add(m_materials, m_materialsCompactSize, a_material);
+}
+
+void DependencySet::Add(const DependencySet& a_set)
+{
+	for (const Primitive* primitive : a_set.m_primitives) { Add(primitive); }
+	for (const Material* material : a_set.m_materials) { Add(material); }
+}
+
+void DependencySet::Compact()
+{
+	Compact(m_primitives, m_primitivesCompactSize);
+	Compact(m_materials, m_materialsCompactSize);
+}
+
+bool DependencySet::Contains(const Primitive* a_primitive) const
+{
+	return std::binary_search(m_primitives.begin(), m_primitives.end(), a_primitive);
+}
+
+bool DependencySet::Contains(const Material* a_material) const
+{
+	return std::binary_search(m_materials.begin(), m_materials.end(), a_material);
+}
@@ -12,6 +12,7 @@
 //\ INCLUDES
 //\------------------------
 #include <cmath>
+#include <limits>
 #include "DirectionalLight.h"
 #include "MathUtil.h"
 #include "Material.h"
@@ -34,47 +35,36 @@ DirectionalLight::~DirectionalLight()
 
 void DirectionalLight::SetDirection(const Vector3& a_direction, const Vector3& a_up)
 {
-	m_Transform.SetColumnV3(2, a_direction);
-	m_Transform.SetColumnV3(1, a_up);
-	m_Transform.Orthonormalise();
+	// Orthonormalise lives on Matrix4 - build the basis there and store the affine part back
+	Matrix4 transform = m_Transform.ToMatrix4();
+	transform.SetColumnV3(2, a_direction);
+	transform.SetColumnV3(1, a_up);
+	transform.Orthonormalise();
+	m_Transform = AffineTransform(transform);
 }
 
 Vector3 DirectionalLight::GetDirection() const
 {
-	return m_Transform.GetColumnV3(2);
+	return m_Transform.GetColumn(2);
 }
 
-//\----------------------------------------------------------------------------------
-//\ Light Implementation - Main function to calculate the lighting
-//\----------------------------------------------------------------------------------
-ColourRGB DirectionalLight::calculateLighting(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, float a_shadowFactor) const
+// The light travels along its forward axis so the direction back to the light is the opposite way
+Vector3 DirectionalLight::GetDirectionToLight(const Vector3& /*a_point*/) const
 {
-	// Work out diffuse -- treat all surfaces the same under this light
-	// Ambient = 0.2f;
-	// Diffuse = 0.8f;
-	// Specular = 0.8f;
-	// Specular factor - 200.f;
-
-	// Calculate effective light colour for the diffuse channel (and metallic specular )
-	Vector3 effectiveColour = m_colourRGB * a_intersectResponse.material->GetAlbedo();
-
-	ColourRGB ambient = effectiveColour * a_intersectResponse.material->GetAmbient();								//Get ambient colour for surface
-	// Light direction is forward axis of light matrix				
-	Vector3 lightDirection = -GetDirection();																		// Get direction to light from surace
-	float lightDiffuse = MathUtil::Max(0.f, Dot(lightDirection, a_intersectResponse.SurfaceNormal));				// Positive values indicate factors in same dir
-	ColourRGB diffuse = effectiveColour * a_intersectResponse.material->GetDiffuse() * lightDiffuse;				// Blend light diffuse with diffuse value and colour														// Blend light diffuse with diffuse value and colour
-	// Calculate light specular value
-	// For non-metals material colour plays no part in specular highlight
-	Vector3 eyeDir = Normalize(a_intersectResponse.HitPos - a_eyePos);												// Get the dir from view to surface
-	Vector3 reflectionVec = Reflect(eyeDir, a_intersectResponse.SurfaceNormal);										// Get the reflection vector of the eye around normal
-	float specularPower = (1.0f - a_intersectResponse.material->GetRoughness()) * 254.f + 1.0f;
-	float specularFactor = std::powf(MathUtil::Max(0.f, Dot(reflectionVec, lightDirection)), specularPower);		// Get the specular value
-	ColourRGB specular = m_colourRGB * a_intersectResponse.material->GetSpecular() * specularFactor;
+	return -GetDirection();
+}
 
-	return ambient + (diffuse + specular) * a_shadowFactor;
+float DirectionalLight::GetDistanceToLight(const Vector3& /*a_point*/) const
+{
+	return std::numeric_limits<float>::max();
 }
 
-Vector3 DirectionalLight::GetDirectionToLight(const Vector3& a_point) const
+// Nothing about the sample depends on the hit, so it is worked out once and copied to every hit
+void DirectionalLight::SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const
 {
-	return GetDirection();
+	const LightSample sample = SampleLight(Vector3(0.f, 0.f, 0.f));
+	for (int i = 0; i < a_batch.count; ++i)
+	{
+		a_result.Store(i, sample);
+	}
 }
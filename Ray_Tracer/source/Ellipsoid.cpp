@@ -7,7 +7,15 @@
 //						scalling of the Ellipsoids radius in all three dimensions.				
 // 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cmath>
 #include "Ellipsoid.h"
+#include "Material.h"
+//\------------------------
 
 Ellipsoid::Ellipsoid() : m_radius(1.f)
 {	
@@ -16,64 +24,94 @@ Ellipsoid::Ellipsoid() : m_radius(1.f)
 Ellipsoid::Ellipsoid(const Vector3& a_position, const float& a_radius) : m_radius(a_radius)
 {
 	SetPosition(a_position);
-	SetScale(Vector3(m_radius, m_radius, m_radius));
+	SetScale(Vector3(a_radius, a_radius, a_radius));
 }
 
 Ellipsoid::~Ellipsoid()
 {
 }
 
-// Function to calculate the point of intersection with an ellipsoid and a ray
+// Function to calculate the distance to the point of intersection with an ellipsoid and a ray
 // Returns true if an intersection occurs, tests for intersections in front of the ray (not behind)
-bool Ellipsoid::IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const
+// Only the distance is produced here - the hit point and normal are built by FinalizeHit for the closest hit
+bool Ellipsoid::IntersectDistance(const Ray& a_ray, float& a_distance) const
 {
-	// The normal matrix is the inverse transpose of the transform
-	Matrix4 normalMatrix = m_Transform.GetTranspose().Inverse();
-
-	Matrix4 invTx = m_Transform.Inverse();									//Get the inverse of the transform matrix
-	Vector4 rayOrigin = invTx * Vector4(a_ray.Origin(), 1.f);				//Multiply ray origin by inverse to get in local space
-	Vector4 rayDir = Normalize(invTx * Vector4(a_ray.Direction()));			//Get ray direction in local space
+	Vector3 OC = m_InvTransform.TransformPoint(a_ray.Origin());			//Multiply ray origin by inverse to get in local space - vector from Ray Origin to Center of sphere
+	Vector3 rayDir = m_InvTransform.TransformVector(a_ray.Direction());	//Ray direction in local space - left unnormalised so distances stay in world ray units
 
-	Vector3 OC = rayOrigin.xyz();				//Vector from Ray Origin to Center of sphere
-	float b = Dot(OC, rayDir.xyz());			//Dot product of direction with vector to center of sphere
+	float a = Dot(rayDir, rayDir);				//Squared length of the local direction
+	float b = Dot(OC, rayDir);					//Dot product of direction with vector to center of sphere
 	float c = Dot(OC, OC) - 1.f;				// Dot product of OC subtract radius squared (radius of 1 for unit sphere
-	float discriminant = b * b - c;				// Discriminent part under sqrt of quadratic (b - c)
+	float discriminant = b * b - a * c;			// Discriminent part under sqrt of quadratic (b - ac)
 	if (discriminant < 0.f)
 	{
 		return false;							// If less than 0 we have no intersections
 	}
-	else
+	// test for both intersection points to see if intersection occurs behind ray origin
+	// discard negative intersection distance as intersection occurs behind ray
+	float sqrtDiscriminant = sqrtf(discriminant);
+	float invA = 1.f / a;
+	float i0 = (-b - sqrtDiscriminant) * invA;	//Complete negative part of the quadratic equation
+	float i1 = (-b + sqrtDiscriminant) * invA;	//Complete positive part of quadratic equation
+
+	float t = -1.f;
+	if (i0 > 0.f)								// Is first intersection point in front of ray origin
 	{
-		// test for both intersection points to see if intersection occurs behind ray origin
-		// discard negative intersection distance as intersection occurs behind ray
-		float dist = -1.f;						//Start with distance initiallised as a negative
-		float i0 = -b - sqrt(discriminant);		//Complete negative part of the quadratic equation
-		float i1 = -b + sqrt(discriminant);		//Complete positive part of quadratic equation
+		t = i0;
+	}
+	else if (i1 > 0.f)							// if first point not in front of origin is second intersection point
+	{
+		t = i1;
+	}
+	else
+	{		return false;		}				// Both intersection points behind ray origin
+
+	a_distance = t * a_ray.Direction().Length();	// Ray parameter to distance travelled along the ray
+	return true;
+}
 
-		if (i0 > 0.f)							// Is first intersection point in front of ray origin
-		{
-			dist = i0;
-		}
-		else if (i1 > 0.f)						// if first point not in front of origin is second intersection point
-		{
-			dist = i1;
-		}
-		else
-		{		return false;		}			// Both intersection points behind ray origin
+// Build the full hit record for an intersection at a_distance along the ray
+void Ellipsoid::FinalizeHit(const Ray& a_ray, float a_distance, IntersectResponse& a_intersectResponse) const
+{
+	Vector3 hp = a_ray.Origin() + Normalize(a_ray.Direction()) * a_distance;			// World space hit point on the surface of the ellipsoid
+	Vector3 sn = Normalize(m_InvTransform.TransformPoint(hp));							// Local hit point on the unit sphere is the direction of the surface normal
+	a_intersectResponse.HitPos = hp;
+	a_intersectResponse.SurfaceNormal = m_InvTransform.TransformNormal(sn);				// The normal matrix is the inverse transpose of the transform
+	a_intersectResponse.SurfaceNormal.Normalize();										// Convert normal into world space by multiplying with normal matrix
+	a_intersectResponse.frontFace = Dot(a_intersectResponse.SurfaceNormal,				// If Normal and incoming ray in same direction then not front on
+		a_ray.Direction()) < 0.f;
+	a_intersectResponse.distance = a_distance;											// Record distance to intersection in intersection response
+	a_intersectResponse.material = m_material;
 
-			// Now that we have chosen positive intersection point
-			Vector4 hp = rayOrigin + rayDir * dist;											// Calculate hit point in local space to ellipsoid
-			Vector3 sn = Normalize(hp.xyz());												// Normalize this point provides direction of surface normal
-			hp = m_Transform * hp;															// Multiply point by transform matrix to get in world space
-			a_intersectResponse.HitPos = Vector3(hp.x, hp.y, hp.z);							// Nearest hitpoint on surface of ellipsoid to ray
-			a_intersectResponse.SurfaceNormal = (normalMatrix * sn).xyz();					// Convert Normal into world space normal by multiplying with normal matrix
-			a_intersectResponse.SurfaceNormal.Normalize();									// Convert normal into world space by multiplying with normal matrix
-			a_intersectResponse.frontFace = Dot(a_intersectResponse.SurfaceNormal,			// If Normal and incoming ray in same direction then not front on
-				a_ray.Direction()) < 0.f;
-			a_intersectResponse.distance = (a_ray.Origin() - hp.xyz()).Length();			// Record distance to intersection in intersection response
-			a_intersectResponse.material = m_material;
-			return true;																	// return true as ray intersected ellipsoid
-		}
-		return false;																		// No intersections here
+	// Texture coordinates are only needed by a textured material. A primitive without a material still gets
+	// them, as an instance of it may override the material with a textured one.
+	if (m_material != nullptr && m_material->GetAlbedoTexture() == nullptr)
+	{
+		a_intersectResponse.uv = Vector2(0.f, 0.f);
+		a_intersectResponse.uvPerUnit = 0.f;
+		return;
 	}
+	// Latitude and longitude around the local x axis, so neither the top nor the front of a sphere sits on a pole
+	// where the texture pinches. Half way round the sphere is one in v, the shorter of the two directions.
+	a_intersectResponse.uv = Vector2(0.5f + atan2f(sn.z, sn.y) / (2.f * MathLib::PI), acosf(std::min(std::max(sn.x, -1.f), 1.f)) / MathLib::PI);
+	a_intersectResponse.uvPerUnit = 1.f / (MathLib::PI * m_radius);
+}
 
+// Mean length of the transformed axes - the radius of a sphere, and close enough for the texture scale of an ellipsoid
+void Ellipsoid::TransformChanged()
+{
+	m_radius = (m_Transform.TransformVector(Vector3(1.f, 0.f, 0.f)).Length() + m_Transform.TransformVector(Vector3(0.f, 1.f, 0.f)).Length() +
+		m_Transform.TransformVector(Vector3(0.f, 0.f, 1.f)).Length()) / 3.f;
+}
+
+// Exact box around the transformed unit sphere - the half size along each world axis is the length of
+// that row of the transform's 3x3 part
+AABB Ellipsoid::GetBounds() const
+{
+	const AffineTransform& t = m_Transform;
+	Vector3 halfSize(sqrtf(t.m[0][0] * t.m[0][0] + t.m[1][0] * t.m[1][0] + t.m[2][0] * t.m[2][0]),
+					 sqrtf(t.m[0][1] * t.m[0][1] + t.m[1][1] * t.m[1][1] + t.m[2][1] * t.m[2][1]),
+					 sqrtf(t.m[0][2] * t.m[0][2] + t.m[1][2] * t.m[1][2] + t.m[2][2] * t.m[2][2]));
+	Vector3 centre = t.GetTranslation();
+	return AABB(centre - halfSize, centre + halfSize);
+}
@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				ExampleScene.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				The demo scene rendered by the application - a row of glass, metal and matte spheres on a
+//						green ground lit by a single directional light, plus a turntable animation of it.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cmath>
+
+#include "ExampleScene.h"
+#include "Animation.h"
+//\------------------------
+
+namespace
+{
+	const Vector3 CAMERA_START = Vector3(0.f, 0.f, 1.f);
+	const Vector3 CAMERA_TARGET = Vector3(0.f, 0.f, -2.5f);
+	const int TURNTABLE_KEYS = 24;			// Camera keys around the circle - the camera moves in a straight line between them
+}
+
+//\----------------------------------------------------------------------------------
+//\ MATERIALS AND OBJECTS IN SCENE - Spheres size, position and material
+//\----------------------------------------------------------------------------------
+ExampleScene::ExampleScene(float a_aspectRatio) :
+	m_light(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f), Vector3(-0.5773f, -0.5733f, -0.5773f)),
+												// | R     | G   | B        Ambient|Difuse|Specular|Rough |Reflect |Trans  |RefIndx
+	m_lightBlueRough(	Material(Vector3(0.3f,  0.6f,   1.f),    0.2f,   0.9f,   0.6f,   1.f,    0.0f,   0.0f,   1.52f)),
+	m_greenSmooth(		Material(Vector3(0.f,   0.6f,   0.0f),   0.2f,   0.9f,   0.9f,   0.f,    0.9f,   1.0f,   1.52f)),
+	m_greenRough(		Material(Vector3(0.f,   0.6f,   0.f),    0.2f,   0.9f,   0.5f,   1.f,    0.0f,   0.f,    2.61f)),
+	m_redSmooth(		Material(Vector3(1.f,   0.0f,   0.f),    0.2f,   0.9f,   0.9f,   0.f,    1.0f,   0.f,    2.61f)),
+	m_clear(			Material(Vector3(1.f,   1.0f,   1.0f),   0.1f,   0.1f,   0.9f,   0.f,    0.5f,   1.f,    1.52f)),
+	m_clearInner(		Material(Vector3(1.f,   1.0f,   1.0f),   0.1f,   0.1f,   0.9f,   0.f,    0.5f,   1.f,    1.0f)),
+	m_ground(Vector3(0.f, -100.5f, -2.5f), 100.f),			// GROUND
+	m_leftSphere(Vector3(-1.f, 0.f, -1.5f), 0.5f),			// Sphere on the - LEFT [BLUE]
+	m_centreSphere(Vector3(0.f, 0.f, -3.5f), 0.5f),			// CENTRE
+	m_rightSphere(Vector3(2.5f, 0.25f, -1.5f), 0.8f),		// CENTRE Right
+	m_glassOuter(Vector3(1.5f, 0.f, -4.5f), 0.5f),			// Sphere on the - RIGHT
+	m_glassInner(Vector3(1.5f, 0.f, -4.5f), 0.4f)			// Clear Sphere
+{
+	m_camera.SetPerspective(60.f, a_aspectRatio, 0.1f, 1000.0f);
+	m_camera.Setposition(CAMERA_START);
+	m_camera.LookAt(CAMERA_TARGET, Vector3(0.f, 1.f, 0.f));
+
+	m_ground.SetMaterial(&m_greenRough);
+	m_leftSphere.SetMaterial(&m_lightBlueRough);
+	m_centreSphere.SetMaterial(&m_redSmooth);
+	m_rightSphere.SetMaterial(&m_greenSmooth);
+	m_glassOuter.SetMaterial(&m_clear);
+	m_glassInner.SetMaterial(&m_clearInner);
+
+	// ADDING SPHERES INTO THE SCENE
+	m_scene.AddObject(&m_ground);
+	m_scene.AddObject(&m_leftSphere);
+	m_scene.AddObject(&m_centreSphere);
+	m_scene.AddObject(&m_glassOuter);
+	m_scene.AddObject(&m_glassInner);
+	m_scene.AddObject(&m_rightSphere);
+	m_scene.AddLight(&m_light);
+	m_scene.SetCamera(&m_camera);
+	m_scene.BuildAccelerationStructure();
+}
+
+ExampleScene::~ExampleScene()
+{
+}
+
+void ExampleScene::SetGroundTexture(const Texture* a_texture, float a_repeat)
+{
+	m_greenRough.SetAlbedoTexture(a_texture, a_repeat);
+}
+
+void ExampleScene::AddTurntable(Animation& a_animation, float a_duration)
+{
+	// Camera circling the target at its starting distance
+	const Vector3 offset = CAMERA_START - CAMERA_TARGET;
+	const float radius = offset.Length();
+	for (int k = 0; k <= TURNTABLE_KEYS; ++k)
+	{
+		float t = (float)k / (float)TURNTABLE_KEYS;
+		float angle = t * 2.f * MathLib::PI;
+		Vector3 position = CAMERA_TARGET + Vector3(radius * std::sin(angle), offset.y, radius * std::cos(angle));
+		a_animation.AddKey(&m_camera, Animation::CameraKey{ t * a_duration, position, CAMERA_TARGET });
+	}
+
+	// Blue sphere bounces twice, green sphere rolls in to the middle of the scene and back
+	const Vector3 noRotation = Vector3(0.f, 0.f, 0.f);
+	const Vector3 leftScale = Vector3(0.5f, 0.5f, 0.5f);
+	const Vector3 leftStart = Vector3(-1.f, 0.f, -1.5f);
+	const Vector3 leftTop = Vector3(-1.f, 1.5f, -1.5f);
+	a_animation.AddKey(&m_leftSphere, Animation::TransformKey{ 0.f, leftStart, noRotation, leftScale });
+	a_animation.AddKey(&m_leftSphere, Animation::TransformKey{ 0.25f * a_duration, leftTop, noRotation, leftScale });
+	a_animation.AddKey(&m_leftSphere, Animation::TransformKey{ 0.5f * a_duration, leftStart, noRotation, leftScale });
+	a_animation.AddKey(&m_leftSphere, Animation::TransformKey{ 0.75f * a_duration, leftTop, noRotation, leftScale });
+	a_animation.AddKey(&m_leftSphere, Animation::TransformKey{ a_duration, leftStart, noRotation, leftScale });
+
+	const Vector3 rightScale = Vector3(0.8f, 0.8f, 0.8f);
+	a_animation.AddKey(&m_rightSphere, Animation::TransformKey{ 0.f, Vector3(2.5f, 0.25f, -1.5f), noRotation, rightScale });
+	a_animation.AddKey(&m_rightSphere, Animation::TransformKey{ 0.5f * a_duration, Vector3(0.f, 0.25f, -2.5f), Vector3(0.f, 0.f, 90.f), rightScale });
+	a_animation.AddKey(&m_rightSphere, Animation::TransformKey{ a_duration, Vector3(2.5f, 0.25f, -1.5f), noRotation, rightScale });
+}
@@ -0,0 +1,452 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				FrameBuffer.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Floating point image with a choice of storage - 32 bit floats to accumulate into, 16 bit
+//						half floats or shared exponent RGBE to keep large images small. Pixels are stored in square
+//						tiles so a tile of the image is one contiguous block of memory.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cstring>
+
+#include "FrameBuffer.h"
+//\------------------------
+
+// SSE2 is part of every x64 target, 32 bit builds need it switched on
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRAMEBUFFER_SSE2
+#include <emmintrin.h>
+#endif
+
+static_assert(sizeof(ColourRGB) == 3 * sizeof(float), "The conversions read colours as packed float triples");
+
+namespace
+{
+	// Channels are clamped below the largest power of two RGBE can hold
+	const float RGBE_MAX = 1e38f;
+	// The brightest channel of a pixel stored as black
+	const float RGBE_MIN = 1e-32f;
+
+	unsigned int FloatBits(float a_value)
+	{
+		unsigned int bits;
+		std::memcpy(&bits, &a_value, sizeof(bits));
+		return bits;
+	}
+
+	float BitsFloat(unsigned int a_bits)
+	{
+		float value;
+		std::memcpy(&value, &a_bits, sizeof(value));
+		return value;
+	}
+
+#ifdef FRAMEBUFFER_SSE2
+	//\----------------------------------------------------------------------------------
+	//\ Four floats to four halves in the low 16 bits of each lane - the same steps as the scalar version with the
+	//\ branches replaced by masks
+	//\----------------------------------------------------------------------------------
+	__m128i FloatToHalf4(__m128 a_values)
+	{
+		const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+		const __m128 sign = _mm_and_ps(a_values, signMask);
+		const __m128 absolute = _mm_xor_ps(a_values, sign);
+		const __m128i absoluteBits = _mm_castps_si128(absolute);
+
+		const __m128 isNaN = _mm_cmpunord_ps(absolute, absolute);
+		const __m128i isFinite = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absoluteBits);
+		const __m128i special = _mm_or_si128(_mm_and_si128(_mm_castps_si128(isNaN), _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+		// Denormal halves - the add rounds the mantissa into place
+		const __m128i isDenormal = _mm_cmpgt_epi32(_mm_set1_epi32(113 << 23), absoluteBits);
+		const __m128i denormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(denormalMagic))), denormalMagic);
+
+		// Normal halves - rebias the exponent and round to nearest even
+		const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+		__m128i normal = _mm_add_epi32(absoluteBits, _mm_set1_epi32((int)((unsigned int)(15 - 127) << 23) + 0xfff));
+		normal = _mm_srli_epi32(_mm_sub_epi32(normal, mantissaOdd), 13);
+
+		__m128i result = _mm_or_si128(_mm_and_si128(isDenormal, denormal), _mm_andnot_si128(isDenormal, normal));
+		result = _mm_or_si128(_mm_and_si128(isFinite, result), _mm_andnot_si128(isFinite, special));
+		return _mm_or_si128(result, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+	}
+
+	// Four halves, zero extended to 32 bits, to four floats
+	__m128 HalfToFloat4(__m128i a_halves)
+	{
+		const __m128i exponentMantissa = _mm_and_si128(a_halves, _mm_set1_epi32(0x7fff));
+		const __m128i sign = _mm_slli_epi32(_mm_xor_si128(a_halves, exponentMantissa), 16);
+		const __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+		const __m128i wasInfNaN = _mm_cmpgt_epi32(exponentMantissa, _mm_set1_epi32(0x7bff));
+		const __m128 infNaNExponent = _mm_and_ps(_mm_castsi128_ps(wasInfNaN), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+		return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infNaNExponent));
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Four packed rgb pixels (12 floats in three registers) to one register per channel and back
+	//\ a = r0 g0 b0 r1	b = g1 b1 r2 g2	c = b2 r3 g3 b3
+	//\----------------------------------------------------------------------------------
+	void Deinterleave(__m128 a_a, __m128 a_b, __m128 a_c, __m128& a_r, __m128& a_g, __m128& a_b3)
+	{
+		a_r = _mm_shuffle_ps(a_a, _mm_shuffle_ps(a_b, a_c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		a_g = _mm_shuffle_ps(_mm_shuffle_ps(a_a, a_b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(a_b, a_c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		a_b3 = _mm_shuffle_ps(_mm_shuffle_ps(a_a, a_b, _MM_SHUFFLE(1, 1, 2, 2)), a_c, _MM_SHUFFLE(3, 0, 2, 0));
+	}
+
+	void Interleave(__m128 a_r, __m128 a_g, __m128 a_b3, __m128& a_a, __m128& a_b, __m128& a_c)
+	{
+		a_a = _mm_shuffle_ps(_mm_unpacklo_ps(a_r, a_g), _mm_unpacklo_ps(a_b3, a_r), _MM_SHUFFLE(3, 0, 1, 0));
+		a_b = _mm_shuffle_ps(_mm_unpacklo_ps(a_g, a_b3), _mm_unpackhi_ps(a_r, a_g), _MM_SHUFFLE(1, 0, 3, 2));
+		a_c = _mm_shuffle_ps(_mm_unpackhi_ps(a_b3, a_r), _mm_unpackhi_ps(a_g, a_b3), _MM_SHUFFLE(3, 2, 3, 0));
+	}
+#endif
+}
+
+//\====================================================================================================
+//\ PIXEL FORMAT CONVERSIONS
+//\====================================================================================================
+
+unsigned short PixelFormat::FloatToHalf(float a_value)
+{
+	unsigned int bits = FloatBits(a_value);
+	const unsigned int sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	unsigned int half;
+	if (bits >= (127u + 16u) << 23)
+	{
+		// Too large for a half - infinity, and NaN stays a quiet NaN
+		half = (bits > 255u << 23) ? 0x7e00 : 0x7c00;
+	}
+	else if (bits < 113u << 23)
+	{
+		// Denormal half or zero - adding the magic number lines the 10 mantissa bits up at the bottom of the float
+		const unsigned int denormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+		half = FloatBits(BitsFloat(bits) + BitsFloat(denormalMagic)) - denormalMagic;
+	}
+	else
+	{
+		// Rebias the exponent and round the mantissa to nearest even
+		const unsigned int mantissaOdd = (bits >> 13) & 1;
+		bits += ((unsigned int)(15 - 127) << 23) + 0xfff;
+		bits += mantissaOdd;
+		half = bits >> 13;
+	}
+	return (unsigned short)(half | (sign >> 16));
+}
+
+float PixelFormat::HalfToFloat(unsigned short a_half)
+{
+	// Shift the exponent and mantissa into place and fix the exponent bias with one multiply
+	float value = BitsFloat((unsigned int)(a_half & 0x7fff) << 13) * BitsFloat((254u - 15u) << 23);
+	unsigned int bits = FloatBits(value);
+	if ((a_half & 0x7fff) > 0x7bff)
+	{
+		bits |= 255u << 23;
+	}
+	return BitsFloat(bits | ((unsigned int)(a_half & 0x8000) << 16));
+}
+
+void PixelFormat::FloatToHalf(const float* a_values, unsigned short* a_halves, size_t a_count)
+{
+	size_t i = 0;
+#ifdef FRAMEBUFFER_SSE2
+	for (; i + 8 <= a_count; i += 8)
+	{
+		// Sign extend so the signed saturating pack leaves every 16 bit pattern as it is
+		__m128i low = FloatToHalf4(_mm_loadu_ps(a_values + i));
+		__m128i high = FloatToHalf4(_mm_loadu_ps(a_values + i + 4));
+		low = _mm_srai_epi32(_mm_slli_epi32(low, 16), 16);
+		high = _mm_srai_epi32(_mm_slli_epi32(high, 16), 16);
+		_mm_storeu_si128((__m128i*)(a_halves + i), _mm_packs_epi32(low, high));
+	}
+#endif
+	for (; i < a_count; ++i)
+	{
+		a_halves[i] = FloatToHalf(a_values[i]);
+	}
+}
+
+void PixelFormat::HalfToFloat(const unsigned short* a_halves, float* a_values, size_t a_count)
+{
+	size_t i = 0;
+#ifdef FRAMEBUFFER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 8 <= a_count; i += 8)
+	{
+		__m128i halves = _mm_loadu_si128((const __m128i*)(a_halves + i));
+		_mm_storeu_ps(a_values + i, HalfToFloat4(_mm_unpacklo_epi16(halves, zero)));
+		_mm_storeu_ps(a_values + i + 4, HalfToFloat4(_mm_unpackhi_epi16(halves, zero)));
+	}
+#endif
+	for (; i < a_count; ++i)
+	{
+		a_values[i] = HalfToFloat(a_halves[i]);
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ RGBE - the exponent is read straight from the bits of the brightest channel rather than with frexp, so the
+//\ scalar and SSE2 versions can share every step
+//\----------------------------------------------------------------------------------
+void PixelFormat::EncodeRGBE(const float* a_rgb, unsigned char* a_rgbe)
+{
+	// max(value, 0) with the value first turns NaN into zero the same way _mm_max_ps does
+	float r = std::min(a_rgb[0] > 0.f ? a_rgb[0] : 0.f, RGBE_MAX);
+	float g = std::min(a_rgb[1] > 0.f ? a_rgb[1] : 0.f, RGBE_MAX);
+	float b = std::min(a_rgb[2] > 0.f ? a_rgb[2] : 0.f, RGBE_MAX);
+	float brightest = std::max(r, std::max(g, b));
+	if (brightest < RGBE_MIN)
+	{
+		a_rgbe[0] = a_rgbe[1] = a_rgbe[2] = a_rgbe[3] = 0;
+		return;
+	}
+	// brightest = m * 2^e with m in [0.5, 1) - the mantissas are the channels scaled by 256 / 2^e
+	const int exponentBits = (int)(FloatBits(brightest) >> 23);
+	const float scale = BitsFloat((unsigned int)(261 - exponentBits) << 23);
+	a_rgbe[0] = (unsigned char)(int)std::min(r * scale + 0.5f, 255.f);
+	a_rgbe[1] = (unsigned char)(int)std::min(g * scale + 0.5f, 255.f);
+	a_rgbe[2] = (unsigned char)(int)std::min(b * scale + 0.5f, 255.f);
+	a_rgbe[3] = (unsigned char)(exponentBits + 2);
+}
+
+void PixelFormat::DecodeRGBE(const unsigned char* a_rgbe, float* a_rgb)
+{
+	// The encoder never writes an exponent below 10 for anything but black
+	const int exponent = a_rgbe[3];
+	const float scale = exponent < 10 ? 0.f : BitsFloat((unsigned int)(exponent - 9) << 23);
+	a_rgb[0] = (float)a_rgbe[0] * scale;
+	a_rgb[1] = (float)a_rgbe[1] * scale;
+	a_rgb[2] = (float)a_rgbe[2] * scale;
+}
+
+void PixelFormat::EncodeRGBE(const float* a_rgb, unsigned char* a_rgbe, size_t a_pixelCount)
+{
+	size_t i = 0;
+#ifdef FRAMEBUFFER_SSE2
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 maximum = _mm_set1_ps(RGBE_MAX);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 largestMantissa = _mm_set1_ps(255.f);
+	for (; i + 4 <= a_pixelCount; i += 4)
+	{
+		const float* rgb = a_rgb + i * 3;
+		__m128 r, g, b;
+		Deinterleave(_mm_loadu_ps(rgb), _mm_loadu_ps(rgb + 4), _mm_loadu_ps(rgb + 8), r, g, b);
+		r = _mm_min_ps(_mm_max_ps(r, zero), maximum);
+		g = _mm_min_ps(_mm_max_ps(g, zero), maximum);
+		b = _mm_min_ps(_mm_max_ps(b, zero), maximum);
+		const __m128 brightest = _mm_max_ps(r, _mm_max_ps(g, b));
+
+		const __m128i exponentBits = _mm_srli_epi32(_mm_castps_si128(brightest), 23);
+		const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(_mm_set1_epi32(261), exponentBits), 23));
+		const __m128i red = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(r, scale), half), largestMantissa));
+		const __m128i green = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(g, scale), half), largestMantissa));
+		const __m128i blue = _mm_cvttps_epi32(_mm_min_ps(_mm_add_ps(_mm_mul_ps(b, scale), half), largestMantissa));
+		const __m128i exponent = _mm_add_epi32(exponentBits, _mm_set1_epi32(2));
+
+		__m128i packed = _mm_or_si128(_mm_or_si128(red, _mm_slli_epi32(green, 8)), _mm_or_si128(_mm_slli_epi32(blue, 16), _mm_slli_epi32(exponent, 24)));
+		packed = _mm_andnot_si128(_mm_castps_si128(_mm_cmplt_ps(brightest, _mm_set1_ps(RGBE_MIN))), packed);
+		_mm_storeu_si128((__m128i*)(a_rgbe + i * 4), packed);
+	}
+#endif
+	for (; i < a_pixelCount; ++i)
+	{
+		EncodeRGBE(a_rgb + i * 3, a_rgbe + i * 4);
+	}
+}
+
+void PixelFormat::DecodeRGBE(const unsigned char* a_rgbe, float* a_rgb, size_t a_pixelCount)
+{
+	size_t i = 0;
+#ifdef FRAMEBUFFER_SSE2
+	const __m128i byteMask = _mm_set1_epi32(0xff);
+	for (; i + 4 <= a_pixelCount; i += 4)
+	{
+		const __m128i packed = _mm_loadu_si128((const __m128i*)(a_rgbe + i * 4));
+		const __m128i exponent = _mm_srli_epi32(packed, 24);
+		__m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_sub_epi32(exponent, _mm_set1_epi32(9)), 23));
+		scale = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmplt_epi32(exponent, _mm_set1_epi32(10))), scale);
+
+		const __m128 r = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, byteMask)), scale);
+		const __m128 g = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 8), byteMask)), scale);
+		const __m128 b = _mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 16), byteMask)), scale);
+		__m128 a, bb, c;
+		Interleave(r, g, b, a, bb, c);
+		float* rgb = a_rgb + i * 3;
+		_mm_storeu_ps(rgb, a);
+		_mm_storeu_ps(rgb + 4, bb);
+		_mm_storeu_ps(rgb + 8, c);
+	}
+#endif
+	for (; i < a_pixelCount; ++i)
+	{
+		DecodeRGBE(a_rgbe + i * 4, a_rgb + i * 3);
+	}
+}
+
+bool PixelFormat::HasSIMD()
+{
+#ifdef FRAMEBUFFER_SSE2
+	return true;
+#else
+	return false;
+#endif
+}
+
+//\====================================================================================================
+//\ FRAME BUFFER
+//\====================================================================================================
+
+FrameBuffer::FrameBuffer() : m_width(0), m_height(0), m_tilesX(0), m_format(FLOAT32), m_bytesPerPixel(BytesPerPixel(FLOAT32))
+{
+}
+
+FrameBuffer::FrameBuffer(int a_width, int a_height, Format a_format) : FrameBuffer()
+{
+	Resize(a_width, a_height, a_format);
+}
+
+FrameBuffer::~FrameBuffer()
+{
+}
+
+void FrameBuffer::Resize(int a_width, int a_height, Format a_format)
+{
+	m_width = std::max(a_width, 0);
+	m_height = std::max(a_height, 0);
+	m_format = a_format;
+	m_bytesPerPixel = BytesPerPixel(a_format);
+	m_tilesX = (m_width + TILE_SIZE - 1) / TILE_SIZE;
+	const int tilesY = (m_height + TILE_SIZE - 1) / TILE_SIZE;
+	// All zero bits is black in every format
+	m_data.assign((size_t)m_tilesX * tilesY * TILE_SIZE * TILE_SIZE * m_bytesPerPixel, 0);
+}
+
+int FrameBuffer::BytesPerPixel(Format a_format)
+{
+	switch (a_format)
+	{
+	case HALF:	return 3 * (int)sizeof(unsigned short);
+	case RGBE:	return 4;
+	default:	return 3 * (int)sizeof(float);
+	}
+}
+
+const char* FrameBuffer::FormatName(Format a_format)
+{
+	switch (a_format)
+	{
+	case HALF:	return "half";
+	case RGBE:	return "rgbe";
+	default:	return "fp32";
+	}
+}
+
+bool FrameBuffer::ParseFormat(const std::string& a_name, Format& a_format)
+{
+	const Format formats[] = { FLOAT32, HALF, RGBE };
+	for (Format format : formats)
+	{
+		if (a_name == FormatName(format))
+		{
+			a_format = format;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Tiles are stored row by row, and the pixels inside a tile row by row
+size_t FrameBuffer::PixelOffset(int a_x, int a_y) const
+{
+	const size_t tile = (size_t)(a_y / TILE_SIZE) * m_tilesX + (a_x / TILE_SIZE);
+	const size_t pixel = tile * TILE_SIZE * TILE_SIZE + (size_t)(a_y % TILE_SIZE) * TILE_SIZE + (a_x % TILE_SIZE);
+	return pixel * m_bytesPerPixel;
+}
+
+void FrameBuffer::Encode(const float* a_rgb, unsigned char* a_stored, int a_count) const
+{
+	switch (m_format)
+	{
+	case HALF:	PixelFormat::FloatToHalf(a_rgb, (unsigned short*)a_stored, (size_t)a_count * 3); break;
+	case RGBE:	PixelFormat::EncodeRGBE(a_rgb, a_stored, (size_t)a_count); break;
+	default:	std::memcpy(a_stored, a_rgb, (size_t)a_count * 3 * sizeof(float)); break;
+	}
+}
+
+void FrameBuffer::Decode(const unsigned char* a_stored, float* a_rgb, int a_count) const
+{
+	switch (m_format)
+	{
+	case HALF:	PixelFormat::HalfToFloat((const unsigned short*)a_stored, a_rgb, (size_t)a_count * 3); break;
+	case RGBE:	PixelFormat::DecodeRGBE(a_stored, a_rgb, (size_t)a_count); break;
+	default:	std::memcpy(a_rgb, a_stored, (size_t)a_count * 3 * sizeof(float)); break;
+	}
+}
+
+void FrameBuffer::SetPixel(int a_x, int a_y, const ColourRGB& a_colour)
+{
+	Encode(&a_colour.x, &m_data[PixelOffset(a_x, a_y)], 1);
+}
+
+ColourRGB FrameBuffer::GetPixel(int a_x, int a_y) const
+{
+	ColourRGB colour;
+	Decode(&m_data[PixelOffset(a_x, a_y)], &colour.x, 1);
+	return colour;
+}
+
+void FrameBuffer::AddPixel(int a_x, int a_y, const ColourRGB& a_colour)
+{
+	SetPixel(a_x, a_y, GetPixel(a_x, a_y) + a_colour);
+}
+
+// The run is split where it crosses from one tile into the next, each piece is contiguous in both buffers
+void FrameBuffer::StoreRow(int a_x, int a_y, const ColourRGB* a_colours, int a_count)
+{
+	int done = 0;
+	while (done < a_count)
+	{
+		const int x = a_x + done;
+		const int count = std::min(TILE_SIZE - x % TILE_SIZE, a_count - done);
+		Encode(&a_colours[done].x, &m_data[PixelOffset(x, a_y)], count);
+		done += count;
+	}
+}
+
+void FrameBuffer::LoadRow(int a_x, int a_y, ColourRGB* a_colours, int a_count) const
+{
+	int done = 0;
+	while (done < a_count)
+	{
+		const int x = a_x + done;
+		const int count = std::min(TILE_SIZE - x % TILE_SIZE, a_count - done);
+		Decode(&m_data[PixelOffset(x, a_y)], &a_colours[done].x, count);
+		done += count;
+	}
+}
+
+void FrameBuffer::Store(const std::vector<ColourRGB>& a_pixels)
+{
+	for (int y = 0; y < m_height; ++y)
+	{
+		StoreRow(0, y, &a_pixels[(size_t)y * m_width], m_width);
+	}
+}
+
+void FrameBuffer::Load(std::vector<ColourRGB>& a_pixels) const
+{
+	a_pixels.resize((size_t)m_width * m_height);
+	for (int y = 0; y < m_height; ++y)
+	{
+		LoadRow(0, y, &a_pixels[(size_t)y * m_width], m_width);
+	}
+}
@@ -0,0 +1,167 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				GeneratedScene.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A field of random spheres and ellipsoids made from a handful of settings and a seed, for
+//						measuring how rendering scales. The same settings always make the same scene, and the size
+//						of the objects follows their count so every scene covers the screen about as deeply.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+#include "GeneratedScene.h"
+#include "Animation.h"
+//\------------------------
+
+const Vector3 GeneratedScene::FIELD_SIZE = Vector3(8.f, 2.5f, 10.f);
+
+namespace
+{
+	const float FIELD_NEAR = 2.f;				// Distance in front of the origin the field starts
+	const float LIGHT_HEIGHT = 2.f;				// Height of the point lights above the top of the field
+
+	bool ParseInt(const std::string& a_text, int& a_value)
+	{
+		char* end = nullptr;
+		long value = strtol(a_text.c_str(), &end, 10);
+		if (a_text.empty() || *end != '\0')
+		{
+			return false;
+		}
+		a_value = (int)value;
+		return true;
+	}
+
+	bool ParseFloat(const std::string& a_text, float& a_value)
+	{
+		char* end = nullptr;
+		float value = strtof(a_text.c_str(), &end);
+		if (a_text.empty() || *end != '\0')
+		{
+			return false;
+		}
+		a_value = value;
+		return true;
+	}
+}
+
+bool GeneratedSceneSettings::Parse(const std::string& a_text)
+{
+	std::stringstream pairs(a_text);
+	std::string pair;
+	while (std::getline(pairs, pair, ','))
+	{
+		size_t equals = pair.find('=');
+		if (equals == std::string::npos)
+		{
+			return false;
+		}
+		const std::string name = pair.substr(0, equals);
+		const std::string value = pair.substr(equals + 1);
+		bool parsed = false;
+		if (name == "objects")			{ parsed = ParseInt(value, objects); objects = std::max(objects, 0); }
+		else if (name == "ellipsoids")	{ parsed = ParseFloat(value, ellipsoids); ellipsoids = std::min(std::max(ellipsoids, 0.f), 1.f); }
+		else if (name == "glass")		{ parsed = ParseFloat(value, glass); glass = std::min(std::max(glass, 0.f), 1.f); }
+		else if (name == "lights")		{ parsed = ParseInt(value, lights); lights = std::max(lights, 1); }
+		else if (name == "depth")		{ parsed = ParseFloat(value, depth); depth = std::max(depth, 0.01f); }
+		else if (name == "seed")		{ parsed = ParseInt(value, seed); }
+		if (!parsed)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string GeneratedSceneSettings::ToString() const
+{
+	std::stringstream text;
+	text << "objects=" << objects << ",ellipsoids=" << ellipsoids << ",glass=" << glass << ",lights=" << lights
+		<< ",depth=" << depth << ",seed=" << seed;
+	return text.str();
+}
+
+//\----------------------------------------------------------------------------------
+//\ Every random number is drawn here in a fixed order from the settings' seed, so a scene can be made again
+//\ anywhere from its settings alone. The objects are sized so their silhouettes, added up, cover the front of
+//\ the field depth times over - a ray through the field then passes about depth of them whatever their count.
+//\----------------------------------------------------------------------------------
+GeneratedScene::GeneratedScene(const GeneratedSceneSettings& a_settings, float a_aspectRatio) :
+	m_settings(a_settings),
+	m_sun(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f) * (1.f / (float)std::max(a_settings.lights, 1)), Vector3(-0.5773f, -0.5733f, -0.5773f))
+{
+	// The presets of the example scene, split into the ones light passes through and the ones it does not
+										// | R     | G   | B        Ambient|Difuse|Specular|Rough |Reflect |Trans  |RefIndx
+	m_opaqueMaterials.push_back(Material(Vector3(0.3f,  0.6f,   1.f),    0.2f,   0.9f,   0.6f,   1.f,    0.0f,   0.0f,   1.52f));	// Light blue rough
+	m_opaqueMaterials.push_back(Material(Vector3(0.f,   0.6f,   0.f),    0.2f,   0.9f,   0.5f,   1.f,    0.0f,   0.f,    2.61f));	// Green rough
+	m_opaqueMaterials.push_back(Material(Vector3(1.f,   0.0f,   0.f),    0.2f,   0.9f,   0.9f,   0.f,    1.0f,   0.f,    2.61f));	// Red smooth
+	m_glassMaterials.push_back(	Material(Vector3(1.f,   1.0f,   1.0f),   0.1f,   0.1f,   0.9f,   0.f,    0.5f,   1.f,    1.52f));	// Clear
+	m_glassMaterials.push_back(	Material(Vector3(0.f,   0.6f,   0.0f),   0.2f,   0.9f,   0.9f,   0.f,    0.9f,   1.0f,   1.52f));	// Green smooth
+
+	const float frontArea = FIELD_SIZE.x * FIELD_SIZE.y;
+	m_objectRadius = std::sqrt(m_settings.depth * frontArea / ((float)std::max(m_settings.objects, 1) * MathLib::PI));
+	m_objectRadius = std::min(m_objectRadius, FIELD_SIZE.y * 0.5f);
+
+	Random::SetSeed(m_settings.seed);
+	m_objects.reserve(m_settings.objects + 1);
+	m_objects.push_back(Ellipsoid(Vector3(0.f, -1000.f, 0.f), 1000.f));		// GROUND
+	m_objects.back().SetMaterial(&m_opaqueMaterials[1]);
+	for (int i = 0; i < m_settings.objects; ++i)
+	{
+		Animation::TransformKey key;
+		key.time = 0.f;
+		key.position = Vector3(Random::RandomRange(-0.5f, 0.5f) * FIELD_SIZE.x, Random::RandomRange(0.f, FIELD_SIZE.y),
+			-FIELD_NEAR - Random::RandomRange(0.f, FIELD_SIZE.z));
+		key.rotation = Vector3(0.f, 0.f, 0.f);
+		key.scale = Vector3(m_objectRadius, m_objectRadius, m_objectRadius);
+		if (Random::RandomFloat() < m_settings.ellipsoids)
+		{
+			key.rotation = Vector3(Random::RandomRange(0.f, 360.f), Random::RandomRange(0.f, 360.f), Random::RandomRange(0.f, 360.f));
+			key.scale = Vector3(Random::RandomRange(0.5f, 1.5f), Random::RandomRange(0.5f, 1.5f), Random::RandomRange(0.5f, 1.5f)) * m_objectRadius;
+		}
+		std::vector<Material>& materials = (Random::RandomFloat() < m_settings.glass) ? m_glassMaterials : m_opaqueMaterials;
+		Material* material = &materials[std::min((int)(Random::RandomFloat() * (float)materials.size()), (int)materials.size() - 1)];
+
+		m_objects.push_back(Ellipsoid());
+		m_objects.back().SetTransform(Animation::ToTransform(key));
+		m_objects.back().SetMaterial(material);
+	}
+
+	// The sun and the point lights share the light out evenly - each point light gives the ground below it its share
+	const float lightHeight = FIELD_SIZE.y + LIGHT_HEIGHT;
+	const float pointIntensity = lightHeight * lightHeight / (float)std::max(m_settings.lights, 1);
+	m_pointLights.reserve(std::max(m_settings.lights - 1, 0));
+	for (int l = 1; l < m_settings.lights; ++l)
+	{
+		Vector3 position(Random::RandomRange(-0.5f, 0.5f) * FIELD_SIZE.x, lightHeight, -FIELD_NEAR - Random::RandomRange(0.f, FIELD_SIZE.z));
+		m_pointLights.push_back(PointLight(position, ColourRGB(1.f, 1.f, 1.f), pointIntensity));
+	}
+
+	m_camera.SetPerspective(60.f, a_aspectRatio, 0.1f, 1000.0f);
+	m_camera.Setposition(Vector3(0.f, FIELD_SIZE.y * 0.6f, 1.5f));
+	m_camera.LookAt(Vector3(0.f, FIELD_SIZE.y * 0.3f, -FIELD_NEAR - FIELD_SIZE.z * 0.5f), Vector3(0.f, 1.f, 0.f));
+
+	for (const Ellipsoid& object : m_objects)
+	{
+		m_scene.AddObject(&object);
+	}
+	m_scene.AddLight(&m_sun);
+	for (const PointLight& light : m_pointLights)
+	{
+		m_scene.AddLight(&light);
+	}
+	m_scene.SetCamera(&m_camera);
+	m_scene.BuildAccelerationStructure();
+}
+
+GeneratedScene::~GeneratedScene()
+{
+}
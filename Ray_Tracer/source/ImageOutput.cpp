@@ -0,0 +1,401 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				ImageOutput.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Binary image formats for a frame buffer - PFM keeps the full floating point colours, QOI and
+//						PNG are lossless 8 bit. The image is cut into strips of rows that are encoded on separate
+//						threads and joined into one file, so large frames encode in a fraction of their render time.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "Deflate.h"
+#include "FrameBuffer.h"
+#include "ImageOutput.h"
+#include "ParallelFor.h"
+//\------------------------
+
+namespace
+{
+	// Strips are at least this many rows, and long enough to hold this many bytes of 8 bit pixels
+	const int MIN_STRIP_ROWS = 16;
+	const size_t MIN_STRIP_BYTES = 256 * 1024;
+
+	int StripRows(const FrameBuffer& a_frame)
+	{
+		size_t rowBytes = std::max((size_t)a_frame.GetWidth() * 3, (size_t)1);
+		return std::max(MIN_STRIP_ROWS, (int)((MIN_STRIP_BYTES + rowBytes - 1) / rowBytes));
+	}
+
+	int StripCount(const FrameBuffer& a_frame, int a_stripRows)
+	{
+		return (a_frame.GetHeight() + a_stripRows - 1) / a_stripRows;
+	}
+
+	// Rows [a_first, a_end) of the frame as packed 8 bit RGB
+	void LoadBytes(const FrameBuffer& a_frame, int a_first, int a_end, std::vector<unsigned char>& a_bytes)
+	{
+		const int width = a_frame.GetWidth();
+		std::vector<ColourRGB> row(width);
+		a_bytes.resize((size_t)(a_end - a_first) * width * 3);
+		unsigned char* out = a_bytes.data();
+		for (int y = a_first; y < a_end; ++y)
+		{
+			if (width > 0)
+			{
+				a_frame.LoadRow(0, y, row.data(), width);
+			}
+			for (const ColourRGB& colour : row)
+			{
+				*out++ = ImageOutput::ToByte(colour.x);
+				*out++ = ImageOutput::ToByte(colour.y);
+				*out++ = ImageOutput::ToByte(colour.z);
+			}
+		}
+	}
+
+	void PutBigEndian(std::vector<unsigned char>& a_output, unsigned int a_value)
+	{
+		a_output.push_back((unsigned char)(a_value >> 24));
+		a_output.push_back((unsigned char)(a_value >> 16));
+		a_output.push_back((unsigned char)(a_value >> 8));
+		a_output.push_back((unsigned char)a_value);
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ QOI - every strip starts with a full RGB pixel and only refers back to colours it has written itself, so it
+	//\ decodes the same whatever the strips before it left behind
+	//\----------------------------------------------------------------------------------
+	void EncodeQOIStrip(const unsigned char* a_pixels, size_t a_pixelCount, std::vector<unsigned char>& a_output)
+	{
+		const unsigned char OP_INDEX = 0x00;
+		const unsigned char OP_DIFF = 0x40;
+		const unsigned char OP_LUMA = 0x80;
+		const unsigned char OP_RUN = 0xc0;
+		const unsigned char OP_RGB = 0xfe;
+
+		// Alpha is always 255 in the image, so an alpha of zero marks an index entry this strip has not written
+		unsigned int index[64] = {};
+		unsigned int previous = 0;
+		int run = 0;
+		a_output.reserve(a_pixelCount * 2);
+		for (size_t i = 0; i < a_pixelCount; ++i)
+		{
+			const unsigned char* rgb = a_pixels + i * 3;
+			const unsigned int pixel = rgb[0] | (rgb[1] << 8) | (rgb[2] << 16) | 0xff000000u;
+			if (i > 0 && pixel == previous)
+			{
+				if (++run == 62)
+				{
+					a_output.push_back((unsigned char)(OP_RUN | (run - 1)));
+					run = 0;
+				}
+				continue;
+			}
+			if (run > 0)
+			{
+				a_output.push_back((unsigned char)(OP_RUN | (run - 1)));
+				run = 0;
+			}
+			const int hash = (rgb[0] * 3 + rgb[1] * 5 + rgb[2] * 7 + 255 * 11) % 64;
+			if (i > 0 && index[hash] == pixel)
+			{
+				a_output.push_back((unsigned char)(OP_INDEX | hash));
+				previous = pixel;
+				continue;
+			}
+			index[hash] = pixel;
+			const int dr = (signed char)(rgb[0] - (previous & 0xff));
+			const int dg = (signed char)(rgb[1] - ((previous >> 8) & 0xff));
+			const int db = (signed char)(rgb[2] - ((previous >> 16) & 0xff));
+			previous = pixel;
+			if (i == 0)
+			{
+				a_output.push_back(OP_RGB);
+				a_output.insert(a_output.end(), rgb, rgb + 3);
+			}
+			else if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+			{
+				a_output.push_back((unsigned char)(OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)));
+			}
+			else if (dg >= -32 && dg <= 31 && dr - dg >= -8 && dr - dg <= 7 && db - dg >= -8 && db - dg <= 7)
+			{
+				a_output.push_back((unsigned char)(OP_LUMA | (dg + 32)));
+				a_output.push_back((unsigned char)(((dr - dg + 8) << 4) | (db - dg + 8)));
+			}
+			else
+			{
+				a_output.push_back(OP_RGB);
+				a_output.insert(a_output.end(), rgb, rgb + 3);
+			}
+		}
+		if (run > 0)
+		{
+			a_output.push_back((unsigned char)(OP_RUN | (run - 1)));
+		}
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ PNG row filters - each row gets whichever of the five filters leaves the smallest sum of absolute
+	//\ differences, the usual guess at what deflate will compress best
+	//\----------------------------------------------------------------------------------
+	int Paeth(int a_left, int a_up, int a_upLeft)
+	{
+		int estimate = a_left + a_up - a_upLeft;
+		int left = std::abs(estimate - a_left);
+		int up = std::abs(estimate - a_up);
+		int upLeft = std::abs(estimate - a_upLeft);
+		if (left <= up && left <= upLeft)
+		{
+			return a_left;
+		}
+		return (up <= upLeft) ? a_up : a_upLeft;
+	}
+
+	int Predict(int a_filter, int a_left, int a_up, int a_upLeft)
+	{
+		switch (a_filter)
+		{
+		case 1:		return a_left;
+		case 2:		return a_up;
+		case 3:		return (a_left + a_up) / 2;
+		case 4:		return Paeth(a_left, a_up, a_upLeft);
+		default:	return 0;
+		}
+	}
+
+	void FilterRow(const unsigned char* a_row, const unsigned char* a_above, size_t a_rowBytes, unsigned char* a_output)
+	{
+		const size_t BPP = 3;
+		int bestFilter = 0;
+		unsigned long long bestCost = ~0ull;
+		for (int filter = 0; filter < 5; ++filter)
+		{
+			unsigned long long cost = 0;
+			for (size_t i = 0; i < a_rowBytes; ++i)
+			{
+				int left = (i >= BPP) ? a_row[i - BPP] : 0;
+				int up = a_above[i];
+				int upLeft = (i >= BPP) ? a_above[i - BPP] : 0;
+				signed char residual = (signed char)(a_row[i] - Predict(filter, left, up, upLeft));
+				cost += std::abs((int)residual);
+			}
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestFilter = filter;
+			}
+		}
+		a_output[0] = (unsigned char)bestFilter;
+		for (size_t i = 0; i < a_rowBytes; ++i)
+		{
+			int left = (i >= BPP) ? a_row[i - BPP] : 0;
+			int up = a_above[i];
+			int upLeft = (i >= BPP) ? a_above[i - BPP] : 0;
+			a_output[i + 1] = (unsigned char)(a_row[i] - Predict(bestFilter, left, up, upLeft));
+		}
+	}
+
+	// Length, type, data and the CRC of the type and data
+	void WriteChunk(std::vector<unsigned char>& a_output, const char* a_type, const unsigned char* a_data, size_t a_size)
+	{
+		PutBigEndian(a_output, (unsigned int)a_size);
+		size_t start = a_output.size();
+		a_output.insert(a_output.end(), a_type, a_type + 4);
+		if (a_size > 0)
+		{
+			a_output.insert(a_output.end(), a_data, a_data + a_size);
+		}
+		PutBigEndian(a_output, Deflate::Crc32(&a_output[start], a_size + 4));
+	}
+}
+
+unsigned char ImageOutput::ToByte(float a_value)
+{
+	// Scaled the same way as WriteColourRGB, but clamped as a byte cannot hold anything outside 0 -> 255
+	int value = static_cast<int>(255.999f * a_value);
+	return (unsigned char)std::min(std::max(value, 0), 255);
+}
+
+ImageOutput::Format ImageOutput::FormatFromFilename(const std::string& a_filename)
+{
+	size_t dot = a_filename.find_last_of('.');
+	if (dot == std::string::npos)
+	{
+		return PPM;
+	}
+	std::string extension = a_filename.substr(dot + 1);
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower((unsigned char)c); });
+	if (extension == "pfm")	{ return PFM; }
+	if (extension == "qoi")	{ return QOI; }
+	if (extension == "png")	{ return PNG; }
+	return PPM;
+}
+
+const char* ImageOutput::FormatName(Format a_format)
+{
+	switch (a_format)
+	{
+	case PPM:	return "ppm";
+	case PFM:	return "pfm";
+	case QOI:	return "qoi";
+	case PNG:	return "png";
+	default:	return "unknown";
+	}
+}
+
+void ImageOutput::EncodePFM(const FrameBuffer& a_frame, std::vector<unsigned char>& a_output, int a_threads)
+{
+	const int width = a_frame.GetWidth();
+	const int height = a_frame.GetHeight();
+	// A negative scale says the floats are little endian - they are written in the order this machine keeps them
+	const unsigned int one = 1;
+	const bool littleEndian = *reinterpret_cast<const unsigned char*>(&one) == 1;
+	std::ostringstream header;
+	header << "PF\n" << width << ' ' << height << '\n' << (littleEndian ? "-1.0" : "1.0") << '\n';
+	const std::string text = header.str();
+	const size_t rowBytes = (size_t)width * sizeof(ColourRGB);
+	a_output.resize(text.size() + rowBytes * height);
+	std::memcpy(a_output.data(), text.data(), text.size());
+	unsigned char* pixels = a_output.data() + text.size();
+
+	// Rows go bottom to top, each one decoded straight into its place in the file
+	const int stripRows = StripRows(a_frame);
+	Parallel::For(StripCount(a_frame, stripRows), [&](int a_strip)
+	{
+		std::vector<ColourRGB> row(width);
+		for (int y = a_strip * stripRows; y < std::min(height, (a_strip + 1) * stripRows); ++y)
+		{
+			if (width > 0)
+			{
+				a_frame.LoadRow(0, y, row.data(), width);
+				std::memcpy(pixels + (size_t)(height - 1 - y) * rowBytes, row.data(), rowBytes);
+			}
+		}
+	}, a_threads);
+}
+
+void ImageOutput::EncodeQOI(const FrameBuffer& a_frame, std::vector<unsigned char>& a_output, int a_threads)
+{
+	const int stripRows = StripRows(a_frame);
+	std::vector<std::vector<unsigned char>> strips(StripCount(a_frame, stripRows));
+	Parallel::For((int)strips.size(), [&](int a_strip)
+	{
+		std::vector<unsigned char> bytes;
+		LoadBytes(a_frame, a_strip * stripRows, std::min(a_frame.GetHeight(), (a_strip + 1) * stripRows), bytes);
+		EncodeQOIStrip(bytes.data(), bytes.size() / 3, strips[a_strip]);
+	}, a_threads);
+
+	a_output.clear();
+	const char magic[4] = { 'q', 'o', 'i', 'f' };
+	a_output.insert(a_output.end(), magic, magic + 4);
+	PutBigEndian(a_output, (unsigned int)a_frame.GetWidth());
+	PutBigEndian(a_output, (unsigned int)a_frame.GetHeight());
+	a_output.push_back(3);			// RGB
+	a_output.push_back(0);			// sRGB colour space
+	for (const std::vector<unsigned char>& strip : strips)
+	{
+		a_output.insert(a_output.end(), strip.begin(), strip.end());
+	}
+	const unsigned char end[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+	a_output.insert(a_output.end(), end, end + 8);
+}
+
+void ImageOutput::EncodePNG(const FrameBuffer& a_frame, std::vector<unsigned char>& a_output, int a_threads)
+{
+	const int width = a_frame.GetWidth();
+	const int height = a_frame.GetHeight();
+	const size_t rowBytes = (size_t)width * 3;
+	const int stripRows = StripRows(a_frame);
+	const int stripCount = StripCount(a_frame, stripRows);
+
+	//\----------------------------------------------------------------------------------
+	//\ Each strip is filtered and deflated on its own into a complete IDAT chunk. Only the last strip ends the
+	//\ deflate stream, and the Adler-32 the zlib stream ends with is put together from the one of each strip.
+	//\----------------------------------------------------------------------------------
+	std::vector<std::vector<unsigned char>> chunks(stripCount);
+	std::vector<unsigned int> adlers(stripCount);
+	std::vector<size_t> filteredSizes(stripCount);
+	Parallel::For(stripCount, [&](int a_strip)
+	{
+		const int first = a_strip * stripRows;
+		const int end = std::min(height, first + stripRows);
+		// The row above the strip is needed to filter its first row
+		const int above = std::max(first - 1, 0);
+		std::vector<unsigned char> bytes;
+		LoadBytes(a_frame, above, end, bytes);
+		const std::vector<unsigned char> zeros(rowBytes, 0);
+		std::vector<unsigned char> filtered((size_t)(end - first) * (rowBytes + 1));
+		for (int y = first; y < end; ++y)
+		{
+			const unsigned char* row = bytes.data() + (size_t)(y - above) * rowBytes;
+			const unsigned char* rowAbove = (y > 0) ? row - rowBytes : zeros.data();
+			FilterRow(row, rowAbove, rowBytes, &filtered[(size_t)(y - first) * (rowBytes + 1)]);
+		}
+		std::vector<unsigned char> compressed;
+		Deflate::Compress(filtered.data(), filtered.size(), a_strip == stripCount - 1, compressed);
+		adlers[a_strip] = Deflate::Adler32(filtered.data(), filtered.size());
+		filteredSizes[a_strip] = filtered.size();
+		WriteChunk(chunks[a_strip], "IDAT", compressed.data(), compressed.size());
+	}, a_threads);
+
+	a_output.clear();
+	const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	a_output.insert(a_output.end(), signature, signature + 8);
+	std::vector<unsigned char> header;
+	PutBigEndian(header, (unsigned int)width);
+	PutBigEndian(header, (unsigned int)height);
+	const unsigned char format[5] = { 8, 2, 0, 0, 0 };		// 8 bits a channel, RGB, deflate, adaptive filters, not interlaced
+	header.insert(header.end(), format, format + 5);
+	WriteChunk(a_output, "IHDR", header.data(), header.size());
+
+	// The zlib header and checksum get chunks of their own so the strips do not have to know where they sit
+	const unsigned char zlibHeader[2] = { 0x78, 0x9c };
+	WriteChunk(a_output, "IDAT", zlibHeader, 2);
+	unsigned int adler = 1;
+	if (stripCount == 0)
+	{
+		// No rows at all still needs a deflate stream
+		std::vector<unsigned char> compressed;
+		Deflate::Compress(nullptr, 0, true, compressed);
+		WriteChunk(a_output, "IDAT", compressed.data(), compressed.size());
+	}
+	for (int strip = 0; strip < stripCount; ++strip)
+	{
+		a_output.insert(a_output.end(), chunks[strip].begin(), chunks[strip].end());
+		adler = (strip == 0) ? adlers[strip] : Deflate::Adler32Combine(adler, adlers[strip], filteredSizes[strip]);
+	}
+	std::vector<unsigned char> checksum;
+	PutBigEndian(checksum, adler);
+	WriteChunk(a_output, "IDAT", checksum.data(), checksum.size());
+	WriteChunk(a_output, "IEND", nullptr, 0);
+}
+
+bool ImageOutput::Write(const std::string& a_filename, const FrameBuffer& a_frame, Format a_format, int a_threads)
+{
+	std::vector<unsigned char> encoded;
+	switch (a_format)
+	{
+	case PFM:	EncodePFM(a_frame, encoded, a_threads); break;
+	case QOI:	EncodeQOI(a_frame, encoded, a_threads); break;
+	case PNG:	EncodePNG(a_frame, encoded, a_threads); break;
+	default:	return false;
+	}
+	std::ofstream file(a_filename.c_str(), std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(encoded.data()), encoded.size());
+	return file.good();
+}
@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				IncrementalRenderer.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Keeps a rendered image and re-renders only the tiles an edit can change. Every tile remembers
+//						the primitives and materials its rays touched, so after an object is moved or a material is
+//						changed only the tiles that depend on it are rendered again.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+
+#include "IncrementalRenderer.h"
+#include "Renderer.h"
+#include "Scene.h"
+//\------------------------
+
+IncrementalRenderer::IncrementalRenderer(const Renderer& a_renderer, int a_tileSize, int a_prepassRaysPerPixel) :
+	m_renderer(a_renderer), m_prepassRaysPerPixel(a_prepassRaysPerPixel > 0 ? a_prepassRaysPerPixel : 1)
+{
+	const int tileSize = a_tileSize > 0 ? a_tileSize : 16;
+	for (int y = 0; y < a_renderer.GetHeight(); y += tileSize)
+	{
+		for (int x = 0; x < a_renderer.GetWidth(); x += tileSize)
+		{
+			Tile tile;
+			tile.x0 = x;
+			tile.y0 = y;
+			tile.x1 = std::min(x + tileSize, a_renderer.GetWidth());
+			tile.y1 = std::min(y + tileSize, a_renderer.GetHeight());
+			tile.dirty = true;
+			m_tiles.push_back(tile);
+		}
+	}
+	m_pixels.resize((size_t)a_renderer.GetWidth() * (size_t)a_renderer.GetHeight());
+}
+
+IncrementalRenderer::~IncrementalRenderer()
+{
+}
+
+void IncrementalRenderer::Render(const Scene& a_scene)
+{
+	InvalidateAll();
+	Update(a_scene);
+}
+
+void IncrementalRenderer::PrimitiveChanged(const Primitive* a_primitive)
+{
+	m_changedPrimitives.push_back(a_primitive);
+}
+
+void IncrementalRenderer::MaterialChanged(const Material* a_material)
+{
+	m_changedMaterials.push_back(a_material);
+}
+
+void IncrementalRenderer::InvalidateAll()
+{
+	for (Tile& tile : m_tiles)
+	{
+		tile.dirty = true;
+	}
+}
+
+bool IncrementalRenderer::DependsOnEdits(const DependencySet& a_dependencies) const
+{
+	for (const Primitive* primitive : m_changedPrimitives)
+	{
+		if (a_dependencies.Contains(primitive)) { return true; }
+	}
+	for (const Material* material : m_changedMaterials)
+	{
+		if (a_dependencies.Contains(material)) { return true; }
+	}
+	return false;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Update - a tile is re-rendered when what it touched before the edit includes an edited object or material.
+//\ A moved object can also appear in tiles that never touched it, so when objects have moved a cheap pre-pass
+//\ traces a few rays through every other tile and records what they touch now.
+//\----------------------------------------------------------------------------------
+int IncrementalRenderer::Update(const Scene& a_scene)
+{
+	for (Tile& tile : m_tiles)
+	{
+		if (!tile.dirty && DependsOnEdits(tile.dependencies))
+		{
+			tile.dirty = true;
+		}
+	}
+	const float pixelSpread = m_renderer.GetPixelSpread(a_scene);
+	if (!m_changedPrimitives.empty())
+	{
+		DependencySet prepass;
+		for (Tile& tile : m_tiles)
+		{
+			if (tile.dirty)
+			{
+				continue;
+			}
+			prepass.Clear();
+			RenderTile(a_scene, tile, m_prepassRaysPerPixel, pixelSpread, false, prepass);
+			tile.dirty = DependsOnEdits(prepass);
+		}
+	}
+	m_changedPrimitives.clear();
+	m_changedMaterials.clear();
+
+	int rendered = 0;
+	for (Tile& tile : m_tiles)
+	{
+		if (!tile.dirty)
+		{
+			continue;
+		}
+		tile.dependencies.Clear();
+		RenderTile(a_scene, tile, m_renderer.GetRaysPerPixel(), pixelSpread, true, tile.dependencies);
+		tile.dirty = false;
+		++rendered;
+	}
+	return rendered;
+}
+
+void IncrementalRenderer::RenderTile(const Scene& a_scene, const Tile& a_tile, int a_raysPerPixel, float a_pixelSpread, bool a_keepPixels, DependencySet& a_dependencies)
+{
+	Scene::SetDependencyRecorder(&a_dependencies);
+	for (int y = a_tile.y0; y < a_tile.y1; ++y)
+	{
+		for (int x = a_tile.x0; x < a_tile.x1; ++x)
+		{
+			ColourRGB colour = m_renderer.RenderPixel(a_scene, x, y, a_raysPerPixel, a_pixelSpread);
+			if (a_keepPixels)
+			{
+				m_pixels[(size_t)y * m_renderer.GetWidth() + x] = colour;
+			}
+		}
+	}
+	Scene::SetDependencyRecorder(nullptr);
+	a_dependencies.Compact();
+}
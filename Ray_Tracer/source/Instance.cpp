@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Instance.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				An instance places shared geometry in the world with its own transform and an optional
+//						material override. The geometry is either a single primitive or a whole sub scene and is only
+//						referenced, so placing the same object thousands of times only costs one instance each.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Instance.h"
+#include "Scene.h"
+//\------------------------
+
+namespace
+{
+	//\----------------------------------------------------------------------------------
+	//\ The last sub scene hit found on this thread. FinalizeHit is usually called for the hit IntersectDistance
+	//\ has only just found - the shadow test always does this - and then the sub scene is not searched again.
+	//\----------------------------------------------------------------------------------
+	struct SubSceneHit
+	{
+		const Instance*		instance = nullptr;
+		Vector3				origin;				// The world ray and distance the hit was found for
+		Vector3				direction;
+		float				distance = 0.f;
+		int					objectIndex = -1;	// Object of the sub scene that was hit
+	};
+	thread_local SubSceneHit t_lastSubSceneHit;
+}
+
+Instance::Instance(const Primitive* a_geometry, const AffineTransform& a_transform, Material* a_material) :
+	m_geometry(a_geometry), m_scene(nullptr)
+{
+	SetTransform(a_transform);
+	SetMaterial(a_material);
+}
+
+Instance::Instance(const Scene* a_scene, const AffineTransform& a_transform, Material* a_material) :
+	m_geometry(nullptr), m_scene(a_scene)
+{
+	SetTransform(a_transform);
+	SetMaterial(a_material);
+}
+
+Instance::~Instance()
+{
+}
+
+// The world ray direction is normalised so world distances are true distances, the instance space direction
+// is normalised again so the shared geometry sees an ordinary ray. The length of the transformed unit
+// direction is the ratio between distances in the two spaces.
+Ray Instance::ToInstanceSpace(const Ray& a_ray, float& a_distanceScale) const
+{
+	Vector3 localDir = m_InvTransform.TransformVector(Normalize(a_ray.Direction()));
+	a_distanceScale = localDir.Length();
+	const float invScale = 1.f / a_distanceScale;
+	return Ray(m_InvTransform.TransformPoint(a_ray.Origin()), localDir * invScale,
+		a_ray.MinLength() * a_distanceScale, a_ray.MaxDistance() * a_distanceScale);
+}
+
+bool Instance::IntersectDistance(const Ray& a_ray, float& a_distance) const
+{
+	float distanceScale = 1.f;
+	Ray localRay = ToInstanceSpace(a_ray, distanceScale);
+
+	float localDistance = 0.f;
+	if (m_geometry != nullptr)
+	{
+		if (!m_geometry->IntersectDistance(localRay, localDistance)) { return false; }
+	}
+	else
+	{
+		int objectIndex = -1;
+		if (!m_scene->IntersectDistance(localRay, localDistance, objectIndex)) { return false; }
+		a_distance = localDistance / distanceScale;
+		t_lastSubSceneHit = { this, a_ray.Origin(), a_ray.Direction(), a_distance, objectIndex };
+		return true;
+	}
+	a_distance = localDistance / distanceScale;
+	return true;
+}
+
+// Only called for the nearest hit - unless it was the last sub scene hit found on this thread, the sub scene has
+// to be searched again to find which of its objects was hit. That search only has to reach just past the hit, the
+// slack covers the rounding of the distance on its way out to world space and back.
+void Instance::FinalizeHit(const Ray& a_ray, float a_distance, IntersectResponse& a_intersectResponse) const
+{
+	float distanceScale = 1.f;
+	Ray localRay = ToInstanceSpace(a_ray, distanceScale);
+	const float localDistance = a_distance * distanceScale;
+
+	if (m_geometry != nullptr)
+	{
+		m_geometry->FinalizeHit(localRay, localDistance, a_intersectResponse);
+	}
+	else
+	{
+		const SubSceneHit& last = t_lastSubSceneHit;
+		int objectIndex = last.objectIndex;
+		if (last.instance != this || last.distance != a_distance || last.origin != a_ray.Origin() || last.direction != a_ray.Direction())
+		{
+			Ray searchRay = localRay;
+			searchRay.SetMaxDistance(localDistance * 1.001f);
+			float sceneDistance = 0.f;
+			m_scene->IntersectDistance(searchRay, sceneDistance, objectIndex);
+		}
+		m_scene->FinalizeHit(localRay, localDistance, objectIndex, a_intersectResponse);
+	}
+
+	// Back into world space - the hit point is rebuilt from the world ray so it matches the distance exactly
+	a_intersectResponse.HitPos = a_ray.Origin() + Normalize(a_ray.Direction()) * a_distance;
+	a_intersectResponse.SurfaceNormal = m_InvTransform.TransformNormal(a_intersectResponse.SurfaceNormal);
+	a_intersectResponse.SurfaceNormal.Normalize();
+	a_intersectResponse.frontFace = Dot(a_intersectResponse.SurfaceNormal, a_ray.Direction()) < 0.f;
+	a_intersectResponse.distance = a_distance;
+	a_intersectResponse.uvPerUnit *= distanceScale;							// Texture coordinates move per instance space unit
+	if (m_material != nullptr)
+	{
+		a_intersectResponse.material = m_material;				// Material override for this instance
+	}
+}
+
+// Box around the shared geometry's box moved into the world by this instance's transform
+AABB Instance::GetBounds() const
+{
+	AABB localBounds = (m_geometry != nullptr) ? m_geometry->GetBounds() : m_scene->GetBounds();
+	return localBounds.Transformed(m_Transform);
+}
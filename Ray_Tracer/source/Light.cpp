@@ -13,18 +13,48 @@
 //\------------------------
 //\ INCLUDES
 //\------------------------
+#include <cmath>
+#include <limits>
+#include <Random.h>
 #include "Light.h"
+#include "FastMath.h"
+#include "Material.h"
+#include "MathUtil.h"
 //\------------------------
 
+// The shading of ShadeSample, given the albedo so a batch can look it up once for every light
+static ColourRGB ShadeHit(const Vector3& a_albedo, const Material& a_material, const Vector3& a_hitPos, const Vector3& a_normal, const Vector3& a_eyePos, const LightSample& a_sample, float a_shadowFactor)
+{
+	// Calculate effective light colour for the diffuse channel (and metallic specular )
+	Vector3 effectiveColour = a_sample.colour * a_albedo;
+
+	ColourRGB ambient = effectiveColour * a_material.GetAmbient();												//Get ambient colour for surface
+	const Vector3& lightDirection = a_sample.directionToLight;														// Get direction to light from surace
+	float lightDiffuse = MathUtil::Max(0.f, Dot(lightDirection, a_normal));										// Positive values indicate factors in same dir
+	ColourRGB diffuse = effectiveColour * a_material.GetDiffuse() * lightDiffuse;								// Blend light diffuse with diffuse value and colour
+	// Calculate light specular value
+	// For non-metals material colour plays no part in specular highlight
+	Vector3 eyeDir = FastMath::NormalizeP(a_hitPos - a_eyePos);													// Get the dir from view to surface
+	Vector3 reflectionVec = Reflect(eyeDir, a_normal);																// Get the reflection vector of the eye around normal
+	float specularPower = (1.0f - a_material.GetRoughness()) * 254.f + 1.0f;
+	float specularFactor = FastMath::PowP(MathUtil::Max(0.f, Dot(reflectionVec, lightDirection)), specularPower);	// Get the specular value
+	ColourRGB specular = a_sample.colour * a_material.GetSpecular() * specularFactor;
+
+	return ambient + (diffuse + specular) * a_shadowFactor;
+}
+
 //\----------------------------------------------------------------------------------
 //\ -- Constructors / Destructors
 //\----------------------------------------------------------------------------------
-Light::Light() : m_Transform(Matrix4::IDENTITY), m_colourRGB(1.f, 1.f, 1.f)
+Light::Light() : m_Transform(AffineTransform::IDENTITY), m_colourRGB(1.f, 1.f, 1.f)
 {
 }
 Light::Light(const Matrix4& a_transform, const ColourRGB& a_colour) : m_Transform(a_transform), m_colourRGB(a_colour)
 {
 }
+Light::Light(const AffineTransform& a_transform, const ColourRGB& a_colour) : m_Transform(a_transform), m_colourRGB(a_colour)
+{
+}
 Light::~Light()
 {
 }
@@ -34,7 +64,132 @@ Light::~Light()
 //\----------------------------------------------------------------------------------
 Vector3 Light::GetDirectionToLight(const Vector3& a_point) const
 {
-	return Normalize(GetPosition() - a_point);
+	return FastMath::NormalizeP(GetPosition() - a_point);
+}
+float Light::GetDistanceToLight(const Vector3& a_point) const
+{
+	return (GetPosition() - a_point).Length();
+}
+LightSample Light::SampleLight(const Vector3& a_point) const
+{
+	LightSample sample;
+	sample.directionToLight = GetDirectionToLight(a_point);
+	sample.distance = GetDistanceToLight(a_point);
+	sample.colour = m_colourRGB;
+	return sample;
+}
+float Light::EstimatePower() const
+{
+	return (m_colourRGB.x + m_colourRGB.y + m_colourRGB.z) * (1.f / 3.f);
+}
+ColourRGB Light::calculateLighting(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, float a_shadowFactor) const
+{
+	return ShadeSample(a_intersectResponse, a_eyePos, SampleLight(a_intersectResponse.HitPos), a_shadowFactor);
+}
+//\----------------------------------------------------------------------------------
+//\ Shading shared by all of the lights - ambient, lambert diffuse and phong specular
+//\----------------------------------------------------------------------------------
+ColourRGB Light::ShadeSample(const IntersectResponse& a_intersectResponse, const Vector3& a_eyePos, const LightSample& a_sample, float a_shadowFactor) const
+{
+	return ShadeHit(a_intersectResponse.material->GetAlbedo(a_intersectResponse), *a_intersectResponse.material, a_intersectResponse.HitPos,
+		a_intersectResponse.SurfaceNormal, a_eyePos, a_sample, a_shadowFactor);
+}
+//\----------------------------------------------------------------------------------
+//\ Batched shading - the samples come from SampleBatch and are shaded four hits at a time. Each lane takes
+//\ the steps ShadeHit takes in the same order, so a hit gets the same colour in a batch as on its own.
+//\----------------------------------------------------------------------------------
+void Light::ShadeBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const
+{
+	SampleBatch(a_batch, a_result);
+
+	int i = 0;
+#ifdef MATHLIB_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 two = _mm_set1_ps(2.f);
+	const __m128 eyeX = _mm_set1_ps(a_batch.eyePosition.x);
+	const __m128 eyeY = _mm_set1_ps(a_batch.eyePosition.y);
+	const __m128 eyeZ = _mm_set1_ps(a_batch.eyePosition.z);
+	for (; i + 4 <= a_batch.count; i += 4)
+	{
+		// Material values are gathered a lane at a time - the hits of a batch mostly share one material
+		alignas(16) float ambientLanes[4];
+		alignas(16) float diffuseLanes[4];
+		alignas(16) float specularLanes[4];
+		alignas(16) float powerLanes[4];
+		for (int lane = 0; lane < 4; ++lane)
+		{
+			const Material* material = a_batch.materials[a_batch.material[i + lane]];
+			ambientLanes[lane] = material->GetAmbient();
+			diffuseLanes[lane] = material->GetDiffuse();
+			specularLanes[lane] = material->GetSpecular();
+			powerLanes[lane] = (1.0f - material->GetRoughness()) * 254.f + 1.0f;
+		}
+		const __m128 ambient = _mm_load_ps(ambientLanes);
+		const __m128 diffuse = _mm_load_ps(diffuseLanes);
+		const __m128 specular = _mm_load_ps(specularLanes);
+
+		const __m128 normalX = _mm_loadu_ps(a_batch.normalX + i);
+		const __m128 normalY = _mm_loadu_ps(a_batch.normalY + i);
+		const __m128 normalZ = _mm_loadu_ps(a_batch.normalZ + i);
+		const __m128 lightX = _mm_loadu_ps(a_result.directionX + i);
+		const __m128 lightY = _mm_loadu_ps(a_result.directionY + i);
+		const __m128 lightZ = _mm_loadu_ps(a_result.directionZ + i);
+		const __m128 colourR = _mm_loadu_ps(a_result.colourR + i);
+		const __m128 colourG = _mm_loadu_ps(a_result.colourG + i);
+		const __m128 colourB = _mm_loadu_ps(a_result.colourB + i);
+
+		// Lambert diffuse
+		const __m128 lightDiffuse = _mm_max_ps(zero, _mm_add_ps(_mm_add_ps(_mm_mul_ps(lightX, normalX), _mm_mul_ps(lightY, normalY)), _mm_mul_ps(lightZ, normalZ)));
+		const __m128 effectiveR = _mm_mul_ps(_mm_loadu_ps(a_batch.albedoR + i), colourR);
+		const __m128 effectiveG = _mm_mul_ps(_mm_loadu_ps(a_batch.albedoG + i), colourG);
+		const __m128 effectiveB = _mm_mul_ps(_mm_loadu_ps(a_batch.albedoB + i), colourB);
+
+		// Phong specular off the eye direction reflected around the normal
+		__m128 eyeDirX = _mm_sub_ps(_mm_loadu_ps(a_batch.positionX + i), eyeX);
+		__m128 eyeDirY = _mm_sub_ps(_mm_loadu_ps(a_batch.positionY + i), eyeY);
+		__m128 eyeDirZ = _mm_sub_ps(_mm_loadu_ps(a_batch.positionZ + i), eyeZ);
+		FastMath::NormalizeP(eyeDirX, eyeDirY, eyeDirZ);
+		const __m128 eyeDotNormal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(eyeDirX, normalX), _mm_mul_ps(eyeDirY, normalY)), _mm_mul_ps(eyeDirZ, normalZ));
+		const __m128 reflectX = _mm_sub_ps(eyeDirX, _mm_mul_ps(_mm_mul_ps(normalX, two), eyeDotNormal));
+		const __m128 reflectY = _mm_sub_ps(eyeDirY, _mm_mul_ps(_mm_mul_ps(normalY, two), eyeDotNormal));
+		const __m128 reflectZ = _mm_sub_ps(eyeDirZ, _mm_mul_ps(_mm_mul_ps(normalZ, two), eyeDotNormal));
+		const __m128 reflectDotLight = _mm_add_ps(_mm_add_ps(_mm_mul_ps(reflectX, lightX), _mm_mul_ps(reflectY, lightY)), _mm_mul_ps(reflectZ, lightZ));
+		const __m128 specularFactor = FastMath::PowP(_mm_max_ps(zero, reflectDotLight), _mm_load_ps(powerLanes));
+
+		// The result is unshadowed, the shadow factor of one drops out
+		_mm_storeu_ps(a_result.colourR + i, _mm_add_ps(_mm_mul_ps(effectiveR, ambient),
+			_mm_add_ps(_mm_mul_ps(_mm_mul_ps(effectiveR, diffuse), lightDiffuse), _mm_mul_ps(_mm_mul_ps(colourR, specular), specularFactor))));
+		_mm_storeu_ps(a_result.colourG + i, _mm_add_ps(_mm_mul_ps(effectiveG, ambient),
+			_mm_add_ps(_mm_mul_ps(_mm_mul_ps(effectiveG, diffuse), lightDiffuse), _mm_mul_ps(_mm_mul_ps(colourG, specular), specularFactor))));
+		_mm_storeu_ps(a_result.colourB + i, _mm_add_ps(_mm_mul_ps(effectiveB, ambient),
+			_mm_add_ps(_mm_mul_ps(_mm_mul_ps(effectiveB, diffuse), lightDiffuse), _mm_mul_ps(_mm_mul_ps(colourB, specular), specularFactor))));
+	}
+#endif
+	for (; i < a_batch.count; ++i)
+	{
+		const ColourRGB colour = ShadeHit(Vector3(a_batch.albedoR[i], a_batch.albedoG[i], a_batch.albedoB[i]), *a_batch.materials[a_batch.material[i]],
+			Vector3(a_batch.positionX[i], a_batch.positionY[i], a_batch.positionZ[i]), Vector3(a_batch.normalX[i], a_batch.normalY[i], a_batch.normalZ[i]),
+			a_batch.eyePosition, a_result.Load(i), 1.f);
+		a_result.colourR[i] = colour.x;
+		a_result.colourG[i] = colour.y;
+		a_result.colourB[i] = colour.z;
+	}
+}
+// One SampleLight a hit, each hit drawing from its own random sequence when the batch has them
+void Light::SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const
+{
+	for (int i = 0; i < a_batch.count; ++i)
+	{
+		if (a_batch.seeds != nullptr)
+		{
+			Random::SetSeed(a_batch.seeds[i]);
+		}
+		a_result.Store(i, SampleLight(Vector3(a_batch.positionX[i], a_batch.positionY[i], a_batch.positionZ[i])));
+		if (a_batch.seeds != nullptr)
+		{
+			a_batch.seeds[i] = Random::GetSeed();
+		}
+	}
 }
 
 //\----------------------------------------------------------------------------------
@@ -42,19 +197,28 @@ Vector3 Light::GetDirectionToLight(const Vector3& a_point) const
 //\----------------------------------------------------------------------------------
 Matrix4 Light::GetTransform() const
 {
-	return m_Transform;
+	return m_Transform.ToMatrix4();
 }
 void Light::SetTransform(const Matrix4& a_m4)
 {
-	m_Transform = a_m4;
+	m_Transform = AffineTransform(a_m4);
 }
 // Get and set the position of the light
 Vector3 Light::GetPosition() const
 {
-	return m_Transform.GetColumnV3(3);
+	return m_Transform.GetTranslation();
 }
 
 void Light::SetPosition(const Vector3& a_v3)
 {
-	m_Transform.SetColumnV3(3, a_v3);
+	m_Transform.SetTranslation(a_v3);
+}
+// Build an orthonormal basis around the facing direction - world up is used unless the light faces straight up or down
+void Light::SetFacing(const Vector3& a_facing)
+{
+	Vector3 forward = Normalize(a_facing);
+	Vector3 up = (fabsf(forward.y) < 0.999f) ? Vector3(0.f, 1.f, 0.f) : Vector3(1.f, 0.f, 0.f);
+	Vector3 right = Normalize(Cross(up, forward));
+	up = Cross(forward, right);
+	m_Transform = AffineTransform(right, up, forward, m_Transform.GetTranslation());
 }
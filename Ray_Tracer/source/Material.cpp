@@ -12,23 +12,37 @@
 //\------------------------
 //\ INCLUDES
 //\------------------------
+#include <cmath>
 #include <Random.h>
 #include "Material.h"
+#include "FastMath.h"
 #include "IntersectionResponse.h"
+#include "Texture.h"
 //\------------------------
 
 class Material;
 
+// The footprint is scaled with the texture so a repeated texture is filtered over as many of its texels
+Vector3 Material::GetAlbedo(const IntersectResponse& a_ir) const
+{
+	if (m_albedoTexture == nullptr)
+	{
+		return m_albedo;
+	}
+	return m_albedo * m_albedoTexture->Sample(Vector2(a_ir.uv.x * m_textureRepeat, a_ir.uv.y * m_textureRepeat), a_ir.footprint * a_ir.uvPerUnit * m_textureRepeat);
+}
+
 // Refraction Calculation
 bool Material::CalcReflection(const Ray& a_in, const IntersectResponse& a_ir, Ray& a_out) const
 {
 	// Generate a random vector in range -1 - 1 for all components 
 	Vector3 randomUnitVec = Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f));
-	randomUnitVec.Normalize();
+	randomUnitVec = FastMath::NormalizeP(randomUnitVec);
 	// Reflected Ray, from hit location 
-	Vector3 reflected = Normalize(Reflect(a_in.Direction(), a_ir.SurfaceNormal));
+	Vector3 reflected = FastMath::NormalizeP(Reflect(a_in.Direction(), a_ir.SurfaceNormal));
 	// Add the random unit vector to the reflected ray based on roughness if smooth then no randomness
 	a_out = Ray(a_ir.HitPos, reflected + (randomUnitVec * m_roughness), 0.001f);
+	a_out.SetCone(a_ir.footprint, a_in.ConeSpread());							// The cone carries on from the width it hit at
 	// Return a true if we have not reflected into the surface
 	return (Dot(a_out.Direction(), a_ir.SurfaceNormal) > 0.f);
 }
@@ -37,7 +51,7 @@ bool Material::CalcRefraction(const Ray& a_in, const IntersectResponse& a_ir, Ra
 {
     // Generate a random vector in range -1 : 1 for all components
     Vector3 randomUnitVec = Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f));
-    randomUnitVec.Normalize();											// Ensure Vector is Normalised to make vector unit vector
+    randomUnitVec = FastMath::NormalizeP(randomUnitVec);				// Ensure Vector is Normalised to make vector unit vector
     // refract the ray from the hit location
     // For this we will assume that on leaving an object the ray enters air refractive index of 1.0
     float refraction_ratio = a_ir.frontFace ? (a_ir.currentRefInd / m_refractiveIndex) : m_refractiveIndex / a_ir.currentRefInd;    // Inversion of n/n1 from snells law
@@ -45,10 +59,11 @@ bool Material::CalcRefraction(const Ray& a_in, const IntersectResponse& a_ir, Ra
 
     float sin2_t = refraction_ratio * refraction_ratio * (1.f - cos_i * cos_i);					// sin(theta_t^2 outgoing angle of refracted ray
 	if (sin2_t > 1.f) return false;
-	float cos_t = sqrtf(fabsf(1.f - sin2_t));
+	float cos_t = FastMath::SqrtP(fabsf(1.f - sin2_t));
 	// Compute direction of outgoing refracted ray
 	Vector3 refracted = a_ir.SurfaceNormal * (refraction_ratio * cos_i - cos_t) + a_in.Direction() * refraction_ratio;
 	a_out = Ray(a_ir.HitPos, refracted + (randomUnitVec * m_roughness), 0.001f);				//Outgoing refracted ray
+	a_out.SetCone(a_ir.footprint, a_in.ConeSpread());
 
 	return true;
 }
@@ -66,9 +81,11 @@ float Material::Schlick(const Ray& a_in, const IntersectResponse& a_ir) const
 		{
 			return 1.f;
 		}
-		cos_i = sqrtf(1.f - sin2_t);															// use cos_t instead of cos_i
+		cos_i = FastMath::SqrtP(1.f - sin2_t);													// use cos_t instead of cos_i
 	}
 	float r0 = (1.f - refraction_ratio) / (1.f + refraction_ratio);								// Schlicks approximation
 		r0 = r0 * r0;
-		return r0 + (1.f - r0) * powf(1.f - cos_i, 5);
+		float x = 1.f - cos_i;
+		float x5 = FastMath::IsFast() ? (x * x) * (x * x) * x : powf(x, 5);					// Multiplying out is exact enough and far cheaper
+		return r0 + (1.f - r0) * x5;
 }
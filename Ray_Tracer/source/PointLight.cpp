@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				PointLight.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A point light shines equally in all directions from the position of its transform. The light
+//						falls off with the square of the distance from the light.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cmath>
+#include "PointLight.h"
+#include "FastMath.h"
+//\------------------------
+
+PointLight::PointLight() : m_intensity(1.f)
+{
+}
+
+PointLight::PointLight(const Vector3& a_position, const ColourRGB& a_colour, float a_intensity)
+	: Light(AffineTransform::IDENTITY, a_colour), m_intensity(a_intensity)
+{
+	SetPosition(a_position);
+}
+
+PointLight::~PointLight()
+{
+}
+
+LightSample PointLight::SampleLight(const Vector3& a_point) const
+{
+	Vector3 toLight = GetPosition() - a_point;
+	float distanceSqr = Dot(toLight, toLight);
+
+	LightSample sample;
+	sample.distance = FastMath::SqrtP(distanceSqr);
+	sample.directionToLight = toLight * (1.f / sample.distance);
+	sample.colour = m_colourRGB * (m_intensity / distanceSqr);			// Inverse square falloff
+	return sample;
+}
+
+// The same steps as SampleLight on four hits at a time, the hits left over one at a time
+void PointLight::SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const
+{
+	int i = 0;
+#ifdef MATHLIB_SSE
+	const Vector3 position = GetPosition();
+	const __m128 positionX = _mm_set1_ps(position.x);
+	const __m128 positionY = _mm_set1_ps(position.y);
+	const __m128 positionZ = _mm_set1_ps(position.z);
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 intensity = _mm_set1_ps(m_intensity);
+	for (; i + 4 <= a_batch.count; i += 4)
+	{
+		const __m128 toLightX = _mm_sub_ps(positionX, _mm_loadu_ps(a_batch.positionX + i));
+		const __m128 toLightY = _mm_sub_ps(positionY, _mm_loadu_ps(a_batch.positionY + i));
+		const __m128 toLightZ = _mm_sub_ps(positionZ, _mm_loadu_ps(a_batch.positionZ + i));
+		const __m128 distanceSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toLightX, toLightX), _mm_mul_ps(toLightY, toLightY)), _mm_mul_ps(toLightZ, toLightZ));
+		const __m128 distance = FastMath::SqrtP(distanceSqr);
+		const __m128 invDistance = _mm_div_ps(one, distance);
+		const __m128 falloff = _mm_div_ps(intensity, distanceSqr);			// Inverse square falloff
+		_mm_storeu_ps(a_result.distance + i, distance);
+		_mm_storeu_ps(a_result.directionX + i, _mm_mul_ps(toLightX, invDistance));
+		_mm_storeu_ps(a_result.directionY + i, _mm_mul_ps(toLightY, invDistance));
+		_mm_storeu_ps(a_result.directionZ + i, _mm_mul_ps(toLightZ, invDistance));
+		_mm_storeu_ps(a_result.colourR + i, _mm_mul_ps(_mm_set1_ps(m_colourRGB.x), falloff));
+		_mm_storeu_ps(a_result.colourG + i, _mm_mul_ps(_mm_set1_ps(m_colourRGB.y), falloff));
+		_mm_storeu_ps(a_result.colourB + i, _mm_mul_ps(_mm_set1_ps(m_colourRGB.z), falloff));
+	}
+#endif
+	for (; i < a_batch.count; ++i)
+	{
+		a_result.Store(i, PointLight::SampleLight(Vector3(a_batch.positionX[i], a_batch.positionY[i], a_batch.positionZ[i])));
+	}
+}
+
+float PointLight::EstimatePower() const
+{
+	return Light::EstimatePower() * m_intensity;
+}
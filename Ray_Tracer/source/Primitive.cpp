@@ -15,32 +15,54 @@
 #include "Material.h"
 //\------------------------
 
-Primitive::Primitive() : m_Transform(Matrix4::IDENTITY), m_Scale()
+Primitive::Primitive() : m_Transform(AffineTransform::IDENTITY), m_InvTransform(AffineTransform::IDENTITY), m_Scale(), m_material(nullptr)
 {
 }
 Primitive::~Primitive()
 {
 }
 
+// Full intersection test - the cheap distance test followed by building the hit record
+bool Primitive::IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const
+{
+	float distance = 0.f;
+	if (!IntersectDistance(a_ray, distance))
+	{
+		return false;
+	}
+	FinalizeHit(a_ray, distance, a_intersectResponse);
+	a_intersectResponse.footprint = a_ray.ConeWidthAt(distance);
+	return true;
+}
+
 // Get and Set primative matrix
 Matrix4 Primitive::GetTransform() const
 {
-	return m_Transform;
+	return m_Transform.ToMatrix4();
 }
 
 void Primitive::SetTransform(const Matrix4& a_m4)
 {
-	m_Transform = a_m4;
+	SetTransform(AffineTransform(a_m4));
+}
+
+void Primitive::SetTransform(const AffineTransform& a_tx)
+{
+	m_Transform = a_tx;
+	m_InvTransform = m_Transform.Inverse();
+	TransformChanged();
 }
 
 Vector3 Primitive::GetPosition() const
 {
-	return m_Transform.GetColumnV3(3);
+	return m_Transform.GetTranslation();
 }
 
 void Primitive::SetPosition(const Vector3& a_v3)
 {
-	m_Transform.SetColumnV3(3, a_v3);
+	m_Transform.SetTranslation(a_v3);
+	m_InvTransform = m_Transform.Inverse();
+	TransformChanged();
 }
 // Get and set the position of the primative
 Vector3 Primitive::GetScale() const
@@ -51,9 +73,11 @@ Vector3 Primitive::GetScale() const
 void Primitive::SetScale(const Vector3& a_v3)
 {
 	m_Scale = a_v3;
-	Matrix4 scale;
+	AffineTransform scale;
 	scale.Scale(a_v3);
 	m_Transform = m_Transform * scale;
+	m_InvTransform = m_Transform.Inverse();
+	TransformChanged();
 }
 //Matrix4 Primitive::GetShear() const
 //{
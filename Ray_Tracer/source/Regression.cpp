@@ -0,0 +1,436 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Regression.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Golden image and throughput checks run from the command line with --regress [directory].
+//						A fixed set of seeded scenes is rendered and each image is compared with the one stored in
+//						the directory, and each render speed with the speed recorded for it on this machine.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+
+#include "Regression.h"
+#include "ExampleScene.h"
+#include "GeneratedScene.h"
+#include "Ellipsoid.h"
+#include "ImageOutput.h"
+#include "Material.h"
+#include "PointLight.h"
+#include "Random.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include "StreamingImage.h"
+#include "Texture.h"
+#include "WavefrontRenderer.h"
+//\------------------------
+
+namespace
+{
+	const int IMAGE_WIDTH = 128;
+	const int IMAGE_HEIGHT = 64;
+	const int RENDER_SEED = 1;
+	// Each scene is timed by the median of at least this many renders lasting at least this long - a slow or fast
+	// moment on a busy machine moves the best or the average, but seldom the middle one
+	const int TIMED_RENDERS = 7;
+	const double TIMED_MS = 2000.0;
+	const char* THROUGHPUT_FILENAME = "throughput.txt";
+
+	//\----------------------------------------------------------------------------------
+	//\ The reference scenes - between them they go through both renderers, glass, ellipsoids, several lights and
+	//\ a hierarchy of thousands of objects. Changing one changes its image, so the golden images must be updated.
+	//\----------------------------------------------------------------------------------
+	struct Reference
+	{
+		const char* name;
+		const char* scene;				// Settings for GeneratedScene, or null for the example scene
+		int raysPerPixel;
+		bool wavefront;					// Rendered by the wavefront renderer on one thread rather than Renderer
+	};
+	const Reference REFERENCES[] =
+	{
+		{ "example",			nullptr,												16,	false },
+		{ "example_wavefront",	nullptr,												16,	true },
+		{ "generated",			"objects=2000,ellipsoids=0.5,glass=0.3,lights=3,seed=7",	8,	false },
+		{ "generated_glass",	"objects=300,ellipsoids=1,glass=0.6,lights=1,seed=11",		8,	true },
+	};
+
+	// Render a reference scene and time it - the image is the same every time, the time is the median of the renders
+	void RenderReference(const Reference& a_reference, std::vector<ColourRGB>& a_pixels, double& a_medianMs)
+	{
+		const float aspectRatio = (float)IMAGE_WIDTH / (float)IMAGE_HEIGHT;
+		std::unique_ptr<ExampleScene> example;
+		std::unique_ptr<GeneratedScene> generated;
+		if (a_reference.scene == nullptr)
+		{
+			example.reset(new ExampleScene(aspectRatio));
+		}
+		else
+		{
+			GeneratedSceneSettings settings;
+			settings.Parse(a_reference.scene);
+			generated.reset(new GeneratedScene(settings, aspectRatio));
+		}
+		const Scene& scene = example ? example->GetScene() : generated->GetScene();
+
+		Renderer renderer(IMAGE_WIDTH, IMAGE_HEIGHT, a_reference.raysPerPixel);
+		renderer.SetSeed(RENDER_SEED);
+		renderer.SetShowProgress(false);
+		WavefrontRenderer wavefront(renderer, 1 << 18, 1);
+		std::vector<double> times;
+		double totalMs = 0.0;
+		for (int r = 0; r < TIMED_RENDERS || totalMs < TIMED_MS; ++r)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			if (a_reference.wavefront)
+			{
+				wavefront.Render(scene, a_pixels);
+			}
+			else
+			{
+				renderer.Render(scene, a_pixels);
+			}
+			const double renderMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			times.push_back(renderMs);
+			totalMs += renderMs;
+		}
+		std::vector<double>::iterator median = times.begin() + times.size() / 2;
+		std::nth_element(times.begin(), median, times.end());
+		a_medianMs = *median;
+	}
+
+	// Camera rays a second of a render in millions - the bounce and shadow rays behind them are the scene's own
+	// business and stay the same while the scene does
+	double MegaRaysPerSecond(const Reference& a_reference, double a_ms)
+	{
+		return (double)IMAGE_WIDTH * IMAGE_HEIGHT * a_reference.raysPerPixel / (a_ms * 1e3);
+	}
+
+	// The colours as the 8 bit image stores them, scaled back the way Texture::LoadImage reads them, so a fresh render
+	// matches its golden image exactly when nothing has changed
+	void Quantise(std::vector<ColourRGB>& a_pixels)
+	{
+		const float invRange = 1.f / 255.f;
+		for (ColourRGB& pixel : a_pixels)
+		{
+			pixel = ColourRGB(ImageOutput::ToByte(pixel.x) * invRange, ImageOutput::ToByte(pixel.y) * invRange, ImageOutput::ToByte(pixel.z) * invRange);
+		}
+	}
+
+	bool WriteImage(const std::string& a_filename, const std::vector<ColourRGB>& a_pixels)
+	{
+		StreamingImage image;
+		return image.Open(a_filename, IMAGE_WIDTH, IMAGE_HEIGHT) && image.WriteRows(0, IMAGE_HEIGHT, a_pixels.data()) && image.Close();
+	}
+
+	std::map<std::string, double> ReadThroughput(const std::string& a_filename)
+	{
+		std::map<std::string, double> throughput;
+		std::ifstream file(a_filename);
+		std::string name;
+		double megaRays = 0.0;
+		while (file >> name >> megaRays)
+		{
+			throughput[name] = megaRays;
+		}
+		return throughput;
+	}
+
+	bool WriteThroughput(const std::string& a_filename, const std::map<std::string, double>& a_throughput)
+	{
+		std::ofstream file(a_filename);
+		for (const auto& entry : a_throughput)
+		{
+			file << entry.first << ' ' << entry.second << '\n';
+		}
+		return (bool)file;
+	}
+
+	// Blur a channel of an image with a small binomial filter - the edges repeat their last pixel
+	void Blur(std::vector<float>& a_channel, int a_width, int a_height)
+	{
+		const float weights[5] = { 1.f / 16.f, 4.f / 16.f, 6.f / 16.f, 4.f / 16.f, 1.f / 16.f };
+		std::vector<float> rows(a_channel.size());
+		for (int y = 0; y < a_height; ++y)
+		{
+			for (int x = 0; x < a_width; ++x)
+			{
+				float sum = 0.f;
+				for (int k = -2; k <= 2; ++k)
+				{
+					sum += weights[k + 2] * a_channel[(size_t)y * a_width + std::min(std::max(x + k, 0), a_width - 1)];
+				}
+				rows[(size_t)y * a_width + x] = sum;
+			}
+		}
+		for (int y = 0; y < a_height; ++y)
+		{
+			for (int x = 0; x < a_width; ++x)
+			{
+				float sum = 0.f;
+				for (int k = -2; k <= 2; ++k)
+				{
+					sum += weights[k + 2] * rows[(size_t)std::min(std::max(y + k, 0), a_height - 1) * a_width + x];
+				}
+				a_channel[(size_t)y * a_width + x] = sum;
+			}
+		}
+	}
+
+	// Brightness and two colour opponent channels of an image, each blurred
+	void ToOpponent(const std::vector<ColourRGB>& a_image, int a_width, int a_height, std::vector<float> a_channels[3])
+	{
+		for (int c = 0; c < 3; ++c)
+		{
+			a_channels[c].resize(a_image.size());
+		}
+		for (size_t i = 0; i < a_image.size(); ++i)
+		{
+			const float r = std::min(std::max(a_image[i].x, 0.f), 1.f);
+			const float g = std::min(std::max(a_image[i].y, 0.f), 1.f);
+			const float b = std::min(std::max(a_image[i].z, 0.f), 1.f);
+			a_channels[0][i] = 0.2126f * r + 0.7152f * g + 0.0722f * b;
+			a_channels[1][i] = r - g;
+			a_channels[2][i] = 0.5f * (r + g) - b;
+		}
+		for (int c = 0; c < 3; ++c)
+		{
+			Blur(a_channels[c], a_width, a_height);
+		}
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Acceleration check - the same rays are traced through an acceleration structure and through the linear
+	//\ search over every object, which has nothing to get wrong. Ray directions are left short of unit length as
+	//\ well, the way rough refraction makes them, since primitives return world distances whatever the length.
+	//\----------------------------------------------------------------------------------
+	const int ACCELERATION_OBJECTS = 200;
+	const int ACCELERATION_RAYS = 20000;
+	const float ACCELERATION_DIRECTION_LENGTHS[] = { 1.f, 0.9f, 0.2f };
+
+	struct AccelerationCheck
+	{
+		const char* name;
+		Scene::Acceleration acceleration;
+	};
+	const AccelerationCheck ACCELERATION_CHECKS[] =
+	{
+		{ "hierarchy",	Scene::BOUNDING_VOLUME_HIERARCHY },
+		{ "grid",		Scene::UNIFORM_GRID },
+	};
+
+	// Rays whose nearest hit or shadow test through a_acceleration differs from the linear search
+	int AccelerationMismatches(Scene::Acceleration a_acceleration)
+	{
+		Material material;
+		PointLight light(Vector3(0.f, 20.f, 0.f), ColourRGB(1.f, 1.f, 1.f), 1.f);
+		Random::SetSeed(RENDER_SEED);
+		std::vector<Ellipsoid> objects;
+		objects.reserve(ACCELERATION_OBJECTS);
+		for (int i = 0; i < ACCELERATION_OBJECTS; ++i)
+		{
+			objects.push_back(Ellipsoid(Vector3(Random::RandomRange(-10.f, 10.f), Random::RandomRange(-10.f, 10.f), Random::RandomRange(-10.f, 10.f)),
+				Random::RandomRange(0.2f, 1.5f)));
+			if (i % 3 == 0)
+			{
+				objects.back().SetScale(Vector3(Random::RandomRange(0.5f, 2.f), Random::RandomRange(0.5f, 2.f), Random::RandomRange(0.5f, 2.f)));
+			}
+			objects.back().SetMaterial(&material);
+		}
+		Scene linear;
+		Scene accelerated;
+		for (const Ellipsoid& object : objects)
+		{
+			linear.AddObject(&object);
+			accelerated.AddObject(&object);
+		}
+		linear.AddLight(&light);
+		accelerated.AddLight(&light);
+		accelerated.SetAcceleration(a_acceleration);
+		accelerated.BuildAccelerationStructure();
+
+		int mismatches = 0;
+		for (int r = 0; r < ACCELERATION_RAYS; ++r)
+		{
+			const float length = ACCELERATION_DIRECTION_LENGTHS[r % (sizeof(ACCELERATION_DIRECTION_LENGTHS) / sizeof(float))];
+			const Vector3 origin(Random::RandomRange(-12.f, 12.f), Random::RandomRange(-12.f, 12.f), Random::RandomRange(-12.f, 12.f));
+			const Vector3 direction = Normalize(Vector3(Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f), Random::RandomRange(-1.f, 1.f))) * length;
+
+			const Ray ray(origin, direction);
+			float linearDistance = 0.f;
+			float acceleratedDistance = 0.f;
+			int linearObject = -1;
+			int acceleratedObject = -1;
+			const bool linearHit = linear.IntersectDistance(ray, linearDistance, linearObject);
+			const bool acceleratedHit = accelerated.IntersectDistance(ray, acceleratedDistance, acceleratedObject);
+			bool differs = linearHit != acceleratedHit || (linearHit && (linearDistance != acceleratedDistance || linearObject != acceleratedObject));
+
+			const Ray shadowRay(origin, direction, 0.001f, Random::RandomRange(1.f, 20.f));
+			differs = differs || linear.ShadowTest(shadowRay, 0) != accelerated.ShadowTest(shadowRay, 0);
+			mismatches += differs ? 1 : 0;
+		}
+		return mismatches;
+	}
+}
+
+Regression::ImageDifference Regression::Compare(const std::vector<ColourRGB>& a_image, const std::vector<ColourRGB>& a_golden, int a_width, int a_height)
+{
+	ImageDifference difference = { 0.0, 0.0, 0.0 };
+	if (a_image.empty() || a_image.size() != a_golden.size())
+	{
+		return ImageDifference{ 0.0, 1.0, 1.0 };
+	}
+
+	double squaredSum = 0.0;
+	for (size_t i = 0; i < a_image.size(); ++i)
+	{
+		const float* pixel = &a_image[i].x;
+		const float* golden = &a_golden[i].x;
+		for (int c = 0; c < 3; ++c)
+		{
+			double channelDifference = (double)std::min(std::max(pixel[c], 0.f), 1.f) - (double)std::min(std::max(golden[c], 0.f), 1.f);
+			squaredSum += channelDifference * channelDifference;
+		}
+	}
+	const double meanSquared = squaredSum / (double)(a_image.size() * 3);
+	difference.psnr = meanSquared > 0.0 ? 10.0 * std::log10(1.0 / meanSquared) : std::numeric_limits<double>::infinity();
+
+	// The brightness difference plus the distance between the colours, the way FLIP's HyAB distance adds them
+	std::vector<float> image[3];
+	std::vector<float> golden[3];
+	ToOpponent(a_image, a_width, a_height, image);
+	ToOpponent(a_golden, a_width, a_height, golden);
+	std::vector<float> errors(a_image.size());
+	double errorSum = 0.0;
+	for (size_t i = 0; i < errors.size(); ++i)
+	{
+		const float a = image[1][i] - golden[1][i];
+		const float b = image[2][i] - golden[2][i];
+		errors[i] = std::min(std::fabs(image[0][i] - golden[0][i]) + 0.5f * std::sqrt(a * a + b * b), 1.f);
+		errorSum += errors[i];
+	}
+	difference.meanError = errorSum / (double)errors.size();
+	std::vector<float>::iterator percentile = errors.begin() + (errors.size() * 99) / 100;
+	std::nth_element(errors.begin(), percentile, errors.end());
+	difference.peakError = *percentile;
+	return difference;
+}
+
+bool Regression::Run(const std::string& a_directory, const Thresholds& a_thresholds, std::ostream& a_out)
+{
+	const std::string throughputFilename = a_directory + "/" + THROUGHPUT_FILENAME;
+	std::map<std::string, double> recorded = ReadThroughput(throughputFilename);
+	bool recordedNew = false;
+	int failures = 0;
+	a_out << "Regression - " << IMAGE_WIDTH << "x" << IMAGE_HEIGHT << " against " << a_directory << std::endl;
+	for (const AccelerationCheck& check : ACCELERATION_CHECKS)
+	{
+		const int mismatches = AccelerationMismatches(check.acceleration);
+		a_out << "  " << std::left << std::setw(20) << check.name << std::right << mismatches << " of " << ACCELERATION_RAYS
+			<< " rays differ from the linear search" << (mismatches == 0 ? "" : " FAILED") << std::endl;
+		failures += mismatches == 0 ? 0 : 1;
+	}
+	for (const Reference& reference : REFERENCES)
+	{
+		std::vector<ColourRGB> pixels;
+		double medianMs = 0.0;
+		RenderReference(reference, pixels, medianMs);
+		Quantise(pixels);
+		const double megaRays = MegaRaysPerSecond(reference, medianMs);
+
+		a_out << "  " << std::left << std::setw(20) << reference.name << std::right;
+		bool passed = true;
+		bool imageChanged = false;
+		std::vector<ColourRGB> golden;
+		int width = 0;
+		int height = 0;
+		const std::string goldenFilename = a_directory + "/" + reference.name + ".ppm";
+		if (!Texture::LoadImage(goldenFilename, golden, width, height) || width != IMAGE_WIDTH || height != IMAGE_HEIGHT)
+		{
+			a_out << "no golden image " << goldenFilename;
+			passed = false;
+		}
+		else
+		{
+			ImageDifference difference = Compare(pixels, golden, IMAGE_WIDTH, IMAGE_HEIGHT);
+			a_out << "PSNR " << std::setw(6) << std::setprecision(4) << difference.psnr << " dB, error " << std::setprecision(3)
+				<< difference.meanError << " (99% under " << difference.peakError << ")";
+			if (difference.psnr < a_thresholds.minPsnr || difference.meanError > a_thresholds.maxMeanError ||
+				difference.peakError > a_thresholds.maxPeakError)
+			{
+				a_out << " - IMAGE CHANGED";
+				passed = false;
+				imageChanged = true;
+			}
+		}
+
+		a_out << ", " << std::setprecision(4) << megaRays << " camera Mrays/s";
+		auto record = recorded.find(reference.name);
+		if (record == recorded.end())
+		{
+			a_out << " (recorded)";
+			recorded[reference.name] = megaRays;
+			recordedNew = true;
+		}
+		else
+		{
+			const double change = megaRays / record->second - 1.0;
+			a_out << " (" << std::showpos << std::setprecision(3) << change * 100.0 << std::noshowpos << "% on " << record->second << ")";
+			if (change < -a_thresholds.maxSlowdown)
+			{
+				a_out << " - SLOWER";
+				passed = false;
+			}
+		}
+		a_out << (passed ? "" : " FAILED") << std::endl;
+		if (!passed)
+		{
+			++failures;
+		}
+		// Only an image that differs is worth looking at - a slow render draws the same picture
+		if (imageChanged)
+		{
+			WriteImage(a_directory + "/" + reference.name + "_failed.ppm", pixels);
+		}
+	}
+	if (recordedNew && !WriteThroughput(throughputFilename, recorded))
+	{
+		a_out << "  could not record the rays a second in " << throughputFilename << std::endl;
+	}
+	a_out << (failures == 0 ? "All passed" : std::to_string(failures) + " failed") << std::endl;
+	return failures == 0;
+}
+
+bool Regression::Update(const std::string& a_directory, std::ostream& a_out)
+{
+	std::map<std::string, double> recorded;
+	bool written = true;
+	for (const Reference& reference : REFERENCES)
+	{
+		std::vector<ColourRGB> pixels;
+		double medianMs = 0.0;
+		RenderReference(reference, pixels, medianMs);
+		recorded[reference.name] = MegaRaysPerSecond(reference, medianMs);
+		const std::string goldenFilename = a_directory + "/" + reference.name + ".ppm";
+		if (!WriteImage(goldenFilename, pixels))
+		{
+			a_out << "Could not write " << goldenFilename << std::endl;
+			written = false;
+			continue;
+		}
+		a_out << "  " << std::left << std::setw(20) << reference.name << std::right << goldenFilename << ", "
+			<< recorded[reference.name] << " camera Mrays/s" << std::endl;
+	}
+	return WriteThroughput(a_directory + "/" + THROUGHPUT_FILENAME, recorded) && written;
+}
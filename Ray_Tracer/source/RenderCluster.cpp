@@ -0,0 +1,438 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				RenderCluster.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Splits a render across worker processes. The coordinator hands out tiles over TCP and puts
+//						the colours that come back into the image, workers render the tiles they are given. Every
+//						pixel has its own random sequence so the image matches a single process render exactly.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <thread>
+
+#include "RenderCluster.h"
+#include "Renderer.h"
+#include "ExampleScene.h"
+#include "FastMath.h"
+#include "Socket.h"
+//\------------------------
+
+namespace
+{
+	//\----------------------------------------------------------------------------------
+	//\ Protocol - every message is a type and a payload length followed by the payload. Integers and floats
+	//\ are sent in the byte order of the machine, so every machine in a cluster must share it.
+	//\		JOB		coordinator -> worker	width, height, rays per pixel, bounces, seed, precision
+	//\		TILE	coordinator -> worker	x, y, width, height
+	//\		RESULT	worker -> coordinator	x, y, width, height then three floats per pixel
+	//\		DONE	coordinator -> worker	no payload - the worker exits
+	//\----------------------------------------------------------------------------------
+	enum MessageType : std::uint32_t
+	{
+		MESSAGE_JOB = 1,
+		MESSAGE_TILE,
+		MESSAGE_RESULT,
+		MESSAGE_DONE,
+	};
+
+	const int TILE_SIZE = 32;
+	const int WAIT_MS = 100;						// Longest the coordinator sleeps between checks on its workers
+	const double SLOW_TILE_FACTOR = 4.0;			// A tile taking this many times the average is handed out again
+	const double MIN_SLOW_TILE_MS = 1000.0;
+	const std::uint32_t MAX_PAYLOAD = 64u << 20;	// Anything bigger is a broken connection, not a tile
+
+	bool SendMessage(Socket& a_socket, MessageType a_type, const std::vector<char>& a_payload)
+	{
+		std::uint32_t header[2] = { (std::uint32_t)a_type, (std::uint32_t)a_payload.size() };
+		return a_socket.SendAll(header, sizeof(header)) && (a_payload.empty() || a_socket.SendAll(a_payload.data(), a_payload.size()));
+	}
+
+	bool ReceiveMessage(Socket& a_socket, MessageType& a_type, std::vector<char>& a_payload)
+	{
+		std::uint32_t header[2];
+		if (!a_socket.ReceiveAll(header, sizeof(header)) || header[1] > MAX_PAYLOAD)
+		{
+			return false;
+		}
+		a_type = (MessageType)header[0];
+		a_payload.resize(header[1]);
+		return a_payload.empty() || a_socket.ReceiveAll(a_payload.data(), a_payload.size());
+	}
+
+	// Payloads are built from and read back into arrays of plain values
+	template<typename T>
+	std::vector<char> ToPayload(const T* a_values, size_t a_count)
+	{
+		std::vector<char> payload(sizeof(T) * a_count);
+		std::memcpy(payload.data(), a_values, payload.size());
+		return payload;
+	}
+
+	struct TileRect
+	{
+		std::int32_t x, y, width, height;
+	};
+
+	//\----------------------------------------------------------------------------------
+	//\ Coordinator state
+	//\----------------------------------------------------------------------------------
+	struct Worker
+	{
+		Socket		socket;
+		int			tile = -1;				// Tile being rendered, -1 when idle
+		std::chrono::steady_clock::time_point started;
+		int			tilesDone = 0;
+	};
+
+	struct TileState
+	{
+		TileRect	rect;
+		bool		done = false;
+		int			inFlight = 0;			// Number of workers rendering it
+	};
+
+	class Coordinator
+	{
+	public:
+		Coordinator(const Renderer& a_renderer, std::vector<ColourRGB>& a_pixels, std::ostream& a_log) :
+			m_renderer(a_renderer), m_pixels(a_pixels), m_log(a_log), m_tilesDone(0), m_tileMsTotal(0.0), m_reissued(0)
+		{
+			// Tiles cover the renderer's crop window, the pixels are the crop window only
+			for (int y = 0; y < a_renderer.GetCropHeight(); y += TILE_SIZE)
+			{
+				for (int x = 0; x < a_renderer.GetCropWidth(); x += TILE_SIZE)
+				{
+					TileState tile;
+					tile.rect.x = a_renderer.GetCropX() + x;
+					tile.rect.y = a_renderer.GetCropY() + y;
+					tile.rect.width = std::min(TILE_SIZE, a_renderer.GetCropWidth() - x);
+					tile.rect.height = std::min(TILE_SIZE, a_renderer.GetCropHeight() - y);
+					m_pending.push_back((int)m_tiles.size());
+					m_tiles.push_back(tile);
+				}
+			}
+			m_pixels.assign((size_t)a_renderer.GetCropWidth() * (size_t)a_renderer.GetCropHeight(), ColourRGB(0.f, 0.f, 0.f));
+		}
+
+		bool IsFinished() const { return m_tilesDone == (int)m_tiles.size(); }
+		int GetReissued() const { return m_reissued; }
+		std::vector<std::unique_ptr<Worker>>& GetWorkers() { return m_workers; }
+
+		void AddWorker(Socket a_socket)
+		{
+			std::unique_ptr<Worker> worker(new Worker());
+			worker->socket = std::move(a_socket);
+			std::int32_t job[6] = { m_renderer.GetWidth(), m_renderer.GetHeight(), m_renderer.GetRaysPerPixel(), m_renderer.GetBounces(), m_renderer.GetSeed(),
+				(std::int32_t)FastMath::GetPrecision() };
+			if (SendMessage(worker->socket, MESSAGE_JOB, ToPayload(job, 6)))
+			{
+				m_workers.push_back(std::move(worker));
+			}
+		}
+
+		// Read the message waiting from worker a_index - returns false when the worker has gone
+		bool ReadFrom(int a_index)
+		{
+			Worker& worker = *m_workers[a_index];
+			MessageType type;
+			std::vector<char> payload;
+			if (!ReceiveMessage(worker.socket, type, payload) || type != MESSAGE_RESULT || payload.size() < sizeof(TileRect))
+			{
+				return false;
+			}
+			TileRect rect;
+			std::memcpy(&rect, payload.data(), sizeof(rect));
+			if (worker.tile < 0 || std::memcmp(&rect, &m_tiles[worker.tile].rect, sizeof(rect)) != 0 ||
+				payload.size() != sizeof(TileRect) + sizeof(float) * 3 * (size_t)rect.width * (size_t)rect.height)
+			{
+				return false;
+			}
+			TileState& tile = m_tiles[worker.tile];
+			--tile.inFlight;
+			if (!tile.done)
+			{
+				// The first copy of a tile to come back is kept
+				const float* colours = reinterpret_cast<const float*>(payload.data() + sizeof(TileRect));
+				for (int i = 0; i < rect.height; ++i)
+				{
+					for (int j = 0; j < rect.width; ++j)
+					{
+						const float* colour = colours + ((size_t)i * rect.width + j) * 3;
+						size_t pixel = (size_t)(rect.y - m_renderer.GetCropY() + i) * m_renderer.GetCropWidth() + (rect.x - m_renderer.GetCropX() + j);
+						m_pixels[pixel] = ColourRGB(colour[0], colour[1], colour[2]);
+					}
+				}
+				tile.done = true;
+				++m_tilesDone;
+				m_tileMsTotal += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - worker.started).count();
+			}
+			worker.tile = -1;
+			++worker.tilesDone;
+			return true;
+		}
+
+		// A worker that has gone takes its tile with it - the tile goes back to the front of the queue
+		void RemoveWorker(int a_index)
+		{
+			Worker& worker = *m_workers[a_index];
+			if (worker.tile >= 0)
+			{
+				TileState& tile = m_tiles[worker.tile];
+				--tile.inFlight;
+				if (!tile.done && tile.inFlight == 0)
+				{
+					m_pending.push_front(worker.tile);
+				}
+			}
+			m_log << "Worker lost after " << worker.tilesDone << " tiles" << std::endl;
+			m_workers.erase(m_workers.begin() + a_index);
+		}
+
+		// Give every idle worker a tile - queued tiles first, then copies of tiles that are taking too long
+		void AssignTiles()
+		{
+			auto now = std::chrono::steady_clock::now();
+			for (size_t w = 0; w < m_workers.size(); ++w)
+			{
+				Worker& worker = *m_workers[w];
+				if (worker.tile >= 0)
+				{
+					continue;
+				}
+				int next = -1;
+				while (!m_pending.empty() && next < 0)
+				{
+					next = m_pending.front();
+					m_pending.pop_front();
+					next = m_tiles[next].done ? -1 : next;
+				}
+				if (next < 0)
+				{
+					next = FindSlowTile(now);
+					if (next < 0)
+					{
+						continue;
+					}
+					++m_reissued;
+				}
+				worker.tile = next;
+				worker.started = now;
+				++m_tiles[next].inFlight;
+				if (!SendMessage(worker.socket, MESSAGE_TILE, ToPayload(&m_tiles[next].rect, 1)))
+				{
+					// Noticed as a disconnect the next time the coordinator reads from it
+					worker.socket.Close();
+				}
+			}
+		}
+
+	private:
+		// Tile rendered by a single worker for much longer than average, -1 if there is none
+		int FindSlowTile(std::chrono::steady_clock::time_point a_now) const
+		{
+			if (m_tilesDone == 0)
+			{
+				return -1;
+			}
+			const double slowMs = std::max(MIN_SLOW_TILE_MS, SLOW_TILE_FACTOR * m_tileMsTotal / (double)m_tilesDone);
+			for (const std::unique_ptr<Worker>& worker : m_workers)
+			{
+				if (worker->tile >= 0 && !m_tiles[worker->tile].done && m_tiles[worker->tile].inFlight == 1 &&
+					std::chrono::duration<double, std::milli>(a_now - worker->started).count() > slowMs)
+				{
+					return worker->tile;
+				}
+			}
+			return -1;
+		}
+
+		const Renderer& m_renderer;
+		std::vector<ColourRGB>& m_pixels;
+		std::ostream& m_log;
+		std::vector<TileState> m_tiles;
+		std::deque<int> m_pending;
+		std::vector<std::unique_ptr<Worker>> m_workers;
+		int m_tilesDone;
+		double m_tileMsTotal;				// Time taken by the tiles that are done, for spotting slow ones
+		int m_reissued;
+	};
+
+	// Quote the executable so paths with spaces survive the shell - cmd needs the whole line quoted again
+	std::string WorkerCommand(const std::string& a_executable, int a_port)
+	{
+		std::string command = "\"" + a_executable + "\" --worker 127.0.0.1:" + std::to_string(a_port);
+#ifdef _WIN32
+		command = "\"" + command + "\"";
+#endif
+		return command;
+	}
+}
+
+bool RenderCluster::RunCoordinator(const Renderer& a_renderer, const std::string& a_executable, int a_localWorkers, int a_port,
+								   std::vector<ColourRGB>& a_pixels, std::ostream& a_log)
+{
+	Socket listener;
+	if (!Socket::Startup() || !listener.Listen(a_port))
+	{
+		a_log << "Could not listen on port " << a_port << std::endl;
+		return false;
+	}
+	const int port = listener.GetPort();
+	a_log << "Coordinator listening on port " << port << std::endl;
+
+	Coordinator coordinator(a_renderer, a_pixels, a_log);
+
+	// Each local worker is run from its own thread so a crashed worker only ends that thread. The threads are
+	// detached, a hung worker must not stop the coordinator from finishing, so the count they update is shared.
+	std::shared_ptr<std::atomic<int>> runningWorkers = std::make_shared<std::atomic<int>>(a_localWorkers);
+	for (int w = 0; w < a_localWorkers; ++w)
+	{
+		std::string command = WorkerCommand(a_executable, port);
+		std::thread([command, runningWorkers]()
+			{
+				std::system(command.c_str());
+				--*runningWorkers;
+			}).detach();
+	}
+
+	bool failed = false;
+	std::vector<Socket*> sockets;
+	std::vector<bool> readable;
+	auto& workers = coordinator.GetWorkers();
+	while (!coordinator.IsFinished())
+	{
+		coordinator.AssignTiles();
+
+		// Workers whose socket was closed by a failed send are dropped without waiting
+		for (int w = (int)workers.size() - 1; w >= 0; --w)
+		{
+			if (!workers[w]->socket.IsOpen())
+			{
+				coordinator.RemoveWorker(w);
+			}
+		}
+		sockets.assign(1, &listener);
+		for (std::unique_ptr<Worker>& worker : workers)
+		{
+			sockets.push_back(&worker->socket);
+		}
+		if (!Socket::WaitReadable(sockets, WAIT_MS, readable))
+		{
+			failed = true;
+			break;
+		}
+		// Read from the workers backwards so removing one does not move the ones still to be read
+		for (int w = (int)workers.size() - 1; w >= 0; --w)
+		{
+			if (readable[w + 1] && !coordinator.ReadFrom(w))
+			{
+				coordinator.RemoveWorker(w);
+			}
+		}
+		if (readable[0])
+		{
+			Socket connection = listener.Accept();
+			if (connection.IsOpen())
+			{
+				coordinator.AddWorker(std::move(connection));
+			}
+		}
+		// With only local workers the job can not finish once they have all gone
+		if (workers.empty() && a_localWorkers > 0 && *runningWorkers == 0)
+		{
+			a_log << "Every worker has exited before the image was finished" << std::endl;
+			failed = true;
+			break;
+		}
+	}
+
+	// Tell the workers to exit - one still rendering a copy of a slow tile exits when it finds the connection closed
+	for (std::unique_ptr<Worker>& worker : workers)
+	{
+		SendMessage(worker->socket, MESSAGE_DONE, std::vector<char>());
+		a_log << "Worker rendered " << worker->tilesDone << " tiles" << std::endl;
+	}
+	workers.clear();
+	listener.Close();
+	if (coordinator.GetReissued() > 0)
+	{
+		a_log << coordinator.GetReissued() << " slow tiles were handed out again" << std::endl;
+	}
+	return !failed;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Worker - the scene is built locally, only the job settings and tiles come over the connection
+//\----------------------------------------------------------------------------------
+bool RenderCluster::RunWorker(const std::string& a_host, int a_port, std::ostream& a_log)
+{
+	Socket connection;
+	if (!Socket::Startup() || !connection.Connect(a_host, a_port))
+	{
+		a_log << "Could not connect to the coordinator at " << a_host << ":" << a_port << std::endl;
+		return false;
+	}
+	MessageType type;
+	std::vector<char> payload;
+	std::int32_t job[6];
+	if (!ReceiveMessage(connection, type, payload) || type != MESSAGE_JOB || payload.size() != sizeof(job))
+	{
+		a_log << "Coordinator did not send a job" << std::endl;
+		return false;
+	}
+	std::memcpy(job, payload.data(), sizeof(job));
+	const int width = job[0], height = job[1];
+
+	ExampleScene example((float)width / (float)height);
+	Renderer renderer(width, height, job[2], job[3]);
+	renderer.SetSeed(job[4]);
+	FastMath::SetPrecision(job[5] == FastMath::FAST ? FastMath::FAST : FastMath::PRECISE);
+	renderer.SetShowProgress(false);
+
+	std::vector<ColourRGB> pixels;
+	while (ReceiveMessage(connection, type, payload))
+	{
+		if (type == MESSAGE_DONE)
+		{
+			return true;
+		}
+		TileRect rect;
+		if (type != MESSAGE_TILE || payload.size() != sizeof(rect))
+		{
+			break;
+		}
+		std::memcpy(&rect, payload.data(), sizeof(rect));
+		renderer.SetCropWindow(rect.x, rect.y, rect.width, rect.height);
+		renderer.Render(example.GetScene(), pixels);
+
+		std::vector<float> result;
+		result.reserve(pixels.size() * 3);
+		for (const ColourRGB& colour : pixels)
+		{
+			result.push_back(colour.x);
+			result.push_back(colour.y);
+			result.push_back(colour.z);
+		}
+		std::vector<char> message = ToPayload(&rect, 1);
+		std::vector<char> colours = ToPayload(result.data(), result.size());
+		message.insert(message.end(), colours.begin(), colours.end());
+		if (!SendMessage(connection, MESSAGE_RESULT, message))
+		{
+			break;
+		}
+	}
+	a_log << "Lost the connection to the coordinator" << std::endl;
+	return false;
+}
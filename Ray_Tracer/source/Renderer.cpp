@@ -0,0 +1,380 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Renderer.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Renders a scene into a pixel buffer and writes the buffer out as an image. Keeping the
+//						pixels in memory lets an animation write one frame while the next one is being rendered.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <future>
+#include <Random.h>
+
+#include "AOV.h"
+#include "FrameBuffer.h"
+#include "ImageOutput.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include "StreamingImage.h"
+//\------------------------
+
+Renderer::Renderer(int a_width, int a_height, int a_raysPerPixel, int a_bounces) :
+	m_width(a_width), m_height(a_height), m_raysPerPixel(a_raysPerPixel), m_bounces(a_bounces), m_seed(0), m_showProgress(true)
+{
+	ClearCropWindow();
+}
+
+Renderer::~Renderer()
+{
+}
+
+// The window is clipped to the image, a window that misses the image altogether renders nothing
+void Renderer::SetCropWindow(int a_x, int a_y, int a_width, int a_height)
+{
+	m_cropX = std::min(std::max(a_x, 0), m_width);
+	m_cropY = std::min(std::max(a_y, 0), m_height);
+	m_cropWidth = std::max(std::min(a_x + a_width, m_width) - m_cropX, 0);
+	m_cropHeight = std::max(std::min(a_y + a_height, m_height) - m_cropY, 0);
+}
+
+void Renderer::ClearCropWindow()
+{
+	m_cropX = 0;
+	m_cropY = 0;
+	m_cropWidth = m_width;
+	m_cropHeight = m_height;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Main Render Loop
+//\----------------------------------------------------------------------------------
+void Renderer::Render(const Scene& a_scene, std::vector<ColourRGB>& a_pixels, AOVBuffers* a_aovs) const
+{
+	a_pixels.resize((size_t)m_cropWidth * (size_t)m_cropHeight);
+	if (a_aovs != nullptr)
+	{
+		a_aovs->Resize(a_pixels.size());
+	}
+
+	const float pixelSpread = GetPixelSpread(a_scene);
+	// For each vertical interval of near plane
+	for (int i = m_cropY; i < m_cropY + m_cropHeight; i++)
+	{
+		if (m_showProgress)
+		{
+			std::clog << "\rCurrently rendering scanline " << i << " of " << m_height << std::flush;
+		}
+		// For each interval of the near plane horizontally
+		for (int j = m_cropX; j < m_cropX + m_cropWidth; j++)
+		{
+			const size_t pixel = (size_t)(i - m_cropY) * m_cropWidth + (j - m_cropX);
+			if (a_aovs != nullptr)
+			{
+				AOVSample aov;
+				a_pixels[pixel] = RenderPixel(a_scene, j, i, m_raysPerPixel, pixelSpread, &aov);
+				a_aovs->Set(pixel, aov);
+			}
+			else
+			{
+				a_pixels[pixel] = RenderPixel(a_scene, j, i, m_raysPerPixel, pixelSpread);
+			}
+		}
+	}
+}
+
+void Renderer::Render(const Scene& a_scene, FrameBuffer& a_frame, AOVBuffers* a_aovs) const
+{
+	if (a_frame.GetWidth() != m_cropWidth || a_frame.GetHeight() != m_cropHeight)
+	{
+		a_frame.Resize(m_cropWidth, m_cropHeight, a_frame.GetFormat());
+	}
+	if (a_aovs != nullptr)
+	{
+		a_aovs->Resize((size_t)m_cropWidth * (size_t)m_cropHeight);
+	}
+
+	std::vector<ColourRGB> row(m_cropWidth);
+	const float pixelSpread = GetPixelSpread(a_scene);
+	for (int i = m_cropY; i < m_cropY + m_cropHeight; i++)
+	{
+		if (m_showProgress)
+		{
+			std::clog << "\rCurrently rendering scanline " << i << " of " << m_height << std::flush;
+		}
+		for (int j = m_cropX; j < m_cropX + m_cropWidth; j++)
+		{
+			if (a_aovs != nullptr)
+			{
+				AOVSample aov;
+				row[j - m_cropX] = RenderPixel(a_scene, j, i, m_raysPerPixel, pixelSpread, &aov);
+				a_aovs->Set((size_t)(i - m_cropY) * m_cropWidth + (j - m_cropX), aov);
+			}
+			else
+			{
+				row[j - m_cropX] = RenderPixel(a_scene, j, i, m_raysPerPixel, pixelSpread);
+			}
+		}
+		if (m_cropWidth > 0)
+		{
+			a_frame.StoreRow(0, i - m_cropY, row.data(), m_cropWidth);
+		}
+	}
+}
+
+bool Renderer::RenderToFile(const Scene& a_scene, const std::string& a_filename, int a_bandRows) const
+{
+	StreamingImage image;
+	std::string comment;
+	if (HasCropWindow())
+	{
+		comment = "crop " + std::to_string(m_cropX) + ' ' + std::to_string(m_cropY) + ' ' + std::to_string(m_width) + ' ' + std::to_string(m_height);
+	}
+	if (!image.Open(a_filename, m_cropWidth, m_cropHeight, comment))
+	{
+		return false;
+	}
+
+	a_bandRows = std::max(a_bandRows, 1);
+	std::vector<ColourRGB> bands[2];
+	std::future<bool> pendingWrite;
+	bool written = true;
+	const float pixelSpread = GetPixelSpread(a_scene);
+	for (int band = 0; band * a_bandRows < m_cropHeight; ++band)
+	{
+		const int first = m_cropY + band * a_bandRows;
+		const int rows = std::min(a_bandRows, m_cropY + m_cropHeight - first);
+		std::vector<ColourRGB>& pixels = bands[band % 2];
+		pixels.resize((size_t)rows * m_cropWidth);
+		for (int i = first; i < first + rows; i++)
+		{
+			if (m_showProgress)
+			{
+				std::clog << "\rCurrently rendering scanline " << i << " of " << m_height << std::flush;
+			}
+			for (int j = m_cropX; j < m_cropX + m_cropWidth; j++)
+			{
+				pixels[(size_t)(i - first) * m_cropWidth + (j - m_cropX)] = RenderPixel(a_scene, j, i, m_raysPerPixel, pixelSpread);
+			}
+		}
+
+		// The band before has had this whole band to finish writing, wait for it before reusing its buffer next time
+		if (pendingWrite.valid())
+		{
+			written = pendingWrite.get() && written;
+		}
+		pendingWrite = std::async(std::launch::async, [&image, &pixels, first, rows, this]()
+			{
+				return image.WriteRows(first - m_cropY, rows, pixels.data());
+			});
+	}
+	if (pendingWrite.valid())
+	{
+		written = pendingWrite.get() && written;
+	}
+	return image.Close() && written;
+}
+
+float Renderer::GetPixelSpread(const Scene& a_scene) const
+{
+	// The gap between the directions of two rays a pixel apart - close enough to the angle between them
+	const Ray centre = a_scene.GetScreenRay(Vector2(0.f, 0.f));
+	const Ray below = a_scene.GetScreenRay(Vector2(0.f, 2.f / (float)m_height));
+	return (centre.Direction() - below.Direction()).Length();
+}
+
+ColourRGB Renderer::RenderPixel(const Scene& a_scene, int a_x, int a_y, int a_raysPerPixel, float a_pixelSpread, AOVSample* a_aov) const
+{
+	// Get reciprical of image dimensions
+	float invWidth = 1.f / (float)m_width;
+	float invHeight = 1.f / (float)m_height;
+
+	// The pixel's own random sequence - it does not matter which pixels were rendered before this one
+	Random::SetSeed(Random::HashSeed(m_seed, a_x, a_y));
+	ColourRGB rayColour(0.f, 0.f, 0.f);
+	AOVSample aovSum = AOVSample{ Vector3(0.f, 0.f, 0.f), Vector3(0.f, 0.f, 0.f), Vector3(0.f, 0.f, 0.f), 0.f, -1 };
+	float centreDistance = 1.f;
+	for (int p = 0; p < a_raysPerPixel; p++)
+	{
+		// Calcuate Screen space Y Location
+		float jitter = Random::RandomFloat();
+		float screenSpaceY = 1.f - 2.f * ((float)a_y + jitter) * invHeight;
+		// Get current pixel in screen sace coordinates
+		float screenSpaceX = 2.f * ((float)a_x + 0.5f) * invWidth - 1.f;
+		Vector2 screenSpacePos = Vector2(screenSpaceX, screenSpaceY);
+		Ray screenRay = a_scene.GetScreenRay(screenSpacePos);
+		screenRay.SetCone(0.f, a_pixelSpread);
+		if (a_aov == nullptr)
+		{
+			rayColour += a_scene.CastRay(screenRay, m_bounces);
+			continue;
+		}
+		AOVSample aov = AOV::Miss();
+		rayColour += a_scene.CastRay(screenRay, m_bounces, 1.0f, &aov);
+		aovSum.position += aov.position;
+		aovSum.normal += aov.normal;
+		aovSum.albedo += aov.albedo;
+		aovSum.depth += aov.depth;
+		if (std::abs(jitter - 0.5f) < centreDistance)
+		{
+			centreDistance = std::abs(jitter - 0.5f);
+			aovSum.primitiveID = aov.primitiveID;
+		}
+	}
+	const float invRays = 1.f / (float)a_raysPerPixel;
+	if (a_aov != nullptr)
+	{
+		*a_aov = AOVSample{ aovSum.position * invRays, aovSum.normal * invRays, aovSum.albedo * invRays, aovSum.depth * invRays, aovSum.primitiveID };
+	}
+	return rayColour * invRays;
+}
+
+void Renderer::RenderAOVs(const Scene& a_scene, AOVBuffers& a_aovs, int a_raysPerPixel) const
+{
+	a_aovs.Resize((size_t)m_cropWidth * (size_t)m_cropHeight);
+
+	const float invWidth = 1.f / (float)m_width;
+	const float invHeight = 1.f / (float)m_height;
+	const float invRays = 1.f / (float)a_raysPerPixel;
+	const float pixelSpread = GetPixelSpread(a_scene);
+	for (int i = m_cropY; i < m_cropY + m_cropHeight; i++)
+	{
+		for (int j = m_cropX; j < m_cropX + m_cropWidth; j++)
+		{
+			AOVSample aovSum = AOVSample{ Vector3(0.f, 0.f, 0.f), Vector3(0.f, 0.f, 0.f), Vector3(0.f, 0.f, 0.f), 0.f, -1 };
+			for (int p = 0; p < a_raysPerPixel; p++)
+			{
+				float screenSpaceY = 1.f - 2.f * ((float)i + ((float)p + 0.5f) * invRays) * invHeight;
+				float screenSpaceX = 2.f * ((float)j + 0.5f) * invWidth - 1.f;
+				Ray screenRay = a_scene.GetScreenRay(Vector2(screenSpaceX, screenSpaceY));
+				screenRay.SetCone(0.f, pixelSpread);
+				// The ray is only intersected, never shaded
+				IntersectResponse ir;
+				AOVSample aov = a_scene.IntersectTest(screenRay, ir) ? AOV::FromHit(screenRay, ir) : AOV::Miss();
+				aovSum.position += aov.position * invRays;
+				aovSum.normal += aov.normal * invRays;
+				aovSum.albedo += aov.albedo * invRays;
+				aovSum.depth += aov.depth * invRays;
+				if (p == a_raysPerPixel / 2)
+				{
+					aovSum.primitiveID = aov.primitiveID;
+				}
+			}
+			a_aovs.Set((size_t)(i - m_cropY) * m_cropWidth + (j - m_cropX), aovSum);
+		}
+	}
+}
+
+void Renderer::WritePPM(std::ostream& a_out, const std::vector<ColourRGB>& a_pixels) const
+{
+	// Output the Image Header Data
+	a_out << "P3" << std::endl;
+	if (HasCropWindow())
+	{
+		a_out << "# crop " << m_cropX << ' ' << m_cropY << ' ' << m_width << ' ' << m_height << std::endl;
+	}
+	a_out << m_cropWidth << ' ' << m_cropHeight << std::endl;
+	a_out << 255 << std::endl;
+	for (int i = 0; i < m_cropHeight; i++)
+	{
+		for (int j = 0; j < m_cropWidth; j++)
+		{
+			WriteColourRGB(a_out, a_pixels[(size_t)i * m_cropWidth + j]);
+		}
+		a_out << std::endl;
+	}
+}
+
+bool Renderer::WritePPM(const std::string& a_filename, const std::vector<ColourRGB>& a_pixels) const
+{
+	std::ofstream file(a_filename.c_str());
+	if (!file)
+	{
+		return false;
+	}
+	WritePPM(file, a_pixels);
+	return file.good();
+}
+
+void Renderer::WritePPM(std::ostream& a_out, const FrameBuffer& a_frame) const
+{
+	// Rows are decoded one at a time rather than expanding the whole frame back to floats
+	std::vector<ColourRGB> row(a_frame.GetWidth());
+	a_out << "P3" << std::endl;
+	if (HasCropWindow())
+	{
+		a_out << "# crop " << m_cropX << ' ' << m_cropY << ' ' << m_width << ' ' << m_height << std::endl;
+	}
+	a_out << a_frame.GetWidth() << ' ' << a_frame.GetHeight() << std::endl;
+	a_out << 255 << std::endl;
+	for (int i = 0; i < a_frame.GetHeight(); i++)
+	{
+		if (!row.empty())
+		{
+			a_frame.LoadRow(0, i, row.data(), a_frame.GetWidth());
+		}
+		for (const ColourRGB& colour : row)
+		{
+			WriteColourRGB(a_out, colour);
+		}
+		a_out << std::endl;
+	}
+}
+
+bool Renderer::WritePPM(const std::string& a_filename, const FrameBuffer& a_frame) const
+{
+	std::ofstream file(a_filename.c_str());
+	if (!file)
+	{
+		return false;
+	}
+	WritePPM(file, a_frame);
+	return file.good();
+}
+
+bool Renderer::WriteImage(const std::string& a_filename, const std::vector<ColourRGB>& a_pixels) const
+{
+	if (ImageOutput::FormatFromFilename(a_filename) == ImageOutput::PPM)
+	{
+		return WritePPM(a_filename, a_pixels);
+	}
+	FrameBuffer frame(m_cropWidth, m_cropHeight);
+	frame.Store(a_pixels);
+	return WriteImage(a_filename, frame);
+}
+
+bool Renderer::WriteImage(const std::string& a_filename, const FrameBuffer& a_frame) const
+{
+	ImageOutput::Format format = ImageOutput::FormatFromFilename(a_filename);
+	if (format == ImageOutput::PPM)
+	{
+		return WritePPM(a_filename, a_frame);
+	}
+	return ImageOutput::Write(a_filename, a_frame, format);
+}
+
+bool Renderer::WriteAOVs(const std::string& a_filename, const AOVBuffers& a_aovs) const
+{
+	const bool values = ImageOutput::FormatFromFilename(a_filename) == ImageOutput::PFM;
+	bool written = true;
+	std::vector<ColourRGB> colours;
+	for (int channel = 0; channel < AOV::CHANNEL_COUNT; ++channel)
+	{
+		if (values)
+		{
+			AOV::ToValues(a_aovs, (AOV::Channel)channel, colours);
+		}
+		else
+		{
+			AOV::ToColours(a_aovs, (AOV::Channel)channel, colours);
+		}
+		written = WriteImage(AOV::ChannelFilename(a_filename, (AOV::Channel)channel), colours) && written;
+	}
+	return written;
+}
@@ -12,14 +12,90 @@
 //\------------------------
 //\ INCLUDES
 //\------------------------
-#include "Scene.h "
+#include "Scene.h"
 #include "Primitive.h"
 #include "Camera.h"
 #include "Light.h"
 #include "Material.h"
+#include "DependencySet.h"
+#include "AOV.h"
+
+#include <mutex>
 //\------------------------
 
-Scene::Scene() : m_pCamera(nullptr)
+namespace
+{
+	// Sky gradient - white at the horizon to blue overhead
+	constexpr Vector3 SKY_HORIZON_COLOUR = Vector3(1.f, 1.f, 1.f);
+	constexpr Vector3 SKY_ZENITH_COLOUR = Vector3(0.4f, 0.7f, 1.f);
+
+	// A refit hierarchy is rebuilt once its surface area cost has grown this much past the cost it was built with
+	const float BVH_REBUILD_RATIO = 1.5f;
+	// An updated grid is rebuilt once this part of its objects has left its box, or of its entries has overflowed its cells
+	const float GRID_REBUILD_FRACTION = 0.1f;
+
+	// Statistics of threads that have finished - each thread adds its own counts when it exits
+	std::mutex g_shadowStatsMutex;
+	ShadowCacheStats g_finishedShadowStats = {};
+
+	//\----------------------------------------------------------------------------------
+	//\ Shadow occluder cache - each thread remembers the last opaque object that blocked each light.
+	//\ Neighbouring hits are usually shadowed by the same object so it is tested first.
+	//\----------------------------------------------------------------------------------
+	struct ShadowCache
+	{
+		const Scene*		scene = nullptr;		// The cache is cleared when a thread starts rendering a different scene
+		std::vector<int>	lastOccluder;			// Object index per light, -1 for none
+		ShadowCacheStats	stats = {};
+
+		~ShadowCache()
+		{
+			std::lock_guard<std::mutex> lock(g_shadowStatsMutex);
+			g_finishedShadowStats.shadowTests += stats.shadowTests;
+			g_finishedShadowStats.cacheHits += stats.cacheHits;
+			g_finishedShadowStats.occluded += stats.occluded;
+		}
+	};
+	thread_local ShadowCache t_shadowCache;
+
+	// Set while the renderer records which objects the rays of a tile touch
+	thread_local DependencySet* t_dependencies = nullptr;
+
+	void RecordDependency(const Primitive* a_object, const Material* a_material)
+	{
+		if (t_dependencies != nullptr)
+		{
+			t_dependencies->Add(a_object);
+			t_dependencies->Add(a_material);
+		}
+	}
+
+	// Stops the recording while it is in scope - for rays whose colour never reaches the pixel
+	class DependencyPause
+	{
+	public:
+		DependencyPause(bool a_pause) : m_saved(t_dependencies) { if (a_pause) { t_dependencies = nullptr; } }
+		~DependencyPause() { t_dependencies = m_saved; }
+	private:
+		DependencySet* m_saved;
+	};
+
+	// Transparency of whatever the ray hit - instances without a material override need the full hit to find their material
+	float OccluderTransparency(const Primitive* a_object, const Ray& a_ray, float a_distance)
+	{
+		const Material* material = a_object->GetMaterial();
+		if (material == nullptr)
+		{
+			IntersectResponse ir;
+			a_object->FinalizeHit(a_ray, a_distance, ir);
+			material = ir.material;
+		}
+		RecordDependency(a_object, material);
+		return material->GetTransparency();
+	}
+}
+
+Scene::Scene() : m_acceleration(BOUNDING_VOLUME_HIERARCHY), m_lightSelection(ALL_LIGHTS), m_lightSamplesPerHit(1), m_pCamera(nullptr)
 {
 	m_objects.clear();
 	m_lights.clear();
@@ -39,35 +115,169 @@ Scene::~Scene()
 void Scene::AddObject(const Primitive* a_object)
 {
 	m_objects.push_back(a_object);
+	m_bvh.Clear();
+	m_grid.Clear();
 }
 
 // Removing objects by looping (iter) over the objects in the scene to test if it matches the objects we are looking for
 // Erasing it and carrying on looping - Just in case the object was added multiple times
 void Scene::RemoveObject(const Primitive* a_object)
 {
-	for (auto iter = m_objects.begin(); iter != m_objects.end(); ++iter)
+	for (auto iter = m_objects.begin(); iter != m_objects.end();)
 	{
 		if (*iter == a_object)			// we have located the object
 		{
 			iter = m_objects.erase(iter);	// Delete the object from the vector
 		}
+		else
+		{
+			++iter;
+		}
+	}
+	m_bvh.Clear();
+	m_grid.Clear();
+}
+
+//\----------------------------------------------------------------------------------
+//\ Acceleration structure
+//\----------------------------------------------------------------------------------
+void Scene::BuildAccelerationStructure()
+{
+	if (m_acceleration == UNIFORM_GRID)
+	{
+		m_grid.Build(m_objects);
+		return;
+	}
+	m_bvh.Build(m_objects);
+}
+
+bool Scene::RefitAccelerationStructure()
+{
+	if (!HasAccelerationStructure())
+	{
+		BuildAccelerationStructure();
+		return true;
+	}
+	if (m_grid.IsBuilt())
+	{
+		m_grid.Refit();
+		if ((float)m_grid.GetOutsideCount() > (float)m_objects.size() * GRID_REBUILD_FRACTION ||
+			(float)m_grid.GetOverflowCount() > (float)m_grid.GetEntryCount() * GRID_REBUILD_FRACTION)
+		{
+			BuildAccelerationStructure();
+			return true;
+		}
+		return false;
+	}
+	m_bvh.Refit();
+	if (m_bvh.Cost() > m_bvh.BuildCost() * BVH_REBUILD_RATIO)
+	{
+		BuildAccelerationStructure();
+		return true;
+	}
+	return false;
+}
+
+void Scene::ObjectMoved(int a_objectIndex)
+{
+	if (m_grid.IsBuilt())
+	{
+		m_grid.Update(a_objectIndex);
+	}
+}
+
+void Scene::SetAcceleration(Acceleration a_acceleration)
+{
+	if (a_acceleration == m_acceleration)
+	{
+		return;
+	}
+	const bool built = HasAccelerationStructure();
+	m_bvh.Clear();
+	m_grid.Clear();
+	m_acceleration = a_acceleration;
+	if (built)
+	{
+		BuildAccelerationStructure();
 	}
 }
 
+AABB Scene::GetBounds() const
+{
+	if (m_bvh.IsBuilt())
+	{
+		return m_bvh.GetBounds();
+	}
+	AABB bounds;
+	for (const Primitive* object : m_objects)
+	{
+		bounds.Grow(object->GetBounds());
+	}
+	return bounds;
+}
+
 void Scene::AddLight(const Light* a_light)
 {
 	m_lights.push_back(a_light);
+	UpdateLightSampling();
 }
 
 void Scene::RemoveLight(const Light* a_light)
 {
-	for (auto iter = m_lights.begin(); iter != m_lights.end(); ++iter)
+	for (auto iter = m_lights.begin(); iter != m_lights.end();)
 	{
 		if (*iter == a_light)				// We have located the light
 		{
 			iter = m_lights.erase(iter);		// Remove the light from the vector
 		}
+		else
+		{
+			++iter;
+		}
 	}
+	UpdateLightSampling();
+}
+
+void Scene::SetLightSelection(LightSelection a_mode, int a_samplesPerHit)
+{
+	m_lightSelection = a_mode;
+	m_lightSamplesPerHit = a_samplesPerHit > 0 ? a_samplesPerHit : 1;
+}
+
+void Scene::UpdateLightSampling()
+{
+	std::vector<float> weights;
+	weights.reserve(m_lights.size());
+	for (const Light* light : m_lights)
+	{
+		weights.push_back(light->EstimatePower());
+	}
+	m_lightTable.Build(weights);
+}
+
+// Either every light in the scene or a few lights chosen in proportion to their power
+int Scene::GetLightSamplesPerHit() const
+{
+	return (m_lightSelection == SAMPLED_LIGHTS && !m_lights.empty()) ? m_lightSamplesPerHit : (int)m_lights.size();
+}
+
+// A sampled light is weighted by one over the chance of choosing it so the sum matches shading every light
+const Light* Scene::ChooseLight(int a_sample, int& a_lightIndex, float& a_weight) const
+{
+	if (m_lightSelection == SAMPLED_LIGHTS && !m_lights.empty())
+	{
+		a_lightIndex = m_lightTable.Sample(Random::RandomFloat());
+		a_weight = 1.f / (m_lightTable.Pdf(a_lightIndex) * (float)m_lightSamplesPerHit);
+		return m_lights[a_lightIndex];
+	}
+	a_lightIndex = a_sample;
+	a_weight = 1.f;
+	return m_lights[a_sample];
+}
+
+Vector3 Scene::GetEyePosition() const
+{
+	return m_pCamera->GetPosition();
 }
 
 //\----------------------------------------------------------------------------------
@@ -79,7 +289,7 @@ Ray Scene::GetScreenRay(const Vector2& a_screenSpacePos) const
 	return m_pCamera->CastRay(a_screenSpacePos);
 }
 
-Vector3 Scene::CastRay(const Ray& a_ray, int a_bounces, float currentIr) const
+Vector3 Scene::CastRay(const Ray& a_ray, int a_bounces, float currentIr, AOVSample* a_aov) const
 {
 	if (a_bounces <= 0)							// Number of bounces remaining for ray (prevents calling function recursively forever)
 	{
@@ -93,59 +303,74 @@ Vector3 Scene::CastRay(const Ray& a_ray, int a_bounces, float currentIr) const
 	{
 		// Calculate lighting 
 		ir.currentRefInd = currentIr;
+		RecordDependency(m_objects[ir.primitiveID], ir.material);
+		if (a_aov != nullptr)
+		{
+			*a_aov = AOV::FromHit(a_ray, ir);
+		}
 		Vector3 rayColour = Vector3(0.f, 0.f, 0.f);
-		// For all the lights in the scene sum the effects the lights have on the object
-		for (auto lightIter = m_lights.begin(); lightIter != m_lights.end(); ++lightIter)
-		{
-			// Test to see if in shadow -- cast ray from intersection toward light
-			Ray shadowRay = Ray(ir.HitPos, -(*lightIter)->GetDirectionToLight(ir.HitPos), 0.001f);
-			IntersectResponse sr;
-			
-			float shadowValue = (!IntersectTest(shadowRay, sr));
-			if (shadowValue < 1.f)
-			{
-				shadowValue += sr.material->GetTransparency();
-			}	// Call HitTest on the shadow ray to see if we have an occluder
-
-			rayColour += (*lightIter)->calculateLighting(ir, m_pCamera->GetPosition()) * shadowValue;
-			// If the material that we have hit is transparent and refractive we need to calculate the refraction vector 
-			// and create a new ray to project into the scene
-			Ray refractRay;
-			ColourRGB refractionColour = ColourRGB(0.f, 0.f, 0.f);
-			if (ir.material->CalcRefraction(a_ray, ir, refractRay))
-			{
-				refractionColour = CastRay(refractRay, a_bounces - 1, ir.material->GetRefractiveIndex()) * ir.material->GetTransparency();
-			}
+		const int lightCount = GetLightSamplesPerHit();
+		for (int l = 0; l < lightCount; ++l)
+		{
+			int lightIndex = l;
+			float lightWeight = 1.f;
+			const Light* light = ChooseLight(l, lightIndex, lightWeight);
+			// Test to see if in shadow -- cast ray from intersection toward the sampled point on the light
+			LightSample lightSample = light->SampleLight(ir.HitPos);
+			Ray shadowRay = Ray(ir.HitPos, lightSample.directionToLight, 0.001f, lightSample.distance);
+			float shadowValue = ShadowTest(shadowRay, lightIndex);
 
-			ColourRGB reflectColour = ColourRGB(0.f, 0.f, 0.f);
-			Ray bounceRay;
-			if (ir.material->CalcReflection(a_ray, ir, bounceRay))
-			{
-				// Call intersect test function to accumlate colour of pixel with bounce ray
-				reflectColour = CastRay(bounceRay, a_bounces - 1, ir.material->GetRefractiveIndex()) * ir.material->GetReflective();
-			}
-			// If the material is reflective and transparent we need to calculate the ratio of each reflective and refractive colours
-			// Use schlicks approximation to calculate fresnel term for object
-			if (ir.material->GetReflective() > 0.f && ir.material->GetTransparency() > 0.f)
-			{
-				float reflectance = ir.material->Schlick(a_ray, ir);
-				rayColour += refractionColour * reflectance + refractionColour * (1.f - reflectance);
-			}
-			else
-			{
-				rayColour += refractionColour + refractionColour;
-			}
+			rayColour += light->ShadeSample(ir, GetEyePosition(), lightSample) * (shadowValue * lightWeight);
+		}
+
+		// The secondary rays only depend on the hit, not on the lights, so they are traced once per hit after the direct lighting
+		// If the material that we have hit is transparent and refractive we need to calculate the refraction vector 
+		// and create a new ray to project into the scene
+		Ray refractRay;
+		ColourRGB refractionColour = ColourRGB(0.f, 0.f, 0.f);
+		if (ir.material->CalcRefraction(a_ray, ir, refractRay))
+		{
+			DependencyPause pause(ir.material->GetTransparency() <= 0.f);		// Opaque - the refracted colour is scaled to nothing
+			refractionColour = CastRay(refractRay, a_bounces - 1, ir.material->GetRefractiveIndex()) * ir.material->GetTransparency();
+		}
+
+		ColourRGB reflectColour = ColourRGB(0.f, 0.f, 0.f);
+		Ray bounceRay;
+		// A material that does not reflect would scale the reflected colour to nothing, so its bounce ray is not traced
+		if (ir.material->GetReflective() > 0.f && ir.material->CalcReflection(a_ray, ir, bounceRay))
+		{
+			// Call intersect test function to accumlate colour of pixel with bounce ray - it stays in the medium it came from
+			reflectColour = CastRay(bounceRay, a_bounces - 1, currentIr) * ir.material->GetReflective();
+		}
+		// If the material is reflective and transparent we need to calculate the ratio of each reflective and refractive colours
+		// Use schlicks approximation to calculate fresnel term for object
+		if (ir.material->GetReflective() > 0.f && ir.material->GetTransparency() > 0.f)
+		{
+			float reflectance = ir.material->Schlick(a_ray, ir);
+			rayColour += reflectColour * reflectance + refractionColour * (1.f - reflectance);
+		}
+		else
+		{
+			rayColour += reflectColour + refractionColour;
 		}
 		return rayColour;
 	}
 	else
 	{
-		Vector3 rayToColour = RayToColour(a_ray);
-		//Use Lerp to get a colour between white and blue based on the vertical value of the rayColour
-		rayToColour = Lerp(Vector3(1.f, 1.f, 1.f), Vector3(0.4f, 0.7f, 1.f), rayToColour.y);
-		return rayToColour;
+		if (a_aov != nullptr)
+		{
+			*a_aov = AOV::Miss();
+		}
+		return SkyColour(a_ray);
 	}
 }
+
+Vector3 Scene::SkyColour(const Ray& a_ray)
+{
+	Vector3 rayToColour = RayToColour(a_ray);
+	//Use Lerp to get a colour between white and blue based on the vertical value of the rayColour
+	return Lerp(SKY_HORIZON_COLOUR, SKY_ZENITH_COLOUR, rayToColour.y);
+}
 //\----------------------------------------------------------------------------------
 //\ -- Intersection test -  - Looping through all the objects in the world and tracking the successful 
 //							  intesections and their distance from the camera
@@ -153,28 +378,169 @@ Vector3 Scene::CastRay(const Ray& a_ray, int a_bounces, float currentIr) const
 
 bool Scene::IntersectTest(const Ray& a_ray, IntersectResponse& a_intersectResponse) const
 {
+	float intersectDistance = 0.f;
+	int nearestObject = -1;
+	if (!IntersectDistance(a_ray, intersectDistance, nearestObject))
+	{
+		return false;
+	}
+	FinalizeHit(a_ray, intersectDistance, nearestObject, a_intersectResponse);
+	return true;
+}
+
+bool Scene::IntersectDistance(const Ray& a_ray, float& a_distance, int& a_objectIndex) const
+{
+	if (m_bvh.IsBuilt())
+	{
+		return m_bvh.IntersectNearest(a_ray, a_distance, a_objectIndex);
+	}
+	if (m_grid.IsBuilt())
+	{
+		return m_grid.IntersectNearest(a_ray, a_distance, a_objectIndex);
+	}
+
 	//Set the current hit distance to be very far away
 	float intersectDistance = a_ray.MaxDistance();
-	bool intersectionOccured = false;
-	IntersectResponse objectIntersection;
+	int nearestObject = -1;
+	Ray clipped = a_ray;													// Cut short at the nearest hit so instances search less of their sub scene
 
 	// For each object in the world test to see if the ray intersects the object
-	for (auto iter = m_objects.begin(); iter != m_objects.end(); ++iter)
+	// Only the distance is calculated here, the full hit record is built once for the nearest object
+	for (int i = 0; i < (int)m_objects.size(); ++i)
+	{
+		float objectDistance = 0.f;
+		if (m_objects[i]->IntersectDistance(clipped, objectDistance))				// Perform intersection test on each object
+		{
+			// Intesection occured - is the intersection closer than previous intersection
+			if (objectDistance > a_ray.MinLength() && objectDistance < intersectDistance)
+			{
+				intersectDistance = objectDistance;									// Store the new distance to the intesection 
+				nearestObject = i;
+				clipped.SetMaxDistance(intersectDistance);
+			}
+		}
+	}
+	if (nearestObject < 0)
+	{
+		return false;
+	}
+	a_distance = intersectDistance;
+	a_objectIndex = nearestObject;
+	return true;
+}
+
+void Scene::FinalizeHit(const Ray& a_ray, float a_distance, int a_objectIndex, IntersectResponse& a_intersectResponse) const
+{
+	m_objects[a_objectIndex]->FinalizeHit(a_ray, a_distance, a_intersectResponse);
+	a_intersectResponse.primitiveID = a_objectIndex;
+	a_intersectResponse.footprint = a_ray.ConeWidthAt(a_distance);
+}
+
+//\----------------------------------------------------------------------------------
+//\ -- Shadow test - any opaque object between the hit and the light blocks it completely so the search
+//							stops at the first one, starting with the cached occluder for this light
+//\----------------------------------------------------------------------------------
+float Scene::ShadowTest(const Ray& a_shadowRay, int a_lightIndex) const
+{
+	ShadowCache& cache = t_shadowCache;
+	if (cache.scene != this)
+	{
+		cache.scene = this;
+		cache.lastOccluder.clear();
+	}
+	if ((int)cache.lastOccluder.size() < (int)m_lights.size())
+	{
+		cache.lastOccluder.resize(m_lights.size(), -1);
+	}
+	++cache.stats.shadowTests;
+
+	// Try the object that blocked this light last time - its material is checked again as it may have been edited since
+	int& lastOccluder = cache.lastOccluder[a_lightIndex];
+	float distance = 0.f;
+	if (lastOccluder >= 0 && lastOccluder < (int)m_objects.size())
 	{
-		const Primitive* object = (*iter);											// Get a pointer to the primitive object
-		if (object->IntersectTest(a_ray, objectIntersection))						// Perform intersection test on each object
+		const Primitive* object = m_objects[lastOccluder];
+		if (object->IntersectDistance(a_shadowRay, distance) && distance > a_shadowRay.MinLength() && distance < a_shadowRay.MaxDistance() &&
+			OccluderTransparency(object, a_shadowRay, distance) <= 0.f)
+		{
+			++cache.stats.cacheHits;
+			++cache.stats.occluded;
+			return 0.f;
+		}
+	}
+
+	// Full search - stop at the first opaque object, otherwise keep the transparency of the nearest transparent one
+	float nearestDistance = a_shadowRay.MaxDistance();
+	float nearestTransparency = 1.f;
+	bool blocked = false;
+	auto testOccluder = [&](int a_objectIndex)
+	{
+		if (!m_objects[a_objectIndex]->IntersectDistance(a_shadowRay, distance) || distance <= a_shadowRay.MinLength() || distance >= a_shadowRay.MaxDistance())
+		{
+			return false;
+		}
+		float transparency = OccluderTransparency(m_objects[a_objectIndex], a_shadowRay, distance);
+		if (transparency <= 0.f)
+		{
+			lastOccluder = a_objectIndex;
+			blocked = true;
+			return true;
+		}
+		if (distance < nearestDistance)
 		{
-			// Intesection occured
-			if (objectIntersection.distance > a_ray.MinLength())
+			nearestDistance = distance;
+			nearestTransparency = transparency;
+		}
+		return false;
+	};
+	if (m_bvh.IsBuilt())
+	{
+		m_bvh.VisitCandidates(a_shadowRay, a_shadowRay.MaxDistance(), testOccluder);
+	}
+	else if (m_grid.IsBuilt())
+	{
+		m_grid.VisitCandidates(a_shadowRay, a_shadowRay.MaxDistance(), testOccluder);
+	}
+	else
+	{
+		for (int i = 0; i < (int)m_objects.size(); ++i)
+		{
+			if (testOccluder(i))
 			{
-				intersectionOccured = true;
-				if (objectIntersection.distance < intersectDistance)				// is the intersection closer than previous intersection
-				{
-					intersectDistance = objectIntersection.distance;				// Store the new distance to the intesection 
-					a_intersectResponse = objectIntersection;
-				}
+				break;
 			}
 		}
 	}
-	return intersectionOccured;
+	if (blocked)
+	{
+		++cache.stats.occluded;
+		return 0.f;
+	}
+	if (nearestDistance < a_shadowRay.MaxDistance())
+	{
+		++cache.stats.occluded;
+	}
+	return nearestTransparency;
+}
+
+ShadowCacheStats Scene::GetShadowCacheStats()
+{
+	std::lock_guard<std::mutex> lock(g_shadowStatsMutex);
+	ShadowCacheStats stats = g_finishedShadowStats;
+	stats.shadowTests += t_shadowCache.stats.shadowTests;
+	stats.cacheHits += t_shadowCache.stats.cacheHits;
+	stats.occluded += t_shadowCache.stats.occluded;
+	return stats;
+}
+
+void Scene::ResetShadowCacheStats()
+{
+	std::lock_guard<std::mutex> lock(g_shadowStatsMutex);
+	g_finishedShadowStats = ShadowCacheStats();
+	t_shadowCache.stats = ShadowCacheStats();
+}
+
+void Scene::SetDependencyRecorder(DependencySet* a_dependencies)
+{
+	t_dependencies = a_dependencies;
 }
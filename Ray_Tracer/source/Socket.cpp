@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Socket.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Minimal blocking TCP socket used by the render cluster - Winsock on Windows, BSD sockets
+//						everywhere else.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Socket.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <cstring>
+//\------------------------
+
+namespace
+{
+#ifdef _WIN32
+	const Socket::Handle INVALID_HANDLE = INVALID_SOCKET;
+	void CloseSocket(Socket::Handle a_handle) { closesocket((SOCKET)a_handle); }
+	const int SEND_FLAGS = 0;
+#else
+	const Socket::Handle INVALID_HANDLE = -1;
+	void CloseSocket(Socket::Handle a_handle) { close(a_handle); }
+#ifdef MSG_NOSIGNAL
+	const int SEND_FLAGS = MSG_NOSIGNAL;		// A worker that has gone away must not kill the sender with SIGPIPE
+#else
+	const int SEND_FLAGS = 0;
+#endif
+#endif
+
+	// Messages are small and answered straight away so Nagle's delay only slows the cluster down
+	void DisableNagle(Socket::Handle a_handle)
+	{
+		int noDelay = 1;
+		setsockopt(a_handle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+	}
+}
+
+Socket::Socket() : m_handle(INVALID_HANDLE)
+{
+}
+
+Socket::~Socket()
+{
+	Close();
+}
+
+Socket::Socket(Socket&& a_other) : m_handle(a_other.m_handle)
+{
+	a_other.m_handle = INVALID_HANDLE;
+}
+
+Socket& Socket::operator=(Socket&& a_other)
+{
+	if (this != &a_other)
+	{
+		Close();
+		m_handle = a_other.m_handle;
+		a_other.m_handle = INVALID_HANDLE;
+	}
+	return *this;
+}
+
+bool Socket::Startup()
+{
+#ifdef _WIN32
+	WSADATA data;
+	return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+	return true;
+#endif
+}
+
+bool Socket::Listen(int a_port)
+{
+	Close();
+	m_handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (m_handle == INVALID_HANDLE)
+	{
+		return false;
+	}
+	int reuse = 1;
+	setsockopt(m_handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons((unsigned short)a_port);
+	if (bind(m_handle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(m_handle, SOMAXCONN) != 0)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+int Socket::GetPort() const
+{
+	sockaddr_in address;
+	socklen_t length = sizeof(address);
+	if (getsockname(m_handle, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+	{
+		return -1;
+	}
+	return ntohs(address.sin_port);
+}
+
+Socket Socket::Accept()
+{
+	Socket connection;
+	connection.m_handle = accept(m_handle, nullptr, nullptr);
+	if (connection.m_handle != INVALID_HANDLE)
+	{
+		DisableNagle(connection.m_handle);
+	}
+	return connection;
+}
+
+bool Socket::Connect(const std::string& a_host, int a_port)
+{
+	Close();
+	addrinfo hints;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* addresses = nullptr;
+	if (getaddrinfo(a_host.c_str(), std::to_string(a_port).c_str(), &hints, &addresses) != 0)
+	{
+		return false;
+	}
+	// Try each address the host resolves to until one connects
+	for (addrinfo* address = addresses; address != nullptr; address = address->ai_next)
+	{
+		m_handle = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+		if (m_handle == INVALID_HANDLE)
+		{
+			continue;
+		}
+		if (connect(m_handle, address->ai_addr, (int)address->ai_addrlen) == 0)
+		{
+			break;
+		}
+		Close();
+	}
+	freeaddrinfo(addresses);
+	if (m_handle == INVALID_HANDLE)
+	{
+		return false;
+	}
+	DisableNagle(m_handle);
+	return true;
+}
+
+bool Socket::SendAll(const void* a_data, size_t a_size)
+{
+	const char* data = static_cast<const char*>(a_data);
+	while (a_size > 0)
+	{
+		int sent = (int)send(m_handle, data, (int)a_size, SEND_FLAGS);
+		if (sent <= 0)
+		{
+			return false;
+		}
+		data += sent;
+		a_size -= (size_t)sent;
+	}
+	return true;
+}
+
+bool Socket::ReceiveAll(void* a_data, size_t a_size)
+{
+	char* data = static_cast<char*>(a_data);
+	while (a_size > 0)
+	{
+		int received = (int)recv(m_handle, data, (int)a_size, 0);
+		if (received <= 0)
+		{
+			return false;
+		}
+		data += received;
+		a_size -= (size_t)received;
+	}
+	return true;
+}
+
+void Socket::Close()
+{
+	if (m_handle != INVALID_HANDLE)
+	{
+		CloseSocket(m_handle);
+		m_handle = INVALID_HANDLE;
+	}
+}
+
+bool Socket::IsOpen() const
+{
+	return m_handle != INVALID_HANDLE;
+}
+
+bool Socket::WaitReadable(const std::vector<Socket*>& a_sockets, int a_timeoutMs, std::vector<bool>& a_readable)
+{
+	fd_set readSet;
+	FD_ZERO(&readSet);
+	Handle highest = 0;
+	for (const Socket* socket : a_sockets)
+	{
+		FD_SET(socket->m_handle, &readSet);
+		highest = socket->m_handle > highest ? socket->m_handle : highest;
+	}
+	timeval timeout;
+	timeout.tv_sec = a_timeoutMs / 1000;
+	timeout.tv_usec = (a_timeoutMs % 1000) * 1000;
+	// The first argument is ignored by Winsock
+	int ready = select((int)highest + 1, &readSet, nullptr, nullptr, &timeout);
+	a_readable.assign(a_sockets.size(), false);
+	if (ready < 0)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < a_sockets.size(); ++i)
+	{
+		a_readable[i] = FD_ISSET(a_sockets[i]->m_handle, &readSet) != 0;
+	}
+	return true;
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+// 
+//	File:				SpotLight.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A spot light is a point light that only shines inside a cone around its forward direction.
+//						Inside the inner angle the light is at full strength, it then fades out smoothly to the outer angle.
+// 
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <cmath>
+#include "SpotLight.h"
+//\------------------------
+
+SpotLight::SpotLight()
+{
+	SetDirection(Vector3(0.f, -1.f, 0.f));
+	SetConeAngles(20.f, 30.f);
+}
+
+SpotLight::SpotLight(const Vector3& a_position, const Vector3& a_direction, const ColourRGB& a_colour, float a_intensity, float a_innerAngle, float a_outerAngle)
+	: PointLight(a_position, a_colour, a_intensity)
+{
+	SetDirection(a_direction);
+	SetConeAngles(a_innerAngle, a_outerAngle);
+}
+
+SpotLight::~SpotLight()
+{
+}
+
+void SpotLight::SetConeAngles(float a_innerAngle, float a_outerAngle)
+{
+	m_cosInner = cosf(a_innerAngle * MathLib::DEG2RAD);
+	m_cosOuter = cosf(a_outerAngle * MathLib::DEG2RAD);
+	if (m_cosInner <= m_cosOuter)
+	{
+		m_cosInner = m_cosOuter + 1e-4f;		// Keep the fade range from collapsing to a divide by zero
+	}
+}
+
+LightSample SpotLight::SampleLight(const Vector3& a_point) const
+{
+	LightSample sample = PointLight::SampleLight(a_point);
+	// Smooth step between the outer and inner cone on the angle away from the light direction
+	float cosAngle = -Dot(sample.directionToLight, GetDirection());
+	float t = (cosAngle - m_cosOuter) / (m_cosInner - m_cosOuter);
+	t = t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+	sample.colour = sample.colour * (t * t * (3.f - 2.f * t));
+	return sample;
+}
+
+void SpotLight::SampleBatch(const ShadingBatch& a_batch, const LightBatchResult& a_result) const
+{
+	PointLight::SampleBatch(a_batch, a_result);
+	const Vector3 direction = GetDirection();
+	for (int i = 0; i < a_batch.count; ++i)
+	{
+		float cosAngle = -(a_result.directionX[i] * direction.x + a_result.directionY[i] * direction.y + a_result.directionZ[i] * direction.z);
+		float t = (cosAngle - m_cosOuter) / (m_cosInner - m_cosOuter);
+		t = t < 0.f ? 0.f : (t > 1.f ? 1.f : t);
+		const float falloff = t * t * (3.f - 2.f * t);
+		a_result.colourR[i] *= falloff;
+		a_result.colourG[i] *= falloff;
+		a_result.colourB[i] *= falloff;
+	}
+}
+
+// A point light lights the whole sphere around it, the spot light only lights the cap of the sphere inside its cone
+float SpotLight::EstimatePower() const
+{
+	return PointLight::EstimatePower() * 0.5f * (1.f - m_cosOuter);
+}
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				StreamingImage.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				An image file written a band of rows at a time for frames too large to hold in memory.
+//						Every pixel has a fixed size in the file, so each band is written straight to its final
+//						offset with a positional write and bands can arrive in any order.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "StreamingImage.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+//\------------------------
+
+namespace
+{
+#ifdef _WIN32
+	const StreamingImage::Handle INVALID_HANDLE = INVALID_HANDLE_VALUE;
+#else
+	const StreamingImage::Handle INVALID_HANDLE = -1;
+#endif
+
+	// A negative PFM scale says the floats are little endian
+	bool IsLittleEndian()
+	{
+		const unsigned int one = 1;
+		return *reinterpret_cast<const unsigned char*>(&one) == 1;
+	}
+}
+
+StreamingImage::StreamingImage() : m_handle(INVALID_HANDLE), m_format(ImageOutput::PPM), m_width(0), m_height(0), m_headerSize(0), m_rowSize(0)
+{
+}
+
+StreamingImage::~StreamingImage()
+{
+	Close();
+}
+
+bool StreamingImage::CanStream(ImageOutput::Format a_format)
+{
+	return a_format == ImageOutput::PPM || a_format == ImageOutput::PFM;
+}
+
+bool StreamingImage::Open(const std::string& a_filename, int a_width, int a_height, const std::string& a_comment)
+{
+	Close();
+	m_format = ImageOutput::FormatFromFilename(a_filename);
+	if (!CanStream(m_format) || a_width < 0 || a_height < 0)
+	{
+		return false;
+	}
+	m_width = a_width;
+	m_height = a_height;
+
+	std::ostringstream header;
+	if (m_format == ImageOutput::PFM)
+	{
+		header << "PF\n" << m_width << ' ' << m_height << '\n' << (IsLittleEndian() ? "-1.0" : "1.0") << '\n';
+		m_rowSize = (size_t)m_width * sizeof(ColourRGB);
+	}
+	else
+	{
+		header << "P6\n";
+		if (!a_comment.empty())
+		{
+			header << "# " << a_comment << '\n';
+		}
+		header << m_width << ' ' << m_height << '\n' << 255 << '\n';
+		m_rowSize = (size_t)m_width * 3;
+	}
+	const std::string text = header.str();
+	m_headerSize = text.size();
+
+#ifdef _WIN32
+	m_handle = CreateFileA(a_filename.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_handle == INVALID_HANDLE)
+	{
+		return false;
+	}
+	// Set the full size now so a disk without room for the image fails before anything is rendered
+	LARGE_INTEGER size;
+	size.QuadPart = (LONGLONG)GetFileSize();
+	if (!SetFilePointerEx(m_handle, size, nullptr, FILE_BEGIN) || !SetEndOfFile(m_handle))
+	{
+		Close();
+		return false;
+	}
+#else
+	m_handle = open(a_filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (m_handle == INVALID_HANDLE)
+	{
+		return false;
+	}
+	if (ftruncate(m_handle, (off_t)GetFileSize()) != 0)
+	{
+		Close();
+		return false;
+	}
+#endif
+	if (!WriteAt(0, text.data(), text.size()))
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool StreamingImage::WriteRows(int a_y, int a_rowCount, const ColourRGB* a_pixels)
+{
+	if (!IsOpen() || a_y < 0 || a_rowCount < 0 || a_y + a_rowCount > m_height)
+	{
+		return false;
+	}
+	if (a_rowCount == 0 || m_rowSize == 0)
+	{
+		return true;
+	}
+	std::vector<unsigned char> bytes(m_rowSize * a_rowCount);
+	if (m_format == ImageOutput::PFM)
+	{
+		// A PFM runs from the bottom row up, so the band goes in upside down and ends at the row above it
+		for (int row = 0; row < a_rowCount; ++row)
+		{
+			std::memcpy(&bytes[m_rowSize * (a_rowCount - 1 - row)], a_pixels + (size_t)row * m_width, m_rowSize);
+		}
+		return WriteAt(m_headerSize + (unsigned long long)m_rowSize * (m_height - a_y - a_rowCount), bytes.data(), bytes.size());
+	}
+	const size_t pixelCount = (size_t)m_width * a_rowCount;
+	for (size_t i = 0; i < pixelCount; ++i)
+	{
+		bytes[i * 3] = ImageOutput::ToByte(a_pixels[i].x);
+		bytes[i * 3 + 1] = ImageOutput::ToByte(a_pixels[i].y);
+		bytes[i * 3 + 2] = ImageOutput::ToByte(a_pixels[i].z);
+	}
+	return WriteAt(m_headerSize + (unsigned long long)m_rowSize * a_y, bytes.data(), bytes.size());
+}
+
+bool StreamingImage::Close()
+{
+	if (!IsOpen())
+	{
+		return true;
+	}
+#ifdef _WIN32
+	bool closed = CloseHandle(m_handle) != 0;
+#else
+	bool closed = close(m_handle) == 0;
+#endif
+	m_handle = INVALID_HANDLE;
+	return closed;
+}
+
+bool StreamingImage::IsOpen() const
+{
+	return m_handle != INVALID_HANDLE;
+}
+
+unsigned long long StreamingImage::GetFileSize() const
+{
+	return m_headerSize + (unsigned long long)m_rowSize * m_height;
+}
+
+bool StreamingImage::WriteAt(unsigned long long a_offset, const void* a_data, size_t a_size)
+{
+	const char* data = static_cast<const char*>(a_data);
+	while (a_size > 0)
+	{
+		// Large bands go in pieces of a gigabyte, well within what one call can write
+		const size_t size = std::min(a_size, (size_t)1 << 30);
+#ifdef _WIN32
+		OVERLAPPED position = {};
+		position.Offset = (DWORD)a_offset;
+		position.OffsetHigh = (DWORD)(a_offset >> 32);
+		DWORD written = 0;
+		if (!WriteFile(m_handle, data, (DWORD)size, &written, &position) || written == 0)
+		{
+			return false;
+		}
+#else
+		ssize_t written = pwrite(m_handle, data, size, (off_t)a_offset);
+		if (written <= 0)
+		{
+			return false;
+		}
+#endif
+		data += written;
+		a_offset += written;
+		a_size -= written;
+	}
+	return true;
+}
@@ -0,0 +1,449 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				Texture.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				An image texture kept on disk as a pyramid of mip levels cut into square tiles. Only the header
+//						is held in memory - texels are fetched a tile at a time through a TextureCache, and each
+//						lookup reads the mip level that matches how much of the texture the ray's footprint covers.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "Texture.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "FrameBuffer.h"
+//\------------------------
+
+namespace
+{
+#ifdef _WIN32
+	const Texture::Handle INVALID_HANDLE = INVALID_HANDLE_VALUE;
+#else
+	const Texture::Handle INVALID_HANDLE = -1;
+#endif
+
+	//\----------------------------------------------------------------------------------
+	//\ Tiled file layout - the header, then each mip level from the full size image down, each level its tiles
+	//\ row by row. Every tile is a full tile of RGB half floats, the ones over the edge of a level padded with
+	//\ its edge texels, so where any tile starts can be worked out from the header alone.
+	//\----------------------------------------------------------------------------------
+	const char TILED_MAGIC[4] = { 'R', 'T', 'T', 'X' };
+	const int TILED_VERSION = 1;
+	struct TiledHeader
+	{
+		char	magic[4];
+		int		version;
+		int		width;
+		int		height;
+		int		tileSize;
+		int		levelCount;
+	};
+
+	// Colour a texture returns where its tiles cannot be read, bright enough to be noticed
+	const ColourRGB MISSING_COLOUR = ColourRGB(1.f, 0.f, 1.f);
+
+	std::atomic<int> g_nextTextureID(1);
+
+	// Next number in a PPM or PFM header, skipping white space and comments
+	bool ReadHeaderValue(std::istream& a_in, std::string& a_value)
+	{
+		a_value.clear();
+		int c = a_in.get();
+		while (c != EOF && (std::isspace(c) || c == '#'))
+		{
+			if (c == '#')
+			{
+				while (c != EOF && c != '\n')
+				{
+					c = a_in.get();
+				}
+			}
+			c = a_in.get();
+		}
+		while (c != EOF && !std::isspace(c))
+		{
+			a_value.push_back((char)c);
+			c = a_in.get();
+		}
+		return !a_value.empty();
+	}
+
+	bool IsLittleEndian()
+	{
+		const unsigned int one = 1;
+		return *reinterpret_cast<const unsigned char*>(&one) == 1;
+	}
+
+	// The next level down - each texel the average of the 2x2 block above it, the edge repeated for odd sizes
+	void HalveImage(const std::vector<ColourRGB>& a_image, int a_width, int a_height, std::vector<ColourRGB>& a_half, int& a_halfWidth, int& a_halfHeight)
+	{
+		a_halfWidth = std::max(a_width / 2, 1);
+		a_halfHeight = std::max(a_height / 2, 1);
+		a_half.resize((size_t)a_halfWidth * a_halfHeight);
+		for (int y = 0; y < a_halfHeight; ++y)
+		{
+			const int y0 = std::min(y * 2, a_height - 1);
+			const int y1 = std::min(y * 2 + 1, a_height - 1);
+			for (int x = 0; x < a_halfWidth; ++x)
+			{
+				const int x0 = std::min(x * 2, a_width - 1);
+				const int x1 = std::min(x * 2 + 1, a_width - 1);
+				a_half[(size_t)y * a_halfWidth + x] = (a_image[(size_t)y0 * a_width + x0] + a_image[(size_t)y0 * a_width + x1] +
+					a_image[(size_t)y1 * a_width + x0] + a_image[(size_t)y1 * a_width + x1]) * 0.25f;
+			}
+		}
+	}
+
+	int WrapTexel(int a_value, int a_size)
+	{
+		a_value %= a_size;
+		return a_value < 0 ? a_value + a_size : a_value;
+	}
+}
+
+Texture::Texture() : m_handle(INVALID_HANDLE), m_cache(nullptr), m_id(g_nextTextureID++), m_width(0), m_height(0), m_tileSize(0)
+{
+}
+
+Texture::~Texture()
+{
+	Close();
+}
+
+bool Texture::LoadImage(const std::string& a_filename, std::vector<ColourRGB>& a_pixels, int& a_width, int& a_height)
+{
+	std::ifstream in(a_filename, std::ios::binary);
+	std::string magic, width, height, range;
+	if (!in || !ReadHeaderValue(in, magic) || !ReadHeaderValue(in, width) || !ReadHeaderValue(in, height) || !ReadHeaderValue(in, range))
+	{
+		return false;
+	}
+	a_width = std::atoi(width.c_str());
+	a_height = std::atoi(height.c_str());
+	if (a_width <= 0 || a_height <= 0)
+	{
+		return false;
+	}
+	const size_t pixelCount = (size_t)a_width * a_height;
+	a_pixels.resize(pixelCount);
+
+	if (magic == "PF" || magic == "Pf")
+	{
+		// Rows run from the bottom up and the sign of the scale gives the byte order
+		const int channels = magic == "PF" ? 3 : 1;
+		const bool swap = (std::atof(range.c_str()) < 0.0) != IsLittleEndian();
+		std::vector<float> row((size_t)a_width * channels);
+		for (int y = a_height - 1; y >= 0; --y)
+		{
+			if (!in.read(reinterpret_cast<char*>(row.data()), row.size() * sizeof(float)))
+			{
+				return false;
+			}
+			for (float& value : row)
+			{
+				if (swap)
+				{
+					unsigned char* bytes = reinterpret_cast<unsigned char*>(&value);
+					std::swap(bytes[0], bytes[3]);
+					std::swap(bytes[1], bytes[2]);
+				}
+			}
+			for (int x = 0; x < a_width; ++x)
+			{
+				const float* texel = &row[(size_t)x * channels];
+				a_pixels[(size_t)y * a_width + x] = channels == 3 ? ColourRGB(texel[0], texel[1], texel[2]) : ColourRGB(texel[0], texel[0], texel[0]);
+			}
+		}
+		return true;
+	}
+
+	const float invRange = 1.f / (float)std::max(std::atoi(range.c_str()), 1);
+	if (magic == "P6")
+	{
+		// One byte a channel up to a range of 255, two bytes (most significant first) above it
+		const int bytesPerValue = std::atoi(range.c_str()) > 255 ? 2 : 1;
+		std::vector<unsigned char> bytes(pixelCount * 3 * bytesPerValue);
+		if (!in.read(reinterpret_cast<char*>(bytes.data()), bytes.size()))
+		{
+			return false;
+		}
+		for (size_t i = 0; i < pixelCount * 3; ++i)
+		{
+			const int value = bytesPerValue == 1 ? bytes[i] : (bytes[i * 2] << 8) | bytes[i * 2 + 1];
+			(&a_pixels[i / 3].x)[i % 3] = (float)value * invRange;
+		}
+		return true;
+	}
+	if (magic == "P3")
+	{
+		for (size_t i = 0; i < pixelCount * 3; ++i)
+		{
+			std::string value;
+			if (!ReadHeaderValue(in, value))
+			{
+				return false;
+			}
+			(&a_pixels[i / 3].x)[i % 3] = (float)std::atoi(value.c_str()) * invRange;
+		}
+		return true;
+	}
+	return false;
+}
+
+bool Texture::CreateTiled(const std::string& a_imageFilename, const std::string& a_tiledFilename, int a_tileSize)
+{
+	std::vector<ColourRGB> pixels;
+	int width = 0;
+	int height = 0;
+	return LoadImage(a_imageFilename, pixels, width, height) && CreateTiled(pixels, width, height, a_tiledFilename, a_tileSize);
+}
+
+bool Texture::CreateTiled(const std::vector<ColourRGB>& a_pixels, int a_width, int a_height, const std::string& a_tiledFilename, int a_tileSize)
+{
+	if (a_width <= 0 || a_height <= 0 || a_tileSize <= 0 || a_pixels.size() < (size_t)a_width * a_height)
+	{
+		return false;
+	}
+	std::ofstream out(a_tiledFilename, std::ios::binary);
+	if (!out)
+	{
+		return false;
+	}
+	int levelCount = 1;
+	while ((std::max(a_width, a_height) >> levelCount) > 0)
+	{
+		++levelCount;
+	}
+	TiledHeader header;
+	std::memcpy(header.magic, TILED_MAGIC, sizeof(header.magic));
+	header.version = TILED_VERSION;
+	header.width = a_width;
+	header.height = a_height;
+	header.tileSize = a_tileSize;
+	header.levelCount = levelCount;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	std::vector<ColourRGB> level(a_pixels.begin(), a_pixels.begin() + (size_t)a_width * a_height);
+	std::vector<ColourRGB> next;
+	int width = a_width;
+	int height = a_height;
+	std::vector<ColourRGB> tile((size_t)a_tileSize * a_tileSize);
+	std::vector<unsigned short> halves(tile.size() * 3);
+	for (int l = 0; l < levelCount; ++l)
+	{
+		for (int tileY = 0; tileY * a_tileSize < height; ++tileY)
+		{
+			for (int tileX = 0; tileX * a_tileSize < width; ++tileX)
+			{
+				for (int y = 0; y < a_tileSize; ++y)
+				{
+					const int sourceY = std::min(tileY * a_tileSize + y, height - 1);
+					for (int x = 0; x < a_tileSize; ++x)
+					{
+						const int sourceX = std::min(tileX * a_tileSize + x, width - 1);
+						tile[(size_t)y * a_tileSize + x] = level[(size_t)sourceY * width + sourceX];
+					}
+				}
+				PixelFormat::FloatToHalf(&tile[0].x, halves.data(), halves.size());
+				out.write(reinterpret_cast<const char*>(halves.data()), halves.size() * sizeof(unsigned short));
+			}
+		}
+		if (l + 1 < levelCount)
+		{
+			int nextWidth = 0;
+			int nextHeight = 0;
+			HalveImage(level, width, height, next, nextWidth, nextHeight);
+			level.swap(next);
+			width = nextWidth;
+			height = nextHeight;
+		}
+	}
+	return (bool)out;
+}
+
+bool Texture::Open(const std::string& a_tiledFilename, TextureCache* a_cache)
+{
+	Close();
+#ifdef _WIN32
+	m_handle = CreateFileA(a_tiledFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+	m_handle = open(a_tiledFilename.c_str(), O_RDONLY);
+#endif
+	TiledHeader header;
+	if (m_handle == INVALID_HANDLE || !ReadAt(0, &header, sizeof(header)) || std::memcmp(header.magic, TILED_MAGIC, sizeof(header.magic)) != 0 ||
+		header.version != TILED_VERSION || header.width <= 0 || header.height <= 0 || header.tileSize <= 0 || header.levelCount <= 0)
+	{
+		Close();
+		return false;
+	}
+	m_cache = a_cache != nullptr ? a_cache : &TextureCache::Shared();
+	m_width = header.width;
+	m_height = header.height;
+	m_tileSize = header.tileSize;
+	unsigned long long offset = sizeof(header);
+	const unsigned long long tileBytes = (unsigned long long)m_tileSize * m_tileSize * 3 * sizeof(unsigned short);
+	for (int l = 0; l < header.levelCount; ++l)
+	{
+		Level level;
+		level.width = std::max(m_width >> l, 1);
+		level.height = std::max(m_height >> l, 1);
+		level.tilesX = (level.width + m_tileSize - 1) / m_tileSize;
+		level.tilesY = (level.height + m_tileSize - 1) / m_tileSize;
+		level.offset = offset;
+		offset += tileBytes * level.tilesX * level.tilesY;
+		m_levels.push_back(level);
+	}
+	return true;
+}
+
+void Texture::Close()
+{
+	if (IsOpen())
+	{
+#ifdef _WIN32
+		CloseHandle(m_handle);
+#else
+		close(m_handle);
+#endif
+	}
+	m_handle = INVALID_HANDLE;
+	m_levels.clear();
+	// Tiles already cached stay there until they are evicted - a texture opened again gets a new id so it
+	// never sees tiles of the file it had before
+	m_id = g_nextTextureID++;
+}
+
+bool Texture::IsOpen() const
+{
+	return m_handle != INVALID_HANDLE;
+}
+
+size_t Texture::GetFullSize() const
+{
+	size_t size = 0;
+	for (const Level& level : m_levels)
+	{
+		size += (size_t)level.tilesX * level.tilesY * m_tileSize * m_tileSize * 3 * sizeof(unsigned short);
+	}
+	return size;
+}
+
+bool Texture::LoadTile(int a_level, int a_tileX, int a_tileY, std::vector<unsigned short>& a_texels) const
+{
+	if (!IsOpen() || a_level < 0 || a_level >= (int)m_levels.size())
+	{
+		return false;
+	}
+	const Level& level = m_levels[a_level];
+	if (a_tileX < 0 || a_tileX >= level.tilesX || a_tileY < 0 || a_tileY >= level.tilesY)
+	{
+		return false;
+	}
+	a_texels.resize((size_t)m_tileSize * m_tileSize * 3);
+	const size_t tileBytes = a_texels.size() * sizeof(unsigned short);
+	return ReadAt(level.offset + tileBytes * ((unsigned long long)a_tileY * level.tilesX + a_tileX), a_texels.data(), tileBytes);
+}
+
+ColourRGB Texture::Sample(const Vector2& a_uv, float a_footprint) const
+{
+	if (m_levels.empty())
+	{
+		return MISSING_COLOUR;
+	}
+	// The level where the footprint is about one texel across, and the blend toward the next one down
+	const float texels = a_footprint * (float)std::max(m_width, m_height);
+	const float lod = std::min(texels > 1.f ? std::log2(texels) : 0.f, (float)(m_levels.size() - 1));
+	const int level = (int)lod;
+	const float blend = lod - (float)level;
+	ColourRGB colour = Bilinear(level, a_uv);
+	if (blend > 0.f && level + 1 < (int)m_levels.size())
+	{
+		colour = Lerp(colour, Bilinear(level + 1, a_uv), blend);
+	}
+	return colour;
+}
+
+ColourRGB Texture::Bilinear(int a_level, const Vector2& a_uv) const
+{
+	const Level& level = m_levels[a_level];
+	const float x = (a_uv.x - std::floor(a_uv.x)) * (float)level.width - 0.5f;
+	const float y = (a_uv.y - std::floor(a_uv.y)) * (float)level.height - 0.5f;
+	const int x0 = (int)std::floor(x);
+	const int y0 = (int)std::floor(y);
+	const float fx = x - (float)x0;
+	const float fy = y - (float)y0;
+
+	// The four texels are usually in one tile, so it is only looked up again when one of them is not
+	TextureCache::TilePtr tile;
+	int tileIndex = -1;
+	auto texel = [&](int a_x, int a_y)
+	{
+		a_x = WrapTexel(a_x, level.width);
+		a_y = WrapTexel(a_y, level.height);
+		const int tileX = a_x / m_tileSize;
+		const int tileY = a_y / m_tileSize;
+		if (tileY * level.tilesX + tileX != tileIndex)
+		{
+			tileIndex = tileY * level.tilesX + tileX;
+			tile = m_cache->GetTile(*this, a_level, tileX, tileY);
+		}
+		if (tile == nullptr)
+		{
+			return MISSING_COLOUR;
+		}
+		const unsigned short* half = &tile->texels[((size_t)(a_y - tileY * m_tileSize) * m_tileSize + (a_x - tileX * m_tileSize)) * 3];
+		return ColourRGB(PixelFormat::HalfToFloat(half[0]), PixelFormat::HalfToFloat(half[1]), PixelFormat::HalfToFloat(half[2]));
+	};
+	const ColourRGB top = Lerp(texel(x0, y0), texel(x0 + 1, y0), fx);
+	const ColourRGB bottom = Lerp(texel(x0, y0 + 1), texel(x0 + 1, y0 + 1), fx);
+	return Lerp(top, bottom, fy);
+}
+
+bool Texture::ReadAt(unsigned long long a_offset, void* a_data, size_t a_size) const
+{
+	char* data = static_cast<char*>(a_data);
+	while (a_size > 0)
+	{
+#ifdef _WIN32
+		OVERLAPPED position = {};
+		position.Offset = (DWORD)a_offset;
+		position.OffsetHigh = (DWORD)(a_offset >> 32);
+		DWORD read = 0;
+		if (!ReadFile(m_handle, data, (DWORD)std::min(a_size, (size_t)1 << 30), &read, &position) || read == 0)
+		{
+			return false;
+		}
+#else
+		ssize_t read = pread(m_handle, data, std::min(a_size, (size_t)1 << 30), (off_t)a_offset);
+		if (read <= 0)
+		{
+			return false;
+		}
+#endif
+		data += read;
+		a_offset += read;
+		a_size -= read;
+	}
+	return true;
+}
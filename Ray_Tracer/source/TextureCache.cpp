@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				TextureCache.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				A fixed size cache of texture tiles shared by every render thread. Tiles are read from their
+//						texture's file the first time they are looked up and the least recently used tiles are
+//						dropped to stay inside the memory budget, so textures far larger than memory can be used.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include "TextureCache.h"
+#include "Texture.h"
+//\------------------------
+
+namespace
+{
+	// Memory a tile costs beyond its texels - the list and index entries that track it
+	const size_t ENTRY_OVERHEAD = 96;
+
+	// Texture, level and tile packed into one key - 24 bits of texture, 8 of level and 16 for each tile coordinate
+	unsigned long long TileKey(int a_texture, int a_level, int a_tileX, int a_tileY)
+	{
+		return ((unsigned long long)(a_texture & 0xffffff) << 40) | ((unsigned long long)(a_level & 0xff) << 32) |
+			((unsigned long long)(a_tileY & 0xffff) << 16) | (unsigned long long)(a_tileX & 0xffff);
+	}
+
+	// Neighbouring tiles differ only in their low bits, so the key is mixed before it picks a shard
+	int ShardOf(unsigned long long a_key, int a_shardCount)
+	{
+		a_key ^= a_key >> 33;
+		a_key *= 0xff51afd7ed558ccdULL;
+		a_key ^= a_key >> 33;
+		return (int)(a_key % (unsigned long long)a_shardCount);
+	}
+}
+
+TextureCache::TextureCache(size_t a_capacityBytes) : m_capacity(a_capacityBytes), m_residentBytes(0), m_peakResidentBytes(0)
+{
+}
+
+TextureCache::~TextureCache()
+{
+}
+
+TextureCache& TextureCache::Shared()
+{
+	static TextureCache s_cache;
+	return s_cache;
+}
+
+void TextureCache::SetCapacity(size_t a_capacityBytes)
+{
+	m_capacity = a_capacityBytes;
+	for (Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		Evict(shard);
+	}
+}
+
+TextureCache::TilePtr TextureCache::GetTile(const Texture& a_texture, int a_level, int a_tileX, int a_tileY)
+{
+	const unsigned long long key = TileKey(a_texture.GetID(), a_level, a_tileX, a_tileY);
+	Shard& shard = m_shards[ShardOf(key, SHARD_COUNT)];
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		++shard.lookups;
+		auto found = shard.index.find(key);
+		if (found != shard.index.end())
+		{
+			++shard.hits;
+			shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+			return found->second->tile;
+		}
+	}
+
+	// Read the tile without holding the lock so other threads are not kept waiting on the disk. Two threads
+	// missing the same tile at once both read it and the second one uses the copy the first put in.
+	std::shared_ptr<TextureTile> tile = std::make_shared<TextureTile>();
+	if (!a_texture.LoadTile(a_level, a_tileX, a_tileY, tile->texels))
+	{
+		return nullptr;
+	}
+	const size_t bytes = tile->texels.size() * sizeof(unsigned short) + ENTRY_OVERHEAD;
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	auto found = shard.index.find(key);
+	if (found != shard.index.end())
+	{
+		return found->second->tile;
+	}
+	++shard.tilesLoaded;
+	shard.entries.push_front(Entry{ key, tile, bytes });
+	shard.index[key] = shard.entries.begin();
+	shard.bytes += bytes;
+	AddResident((long long)bytes);
+	Evict(shard);
+	return tile;
+}
+
+void TextureCache::Evict(Shard& a_shard)
+{
+	const size_t budget = m_capacity / SHARD_COUNT;
+	// The newest tile always stays so a budget smaller than a tile still works, just slowly
+	while (a_shard.bytes > budget && a_shard.entries.size() > 1)
+	{
+		const Entry& oldest = a_shard.entries.back();
+		a_shard.bytes -= oldest.bytes;
+		AddResident(-(long long)oldest.bytes);
+		a_shard.index.erase(oldest.key);
+		a_shard.entries.pop_back();
+		++a_shard.evictions;
+	}
+}
+
+void TextureCache::AddResident(long long a_bytes)
+{
+	const size_t resident = (size_t)((long long)(m_residentBytes += (size_t)a_bytes));
+	size_t peak = m_peakResidentBytes;
+	while (resident > peak && !m_peakResidentBytes.compare_exchange_weak(peak, resident))
+	{
+	}
+}
+
+void TextureCache::Clear()
+{
+	for (Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		AddResident(-(long long)shard.bytes);
+		shard.entries.clear();
+		shard.index.clear();
+		shard.bytes = 0;
+	}
+}
+
+TextureCacheStats TextureCache::GetStats() const
+{
+	TextureCacheStats stats = {};
+	for (const Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		stats.lookups += shard.lookups;
+		stats.hits += shard.hits;
+		stats.tilesLoaded += shard.tilesLoaded;
+		stats.evictions += shard.evictions;
+	}
+	stats.residentBytes = m_residentBytes;
+	stats.peakResidentBytes = m_peakResidentBytes;
+	stats.capacityBytes = m_capacity;
+	return stats;
+}
+
+void TextureCache::ResetStats()
+{
+	for (Shard& shard : m_shards)
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		shard.lookups = 0;
+		shard.hits = 0;
+		shard.tilesLoaded = 0;
+		shard.evictions = 0;
+	}
+	m_peakResidentBytes = (size_t)m_residentBytes;
+}
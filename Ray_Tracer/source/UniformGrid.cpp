@@ -0,0 +1,415 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				UniformGrid.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Uniform grid over the primitives of a scene for scenes where everything moves every frame.
+//						The build is a parallel counting sort of the objects into cells, linear in the object count,
+//						and a moved object is taken out of the cells it left and put in the ones it now covers without
+//						touching the rest. Rays walk the cells they pass through in order with a 3D-DDA.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+#include "ParallelFor.h"
+#include "Primitive.h"
+#include "UniformGrid.h"
+//\------------------------
+
+namespace
+{
+	const float CELLS_PER_OBJECT = 2.f;		// Cells made for each object in the box - more cells, fewer objects in each
+	const int MAX_RESOLUTION = 256;			// Cells along any one axis
+	const int MAX_CELLS = 1 << 21;
+	const float LARGE_OBJECT_SIZE = 32.f;		// An object this many times the size of the median object is left out of the cells
+	const int LARGE_OBJECT_CELLS = 256;		// As is one that would cover more cells than this
+	const float BOUNDS_MARGIN = 0.01f;		// Part of the box added on every side, so objects moving about at the edge stay inside
+	const int BUILD_CHUNK_SIZE = 1024;		// Objects a thread takes at a time during the build
+
+	float Axis(const Vector3& a_v3, int a_axis)
+	{
+		return a_axis == 0 ? a_v3.x : (a_axis == 1 ? a_v3.y : a_v3.z);
+	}
+
+	template<typename Body>
+	void ForObjects(int a_count, int a_threads, Body a_body)
+	{
+		Parallel::For((a_count + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE, [&](int a_chunk)
+		{
+			const int end = std::min(a_count, (a_chunk + 1) * BUILD_CHUNK_SIZE);
+			for (int i = a_chunk * BUILD_CHUNK_SIZE; i < end; ++i)
+			{
+				a_body(i);
+			}
+		}, a_threads);
+	}
+}
+
+UniformGrid::UniformGrid() : m_objects(nullptr), m_resolution{ 0, 0, 0 }, m_freeOverflow(-1), m_freeOverflowCount(0), m_outsideCount(0)
+{
+}
+
+UniformGrid::~UniformGrid()
+{
+}
+
+void UniformGrid::Clear()
+{
+	m_objects = nullptr;
+	m_bounds = AABB();
+	m_resolution[0] = m_resolution[1] = m_resolution[2] = 0;
+	m_cellStart.clear();
+	m_cellCount.clear();
+	m_entries.clear();
+	m_overflowHead.clear();
+	m_overflow.clear();
+	m_freeOverflow = -1;
+	m_freeOverflowCount = 0;
+	m_ranges.clear();
+	m_global.clear();
+	m_globalSlot.clear();
+	m_outsideCount = 0;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Build - the box is sized to the objects left once the few far bigger than the rest (a ground sphere, a sky)
+//\ are taken out, so they do not stretch the cells over empty space. The cells are then counted, laid out with
+//\ a prefix sum and filled, with the counting and filling spread over the threads.
+//\----------------------------------------------------------------------------------
+void UniformGrid::Build(const std::vector<const Primitive*>& a_objects, int a_threads)
+{
+	Clear();
+	if (a_objects.empty())
+	{
+		return;
+	}
+	m_objects = &a_objects;
+	const int objectCount = (int)a_objects.size();
+
+	std::vector<AABB> bounds(objectCount);
+	std::vector<float> sizes(objectCount);
+	ForObjects(objectCount, a_threads, [&](int a_object)
+	{
+		bounds[a_object] = a_objects[a_object]->GetBounds();
+		const Vector3 extent = bounds[a_object].Extent();
+		sizes[a_object] = std::max(std::max(extent.x, extent.y), extent.z);
+	});
+	std::vector<float> sortedSizes = sizes;
+	std::nth_element(sortedSizes.begin(), sortedSizes.begin() + objectCount / 2, sortedSizes.end());
+	const float largeSize = sortedSizes[objectCount / 2] * LARGE_OBJECT_SIZE;
+
+	m_ranges.resize(objectCount);
+	m_globalSlot.assign(objectCount, -1);
+	int cellObjects = 0;
+	for (int i = 0; i < objectCount; ++i)
+	{
+		if (sizes[i] > largeSize)
+		{
+			m_ranges[i].placement = LARGE;
+			continue;
+		}
+		m_ranges[i].placement = IN_CELLS;
+		m_bounds.Grow(bounds[i]);
+		++cellObjects;
+	}
+
+	if (cellObjects == 0)
+	{
+		// Nothing for the cells - every object is tested by every ray
+		for (int i = 0; i < objectCount; ++i)
+		{
+			m_globalSlot[i] = i;
+			m_global.push_back(i);
+		}
+		return;
+	}
+
+	// Cells about as deep as they are wide, as many of them as the objects ask for - a flat box still gets a layer
+	Vector3 extent = m_bounds.Extent();
+	const float minExtent = std::max(std::max(std::max(extent.x, extent.y), extent.z) * 1e-3f, 1e-6f);
+	extent = Vector3(std::max(extent.x, minExtent), std::max(extent.y, minExtent), std::max(extent.z, minExtent));
+	m_bounds = AABB(m_bounds.Centre() - extent * (0.5f + BOUNDS_MARGIN), m_bounds.Centre() + extent * (0.5f + BOUNDS_MARGIN));
+	extent = m_bounds.Extent();
+	float cellsPerUnit = std::cbrt(CELLS_PER_OBJECT * (float)cellObjects / (extent.x * extent.y * extent.z));
+	for (int attempt = 0; attempt < 2; ++attempt)
+	{
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			m_resolution[axis] = std::min(std::max((int)std::ceil(Axis(extent, axis) * cellsPerUnit), 1), MAX_RESOLUTION);
+		}
+		const float cells = (float)m_resolution[0] * (float)m_resolution[1] * (float)m_resolution[2];
+		if (cells <= (float)MAX_CELLS)
+		{
+			break;
+		}
+		cellsPerUnit *= std::cbrt((float)MAX_CELLS / cells) * 0.99f;
+	}
+	m_cellSize = Vector3(extent.x / (float)m_resolution[0], extent.y / (float)m_resolution[1], extent.z / (float)m_resolution[2]);
+	m_invCellSize = Vector3((float)m_resolution[0] / extent.x, (float)m_resolution[1] / extent.y, (float)m_resolution[2] / extent.z);
+	const int cellCount = GetCellCount();
+
+	// Count the entries of every cell
+	std::unique_ptr<std::atomic<int>[]> counts(new std::atomic<int>[cellCount]);
+	for (int c = 0; c < cellCount; ++c)
+	{
+		counts[c] = 0;
+	}
+	ForObjects(objectCount, a_threads, [&](int a_object)
+	{
+		if (m_ranges[a_object].placement == LARGE)
+		{
+			return;
+		}
+		CellRange& range = m_ranges[a_object];
+		range = RangeOf(bounds[a_object]);
+		if (range.placement != IN_CELLS)
+		{
+			return;
+		}
+		for (int z = range.min[2]; z <= range.max[2]; ++z)
+		{
+			for (int y = range.min[1]; y <= range.max[1]; ++y)
+			{
+				for (int x = range.min[0]; x <= range.max[0]; ++x)
+				{
+					counts[CellIndex(x, y, z)].fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		}
+	});
+
+	// Lay the cells out one after another, then fill them - counts is reused as each cell's fill position
+	m_cellStart.resize(cellCount + 1);
+	m_cellCount.resize(cellCount);
+	m_overflowHead.assign(cellCount, -1);
+	int entryCount = 0;
+	for (int c = 0; c < cellCount; ++c)
+	{
+		m_cellStart[c] = entryCount;
+		m_cellCount[c] = counts[c];
+		entryCount += counts[c];
+		counts[c] = m_cellStart[c];
+	}
+	m_cellStart[cellCount] = entryCount;
+	m_entries.resize(entryCount);
+	ForObjects(objectCount, a_threads, [&](int a_object)
+	{
+		const CellRange& range = m_ranges[a_object];
+		if (range.placement != IN_CELLS)
+		{
+			return;
+		}
+		for (int z = range.min[2]; z <= range.max[2]; ++z)
+		{
+			for (int y = range.min[1]; y <= range.max[1]; ++y)
+			{
+				for (int x = range.min[0]; x <= range.max[0]; ++x)
+				{
+					m_entries[counts[CellIndex(x, y, z)].fetch_add(1, std::memory_order_relaxed)] = a_object;
+				}
+			}
+		}
+	});
+	// The threads fill a cell in any order - sorting it makes the order, and so the shadow cache, the same every build
+	Parallel::For((cellCount + BUILD_CHUNK_SIZE - 1) / BUILD_CHUNK_SIZE, [&](int a_chunk)
+	{
+		const int end = std::min(cellCount, (a_chunk + 1) * BUILD_CHUNK_SIZE);
+		for (int c = a_chunk * BUILD_CHUNK_SIZE; c < end; ++c)
+		{
+			std::sort(m_entries.begin() + m_cellStart[c], m_entries.begin() + m_cellStart[c + 1]);
+		}
+	}, a_threads);
+
+	for (int i = 0; i < objectCount; ++i)
+	{
+		if (m_ranges[i].placement != IN_CELLS)
+		{
+			m_globalSlot[i] = (int)m_global.size();
+			m_global.push_back(i);
+			m_outsideCount += m_ranges[i].placement == OUTSIDE ? 1 : 0;
+		}
+	}
+}
+
+// Outside unless the whole box is inside the grid, so nothing of an object is ever past the cells it is in
+UniformGrid::CellRange UniformGrid::RangeOf(const AABB& a_bounds) const
+{
+	CellRange range;
+	range.placement = OUTSIDE;
+	if (!(a_bounds.min.x >= m_bounds.min.x && a_bounds.min.y >= m_bounds.min.y && a_bounds.min.z >= m_bounds.min.z &&
+		a_bounds.max.x <= m_bounds.max.x && a_bounds.max.y <= m_bounds.max.y && a_bounds.max.z <= m_bounds.max.z))
+	{
+		return range;
+	}
+	int cells = 1;
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		const float boundsMin = Axis(m_bounds.min, axis);
+		const float invCellSize = Axis(m_invCellSize, axis);
+		range.min[axis] = std::min((int)((Axis(a_bounds.min, axis) - boundsMin) * invCellSize), m_resolution[axis] - 1);
+		range.max[axis] = std::min((int)((Axis(a_bounds.max, axis) - boundsMin) * invCellSize), m_resolution[axis] - 1);
+		cells *= range.max[axis] - range.min[axis] + 1;
+	}
+	range.placement = cells > LARGE_OBJECT_CELLS ? LARGE : IN_CELLS;
+	return range;
+}
+
+//\----------------------------------------------------------------------------------
+//\ Update - nothing changes while the object stays in the same cells. Otherwise it is taken out of its old
+//\ cells and put in the new ones, using space freed in a cell before going to the cell's overflow list.
+//\----------------------------------------------------------------------------------
+void UniformGrid::Update(int a_objectIndex)
+{
+	if (!IsBuilt() || m_ranges[a_objectIndex].placement == LARGE)
+	{
+		return;
+	}
+	const CellRange range = RangeOf((*m_objects)[a_objectIndex]->GetBounds());
+	const CellRange& oldRange = m_ranges[a_objectIndex];
+	if (range.placement == oldRange.placement && (range.placement != IN_CELLS ||
+		(std::equal(range.min, range.min + 3, oldRange.min) && std::equal(range.max, range.max + 3, oldRange.max))))
+	{
+		return;
+	}
+	Remove(a_objectIndex, oldRange);
+	Insert(a_objectIndex, range);
+	m_ranges[a_objectIndex] = range;
+}
+
+void UniformGrid::Refit()
+{
+	for (int i = 0; i < (int)m_ranges.size(); ++i)
+	{
+		Update(i);
+	}
+}
+
+void UniformGrid::Insert(int a_objectIndex, const CellRange& a_range)
+{
+	if (a_range.placement != IN_CELLS)
+	{
+		m_globalSlot[a_objectIndex] = (int)m_global.size();
+		m_global.push_back(a_objectIndex);
+		m_outsideCount += a_range.placement == OUTSIDE ? 1 : 0;
+		return;
+	}
+	for (int z = a_range.min[2]; z <= a_range.max[2]; ++z)
+	{
+		for (int y = a_range.min[1]; y <= a_range.max[1]; ++y)
+		{
+			for (int x = a_range.min[0]; x <= a_range.max[0]; ++x)
+			{
+				const int cell = CellIndex(x, y, z);
+				if (m_cellStart[cell] + m_cellCount[cell] < m_cellStart[cell + 1])
+				{
+					m_entries[m_cellStart[cell] + m_cellCount[cell]++] = a_objectIndex;
+					continue;
+				}
+				int entry = m_freeOverflow;
+				if (entry >= 0)
+				{
+					m_freeOverflow = m_overflow[entry].next;
+					--m_freeOverflowCount;
+				}
+				else
+				{
+					entry = (int)m_overflow.size();
+					m_overflow.push_back(Overflow());
+				}
+				m_overflow[entry].object = a_objectIndex;
+				m_overflow[entry].next = m_overflowHead[cell];
+				m_overflowHead[cell] = entry;
+			}
+		}
+	}
+}
+
+void UniformGrid::Remove(int a_objectIndex, const CellRange& a_range)
+{
+	if (a_range.placement != IN_CELLS)
+	{
+		// The last object in the list takes its place
+		const int slot = m_globalSlot[a_objectIndex];
+		m_global[slot] = m_global.back();
+		m_globalSlot[m_global[slot]] = slot;
+		m_global.pop_back();
+		m_globalSlot[a_objectIndex] = -1;
+		m_outsideCount -= a_range.placement == OUTSIDE ? 1 : 0;
+		return;
+	}
+	for (int z = a_range.min[2]; z <= a_range.max[2]; ++z)
+	{
+		for (int y = a_range.min[1]; y <= a_range.max[1]; ++y)
+		{
+			for (int x = a_range.min[0]; x <= a_range.max[0]; ++x)
+			{
+				const int cell = CellIndex(x, y, z);
+				int* first = &m_entries[0] + m_cellStart[cell];
+				int* last = first + m_cellCount[cell];
+				int* found = std::find(first, last, a_objectIndex);
+				if (found != last)
+				{
+					*found = *(last - 1);
+					--m_cellCount[cell];
+					continue;
+				}
+				for (int* link = &m_overflowHead[cell]; *link >= 0; link = &m_overflow[*link].next)
+				{
+					if (m_overflow[*link].object == a_objectIndex)
+					{
+						const int entry = *link;
+						*link = m_overflow[entry].next;
+						m_overflow[entry].next = m_freeOverflow;
+						m_freeOverflow = entry;
+						++m_freeOverflowCount;
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Nearest hit - the walk stops after the first cell whose far side is past the nearest hit so far. A hit further
+//\ on in an object that also covers later cells is kept, and only beaten by something nearer in those cells.
+//\----------------------------------------------------------------------------------
+bool UniformGrid::IntersectNearest(const Ray& a_ray, float& a_distance, int& a_objectIndex) const
+{
+	if (!IsBuilt())
+	{
+		return false;
+	}
+	float nearest = a_ray.MaxDistance();
+	int nearestObject = -1;
+	Ray clipped = a_ray;					// Cut short at the nearest hit for instances, the same as the hierarchy
+	Walk(a_ray, nearest, [&](int a_object)
+	{
+		float objectDistance = 0.f;
+		if ((*m_objects)[a_object]->IntersectDistance(clipped, objectDistance) && objectDistance > a_ray.MinLength())
+		{
+			// Same rule as the linear search - ties go to the object added to the scene first
+			if (objectDistance < nearest || (objectDistance == nearest && a_object < nearestObject))
+			{
+				nearest = objectDistance;
+				nearestObject = a_object;
+				clipped.SetMaxDistance(nearest);
+			}
+		}
+		return false;
+	});
+	if (nearestObject < 0)
+	{
+		return false;
+	}
+	a_distance = nearest;
+	a_objectIndex = nearestObject;
+	return true;
+}
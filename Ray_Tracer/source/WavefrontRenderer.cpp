@@ -0,0 +1,762 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//	File:				WavefrontRenderer.cpp
+//	Author:				Scott Baldwin
+//	Last Edited:		19-10-26
+//	Brief:				Renders the same image as Renderer breadth first - a large wave of paths is moved through
+//						separate stages instead of tracing one ray at a time to the bottom of its recursion. Each
+//						stage is a loop over arrays of one kind of data, run across every core, so intersection,
+//						shading and shadow code each get the caches to themselves while they run.
+//
+///////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//\------------------------
+//\ INCLUDES
+//\------------------------
+#include <algorithm>
+#include <chrono>
+#include <Random.h>
+
+#include "Light.h"
+#include "Material.h"
+#include "ParallelFor.h"
+#include "Renderer.h"
+#include "Scene.h"
+#include "WavefrontRenderer.h"
+//\------------------------
+
+namespace
+{
+	// Items a thread takes from a stage at a time - enough to keep the shared counter out of the way
+	const int CHUNK_SIZE = 256;
+
+	// Hand a_body the first and one past the last item of each chunk, for stages that work a chunk at a time
+	template<typename Body>
+	void ForChunkRanges(int a_count, int a_threads, Body a_body)
+	{
+		Parallel::For((a_count + CHUNK_SIZE - 1) / CHUNK_SIZE, [&](int a_chunk)
+		{
+			a_body(a_chunk * CHUNK_SIZE, std::min(a_count, (a_chunk + 1) * CHUNK_SIZE));
+		}, a_threads);
+	}
+
+	template<typename Body>
+	void ForChunks(int a_count, int a_threads, Body a_body)
+	{
+		ForChunkRanges(a_count, a_threads, [&](int a_begin, int a_end)
+		{
+			for (int i = a_begin; i < a_end; ++i)
+			{
+				a_body(i);
+			}
+		});
+	}
+
+	// Spread the low 10 bits of a_value out to every third bit
+	unsigned int SpreadBits(unsigned int a_value)
+	{
+		a_value &= 0x3ff;
+		a_value = (a_value | (a_value << 16)) & 0x030000ff;
+		a_value = (a_value | (a_value << 8)) & 0x0300f00f;
+		a_value = (a_value | (a_value << 4)) & 0x030c30c3;
+		a_value = (a_value | (a_value << 2)) & 0x09249249;
+		return a_value;
+	}
+
+	//\----------------------------------------------------------------------------------
+	//\ Least significant digit first radix sort on the a_keyBits bits above the low 32, which hold the path
+	//\ index and ride along with the key
+	//\----------------------------------------------------------------------------------
+	void RadixSort(std::vector<unsigned long long>& a_keys, std::vector<unsigned long long>& a_scratch, int a_keyBits)
+	{
+		const int DIGIT_BITS = 11;
+		const int DIGIT_COUNT = 1 << DIGIT_BITS;
+		a_scratch.resize(a_keys.size());
+		for (int shift = 32; shift < 32 + a_keyBits; shift += DIGIT_BITS)
+		{
+			std::vector<size_t> offsets(DIGIT_COUNT + 1, 0);
+			for (unsigned long long key : a_keys)
+			{
+				++offsets[((key >> shift) & (DIGIT_COUNT - 1)) + 1];
+			}
+			for (int digit = 0; digit < DIGIT_COUNT; ++digit)
+			{
+				offsets[digit + 1] += offsets[digit];
+			}
+			for (unsigned long long key : a_keys)
+			{
+				a_scratch[offsets[(key >> shift) & (DIGIT_COUNT - 1)]++] = key;
+			}
+			a_keys.swap(a_scratch);
+		}
+	}
+
+	class StageTimer
+	{
+	public:
+		StageTimer(double& a_total) : m_total(a_total), m_start(std::chrono::high_resolution_clock::now()) {}
+		~StageTimer()
+		{
+			m_total += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count();
+		}
+	private:
+		double& m_total;
+		std::chrono::high_resolution_clock::time_point m_start;
+	};
+}
+
+void WavefrontRenderer::Paths::Resize(size_t a_count)
+{
+	for (std::vector<float>* values : { &originX, &originY, &originZ, &directionX, &directionY, &directionZ, &minLength, &coneWidth,
+		&coneSpread, &weight, &refractiveIndex, &radianceR, &radianceG, &radianceB })
+	{
+		values->resize(a_count);
+	}
+	bounces.resize(a_count);
+	seed.resize(a_count);
+	alive.resize(a_count);
+	sample.resize(a_count);
+	branch.resize(a_count);
+}
+
+void WavefrontRenderer::Hits::Resize(size_t a_count)
+{
+	for (std::vector<float>* values : { &distance, &positionX, &positionY, &positionZ, &normalX, &normalY, &normalZ, &u, &v, &uvPerUnit, &footprint })
+	{
+		values->resize(a_count);
+	}
+	object.resize(a_count);
+	frontFace.resize(a_count);
+	material.resize(a_count);
+}
+
+void WavefrontRenderer::ShadowRays::Resize(size_t a_count)
+{
+	for (std::vector<float>* values : { &directionX, &directionY, &directionZ, &maxDistance, &colourR, &colourG, &colourB })
+	{
+		values->resize(a_count);
+	}
+	light.resize(a_count);
+}
+
+void WavefrontRenderer::Branches::Resize(size_t a_count)
+{
+	for (std::vector<float>* values : { &originX, &originY, &originZ, &directionX, &directionY, &directionZ, &minLength, &coneWidth,
+		&coneSpread, &weight, &refractiveIndex })
+	{
+		values->resize(a_count);
+	}
+	seed.resize(a_count);
+	queued.resize(a_count);
+}
+
+WavefrontRenderer::WavefrontRenderer(const Renderer& a_renderer, int a_waveSize, int a_threads) :
+	m_renderer(a_renderer), m_waveSize(std::max(a_waveSize, 1)), m_threads(a_threads), m_rayOrder(MATERIAL_ORDER), m_times(), m_shadowSlots(0),
+	m_sampleCount(0)
+{
+}
+
+WavefrontRenderer::~WavefrontRenderer()
+{
+}
+
+void WavefrontRenderer::Render(const Scene& a_scene, std::vector<ColourRGB>& a_pixels)
+{
+	const int cropWidth = m_renderer.GetCropWidth();
+	const int pixelCount = cropWidth * m_renderer.GetCropHeight();
+	const int raysPerPixel = std::max(m_renderer.GetRaysPerPixel(), 1);
+	a_pixels.resize(pixelCount);
+	m_times = WavefrontStageTimes();
+
+	// A wave is made of whole pixels so each pixel can be summed as soon as its wave is done
+	const int pixelsPerWave = std::max(m_waveSize / raysPerPixel, 1);
+	const int pathCount = std::min(pixelsPerWave, std::max(pixelCount, 1)) * raysPerPixel;
+	m_shadowSlots = std::max(a_scene.GetLightSamplesPerHit(), 1);
+	GrowPaths(pathCount);
+
+	const float invRays = 1.f / (float)raysPerPixel;
+	for (int firstPixel = 0; firstPixel < pixelCount; firstPixel += pixelsPerWave)
+	{
+		const int wavePixels = std::min(pixelsPerWave, pixelCount - firstPixel);
+		Generate(a_scene, firstPixel, wavePixels);
+		for (bool secondary = false; !m_active.empty(); secondary = true)
+		{
+			if (secondary && m_rayOrder == MORTON_ORDER)
+			{
+				SortRays();
+			}
+			Extend(a_scene, secondary);
+			Shade(a_scene);
+			Connect(a_scene);
+			Compact();
+		}
+
+		// Samples are summed in the same order RenderPixel adds them - every branch has added its colour to its sample by now
+		ForChunks(wavePixels, m_threads, [&](int a_pixel)
+		{
+			ColourRGB colour(0.f, 0.f, 0.f);
+			for (int p = a_pixel * raysPerPixel; p < (a_pixel + 1) * raysPerPixel; ++p)
+			{
+				colour += ColourRGB(m_paths.radianceR[p], m_paths.radianceG[p], m_paths.radianceB[p]);
+			}
+			a_pixels[firstPixel + a_pixel] = colour * invRays;
+		});
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Generate - a camera ray for every sample of every pixel in the wave, jittered down the pixel the way
+//\ RenderPixel jitters them
+//\----------------------------------------------------------------------------------
+void WavefrontRenderer::Generate(const Scene& a_scene, int a_firstPixel, int a_pixelCount)
+{
+	StageTimer timer(m_times.generateMs);
+	const int raysPerPixel = std::max(m_renderer.GetRaysPerPixel(), 1);
+	const int pathCount = a_pixelCount * raysPerPixel;
+	const int cropWidth = m_renderer.GetCropWidth();
+	const float invWidth = 1.f / (float)m_renderer.GetWidth();
+	const float invHeight = 1.f / (float)m_renderer.GetHeight();
+	const float pixelSpread = m_renderer.GetPixelSpread(a_scene);
+	ForChunks(pathCount, m_threads, [&](int a_path)
+	{
+		const int pixel = a_firstPixel + a_path / raysPerPixel;
+		const int x = m_renderer.GetCropX() + pixel % cropWidth;
+		const int y = m_renderer.GetCropY() + pixel / cropWidth;
+		// Every sample has a sequence of its own, so it does not matter which thread runs it or in what order
+		Random::SetSeed(Random::HashSeed(Random::HashSeed(m_renderer.GetSeed(), x, y), a_path % raysPerPixel, 0));
+		float jitter = Random::RandomFloat();
+		Vector2 screenSpacePos(2.f * ((float)x + 0.5f) * invWidth - 1.f, 1.f - 2.f * ((float)y + jitter) * invHeight);
+		Ray ray = a_scene.GetScreenRay(screenSpacePos);
+
+		const Vector3 origin = ray.Origin();
+		const Vector3 direction = ray.Direction();
+		m_paths.originX[a_path] = origin.x;
+		m_paths.originY[a_path] = origin.y;
+		m_paths.originZ[a_path] = origin.z;
+		m_paths.directionX[a_path] = direction.x;
+		m_paths.directionY[a_path] = direction.y;
+		m_paths.directionZ[a_path] = direction.z;
+		m_paths.minLength[a_path] = ray.MinLength();
+		m_paths.coneWidth[a_path] = 0.f;
+		m_paths.coneSpread[a_path] = pixelSpread;
+		m_paths.weight[a_path] = 1.f;
+		m_paths.refractiveIndex[a_path] = 1.f;
+		m_paths.bounces[a_path] = m_renderer.GetBounces();
+		m_paths.seed[a_path] = Random::GetSeed();
+		m_paths.radianceR[a_path] = 0.f;
+		m_paths.radianceG[a_path] = 0.f;
+		m_paths.radianceB[a_path] = 0.f;
+		m_paths.alive[a_path] = 1;
+		m_paths.sample[a_path] = a_path;
+		m_paths.branch[a_path] = 0;
+	});
+
+	// Every path after the camera samples is free for the reflections this wave splits off
+	m_sampleCount = pathCount;
+	m_freePaths.clear();
+	for (int path = (int)m_paths.alive.size() - 1; path >= pathCount; --path)
+	{
+		m_freePaths.push_back(path);
+	}
+
+	// CastRay returns black without tracing anything when it has no bounces
+	m_active.clear();
+	if (m_renderer.GetBounces() > 0)
+	{
+		m_active.resize(pathCount);
+		for (int i = 0; i < pathCount; ++i)
+		{
+			m_active[i] = i;
+		}
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Extend - the nearest hit of every live path, with the hit record kept for the shading stage
+//\----------------------------------------------------------------------------------
+void WavefrontRenderer::Extend(const Scene& a_scene, bool a_secondary)
+{
+	StageTimer timer(m_times.extendMs);
+	double secondaryMs = 0.0;
+	StageTimer secondaryTimer(a_secondary ? m_times.secondaryExtendMs : secondaryMs);
+	m_times.extensions += (long long)m_active.size();
+	m_times.secondaryExtensions += a_secondary ? (long long)m_active.size() : 0;
+	ForChunks((int)m_active.size(), m_threads, [&](int a_index)
+	{
+		const int path = m_active[a_index];
+		Ray ray(Vector3(m_paths.originX[path], m_paths.originY[path], m_paths.originZ[path]),
+			Vector3(m_paths.directionX[path], m_paths.directionY[path], m_paths.directionZ[path]), m_paths.minLength[path]);
+		ray.SetCone(m_paths.coneWidth[path], m_paths.coneSpread[path]);
+		float distance = 0.f;
+		int object = -1;
+		if (!a_scene.IntersectDistance(ray, distance, object))
+		{
+			m_hits.object[path] = -1;
+			return;
+		}
+		IntersectResponse ir;
+		a_scene.FinalizeHit(ray, distance, object, ir);
+		m_hits.object[path] = object;
+		m_hits.distance[path] = distance;
+		m_hits.positionX[path] = ir.HitPos.x;
+		m_hits.positionY[path] = ir.HitPos.y;
+		m_hits.positionZ[path] = ir.HitPos.z;
+		m_hits.normalX[path] = ir.SurfaceNormal.x;
+		m_hits.normalY[path] = ir.SurfaceNormal.y;
+		m_hits.normalZ[path] = ir.SurfaceNormal.z;
+		m_hits.u[path] = ir.uv.x;
+		m_hits.v[path] = ir.uv.y;
+		m_hits.uvPerUnit[path] = ir.uvPerUnit;
+		m_hits.footprint[path] = ir.footprint;
+		m_hits.frontFace[path] = ir.frontFace ? 1 : 0;
+		m_hits.material[path] = ir.material;
+	});
+}
+
+unsigned long long WavefrontRenderer::RayOrderKey(const Vector3& a_origin, const Vector3& a_direction, const AABB& a_bounds)
+{
+	// The cells are cubes sized by the longest side, so a flat scene spends its bits along its length
+	const Vector3 extent = a_bounds.Extent();
+	const float longest = std::max(std::max(extent.x, extent.y), extent.z);
+	const float scale = longest > 0.f ? 1023.f / longest : 0.f;
+	// Origins outside the box go in the nearest cell
+	auto cell = [scale](float a_offset) { return (unsigned int)std::min(std::max(a_offset * scale, 0.f), 1023.f); };
+	const unsigned int x = SpreadBits(cell(a_origin.x - a_bounds.min.x));
+	const unsigned int y = SpreadBits(cell(a_origin.y - a_bounds.min.y));
+	const unsigned int z = SpreadBits(cell(a_origin.z - a_bounds.min.z));
+	const unsigned long long octant = (a_direction.x < 0.f ? 4u : 0u) | (a_direction.y < 0.f ? 2u : 0u) | (a_direction.z < 0.f ? 1u : 0u);
+	return (octant << 30) | (x << 2) | (y << 1) | z;
+}
+
+void WavefrontRenderer::SortRays(const std::vector<Ray>& a_rays, std::vector<int>& a_order)
+{
+	AABB bounds;
+	for (const Ray& ray : a_rays)
+	{
+		bounds.Grow(ray.Origin());
+	}
+	std::vector<unsigned long long> keys(a_rays.size());
+	std::vector<unsigned long long> scratch;
+	for (size_t i = 0; i < a_rays.size(); ++i)
+	{
+		keys[i] = (RayOrderKey(a_rays[i].Origin(), a_rays[i].Direction(), bounds) << 32) | (unsigned int)i;
+	}
+	RadixSort(keys, scratch, 33);
+	a_order.resize(a_rays.size());
+	for (size_t i = 0; i < a_rays.size(); ++i)
+	{
+		a_order[i] = (int)(keys[i] & 0xffffffffu);
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Sort - every live path is keyed on the octant and origin of its ray and the paths are extended in key
+//\ order, so rays heading the same way out of the same part of the scene are traced one after another
+//\----------------------------------------------------------------------------------
+void WavefrontRenderer::SortRays()
+{
+	StageTimer timer(m_times.sortMs);
+	// The grid covers the ray origins rather than the scene, which a ground plane sized sphere can make far
+	// too big for the cells to tell nearby rays apart
+	AABB bounds;
+	for (int path : m_active)
+	{
+		bounds.Grow(Vector3(m_paths.originX[path], m_paths.originY[path], m_paths.originZ[path]));
+	}
+	m_sortKeys.resize(m_active.size());
+	ForChunks((int)m_active.size(), m_threads, [&](int a_index)
+	{
+		const int path = m_active[a_index];
+		const unsigned long long key = RayOrderKey(Vector3(m_paths.originX[path], m_paths.originY[path], m_paths.originZ[path]),
+			Vector3(m_paths.directionX[path], m_paths.directionY[path], m_paths.directionZ[path]), bounds);
+		m_sortKeys[a_index] = (key << 32) | (unsigned int)path;
+	});
+	RadixSort(m_sortKeys, m_sortScratch, 33);
+	for (size_t i = 0; i < m_active.size(); ++i)
+	{
+		m_active[i] = (int)(m_sortKeys[i] & 0xffffffffu);
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Shade - misses take the sky colour and finish. Hits are sorted by material, so all the hits on one
+//\ material are shaded together, then get their light samples and shading queued for the shadow stage and
+//\ carry on as the secondary rays CastRay traces - the refracted ray, with the reflected one queued for a path
+//\ of its own when there are both. A chunk of hits is lit a shadow slot at a time - every hit chooses its
+//\ light, then the hits that chose the same light are sampled and shaded in one Light::ShadeBatch call.
+//\----------------------------------------------------------------------------------
+void WavefrontRenderer::Shade(const Scene& a_scene)
+{
+	StageTimer timer(m_times.shadeMs);
+
+	// Group the hits by material with a counting sort - a scene has a handful of materials
+	std::vector<const Material*> materials;
+	m_scratch.resize(m_active.size());
+	std::vector<int> counts;
+	for (size_t i = 0; i < m_active.size(); ++i)
+	{
+		const int path = m_active[i];
+		if (m_hits.object[path] < 0)
+		{
+			m_scratch[i] = -1;
+			continue;
+		}
+		const Material* material = m_hits.material[path];
+		size_t bucket = std::find(materials.begin(), materials.end(), material) - materials.begin();
+		if (bucket == materials.size())
+		{
+			materials.push_back(material);
+			counts.push_back(0);
+		}
+		++counts[bucket];
+		m_scratch[i] = (int)bucket;
+	}
+	std::vector<int> starts(counts.size() + 1, 0);
+	for (size_t bucket = 0; bucket < counts.size(); ++bucket)
+	{
+		starts[bucket + 1] = starts[bucket] + counts[bucket];
+	}
+	m_shadeOrder.resize(starts.back());
+	m_shadeMaterial.resize(starts.back());
+	for (size_t i = 0; i < m_active.size(); ++i)
+	{
+		const int path = m_active[i];
+		if (m_scratch[i] < 0)
+		{
+			const ColourRGB sky = Scene::SkyColour(Ray(Vector3(m_paths.originX[path], m_paths.originY[path], m_paths.originZ[path]),
+				Vector3(m_paths.directionX[path], m_paths.directionY[path], m_paths.directionZ[path])));
+			m_paths.radianceR[path] += sky.x * m_paths.weight[path];
+			m_paths.radianceG[path] += sky.y * m_paths.weight[path];
+			m_paths.radianceB[path] += sky.z * m_paths.weight[path];
+			m_paths.alive[path] = 0;
+			continue;
+		}
+		m_shadeMaterial[starts[m_scratch[i]]] = m_scratch[i];
+		m_shadeOrder[starts[m_scratch[i]]++] = path;
+	}
+
+	auto hitResponse = [&](int a_path)
+	{
+		IntersectResponse ir;
+		ir.HitPos = Vector3(m_hits.positionX[a_path], m_hits.positionY[a_path], m_hits.positionZ[a_path]);
+		ir.SurfaceNormal = Vector3(m_hits.normalX[a_path], m_hits.normalY[a_path], m_hits.normalZ[a_path]);
+		ir.frontFace = m_hits.frontFace[a_path] != 0;
+		ir.distance = m_hits.distance[a_path];
+		ir.material = m_hits.material[a_path];
+		ir.currentRefInd = m_paths.refractiveIndex[a_path];
+		ir.primitiveID = m_hits.object[a_path];
+		ir.uv = Vector2(m_hits.u[a_path], m_hits.v[a_path]);
+		ir.uvPerUnit = m_hits.uvPerUnit[a_path];
+		ir.footprint = m_hits.footprint[a_path];
+		return ir;
+	};
+
+	const Vector3 eyePosition = a_scene.GetEyePosition();
+	const int lightCount = a_scene.GetLightSamplesPerHit();
+	ForChunkRanges((int)m_shadeOrder.size(), m_threads, [&](int a_begin, int a_end)
+	{
+		const int count = a_end - a_begin;
+		// The albedo is looked up once a hit, texture and all, and shared by every light the hit samples
+		float albedoR[CHUNK_SIZE], albedoG[CHUNK_SIZE], albedoB[CHUNK_SIZE];
+		int seeds[CHUNK_SIZE];
+		for (int k = 0; k < count; ++k)
+		{
+			const int path = m_shadeOrder[a_begin + k];
+			const Vector3 albedo = m_hits.material[path]->GetAlbedo(hitResponse(path));
+			albedoR[k] = albedo.x;
+			albedoG[k] = albedo.y;
+			albedoB[k] = albedo.z;
+			seeds[k] = m_paths.seed[path];
+		}
+
+		// A batch is gathered from the hits that chose the same light, so it reads one run of memory
+		float positionX[CHUNK_SIZE], positionY[CHUNK_SIZE], positionZ[CHUNK_SIZE];
+		float normalX[CHUNK_SIZE], normalY[CHUNK_SIZE], normalZ[CHUNK_SIZE];
+		float batchAlbedoR[CHUNK_SIZE], batchAlbedoG[CHUNK_SIZE], batchAlbedoB[CHUNK_SIZE];
+		int batchMaterial[CHUNK_SIZE];
+		int batchSeeds[CHUNK_SIZE];
+		float directionX[CHUNK_SIZE], directionY[CHUNK_SIZE], directionZ[CHUNK_SIZE], distance[CHUNK_SIZE];
+		float colourR[CHUNK_SIZE], colourG[CHUNK_SIZE], colourB[CHUNK_SIZE];
+		const ShadingBatch batch = { 0, positionX, positionY, positionZ, normalX, normalY, normalZ, batchAlbedoR, batchAlbedoG, batchAlbedoB,
+			batchMaterial, materials.data(), batchSeeds, eyePosition };
+		const LightBatchResult result = { directionX, directionY, directionZ, distance, colourR, colourG, colourB };
+
+		// Direct light - the shading is worked out now and only kept if the shadow ray gets through
+		const Light* lights[CHUNK_SIZE];
+		int lightIndices[CHUNK_SIZE];
+		float lightWeights[CHUNK_SIZE];
+		int order[CHUNK_SIZE];
+		for (int slot = 0; slot < m_shadowSlots; ++slot)
+		{
+			if (slot >= lightCount)
+			{
+				for (int k = 0; k < count; ++k)
+				{
+					m_shadows.light[(size_t)m_shadeOrder[a_begin + k] * m_shadowSlots + slot] = -1;
+				}
+				continue;
+			}
+			for (int k = 0; k < count; ++k)
+			{
+				Random::SetSeed(seeds[k]);
+				lightIndices[k] = slot;
+				lightWeights[k] = 1.f;
+				lights[k] = a_scene.ChooseLight(slot, lightIndices[k], lightWeights[k]);
+				seeds[k] = Random::GetSeed();
+				order[k] = k;
+			}
+			std::sort(order, order + count, [&](int a_left, int a_right) { return lightIndices[a_left] < lightIndices[a_right]; });
+
+			for (int first = 0; first < count;)
+			{
+				const Light* light = lights[order[first]];
+				int last = first;
+				for (; last < count && lights[order[last]] == light; ++last)
+				{
+					const int k = order[last];
+					const int path = m_shadeOrder[a_begin + k];
+					const int j = last - first;
+					positionX[j] = m_hits.positionX[path];
+					positionY[j] = m_hits.positionY[path];
+					positionZ[j] = m_hits.positionZ[path];
+					normalX[j] = m_hits.normalX[path];
+					normalY[j] = m_hits.normalY[path];
+					normalZ[j] = m_hits.normalZ[path];
+					batchAlbedoR[j] = albedoR[k];
+					batchAlbedoG[j] = albedoG[k];
+					batchAlbedoB[j] = albedoB[k];
+					batchMaterial[j] = m_shadeMaterial[a_begin + k];
+					batchSeeds[j] = seeds[k];
+				}
+				ShadingBatch run = batch;
+				run.count = last - first;
+				light->ShadeBatch(run, result);
+
+				for (int j = 0; j < run.count; ++j)
+				{
+					const int k = order[first + j];
+					const int path = m_shadeOrder[a_begin + k];
+					const size_t shadow = (size_t)path * m_shadowSlots + slot;
+					const float scale = lightWeights[k] * m_paths.weight[path];
+					m_shadows.directionX[shadow] = directionX[j];
+					m_shadows.directionY[shadow] = directionY[j];
+					m_shadows.directionZ[shadow] = directionZ[j];
+					m_shadows.maxDistance[shadow] = distance[j];
+					m_shadows.light[shadow] = lightIndices[k];
+					m_shadows.colourR[shadow] = colourR[j] * scale;
+					m_shadows.colourG[shadow] = colourG[j] * scale;
+					m_shadows.colourB[shadow] = colourB[j] * scale;
+					seeds[k] = batchSeeds[j];
+				}
+				first = last;
+			}
+		}
+
+		for (int k = 0; k < count; ++k)
+		{
+			const int path = m_shadeOrder[a_begin + k];
+			Random::SetSeed(seeds[k]);
+			Ray ray(Vector3(m_paths.originX[path], m_paths.originY[path], m_paths.originZ[path]),
+				Vector3(m_paths.directionX[path], m_paths.directionY[path], m_paths.directionZ[path]), m_paths.minLength[path]);
+			ray.SetCone(m_paths.coneWidth[path], m_paths.coneSpread[path]);
+			const IntersectResponse ir = hitResponse(path);
+
+			// The secondary rays CastRay traces, each weighted by what CastRay scales its colour by. A ray whose colour
+			// would be scaled to nothing is not traced, and neither is one CastRay would end without a bounce left.
+			const Material* material = ir.material;
+			const float weight = m_paths.weight[path];
+			const float transparency = material->GetTransparency();
+			const float reflective = material->GetReflective();
+			const float refractiveIndex = m_paths.refractiveIndex[path];
+			m_paths.bounces[path] -= 1;
+			const bool bouncesLeft = m_paths.bounces[path] > 0;
+			Ray refractRay;
+			const bool refracted = ir.material->CalcRefraction(ray, ir, refractRay) && transparency > 0.f && bouncesLeft;
+			Ray bounceRay;
+			const bool reflected = reflective > 0.f && bouncesLeft && ir.material->CalcReflection(ray, ir, bounceRay);
+			float refractWeight = weight * transparency;
+			float reflectWeight = weight * reflective;
+			if (reflective > 0.f && transparency > 0.f)
+			{
+				const float reflectance = material->Schlick(ray, ir);
+				reflectWeight *= reflectance;
+				refractWeight *= 1.f - reflectance;
+			}
+
+			m_branches.queued[path] = 0;
+			if (refracted)
+			{
+				SetPathRay(path, refractRay, refractWeight, material->GetRefractiveIndex());
+				if (reflected)
+				{
+					// Its own random sequence, split off from this path's so the two do not repeat each other
+					const Vector3 origin = bounceRay.Origin();
+					const Vector3 direction = bounceRay.Direction();
+					m_branches.originX[path] = origin.x;
+					m_branches.originY[path] = origin.y;
+					m_branches.originZ[path] = origin.z;
+					m_branches.directionX[path] = direction.x;
+					m_branches.directionY[path] = direction.y;
+					m_branches.directionZ[path] = direction.z;
+					m_branches.minLength[path] = bounceRay.MinLength();
+					m_branches.coneWidth[path] = bounceRay.ConeWidthAt(0.f);
+					m_branches.coneSpread[path] = bounceRay.ConeSpread();
+					m_branches.weight[path] = reflectWeight;
+					m_branches.refractiveIndex[path] = refractiveIndex;
+					m_branches.seed[path] = Random::HashSeed(Random::GetSeed(), m_paths.bounces[path], 1);
+					m_branches.queued[path] = 1;
+				}
+			}
+			else if (reflected)
+			{
+				SetPathRay(path, bounceRay, reflectWeight, refractiveIndex);		// Reflected rays stay in the medium they came from
+			}
+			else
+			{
+				m_paths.alive[path] = 0;
+			}
+			m_paths.seed[path] = Random::GetSeed();
+		}
+	});
+}
+
+//\----------------------------------------------------------------------------------
+//\ Connect - the shadow rays queued by the shading stage, each path's own slots on one thread so the colour
+//\ the lights add needs no locking
+//\----------------------------------------------------------------------------------
+void WavefrontRenderer::Connect(const Scene& a_scene)
+{
+	StageTimer timer(m_times.connectMs);
+	std::vector<long long> shadowRays(m_shadeOrder.size() / CHUNK_SIZE + 1, 0);
+	ForChunks((int)m_shadeOrder.size(), m_threads, [&](int a_index)
+	{
+		const int path = m_shadeOrder[a_index];
+		const Vector3 hitPosition(m_hits.positionX[path], m_hits.positionY[path], m_hits.positionZ[path]);
+		for (int slot = 0; slot < m_shadowSlots; ++slot)
+		{
+			const size_t shadow = (size_t)path * m_shadowSlots + slot;
+			if (m_shadows.light[shadow] < 0)
+			{
+				continue;
+			}
+			Ray shadowRay(hitPosition, Vector3(m_shadows.directionX[shadow], m_shadows.directionY[shadow], m_shadows.directionZ[shadow]),
+				0.001f, m_shadows.maxDistance[shadow]);
+			float shadowValue = a_scene.ShadowTest(shadowRay, m_shadows.light[shadow]);
+			m_paths.radianceR[path] += m_shadows.colourR[shadow] * shadowValue;
+			m_paths.radianceG[path] += m_shadows.colourG[shadow] * shadowValue;
+			m_paths.radianceB[path] += m_shadows.colourB[shadow] * shadowValue;
+			++shadowRays[a_index / CHUNK_SIZE];
+		}
+	});
+	for (long long count : shadowRays)
+	{
+		m_times.shadowRays += count;
+	}
+}
+
+//\----------------------------------------------------------------------------------
+//\ Compact - finished paths leave the queue. The survivors keep their material order, so the next
+//\ extension starts with rays that left the same surfaces together. The reflected rays queued by the
+//\ shading stage follow them, each on a path of its own.
+//\----------------------------------------------------------------------------------
+void WavefrontRenderer::Compact()
+{
+	StageTimer timer(m_times.compactMs);
+
+	// Finished branches add their colour to their camera sample and free their path. They are added in the order of
+	// their branch bits, so the sums come out the same bits whatever order the rays were traced in.
+	std::vector<std::pair<unsigned long long, int>> finished;
+	for (int path : m_active)
+	{
+		if (!m_paths.alive[path] && path >= m_sampleCount)
+		{
+			finished.push_back(std::make_pair(((unsigned long long)m_paths.sample[path] << 32) | m_paths.branch[path], path));
+		}
+	}
+	std::sort(finished.begin(), finished.end());
+	for (const std::pair<unsigned long long, int>& branch : finished)
+	{
+		const int path = branch.second;
+		const int sample = m_paths.sample[path];
+		m_paths.radianceR[sample] += m_paths.radianceR[path];
+		m_paths.radianceG[sample] += m_paths.radianceG[path];
+		m_paths.radianceB[sample] += m_paths.radianceB[path];
+		m_freePaths.push_back(path);
+	}
+
+	m_active.clear();
+	int queued = 0;
+	for (int path : m_shadeOrder)
+	{
+		if (m_paths.alive[path])
+		{
+			m_active.push_back(path);
+		}
+		queued += m_branches.queued[path];
+	}
+	if ((int)m_freePaths.size() < queued)
+	{
+		const size_t first = m_paths.alive.size();
+		GrowPaths(first + (size_t)queued - m_freePaths.size());
+		for (size_t path = m_paths.alive.size(); path-- > first;)
+		{
+			m_freePaths.push_back((int)path);
+		}
+	}
+	for (int parent : m_shadeOrder)
+	{
+		if (!m_branches.queued[parent])
+		{
+			continue;
+		}
+		const int path = m_freePaths.back();
+		m_freePaths.pop_back();
+		m_paths.originX[path] = m_branches.originX[parent];
+		m_paths.originY[path] = m_branches.originY[parent];
+		m_paths.originZ[path] = m_branches.originZ[parent];
+		m_paths.directionX[path] = m_branches.directionX[parent];
+		m_paths.directionY[path] = m_branches.directionY[parent];
+		m_paths.directionZ[path] = m_branches.directionZ[parent];
+		m_paths.minLength[path] = m_branches.minLength[parent];
+		m_paths.coneWidth[path] = m_branches.coneWidth[parent];
+		m_paths.coneSpread[path] = m_branches.coneSpread[parent];
+		m_paths.weight[path] = m_branches.weight[parent];
+		m_paths.refractiveIndex[path] = m_branches.refractiveIndex[parent];
+		m_paths.bounces[path] = m_paths.bounces[parent];
+		m_paths.seed[path] = m_branches.seed[parent];
+		m_paths.radianceR[path] = 0.f;
+		m_paths.radianceG[path] = 0.f;
+		m_paths.radianceB[path] = 0.f;
+		m_paths.alive[path] = 1;
+		m_paths.sample[path] = m_paths.sample[parent];
+		// A path splits one reflection off at most for each bounce, so the bit for the bounces left is its own
+		m_paths.branch[path] = m_paths.branch[parent] | (1u << std::min(m_paths.bounces[parent], 31));
+		m_branches.queued[parent] = 0;
+		m_active.push_back(path);
+	}
+}
+
+void WavefrontRenderer::SetPathRay(int a_path, const Ray& a_ray, float a_weight, float a_refractiveIndex)
+{
+	const Vector3 origin = a_ray.Origin();
+	const Vector3 direction = a_ray.Direction();
+	m_paths.originX[a_path] = origin.x;
+	m_paths.originY[a_path] = origin.y;
+	m_paths.originZ[a_path] = origin.z;
+	m_paths.directionX[a_path] = direction.x;
+	m_paths.directionY[a_path] = direction.y;
+	m_paths.directionZ[a_path] = direction.z;
+	m_paths.minLength[a_path] = a_ray.MinLength();
+	m_paths.coneWidth[a_path] = a_ray.ConeWidthAt(0.f);
+	m_paths.coneSpread[a_path] = a_ray.ConeSpread();
+	m_paths.weight[a_path] = a_weight;
+	m_paths.refractiveIndex[a_path] = a_refractiveIndex;
+}
+
+void WavefrontRenderer::GrowPaths(size_t a_count)
+{
+	m_paths.Resize(a_count);
+	m_hits.Resize(a_count);
+	m_shadows.Resize(a_count * m_shadowSlots);
+	m_branches.Resize(a_count);
+}
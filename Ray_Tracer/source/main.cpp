@@ -10,28 +10,42 @@
 //\------------------------
 //\ INCLUDES
 //\------------------------
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <ColourRGB.h>
 #include <string>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <chrono>
 #include <time.h>
 #include <Random.h>
+#include <FastMath.h>
 
-#include "Ellipsoid.h"
-#include "Camera.h"
-#include "Ray.h"
-#include "ColourRGB.h"
-#include "DirectionalLight.h"
 #include "Scene.h"
-#include "Light.h"
-#include "Material.h"
+#include "Benchmark.h"
+#include "Renderer.h"
+#include "ExampleScene.h"
+#include "GeneratedScene.h"
+#include "Regression.h"
+#include "Animation.h"
+#include "CropMerge.h"
+#include "RenderCluster.h"
+#include "Denoiser.h"
+#include "AOV.h"
+#include "FrameBuffer.h"
+#include "ImageOutput.h"
+#include "StreamingImage.h"
+#include "Texture.h"
+#include "WavefrontRenderer.h"
 //\------------------------
 
 //\====================================================================================================
 //\ MAIN - RAY_TRACER
 //\====================================================================================================
 
+// Positions of the arguments that are not options, counted among themselves so the options can go anywhere
 typedef enum input_args
 {
     OUTPUT_FILE = 1,
@@ -39,6 +53,9 @@ typedef enum input_args
     OUTPUT_HEIGHT,
 }input_args;
 
+// Times a --texture repeats around the ground sphere - about a texture every three units across the ground
+const float GROUND_TEXTURE_REPEAT = 100.f;
+
 void displayUsage(char* a_path)
 {
     std::string fullpath = a_path; // get the full path as a string
@@ -46,6 +63,155 @@ void displayUsage(char* a_path)
     std:: string exeName = fullpath.substr(fullpath.find_first_of('\\') + 1, fullpath.length());
     // Display a message to the user indicating usage of the executable
     std::cout << "usage: " << exeName << " [output image name] [image width] [imageheight]" << std::endl;
+    std::cout << "       " << exeName << " [output image name] [image width] [imageheight] --frames [frame count]" << std::endl;
+    std::cout << "       " << exeName << " --bench [benchmark name]" << std::endl;
+    std::cout << "       " << exeName << " --merge [output image name] [crop image names...]" << std::endl;
+    std::cout << "       " << exeName << " --worker [host:port]" << std::endl;
+    std::cout << "       " << exeName << " --regress [golden directory]         check the reference renders against their golden images" << std::endl;
+    std::cout << "       " << exeName << " --regress-update [golden directory]  render the reference scenes as the new golden images" << std::endl;
+    std::cout << "options: --seed [seed]                      seed for the random sequence of every pixel" << std::endl;
+    std::cout << "         --crop [x] [y] [width] [height]     only render this rectangle of the image" << std::endl;
+    std::cout << "         --spp [rays per pixel]              number of rays averaged for each pixel (default 100)" << std::endl;
+    std::cout << "         --denoise                           filter the noise out of the image, 8 to 16 rays per pixel is enough" << std::endl;
+    std::cout << "         --wavefront                         trace a wave of paths a stage at a time on every core" << std::endl;
+    std::cout << "         --sort-rays                         with --wavefront, sort the bounce rays by direction and origin first" << std::endl;
+    std::cout << "         --storage [fp32|half|rgbe]          how the image is held in memory before it is written" << std::endl;
+    std::cout << "         --aov                               also write position, normal, albedo, depth and id images" << std::endl;
+    std::cout << "         --stream [band rows]                write each band of rows to the file as it finishes, for images too" << std::endl;
+    std::cout << "                                             large for memory - .ppm (written as binary) or .pfm only" << std::endl;
+    std::cout << "         --cluster [workers]                 share the render out to this many local worker processes" << std::endl;
+    std::cout << "         --port [port]                       port the cluster listens on for workers on other machines" << std::endl;
+    std::cout << "         --texture [image]                   texture the ground with a .ppm or .pfm - a tiled copy is made next" << std::endl;
+    std::cout << "                                             to it the first time, or give the tiled .rttx itself" << std::endl;
+    std::cout << "         --texture-cache [MB]                memory the texture tiles can use (default 64)" << std::endl;
+    std::cout << "         --precision [precise|fast]          fast swaps pow, sqrt and normalize in shading and sampling for" << std::endl;
+    std::cout << "                                             approximations - quicker, with a slightly different image" << std::endl;
+    std::cout << "         --threads [count]                   threads for --wavefront (default one per core)" << std::endl;
+    std::cout << "         --grid                              trace against a uniform grid instead of the bounding volume hierarchy -" << std::endl;
+    std::cout << "                                             quicker to build and update with --frames, slower to trace" << std::endl;
+    std::cout << "         --light-samples [count]             shadow test this many lights a hit, picked in proportion to their" << std::endl;
+    std::cout << "                                             power, instead of every light - for scenes with many lights" << std::endl;
+    std::cout << "         --generate [name=value,...]         render a generated field of spheres instead of the example scene -" << std::endl;
+    std::cout << "                                             objects, ellipsoids, glass, lights, depth and seed, e.g. objects=5000,glass=0.1" << std::endl;
+    std::cout << "         --sweep [csv file]                  render generated scenes at every count below and write the times" << std::endl;
+    std::cout << "         --sweep-objects [n,n,...]           object counts to sweep (default 100,1000,10000)" << std::endl;
+    std::cout << "         --sweep-threads [n,n,...]           thread counts to sweep (default 1,2,4... up to one per core)" << std::endl;
+    std::cout << "         --sweep-spp [n,n,...]               rays per pixel to sweep (default 4)" << std::endl;
+    std::cout << "         --regress-slowdown [percent]        with --regress, how much slower than recorded a render may be (default 30)" << std::endl;
+    std::cout << "the extension of the output image picks its format - .ppm, .pfm (float), .qoi or .png" << std::endl;
+}
+
+// Frame number appended to the file name before the extension - out.ppm becomes out_0000.ppm
+std::string frameFilename(const std::string& a_filename, int a_frame)
+{
+    std::string number = std::to_string(a_frame);
+    number.insert(0, number.length() < 4 ? 4 - number.length() : 0, '0');
+    size_t extension = a_filename.find_last_of('.');
+    return a_filename.substr(0, extension) + "_" + number + a_filename.substr(extension);
+}
+
+// Read a comma separated list of positive counts - false if any of them is not one
+bool parseCounts(const std::string& a_text, std::vector<int>& a_counts)
+{
+    a_counts.clear();
+    size_t start = 0;
+    while (start <= a_text.size())
+    {
+        size_t comma = std::min(a_text.find(',', start), a_text.size());
+        int count = atoi(a_text.substr(start, comma - start).c_str());
+        if (count <= 0)
+        {
+            return false;
+        }
+        a_counts.push_back(count);
+        start = comma + 1;
+    }
+    return !a_counts.empty();
+}
+
+// Open a tiled texture, first making the tiled copy of an image next to it if there is not one already
+bool openTexture(const std::string& a_filename, Texture& a_texture)
+{
+    const std::string tiledExtension = ".rttx";
+    if (a_filename.size() > tiledExtension.size() && a_filename.compare(a_filename.size() - tiledExtension.size(), tiledExtension.size(), tiledExtension) == 0)
+    {
+        return a_texture.Open(a_filename);
+    }
+    const std::string tiledFilename = a_filename.substr(0, a_filename.find_last_of('.')) + tiledExtension;
+    if (a_texture.Open(tiledFilename))
+    {
+        return true;
+    }
+    std::clog << "Making the tiled texture " << tiledFilename << std::endl;
+    return Texture::CreateTiled(a_filename, tiledFilename) && a_texture.Open(tiledFilename);
+}
+
+// Filter the noise out of rendered pixels guided by the output variables of the same pixels
+void denoisePixels(const Renderer& a_renderer, const AOVBuffers& a_aovs, std::vector<ColourRGB>& a_pixels)
+{
+    Denoiser denoiser;
+    denoiser.Denoise(a_pixels, a_aovs, a_renderer.GetCropWidth(), a_renderer.GetCropHeight(), a_pixels);
+}
+
+//\----------------------------------------------------------------------------------
+//\ Animation - every frame is rendered in this process so the scene and its hierarchy are reused. The hierarchy, or
+//\ the grid, is refit to the moved objects each frame and only rebuilt when the refit one gets too slow. Frames
+//\ are rendered into two buffers in turn so frame N is written to disk while frame N + 1 renders.
+//\----------------------------------------------------------------------------------
+int renderAnimation(ExampleScene& a_example, const Renderer& a_renderer, const std::string& a_filename, int a_frameCount, bool a_denoise, bool a_writeAOVs)
+{
+    Animation animation;
+    a_example.AddTurntable(animation, 1.f);
+    Scene& scene = a_example.GetScene();
+    const char* structure = scene.GetAcceleration() == Scene::UNIFORM_GRID ? "grid" : "hierarchy";
+
+    std::vector<ColourRGB> pixels[2];
+    AOVBuffers aovs[2];
+    std::future<bool> pendingWrite;
+    int rebuilds = 0;
+    bool writeFailed = false;
+    for (int frame = 0; frame < a_frameCount; ++frame)
+    {
+        // The turntable loops, so the last frame stops one step short of the first
+        animation.Apply((float)frame / (float)a_frameCount);
+        auto start = std::chrono::high_resolution_clock::now();
+        bool rebuilt = scene.RefitAccelerationStructure();
+        rebuilds += rebuilt ? 1 : 0;
+        double refitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        std::vector<ColourRGB>& framePixels = pixels[frame % 2];
+        AOVBuffers& frameAOVs = aovs[frame % 2];
+        a_renderer.Render(scene, framePixels, (a_denoise || a_writeAOVs) ? &frameAOVs : nullptr);
+        if (a_denoise)
+        {
+            denoisePixels(a_renderer, frameAOVs, framePixels);
+        }
+
+        // The previous frame has had the whole render to finish writing, wait for it before starting this one
+        if (pendingWrite.valid() && !pendingWrite.get())
+        {
+            writeFailed = true;
+        }
+        std::string filename = frameFilename(a_filename, frame);
+        pendingWrite = std::async(std::launch::async, [&a_renderer, &framePixels, &frameAOVs, filename, a_writeAOVs]()
+            {
+                bool written = a_renderer.WriteImage(filename, framePixels);
+                return (a_writeAOVs ? a_renderer.WriteAOVs(filename, frameAOVs) : true) && written;
+            });
+        std::clog << "\rFrame " << frame + 1 << " of " << a_frameCount << " -> " << filename
+            << " (" << structure << (rebuilt ? " rebuilt" : " refit") << " in " << refitMs << "ms)" << std::endl;
+    }
+    if (pendingWrite.valid() && !pendingWrite.get())
+    {
+        writeFailed = true;
+    }
+    std::clog << "Rebuilt the " << structure << " " << rebuilds << " times over " << a_frameCount << " frames" << std::endl;
+    if (writeFailed)
+    {
+        std::cerr << "Failed to write one or more frames" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
 }
 
 int main(int argv, char* argc[])
@@ -53,9 +219,33 @@ int main(int argv, char* argc[])
     // set up the diamensions of the image
     int imageWidth = 512;
     int imageHeight = 256;
-    int channelColours = 255;
+    int frameCount = 1;
+    int seed = (int)time(nullptr);
+    int cropX = 0, cropY = 0, cropWidth = -1, cropHeight = -1;
+    int clusterWorkers = -1;
+    int clusterPort = 0;
+    int raysPerPixel = 100;
+    int streamRows = 0;
+    int threads = 0;
+    bool denoise = false;
+    bool wavefront = false;
+    bool sortRays = false;
+    bool writeAOVs = false;
+    bool generate = false;
+    bool uniformGrid = false;
+    int lightSamples = 0;
+    GeneratedSceneSettings generateSettings;
+    std::string sweepFilename;
+    Benchmark::SweepSettings sweep;
+    std::string regressDirectory;
+    bool regressUpdate = false;
+    Regression::Thresholds regressThresholds;
+    std::string textureFilename;
+    size_t textureCacheBytes = TextureCache::DEFAULT_CAPACITY;
+    FrameBuffer::Format storage = FrameBuffer::FLOAT32;
     // Output the file name
     std::string outputFilename;
+    int positionalCount = 0;
 
     if (argv < 2) // Less than 2 as the path and executable name are always present
         {
@@ -72,11 +262,192 @@ int main(int argv, char* argc[])
                 displayUsage(argc[0]);
                 return EXIT_SUCCESS;
             }
-            switch (i)
+            if (arg == "--bench")
+            {
+                // Run a built in benchmark instead of rendering
+                std::string benchName = (i + 1 < argv) ? argc[i + 1] : "";
+                if (!Benchmark::Run(benchName, std::cout))
+                {
+                    Benchmark::List(std::cout);
+                    return EXIT_FAILURE;
+                }
+                return EXIT_SUCCESS;
+            }
+            if ((arg == "--regress" || arg == "--regress-update") && i + 1 < argv)
+            {
+                regressUpdate = (arg == "--regress-update");
+                regressDirectory = argc[++i];
+                continue;
+            }
+            if (arg == "--regress-slowdown" && i + 1 < argv)
+            {
+                regressThresholds.maxSlowdown = std::max(atof(argc[++i]), 0.0) / 100.0;
+                continue;
+            }
+            if (arg == "--merge")
+            {
+                // Assemble crop renders into the full image instead of rendering
+                if (i + 2 >= argv)
+                {
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
+                }
+                std::vector<std::string> inputs(argc + i + 2, argc + argv);
+                return CropMerge::Merge(inputs, argc[i + 1], std::cerr) ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+            if (arg == "--worker" && i + 1 < argv)
+            {
+                // Render tiles for a coordinator until it says the image is done
+                std::string address = argc[i + 1];
+                size_t colon = address.find_last_of(':');
+                if (colon == std::string::npos)
+                {
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
+                }
+                return RenderCluster::RunWorker(address.substr(0, colon), atoi(address.c_str() + colon + 1), std::cerr) ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+            if (arg == "--cluster" && i + 1 < argv)
+            {
+                clusterWorkers = atoi(argc[++i]);
+                continue;
+            }
+            if (arg == "--port" && i + 1 < argv)
+            {
+                clusterPort = atoi(argc[++i]);
+                continue;
+            }
+            if (arg == "--spp" && i + 1 < argv)
+            {
+                raysPerPixel = std::max(atoi(argc[++i]), 1);
+                continue;
+            }
+            if (arg == "--denoise")
+            {
+                denoise = true;
+                continue;
+            }
+            if (arg == "--wavefront")
+            {
+                wavefront = true;
+                continue;
+            }
+            if (arg == "--sort-rays")
+            {
+                sortRays = true;
+                continue;
+            }
+            if (arg == "--precision" && i + 1 < argv)
+            {
+                FastMath::Precision precision;
+                if (!FastMath::ParsePrecision(argc[++i], precision))
+                {
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
+                }
+                FastMath::SetPrecision(precision);
+                continue;
+            }
+            if (arg == "--grid")
+            {
+                uniformGrid = true;
+                continue;
+            }
+            if (arg == "--light-samples" && i + 1 < argv)
+            {
+                lightSamples = std::max(atoi(argc[++i]), 1);
+                continue;
+            }
+            if (arg == "--threads" && i + 1 < argv)
+            {
+                threads = std::max(atoi(argc[++i]), 1);
+                continue;
+            }
+            if (arg == "--generate" && i + 1 < argv)
+            {
+                generate = true;
+                if (!generateSettings.Parse(argc[++i]))
+                {
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
+                }
+                continue;
+            }
+            if (arg == "--sweep" && i + 1 < argv)
+            {
+                sweepFilename = argc[++i];
+                continue;
+            }
+            if ((arg == "--sweep-objects" || arg == "--sweep-threads" || arg == "--sweep-spp") && i + 1 < argv)
+            {
+                std::vector<int>& counts = (arg == "--sweep-objects") ? sweep.objectCounts : (arg == "--sweep-threads") ? sweep.threadCounts : sweep.raysPerPixel;
+                if (!parseCounts(argc[++i], counts))
+                {
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
+                }
+                continue;
+            }
+            if (arg == "--storage" && i + 1 < argv)
+            {
+                if (!FrameBuffer::ParseFormat(argc[++i], storage))
+                {
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
+                }
+                continue;
+            }
+            if (arg == "--stream" && i + 1 < argv)
+            {
+                streamRows = std::max(atoi(argc[++i]), 1);
+                continue;
+            }
+            if (arg == "--texture" && i + 1 < argv)
+            {
+                textureFilename = argc[++i];
+                continue;
+            }
+            if (arg == "--texture-cache" && i + 1 < argv)
+            {
+                textureCacheBytes = (size_t)std::max(atoi(argc[++i]), 1) << 20;
+                continue;
+            }
+            if (arg == "--aov")
+            {
+                writeAOVs = true;
+                continue;
+            }
+            if (arg == "--seed" && i + 1 < argv)
+            {
+                seed = atoi(argc[++i]);
+                continue;
+            }
+            if (arg == "--crop" && i + 4 < argv)
+            {
+                cropX = atoi(argc[++i]);
+                cropY = atoi(argc[++i]);
+                cropWidth = atoi(argc[++i]);
+                cropHeight = atoi(argc[++i]);
+                continue;
+            }
+            if (arg == "--frames" && i + 1 < argv)
+            {
+                // Render an animation instead of a single image
+                frameCount = atoi(argc[++i]);
+                continue;
+            }
+            // Anything left that looks like an option is unknown or is missing its values
+            if (arg.size() > 1 && arg[0] == '-')
+            {
+                std::cerr << "Unknown option or missing values: " << arg << std::endl;
+                displayUsage(argc[0]);
+                return EXIT_FAILURE;
+            }
+            switch (++positionalCount)
             {
             case OUTPUT_FILE:
                 {
-                    outputFilename = argc[OUTPUT_FILE];
+                    outputFilename = arg;
                     // Check to see if the extension was included
                     if (outputFilename.find_last_of(".") == std::string::npos)
                     {
@@ -87,153 +458,211 @@ int main(int argv, char* argc[])
                 }
             case OUTPUT_WIDTH:
                 {
-                    imageWidth = atoi(argc[OUTPUT_WIDTH]);
+                    imageWidth = atoi(arg.c_str());
                     break;
                 }
             case OUTPUT_HEIGHT:
                 {
-                    imageHeight = atoi(argc[OUTPUT_HEIGHT]);
+                    imageHeight = atoi(arg.c_str());
                     break;
                 }
             default:
                 {
-                    continue;
+                    std::cerr << "Too many arguments: " << arg << std::endl;
+                    displayUsage(argc[0]);
+                    return EXIT_FAILURE;
                 }
             }
         }
     }
-   
-    // Need to change std::cout to outputFilename
-    std::streambuf* backup = std::cout.rdbuf();         // Backup std::cout's stream buffer
-    std::ofstream outbuff(outputFilename.c_str());      // Create an out file stream and set it to our output file name
-    std::cout.rdbuf(outbuff.rdbuf());                   // Set the stream buffer for the cout to the file out stream buffer
-
-    //\----------------------------------------------------------------------------------
-    //\ SCENE AND CAMERA - Position, Direction and Dimensions
-    //\----------------------------------------------------------------------------------
-    Scene mainScene;
-
-    Camera mainCamera;
-    mainCamera.SetPerspective(60.f, (float)imageWidth/(float)imageHeight, 0.1f, 1000.0f);
-    mainCamera.Setposition(Vector3(0.f,0.f, 1.f));
-    mainCamera.LookAt(Vector3(0.f,0.f,-2.5f), Vector3(0.f,1.f,0.f));
-   
-    Random::SetSeed(time(nullptr));
-    int raysPerPixel = 100;
-
-    Random::SetSeed((int)time(nullptr));
-
-    // Output the Image Header Data
-    std::cout << "P3" << std::endl;
-    std::cout << imageWidth << ' ' << imageHeight << std::endl;
-    std::cout << channelColours << std::endl;
-
-    //\----------------------------------------------------------------------------------
-    //\ LIGHTING 
-    //\----------------------------------------------------------------------------------
-    // Put the light in the scene
-    DirectionalLight dl = DirectionalLight(Matrix4::IDENTITY, Vector3(1.f, 1.f, 1.f), Vector3(-0.5773f, -0.5733f, -0.5773f));
-
-    //\----------------------------------------------------------------------------------
-    // MATERIALS 
-    //\----------------------------------------------------------------------------------
-                                                // | R     | G   | B        Ambient|Difuse|Specular|Rough |Reflect |Trans  |RefIndx
-    Material lightBlueSmooth =   Material(Vector3(0.2,   0.6,    1.f),    0.2f,   0.9f,   0.9f,   0.f,    0.9f,   0.9f,   1.52f);
-    Material lightBlueRough =    Material(Vector3(0.3f,  0.6f,   1.f),    0.2f,   0.9f,   0.6f,   1.f,    0.0f,   0.0f,   1.52f);
-    Material greenSmooth =       Material(Vector3(0.f,   0.6f,   0.0f),   0.2f,   0.9f,   0.9f,   0.f,    0.9f,   1.0f,   1.52f);
-    Material greenRough =        Material(Vector3(0.f,   0.6f,   0.f),    0.2f,   0.9f,   0.5f,   1.f,    0.0f,   0.f,    2.61f);
-    Material yellowSmooth =      Material(Vector3(0.5f,  0.5f,   0.f),    0.2f,   0.9f,   0.9f,   0.f,    1.0f,   0.f,    2.61f);
-    Material yellowRough =       Material(Vector3(0.5f,  0.5f,   0.f),    0.2f,   0.9f,   0.1f,   1.f,    0.0f,   0.f,    2.61f);
-    Material redSmooth =         Material(Vector3(1.f,   0.0f,   0.f),    0.2f,   0.9f,   0.9f,   0.f,    1.0f,   0.f,    2.61f);
-    Material redRough =          Material(Vector3(1.f,   0.0f,   0.f),    0.2f,   0.9f,   0.1f,   1.f,    0.0f,   0.f,    1.52f);
-    Material Clear = Material(Vector3(1.f, 1.0f, 1.0f), 0.1f, 0.1f, 0.9f, 0.f, 0.5f, 1.f, 1.52f);
-    Material ClearInner = Material(Vector3(1.f, 1.0f, 1.0f), 0.1f, 0.1f, 0.9f, 0.f, 0.5f, 1.f, 1.0f);
-
-    Material Metal =             Material(Vector3(0.8f,  0.8f,   0.8f),   0.1f,   0.1f,   0.9f,   0.f,    1.0f,   0.f,    2.61f);
-
-    //\----------------------------------------------------------------------------------
-    //\ OBJECTS IN SCENE - Spheres size, position and material
-    //\----------------------------------------------------------------------------------
-
-    // GROUND
-    Ellipsoid s1(Vector3(0.f, -100.5f, -2.5f), 100.f);
-    s1.SetScale(Vector3(1.f, 1.f, 1.f));
-    s1.SetMaterial(&greenRough);
-
-    // Sphere on the - LEFT [BLUE]
-    Ellipsoid s2(Vector3(-1.f, 0.f, -1.5f), 0.5f);
-    s2.SetScale(Vector3(1.f, 1.f, 1.f));
-    s2.SetMaterial(&lightBlueRough);
-
-    // THIRD ELLIPSOIN - CENTRE
-
-    Ellipsoid s3(Vector3(0.f, 0.f, -3.5f), 0.5f);
-    s3.SetScale(Vector3(1.f, 1.f, 1.f)); 
-    s3.SetMaterial(&redSmooth);
-
-    // THIRD ELLIPSOIN - CENTRE Right
-
-    Ellipsoid s6(Vector3(2.5f, 0.25f, -1.5f), 0.8f);
-    s6.SetScale(Vector3(1.f, 1.f, 1.f));
-    s6.SetMaterial(&greenSmooth);
 
 
-    // Sphere on the - RIGHT
-    Ellipsoid s4(Vector3(1.5f, 0.f, -4.5f), 0.5f);
-    s4.SetScale(Vector3(1.f, 1.f, 1.f));
-    s4.SetMaterial(&Clear);
-
-    // Clear Sphere
-    Ellipsoid s5(Vector3(1.5f, 0.f, -4.5f), 0.4f);
-    s5.SetScale(Vector3(1.f, 1.f, 1.f));
-    s5.SetMaterial(&ClearInner);
-
-    // ADDING SPHERES INTO THE SCENE
-    mainScene.AddObject(&s1);
-    mainScene.AddObject(&s2);
-    mainScene.AddObject(&s3);
-    mainScene.AddObject(&s4);
-    mainScene.AddObject(&s5);
-    mainScene.AddObject(&s6);
-    mainScene.AddLight(&dl);
-    mainScene.SetCamera(&mainCamera);
-
+    if (!regressDirectory.empty())
+    {
+        // Exits with failure when an image has changed or a render has slowed, for running from a build script
+        bool passed = regressUpdate ? Regression::Update(regressDirectory, std::cout) : Regression::Run(regressDirectory, regressThresholds, std::cout);
+        return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    if (!sweepFilename.empty())
+    {
+        // Time generated scenes instead of rendering an image - the objects of --generate are swept over
+        std::ofstream csv(sweepFilename);
+        if (!csv)
+        {
+            std::cerr << "Failed to write " << sweepFilename << std::endl;
+            return EXIT_FAILURE;
+        }
+        sweep.scene = generateSettings;
+        sweep.width = imageWidth;
+        sweep.height = imageHeight;
+        Benchmark::Sweep(sweep, csv, std::clog);
+        return EXIT_SUCCESS;
+    }
 
-    // Get reciprical of image dimensions
-    float invWidth = 1.f / (float)imageWidth;
-    float invHeight = 1.f / (float)imageHeight;
-    
+    // Everything from here on renders an image, which needs its name and size
+    if (positionalCount < OUTPUT_HEIGHT || imageWidth <= 0 || imageHeight <= 0)
+    {
+        std::cerr << "An output image name, width and height are needed" << std::endl;
+        displayUsage(argc[0]);
+        return EXIT_FAILURE;
+    }
 
     //\----------------------------------------------------------------------------------
-    //\ Main Render Loop 
+    //\ SCENE AND CAMERA - Position, Direction and Dimensions
     //\----------------------------------------------------------------------------------
+    ExampleScene example((float)imageWidth / (float)imageHeight);
+    std::unique_ptr<GeneratedScene> generated;
+    if (generate)
+    {
+        generated.reset(new GeneratedScene(generateSettings, (float)imageWidth / (float)imageHeight));
+        std::clog << "Generated scene " << generateSettings.ToString() << std::endl;
+        if (clusterWorkers >= 0 || frameCount > 1 || !textureFilename.empty())
+        {
+            std::clog << "--cluster, --frames and --texture only work with the example scene and are ignored" << std::endl;
+            clusterWorkers = -1;
+            frameCount = 1;
+            textureFilename.clear();
+        }
+    }
+    if (uniformGrid)
+    {
+        (generated ? generated->GetScene() : example.GetScene()).SetAcceleration(Scene::UNIFORM_GRID);
+    }
+    if (lightSamples > 0)
+    {
+        (generated ? generated->GetScene() : example.GetScene()).SetLightSelection(Scene::SAMPLED_LIGHTS, lightSamples);
+        if (clusterWorkers >= 0)
+        {
+            std::clog << "--light-samples is not passed on to cluster workers, they shadow test every light" << std::endl;
+        }
+    }
+    const Scene& scene = generated ? generated->GetScene() : example.GetScene();
+    Renderer renderer(imageWidth, imageHeight, raysPerPixel);
+    renderer.SetSeed(seed);
+    if (cropWidth >= 0)
+    {
+        renderer.SetCropWindow(cropX, cropY, cropWidth, cropHeight);
+    }
+    Texture groundTexture;
+    TextureCache::Shared().SetCapacity(textureCacheBytes);
+    if (!textureFilename.empty())
+    {
+        if (!openTexture(textureFilename, groundTexture))
+        {
+            std::cerr << "Failed to load the texture " << textureFilename << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (clusterWorkers >= 0)
+        {
+            std::clog << "--texture is not passed on to cluster workers, their part of the image is untextured" << std::endl;
+        }
+        example.SetGroundTexture(&groundTexture, GROUND_TEXTURE_REPEAT);
+    }
 
-    // For each vertical interval of near plane
-    for (int i = 0; i < imageHeight; i++)
+    if (frameCount > 1)
+    {
+        int result = renderAnimation(example, renderer, outputFilename, frameCount, denoise, writeAOVs);
+        if (result != EXIT_SUCCESS)
+        {
+            return result;
+        }
+    }
+    else if (streamRows > 0)
+    {
+        // Nothing but the band being rendered and the one being written is held - anything that needs the whole image is left out
+        if (!StreamingImage::CanStream(ImageOutput::FormatFromFilename(outputFilename)))
+        {
+            std::cerr << "Only .ppm and .pfm images can be streamed" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (denoise || writeAOVs || clusterWorkers >= 0)
+        {
+            std::clog << "--denoise, --aov and --cluster need the whole image and are ignored when streaming" << std::endl;
+        }
+        if (!renderer.RenderToFile(scene, outputFilename, streamRows))
+        {
+            std::cerr << "Failed to write " << outputFilename << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    else
     {
-        std::clog << "\rCurrently rendering scanline " << i << " of " << imageHeight << std::flush;
-        // For each interval of the near plane horizontally
-        for (int j = 0; j < imageWidth; j++)
+        // The image is kept in the chosen storage - only the cluster, the wavefront renderer and the denoiser need every
+        // pixel as full floats at once
+        FrameBuffer frame(renderer.GetCropWidth(), renderer.GetCropHeight(), storage);
+        AOVBuffers aovs;
+        AOVBuffers* renderAOVs = (denoise || writeAOVs) ? &aovs : nullptr;
+        if (clusterWorkers >= 0 || wavefront || denoise)
         {
-            ColourRGB rayColour(0.f, 0.f, 0.f);
-            for (int p = 0; p < raysPerPixel; p++)
+            std::vector<ColourRGB> pixels;
+            if (clusterWorkers >= 0)
+            {
+                // With no local workers the coordinator waits for workers on other machines to connect
+                if (!RenderCluster::RunCoordinator(renderer, argc[0], clusterWorkers, clusterPort, pixels, std::clog))
+                {
+                    return EXIT_FAILURE;
+                }
+                // The workers only send back colours, the output variables need nothing but primary rays
+                if (renderAOVs != nullptr)
+                {
+                    renderer.RenderAOVs(scene, aovs);
+                }
+            }
+            else if (wavefront)
+            {
+                WavefrontRenderer wavefrontRenderer(renderer, 1 << 18, threads);
+                wavefrontRenderer.SetRayOrder(sortRays ? WavefrontRenderer::MORTON_ORDER : WavefrontRenderer::MATERIAL_ORDER);
+                wavefrontRenderer.Render(scene, pixels);
+                if (renderAOVs != nullptr)
+                {
+                    renderer.RenderAOVs(scene, aovs);
+                }
+            }
+            else
+            {
+                renderer.Render(scene, pixels, renderAOVs);
+            }
+            if (denoise)
             {
-                // Calcuate Screen space Y Location
-                float screenSpaceY = 1.f - 2.f * ((float)i + Random::RandomFloat()) * invHeight;
-                // Get current pixel in screen sace coordinates
-                float screenSpaceX = 2.f * ((float)j + 0.5f) * invWidth - 1.f;
-                Vector2 screenSpacePos = Vector2(screenSpaceX, screenSpaceY);
-                Ray screenRay = mainScene.GetScreenRay(screenSpacePos);
-                rayColour += mainScene.CastRay(screenRay, 15);
+                denoisePixels(renderer, aovs, pixels);
             }
-            rayColour = rayColour * (1.f / (float)raysPerPixel);
-            //Write to output stream
-            WriteColourRGB(std::cout, rayColour);
+            frame.Store(pixels);
+        }
+        else
+        {
+            renderer.Render(scene, frame, renderAOVs);
+        }
+        if (!renderer.WriteImage(outputFilename, frame))
+        {
+            std::cerr << "Failed to write " << outputFilename << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (writeAOVs && !renderer.WriteAOVs(outputFilename, aovs))
+        {
+            std::cerr << "Failed to write the AOVs of " << outputFilename << std::endl;
+            return EXIT_FAILURE;
         }
-        std::cout << std::endl;
     }
 
-    // Set the output stream buffer back to what it was previously
-    std::cout.rdbuf(backup);
+    // Report how often the shadow occluder cache answered a shadow ray on its own - a cluster traces nothing here
+    ShadowCacheStats shadowStats = Scene::GetShadowCacheStats();
+    if (shadowStats.shadowTests > 0)
+    {
+        std::clog << "\nShadow rays: " << shadowStats.shadowTests << ", occluded: " << shadowStats.occluded
+            << ", answered by the occluder cache: " << shadowStats.cacheHits;
+        if (shadowStats.occluded > 0)
+        {
+            std::clog << " (" << 100.0 * (double)shadowStats.cacheHits / (double)shadowStats.occluded << "% of occluded)";
+        }
+        std::clog << std::endl;
+    }
+    TextureCacheStats textureStats = TextureCache::Shared().GetStats();
+    if (textureStats.lookups > 0)
+    {
+        std::clog << "Texture tiles: " << textureStats.lookups << " lookups, " << 100.0 * (double)textureStats.hits / (double)textureStats.lookups
+            << "% hits, " << textureStats.tilesLoaded << " loaded, " << textureStats.evictions << " evicted - peak "
+            << (double)textureStats.peakResidentBytes / (1 << 20) << " MB resident of " << (double)textureStats.capacityBytes / (1 << 20)
+            << " MB, the whole texture is " << (double)groundTexture.GetFullSize() / (1 << 20) << " MB" << std::endl;
+    }
     return EXIT_SUCCESS;
 }